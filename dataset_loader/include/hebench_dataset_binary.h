@@ -0,0 +1,183 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_DatasetBinary_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_DatasetBinary_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "hebench_dataset_loader.h"
+
+namespace hebench {
+namespace DataLoader {
+
+/**
+ * @brief Binary dataset file layout.
+ * @details All values are stored little-endian. Offsets are absolute from the
+ * start of the file. A binary dataset file is organized as:
+ *
+ * @code
+ * BinaryDatasetFileHeader
+ * BinaryDatasetComponent[input_count]      (inputs, in order)
+ * BinaryDatasetComponent[output_count]     (outputs, in order)
+ * component data                           (each component aligned to 64 bytes)
+ * @endcode
+ *
+ * The data for a component holds all of its samples contiguously, in order. All
+ * samples in a component have the same number of elements, thus, sample `i` starts
+ * at `data_offset + i * sample_size * element_size`. This is the same arrangement
+ * used by the Test Harness data loaders, so, the `NativeDataBuffer` for each sample
+ * can point directly into a memory mapped file.
+ */
+namespace BinaryDatasetFormat {
+
+static constexpr char Magic[8]                = { 'H', 'E', 'B', 'D', 'A', 'T', 'S', 'T' };
+static constexpr std::uint32_t ByteOrderMark  = 0x01020304;
+static constexpr std::uint16_t VersionMajor   = 1;
+static constexpr std::uint16_t VersionMinor   = 0;
+static constexpr std::uint64_t DataAlignment  = 64;
+static constexpr const char *DefaultExtension = ".hebd";
+
+enum DataType : std::uint32_t
+{
+    Int32 = 0,
+    Int64,
+    Float32,
+    Float64
+};
+
+template <typename T>
+constexpr DataType getDataType()
+{
+    static_assert(std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::int64_t> || std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "Only `int32_t`, `int64_t`, `float`, and `double` are supported as types.");
+    if constexpr (std::is_same_v<T, std::int32_t>)
+        return DataType::Int32;
+    else if constexpr (std::is_same_v<T, std::int64_t>)
+        return DataType::Int64;
+    else if constexpr (std::is_same_v<T, float>)
+        return DataType::Float32;
+    else
+        return DataType::Float64;
+}
+
+struct BinaryDatasetFileHeader
+{
+    char magic[8];
+    std::uint32_t byte_order_mark;
+    std::uint16_t version_major;
+    std::uint16_t version_minor;
+    std::uint64_t file_size;
+    std::uint32_t data_type; // BinaryDatasetFormat::DataType
+    std::uint32_t element_size; // size, in bytes, of each element
+    std::uint64_t input_count; // number of input components
+    std::uint64_t output_count; // number of output components
+    std::uint64_t components_offset;
+    std::uint64_t reserved;
+};
+
+struct BinaryDatasetComponent
+{
+    std::uint64_t sample_count;
+    std::uint64_t sample_size; // number of elements in each sample
+    std::uint64_t data_offset;
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(BinaryDatasetFileHeader) == 64, "Unexpected padding in binary dataset file header.");
+static_assert(sizeof(BinaryDatasetComponent) == 32, "Unexpected padding in binary dataset component.");
+
+/**
+ * @brief Determines whether the specified file starts with the binary dataset signature.
+ * @return `true` if file is a binary dataset, `false` otherwise (including when the file
+ * cannot be opened).
+ */
+bool isBinaryDatasetFile(const std::string &filename);
+
+/**
+ * @brief Saves a dataset to a file in binary dataset format.
+ * @param[in] filename Name of the file to write. Overwritten if it exists.
+ * @param[in] dataset Dataset to save.
+ * @throws std::invalid_argument if samples in a component do not all have the same size.
+ * @throws std::ios_base::failure if the file cannot be written.
+ */
+template <typename T>
+void saveToFile(const std::string &filename, const ExternalDataset<T> &dataset);
+/**
+ * @brief Converts a dataset from the external CSV format into binary dataset format.
+ * @param[in] csv_filename Name of the CSV dataset file to convert.
+ * @param[in] binary_filename Name of the binary dataset file to write.
+ * @param[in] max_threads Maximum number of threads to use to load the CSV dataset.
+ * If 0, the number of hardware threads is used.
+ * @details Values in the CSV dataset are converted to type `T`.
+ */
+template <typename T>
+void convertFromCSV(const std::string &csv_filename, const std::string &binary_filename,
+                    std::size_t max_threads = 0);
+
+} // namespace BinaryDatasetFormat
+
+/**
+ * @brief View of a memory mapped binary dataset file.
+ * @details The file is validated on construction: the header, the component table
+ * and the data bounds are checked. Sample data is accessed directly from the mapped
+ * memory.
+ *
+ * The file is mapped copy-on-write: sample data is writable through the pointers
+ * returned, but changes are never written back to the file.
+ */
+class MappedBinaryDataset
+{
+public:
+    MappedBinaryDataset(const MappedBinaryDataset &)            = delete;
+    MappedBinaryDataset &operator=(const MappedBinaryDataset &) = delete;
+
+public:
+    /**
+     * @brief Maps the specified binary dataset file into memory.
+     * @param[in] filename Name of binary dataset file to map.
+     * @throws std::ios_base::failure if the file cannot be mapped.
+     * @throws std::runtime_error if the file is not a valid binary dataset.
+     */
+    MappedBinaryDataset(const std::string &filename);
+    ~MappedBinaryDataset();
+
+    BinaryDatasetFormat::DataType getDataType() const { return static_cast<BinaryDatasetFormat::DataType>(m_p_file_header->data_type); }
+    std::uint64_t getElementSize() const { return m_p_file_header->element_size; }
+
+    std::uint64_t getInputCount() const { return m_p_file_header->input_count; }
+    const BinaryDatasetFormat::BinaryDatasetComponent &getInput(std::uint64_t index) const { return m_p_components[index]; }
+    std::uint64_t getOutputCount() const { return m_p_file_header->output_count; }
+    const BinaryDatasetFormat::BinaryDatasetComponent &getOutput(std::uint64_t index) const { return m_p_components[getInputCount() + index]; }
+
+    /**
+     * @brief Retrieves the number of samples in each component.
+     */
+    ExternalDatasetShape getShape() const;
+    /**
+     * @brief Retrieves a pointer to the data of a sample.
+     * @param[in] component Component containing the sample, as returned by `getInput()`
+     * or `getOutput()`.
+     * @param[in] sample_index Index of the sample. Must be less than `component.sample_count`.
+     */
+    void *getSampleData(const BinaryDatasetFormat::BinaryDatasetComponent &component,
+                        std::uint64_t sample_index) const;
+    /**
+     * @brief Size, in bytes, of the mapped file.
+     */
+    std::uint64_t getMappedSize() const { return m_mapped_size; }
+
+private:
+    void *m_p_mapped;
+    std::uint64_t m_mapped_size;
+    const BinaryDatasetFormat::BinaryDatasetFileHeader *m_p_file_header;
+    const BinaryDatasetFormat::BinaryDatasetComponent *m_p_components;
+};
+
+} // namespace DataLoader
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_DatasetBinary_H_0596d40a3cce4b108a81595c50eb286d
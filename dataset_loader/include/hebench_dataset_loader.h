@@ -34,6 +34,70 @@ struct ExternalDataset
     std::vector<std::vector<std::vector<T>>> outputs;
 };
 
+/**
+ * @brief Number of samples found in an external dataset for each component.
+ */
+struct ExternalDatasetShape
+{
+    /**
+     * @brief `input_sample_counts[i]` is the number of samples found for input parameter `i`.
+     */
+    std::vector<std::uint64_t> input_sample_counts;
+    /**
+     * @brief `output_sample_counts[i]` is the number of samples found for output component `i`.
+     */
+    std::vector<std::uint64_t> output_sample_counts;
+};
+
+/**
+ * @brief Receives the samples loaded from an external dataset.
+ * @details Implement this interface to have the loader store the parsed samples
+ * directly into their final location, without building an `ExternalDataset`.
+ */
+template <typename T>
+class IExternalDatasetSink
+{
+public:
+    virtual ~IExternalDatasetSink() {}
+
+    /**
+     * @brief Notifies the number of samples in the dataset for every component.
+     * @param[in] shape Number of samples found for each component.
+     * @throws Standard C++ exception derived from std::exception to abort loading.
+     * @details This method is called once, before any sample is stored, so that
+     * storage for the whole dataset can be allocated upfront. Samples in excess of
+     * those needed can be discarded later by returning `nullptr` from `getSampleBuffer()`.
+     *
+     * Default implementation does nothing.
+     */
+    virtual void onShape(const ExternalDatasetShape &shape) { (void)shape; }
+    /**
+     * @brief Notifies that samples with index up to \p sample_count - 1 will be
+     * stored for the specified component.
+     * @param[in] is_input `true` if component is an input parameter, `false` if it is
+     * an output component.
+     * @param[in] component_index Index of the component.
+     * @param[in] sample_count Total number of samples for the component so far.
+     * @details This method is never called concurrently. It is called, at least once,
+     * for every component found in the dataset, even if it has no samples.
+     */
+    virtual void reserveSamples(bool is_input, std::uint64_t component_index, std::uint64_t sample_count) = 0;
+    /**
+     * @brief Retrieves the location where to store a loaded sample.
+     * @param[in] is_input `true` if component is an input parameter, `false` if it is
+     * an output component.
+     * @param[in] component_index Index of the component.
+     * @param[in] sample_index Index of the sample in the component.
+     * @param[in] sample_size Number of elements in the loaded sample.
+     * @return Pointer to a buffer with room for \p sample_size elements where the sample
+     * will be copied, or `nullptr` to discard the sample.
+     * @details This method may be called concurrently for different samples. It is always
+     * called after `reserveSamples()` has covered \p sample_index .
+     */
+    virtual T *getSampleBuffer(bool is_input, std::uint64_t component_index,
+                               std::uint64_t sample_index, std::uint64_t sample_size) = 0;
+};
+
 template <typename T,
           // Only `int32_t`, `int64_t`, `float`, and `double` are supported as types.
           typename = std::enable_if_t<std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::int64_t> || std::is_same_v<T, float> || std::is_same_v<T, double>>>
@@ -45,6 +109,8 @@ public:
      * @param[in] filename Name of the file to load.
      * @param[in] max_loaded_size Maximum size, in bytes, allowed for the data to occupy after
      * loading. If 0, there is no limit to how much memory the data can occupy.
+     * @param[in] max_threads Maximum number of threads to use for loading, including the
+     * calling thread. If 0, the number of hardware threads is used.
      * @throws Standard C++ exception derived from std::exception on error describing the
      * failure.
      * @return An `ExternalDataset` structure containing the data loaded where the loaded scalars
@@ -58,9 +124,47 @@ public:
      * \p max_loaded_size . Otherwise, an exception is thrown because the size of the dataset in
      * the file specified after loading and converting to `ExternalDataset` is larger than
      * non-zero \p max_loaded_size .
+     *
+     * Data blocks are split into line-aligned chunks that are parsed concurrently, and
+     * CSV files referenced by `csv` kind data blocks are loaded concurrently. Loaded samples
+     * are always stored in the same order as they appear in the files.
      */
     static ExternalDataset<T> loadFromCSV(const std::string &filename,
-                                          std::uint64_t max_loaded_size = 0);
+                                          std::uint64_t max_loaded_size = 0,
+                                          std::size_t max_threads       = 0);
+    /**
+     * @brief Loads a dataset from an external csv file directly into a sink.
+     * @param[in] filename Name of the file to load.
+     * @param[in] sink Object that will receive the samples loaded.
+     * @param[in] max_threads Maximum number of threads to use for loading, including the
+     * calling thread. If 0, the number of hardware threads is used.
+     * @throws Standard C++ exception derived from std::exception on error describing the
+     * failure.
+     * @return The number of samples loaded for each component.
+     * @details The file is read twice. First, samples are counted, without parsing
+     * them, and the resulting shape is passed to `IExternalDatasetSink::onShape()`. Then,
+     * samples are loaded.
+     *
+     * Every sample is parsed into a per-thread scratch buffer and copied into the location
+     * given by \p sink , so, no intermediate copy of the whole dataset is kept in memory,
+     * except for the samples from CSV files referenced by `csv` kind data blocks, which
+     * are buffered per file while the files are loaded concurrently.
+     */
+    static ExternalDatasetShape loadFromCSV(const std::string &filename,
+                                            IExternalDatasetSink<T> &sink,
+                                            std::size_t max_threads = 0);
+    /**
+     * @brief Counts the samples in an external csv file without loading them.
+     * @param[in] filename Name of the file to scan.
+     * @param[in] max_threads Maximum number of threads to use, including the
+     * calling thread. If 0, the number of hardware threads is used.
+     * @throws Standard C++ exception derived from std::exception on error describing the
+     * failure.
+     * @return The number of samples found for each component.
+     * @details The file structure is fully validated, but samples are not parsed.
+     */
+    static ExternalDatasetShape scanCSV(const std::string &filename,
+                                        std::size_t max_threads = 0);
 };
 
 // template implementations
@@ -4,6 +4,7 @@
 #ifndef __HEBENCH_DATASET_LOADER_FUNCTIONAL_TEST__H__
 #define __HEBENCH_DATASET_LOADER_FUNCTIONAL_TEST__H__
 
+#include "hebench_dataset_binary.h"
 #include "hebench_dataset_loader.h"
 #include <cstdlib>
 #include <cstring>
@@ -23,24 +24,37 @@ enum DataType
 
 constexpr std::uint8_t help_arg = 1;
 constexpr const char *help_msg  = "NAME\n\tdata_loader - launches the data loader module.\n\n"
-                                 "SYNOPSYS\n\tdata_loader [OPTION] [FILE] [DATA_TYPE] [MAX_LOAD]\n\n"
+                                 "SYNOPSYS\n\tdata_loader [OPTION] [FILE] [DATA_TYPE] [MAX_LOAD]\n"
+                                 "\tdata_loader -c [FILE] [DATA_TYPE] [OUTPUT_FILE]\n\n"
                                  "DESCRIPTION\n\tIs a launcher app to test the data loader module.\n"
                                  "\tWith no MAX_LOAD, it will be set to 0.\n\n"
+                                 "\t-c, --convert converts the CSV dataset FILE into binary dataset format,\n"
+                                 "\t\tsaving it to OUTPUT_FILE (usually with extension \".hebd\").\n"
+                                 "\t\tValues are converted to DATA_TYPE.\n\n"
                                  "\t-h, --help displays help mesage and exits";
 constexpr const char *check_usage = "Please check the correct usage by typing \"data_loader -h\" or"
                                     " \"data_loader --help\".";
-constexpr const char *help_cstr_short = "-h";
-constexpr const char *help_cstr_long  = "--help";
+constexpr const char *help_cstr_short    = "-h";
+constexpr const char *help_cstr_long     = "--help";
+constexpr const char *convert_cstr_short = "-c";
+constexpr const char *convert_cstr_long  = "--convert";
 
 constexpr std::uint8_t file_path_arg       = 1;
 constexpr std::uint8_t type_arg            = 2;
 constexpr std::uint8_t max_loaded_size_arg = 3;
 
+constexpr std::uint8_t convert_arg             = 1;
+constexpr std::uint8_t convert_file_path_arg   = 2;
+constexpr std::uint8_t convert_type_arg        = 3;
+constexpr std::uint8_t convert_output_path_arg = 4;
+constexpr std::uint8_t convert_args_count      = 5;
+
 constexpr std::uint8_t max_args_allowed = 4;
 constexpr std::uint8_t min_args_allowed = 2;
 
 void signal_error(const char *msg, bool usage = false);
 std::uint8_t get_type_from_data(std::string);
 void load_from_csv(std::string data, std::filesystem::path file_path, std::uint64_t max_loaded_size);
+void convert_csv_to_binary(std::string data, std::filesystem::path file_path, std::filesystem::path output_path);
 
 #endif //!__HEBENCH_DATASET_LOADER_FUNCTIONAL_TEST__H__
@@ -0,0 +1,150 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_ParallelFor_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_ParallelFor_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace hebench {
+namespace Utilities {
+
+/**
+ * @brief Executes a task over a range of indices split into contiguous chunks
+ * that are processed concurrently.
+ * @param[in] count Number of indices in the range `[0, count)`.
+ * @param[in] task Function to call for each chunk. It receives the first index
+ * of the chunk and the index one past the end of the chunk.
+ * @param[in] min_chunk_size Minimum number of indices per chunk. Ranges smaller
+ * than twice this value are executed on the calling thread.
+ * @param[in] max_threads Maximum number of threads to use, including the calling
+ * thread. If `0`, the number of hardware threads is used.
+ * @throws Any exception thrown by \p task . If several chunks throw, the first
+ * exception caught is rethrown after all chunks complete.
+ * @details Chunks are contiguous and non-overlapping. Clients that need
+ * deterministic results must make the output of each index independent of the
+ * chunk in which it was processed.
+ */
+inline void parallelForChunks(std::uint64_t count,
+                              const std::function<void(std::uint64_t, std::uint64_t)> &task,
+                              std::uint64_t min_chunk_size = 1,
+                              std::size_t max_threads      = 0)
+{
+    if (count <= 0)
+        return;
+    if (min_chunk_size <= 0)
+        min_chunk_size = 1;
+    if (max_threads <= 0)
+        max_threads = std::max(std::thread::hardware_concurrency(), 1U);
+
+    std::uint64_t num_chunks = std::min<std::uint64_t>(max_threads, count / min_chunk_size);
+    if (num_chunks <= 1)
+    {
+        // not worth spawning threads
+        task(0, count);
+    } // end if
+    else
+    {
+        std::mutex mtx_exception;
+        std::exception_ptr p_exception;
+        auto run_chunk = [&task, &mtx_exception, &p_exception](std::uint64_t first, std::uint64_t last) {
+            try
+            {
+                task(first, last);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mtx_exception);
+                if (!p_exception)
+                    p_exception = std::current_exception();
+            }
+        };
+
+        // distribute the remainder among the first chunks
+        std::uint64_t chunk_size = count / num_chunks;
+        std::uint64_t remainder  = count % num_chunks;
+        std::vector<std::thread> threads;
+        threads.reserve(num_chunks - 1);
+        std::uint64_t first = 0;
+        for (std::uint64_t chunk_i = 0; chunk_i < num_chunks; ++chunk_i)
+        {
+            std::uint64_t last = first + chunk_size + (chunk_i < remainder ? 1 : 0);
+            if (chunk_i + 1 < num_chunks)
+                threads.emplace_back(run_chunk, first, last);
+            else
+                run_chunk(first, last); // calling thread handles last chunk
+            first = last;
+        } // end for
+        for (auto &th : threads)
+            th.join();
+
+        if (p_exception)
+            std::rethrow_exception(p_exception);
+    } // end else
+}
+
+/**
+ * @brief Finds the lowest index in a range for which a predicate holds, evaluating
+ * the predicate concurrently on contiguous chunks of the range.
+ * @param[in] count Number of indices in the range `[0, count)`.
+ * @param[in] predicate Function with signature `bool(std::uint64_t, State &)` to
+ * evaluate for each index. It receives the index and a default constructed state
+ * object, owned by the chunk, where it can record details about the index.
+ * @param[out] found_state If an index is found, receives the state of the chunk
+ * after the predicate returned `true` for the lowest index found. Left untouched
+ * otherwise.
+ * @param[in] min_chunk_size Minimum number of indices per chunk.
+ * @param[in] max_threads Maximum number of threads to use.
+ * @return The lowest index for which \p predicate returned `true`, or \p count if
+ * it returned `false` for all indices.
+ * @throws Any exception thrown by \p predicate , as parallelForChunks().
+ * @details The predicate is evaluated exactly once for every index lower than the
+ * index returned. Chunks stop evaluating the predicate at the first index found
+ * and skip the rest of their indices once a lower index is found by any chunk, so,
+ * the predicate may have been evaluated for some indices after the one returned.
+ * @sa parallelForChunks()
+ */
+template <class State, class Predicate>
+std::uint64_t parallelFindFirst(std::uint64_t count,
+                                const Predicate &predicate,
+                                State &found_state,
+                                std::uint64_t min_chunk_size = 1,
+                                std::size_t max_threads      = 0)
+{
+    std::atomic<std::uint64_t> found_i(count);
+    std::mutex mtx_found;
+    parallelForChunks(
+        count,
+        [&predicate, &found_state, &found_i, &mtx_found](std::uint64_t first, std::uint64_t last) {
+            State state;
+            for (std::uint64_t i = first; i < last && i < found_i; ++i)
+                if (predicate(i, state))
+                {
+                    // keep the state of the lowest index found
+                    std::lock_guard<std::mutex> lock(mtx_found);
+                    if (i < found_i)
+                    {
+                        found_state = std::move(state);
+                        found_i     = i;
+                    } // end if
+                    break;
+                } // end if
+        },
+        min_chunk_size,
+        max_threads);
+    return found_i;
+}
+
+} // namespace Utilities
+} // namespace hebench
+
+#endif // defined _HEBench_ParallelFor_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,275 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hebench_dataset_binary.h"
+
+namespace hebench {
+namespace DataLoader {
+namespace BinaryDatasetFormat {
+
+static bool isHostLittleEndian()
+{
+    const std::uint32_t value = ByteOrderMark;
+    std::uint8_t first_byte;
+    std::memcpy(&first_byte, &value, sizeof(first_byte));
+    return first_byte == (ByteOrderMark & 0xFF);
+}
+
+bool isBinaryDatasetFile(const std::string &filename)
+{
+    char magic[sizeof(Magic)];
+    std::ifstream fnum(filename, std::ios_base::in | std::ios_base::binary);
+    return fnum.is_open()
+           && fnum.read(magic, sizeof(magic))
+           && std::equal(magic, magic + sizeof(magic), Magic);
+}
+
+static std::uint64_t getDataTypeSize(DataType data_type)
+{
+    switch (data_type)
+    {
+    case DataType::Int32:
+        return sizeof(std::int32_t);
+    case DataType::Int64:
+        return sizeof(std::int64_t);
+    case DataType::Float32:
+        return sizeof(float);
+    case DataType::Float64:
+        return sizeof(double);
+    } // end switch
+    return 0;
+}
+
+template <typename T>
+void saveToFile(const std::string &filename, const ExternalDataset<T> &dataset)
+{
+    if (!isHostLittleEndian())
+        throw std::runtime_error("Binary dataset format is only supported on little-endian hosts.");
+
+    // compute file layout
+
+    BinaryDatasetFileHeader file_header;
+    std::memset(&file_header, 0, sizeof(file_header));
+    std::copy(Magic, Magic + sizeof(Magic), file_header.magic);
+    file_header.byte_order_mark   = ByteOrderMark;
+    file_header.version_major     = VersionMajor;
+    file_header.version_minor     = VersionMinor;
+    file_header.data_type         = getDataType<T>();
+    file_header.element_size      = sizeof(T);
+    file_header.input_count       = dataset.inputs.size();
+    file_header.output_count      = dataset.outputs.size();
+    file_header.components_offset = sizeof(BinaryDatasetFileHeader);
+
+    auto align = [](std::uint64_t value, std::uint64_t alignment) -> std::uint64_t {
+        return (value + alignment - 1) / alignment * alignment;
+    };
+
+    std::vector<const std::vector<std::vector<T>> *> components;
+    for (const auto &component : dataset.inputs)
+        components.push_back(&component);
+    for (const auto &component : dataset.outputs)
+        components.push_back(&component);
+
+    std::vector<BinaryDatasetComponent> component_table(components.size());
+    std::uint64_t offset = file_header.components_offset + component_table.size() * sizeof(BinaryDatasetComponent);
+    for (std::size_t component_i = 0; component_i < components.size(); ++component_i)
+    {
+        const std::vector<std::vector<T>> &component = *components[component_i];
+        BinaryDatasetComponent &binary_component     = component_table[component_i];
+        binary_component.sample_count                = component.size();
+        binary_component.sample_size                 = component.empty() ? 0 : component.front().size();
+        binary_component.reserved                    = 0;
+        for (std::size_t sample_i = 0; sample_i < component.size(); ++sample_i)
+        {
+            if (component[sample_i].size() != binary_component.sample_size)
+            {
+                std::stringstream ss;
+                ss << "Samples in a binary dataset component must all have the same size. "
+                   << (component_i < dataset.inputs.size() ? "Input " : "Output ")
+                   << (component_i < dataset.inputs.size() ? component_i : component_i - dataset.inputs.size())
+                   << ", sample " << sample_i << " has " << component[sample_i].size() << " elements, but "
+                   << binary_component.sample_size << " were expected.";
+                throw std::invalid_argument(ss.str());
+            } // end if
+        } // end for
+        binary_component.data_offset = align(offset, DataAlignment);
+        offset                       = binary_component.data_offset + binary_component.sample_count * binary_component.sample_size * sizeof(T);
+    } // end for
+    file_header.file_size = offset;
+
+    // write
+
+    std::ofstream fnum(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!fnum.is_open())
+        throw std::ios_base::failure("Could not open file \"" + filename + "\" for writing.");
+
+    std::uint64_t written = 0;
+    auto write_bytes      = [&fnum, &written](const void *p_data, std::size_t size) {
+        fnum.write(reinterpret_cast<const char *>(p_data), size);
+        written += size;
+    };
+    auto write_padding = [&fnum, &written](std::uint64_t next_offset) {
+        assert(next_offset >= written);
+        static const char zeros[DataAlignment] = {};
+        fnum.write(zeros, next_offset - written);
+        written = next_offset;
+    };
+
+    write_bytes(&file_header, sizeof(file_header));
+    write_bytes(component_table.data(), component_table.size() * sizeof(BinaryDatasetComponent));
+    for (std::size_t component_i = 0; component_i < components.size(); ++component_i)
+    {
+        write_padding(component_table[component_i].data_offset);
+        for (const auto &sample : *components[component_i])
+            write_bytes(sample.data(), sample.size() * sizeof(T));
+    } // end for
+    assert(written == file_header.file_size);
+
+    if (!fnum)
+        throw std::ios_base::failure("Error writing binary dataset to file \"" + filename + "\".");
+}
+
+template <typename T>
+void convertFromCSV(const std::string &csv_filename, const std::string &binary_filename,
+                    std::size_t max_threads)
+{
+    saveToFile<T>(binary_filename, ExternalDatasetLoader<T>::loadFromCSV(csv_filename, 0, max_threads));
+}
+
+template void saveToFile<std::int32_t>(const std::string &, const ExternalDataset<std::int32_t> &);
+template void saveToFile<std::int64_t>(const std::string &, const ExternalDataset<std::int64_t> &);
+template void saveToFile<float>(const std::string &, const ExternalDataset<float> &);
+template void saveToFile<double>(const std::string &, const ExternalDataset<double> &);
+template void convertFromCSV<std::int32_t>(const std::string &, const std::string &, std::size_t);
+template void convertFromCSV<std::int64_t>(const std::string &, const std::string &, std::size_t);
+template void convertFromCSV<float>(const std::string &, const std::string &, std::size_t);
+template void convertFromCSV<double>(const std::string &, const std::string &, std::size_t);
+
+} // namespace BinaryDatasetFormat
+
+//---------------------------
+// class MappedBinaryDataset
+//---------------------------
+
+MappedBinaryDataset::MappedBinaryDataset(const std::string &filename) :
+    m_p_mapped(nullptr),
+    m_mapped_size(0),
+    m_p_file_header(nullptr),
+    m_p_components(nullptr)
+{
+    using namespace BinaryDatasetFormat;
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::ios_base::failure("Could not open file \"" + filename + "\": " + std::strerror(errno));
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(BinaryDatasetFileHeader)))
+    {
+        ::close(fd);
+        throw std::runtime_error("File \"" + filename + "\" is not a valid binary dataset: file too small.");
+    } // end if
+
+    // private writable mapping: clients get non-const buffers, but the file is never modified
+    m_mapped_size = static_cast<std::uint64_t>(file_stat.st_size);
+    m_p_mapped    = ::mmap(nullptr, m_mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd); // mapping remains valid after closing the file
+    if (m_p_mapped == MAP_FAILED)
+    {
+        m_p_mapped = nullptr;
+        throw std::ios_base::failure("Could not map file \"" + filename + "\" into memory: " + std::strerror(errno));
+    } // end if
+
+    try
+    {
+        const std::uint8_t *p_data = reinterpret_cast<const std::uint8_t *>(m_p_mapped);
+        m_p_file_header            = reinterpret_cast<const BinaryDatasetFileHeader *>(p_data);
+
+        if (!std::equal(m_p_file_header->magic, m_p_file_header->magic + sizeof(Magic), Magic))
+            throw std::runtime_error("File \"" + filename + "\" is not a binary dataset.");
+        if (m_p_file_header->byte_order_mark != ByteOrderMark)
+            throw std::runtime_error("Binary dataset \"" + filename + "\" has a byte order not supported by this host.");
+        if (m_p_file_header->version_major != VersionMajor)
+        {
+            std::stringstream ss;
+            ss << "Binary dataset \"" << filename << "\" has unsupported version " << m_p_file_header->version_major
+               << "." << m_p_file_header->version_minor << ". Expected version " << VersionMajor << ".x.";
+            throw std::runtime_error(ss.str());
+        } // end if
+        if (m_p_file_header->file_size != m_mapped_size)
+            throw std::runtime_error("Binary dataset \"" + filename + "\" is truncated or corrupted.");
+        if (m_p_file_header->data_type > DataType::Float64)
+            throw std::runtime_error("Binary dataset \"" + filename + "\" has an unknown data type.");
+        if (m_p_file_header->element_size != getDataTypeSize(static_cast<DataType>(m_p_file_header->data_type)))
+            throw std::runtime_error("Binary dataset \"" + filename + "\" has an element size that does not match its data type.");
+
+        // validate tables
+        std::uint64_t component_count = m_p_file_header->input_count + m_p_file_header->output_count;
+        if (m_p_file_header->components_offset % alignof(BinaryDatasetComponent) != 0
+            || m_p_file_header->components_offset > m_mapped_size
+            || component_count < m_p_file_header->input_count
+            || component_count > (m_mapped_size - m_p_file_header->components_offset) / sizeof(BinaryDatasetComponent))
+            throw std::runtime_error("Binary dataset \"" + filename + "\" has invalid component table bounds.");
+        m_p_components = reinterpret_cast<const BinaryDatasetComponent *>(p_data + m_p_file_header->components_offset);
+        for (std::uint64_t i = 0; i < component_count; ++i)
+        {
+            const BinaryDatasetComponent &component = m_p_components[i];
+            std::uint64_t sample_bytes              = component.sample_size * m_p_file_header->element_size;
+            if (component.data_offset % DataAlignment != 0
+                || component.data_offset > m_mapped_size
+                || (component.sample_size > 0 && sample_bytes / component.sample_size != m_p_file_header->element_size)
+                || (sample_bytes > 0 && component.sample_count > (m_mapped_size - component.data_offset) / sample_bytes))
+                throw std::runtime_error("Binary dataset \"" + filename + "\" has invalid component data bounds.");
+        } // end for
+    }
+    catch (...)
+    {
+        ::munmap(m_p_mapped, m_mapped_size);
+        m_p_mapped = nullptr;
+        throw;
+    }
+}
+
+MappedBinaryDataset::~MappedBinaryDataset()
+{
+    if (m_p_mapped)
+        ::munmap(m_p_mapped, m_mapped_size);
+}
+
+ExternalDatasetShape MappedBinaryDataset::getShape() const
+{
+    ExternalDatasetShape retval;
+    retval.input_sample_counts.resize(getInputCount());
+    for (std::uint64_t i = 0; i < getInputCount(); ++i)
+        retval.input_sample_counts[i] = getInput(i).sample_count;
+    retval.output_sample_counts.resize(getOutputCount());
+    for (std::uint64_t i = 0; i < getOutputCount(); ++i)
+        retval.output_sample_counts[i] = getOutput(i).sample_count;
+    return retval;
+}
+
+void *MappedBinaryDataset::getSampleData(const BinaryDatasetFormat::BinaryDatasetComponent &component,
+                                         std::uint64_t sample_index) const
+{
+    assert(sample_index < component.sample_count);
+    return reinterpret_cast<std::uint8_t *>(m_p_mapped) + component.data_offset
+           + sample_index * component.sample_size * m_p_file_header->element_size;
+}
+
+} // namespace DataLoader
+} // namespace hebench
@@ -1,17 +1,25 @@
 // Copyright (C) 2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <cstring>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <limits>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 #include "hebench/modules/general/include/hebench_utilities.h"
 #include "hebench_dataset_loader.h"
+#include "hebench_parallel_for.h"
 
 namespace hebench {
 namespace DataLoader {
@@ -45,10 +53,22 @@ public:
     constexpr static const char *ControlLineKindLocal = "local";
     constexpr static const char *ControlLineKindCSV   = "csv";
 
+    /**
+     * @brief Minimum number of samples parsed per thread.
+     */
+    constexpr static std::uint64_t MinSamplesPerChunk = 64;
+
 public:
     static bool isComment(std::string_view s_view);
     static bool isEmpty(std::string_view s_view);
     static bool isCommentOrEmpty(std::string_view s_view) { return isComment(s_view) || isEmpty(s_view); }
+
+    /**
+     * @brief Resolves the number of threads to use.
+     * @param[in] max_threads Maximum number of threads requested. If 0, the number
+     * of hardware threads is used.
+     */
+    static std::size_t getThreadCount(std::size_t max_threads);
 };
 
 bool EDLHelper::isComment(std::string_view s_view)
@@ -63,6 +83,177 @@ bool EDLHelper::isEmpty(std::string_view s_view)
     return s_view.empty();
 }
 
+std::size_t EDLHelper::getThreadCount(std::size_t max_threads)
+{
+    return max_threads > 0 ? max_threads : std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+/**
+ * @brief Extracts lines from an input stream by reading it in large blocks.
+ * @details Lines are returned as views into an internal buffer, thus, no allocation
+ * occurs per line. A returned line is only valid until the next call to `getLine()`.
+ *
+ * Lines are split on `'\n'` following the same rules as `std::getline()`: the
+ * delimiter is not included in the line, and a last line without delimiter at the
+ * end of the stream is also returned.
+ */
+class EDLLineReader
+{
+public:
+    static constexpr std::size_t DefaultBlockSize = 4 * 1024 * 1024;
+
+    EDLLineReader(std::istream &is, std::size_t block_size = DefaultBlockSize);
+
+    /**
+     * @brief Extracts the next line from the stream.
+     * @param[out] out_line View of the extracted line.
+     * @return `true` if a line was extracted, `false` if the end of the stream
+     * was reached.
+     * @details \p out_line remains valid until the next call to `getLine()`
+     * or `getLines()`.
+     */
+    bool getLine(std::string_view &out_line);
+    /**
+     * @brief Extracts a batch of lines from the stream.
+     * @param[out] out_lines Views of the extracted lines. Previous contents are cleared.
+     * @param[in] max_lines Maximum number of lines to extract.
+     * @return `true` if at least one line was extracted, `false` if the end of the
+     * stream was reached.
+     * @details At least one line is extracted if available. All the lines extracted
+     * remain valid until the next call to `getLine()` or `getLines()`. This is intended
+     * to hand out all the complete lines from a block read at once, so that they can be
+     * processed concurrently.
+     */
+    bool getLines(std::vector<std::string_view> &out_lines, std::size_t max_lines);
+
+private:
+    /**
+     * @brief Extracts the next line only if it is complete in the buffer.
+     * @return `true` if a line was extracted.
+     */
+    bool getBufferedLine(std::string_view &out_line);
+    /**
+     * @brief Reads the next block from the stream into the buffer.
+     * @return `true` if any data was read.
+     */
+    bool readBlock();
+
+    std::istream &m_is;
+    std::vector<char> m_buffer;
+    std::size_t m_begin; // start of unread data in buffer
+    std::size_t m_end; // end of unread data in buffer
+};
+
+EDLLineReader::EDLLineReader(std::istream &is, std::size_t block_size) :
+    m_is(is),
+    m_buffer(std::max<std::size_t>(block_size, 1)),
+    m_begin(0),
+    m_end(0)
+{
+}
+
+bool EDLLineReader::readBlock()
+{
+    if (!m_is)
+        return false;
+
+    // move leftover partial line to the start of the buffer
+    if (m_begin > 0)
+    {
+        std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+        m_end -= m_begin;
+        m_begin = 0;
+    } // end if
+    // grow buffer if a single line does not fit
+    if (m_end >= m_buffer.size())
+        m_buffer.resize(m_buffer.size() * 2);
+
+    m_is.read(m_buffer.data() + m_end, static_cast<std::streamsize>(m_buffer.size() - m_end));
+    std::size_t bytes_read = static_cast<std::size_t>(m_is.gcount());
+    m_end += bytes_read;
+
+    return bytes_read > 0;
+}
+
+bool EDLLineReader::getBufferedLine(std::string_view &out_line)
+{
+    const char *p_begin = m_buffer.data() + m_begin;
+    const char *p_eol   = static_cast<const char *>(std::memchr(p_begin, '\n', m_end - m_begin));
+    if (!p_eol)
+        return false;
+
+    std::size_t eol = static_cast<std::size_t>(p_eol - m_buffer.data());
+    out_line        = std::string_view(p_begin, eol - m_begin);
+    m_begin         = eol + 1;
+    return true;
+}
+
+bool EDLLineReader::getLine(std::string_view &out_line)
+{
+    // read more data until a complete line is buffered
+    while (!getBufferedLine(out_line))
+    {
+        if (!readBlock())
+        {
+            // end of stream: return any leftover as the last line
+            if (m_begin >= m_end)
+                return false;
+            out_line = std::string_view(m_buffer.data() + m_begin, m_end - m_begin);
+            m_begin  = m_end;
+            return true;
+        } // end if
+    } // end while
+    return true;
+}
+
+bool EDLLineReader::getLines(std::vector<std::string_view> &out_lines, std::size_t max_lines)
+{
+    out_lines.clear();
+
+    std::string_view line;
+    if (max_lines > 0 && getLine(line))
+    {
+        out_lines.push_back(line);
+        // take the rest of complete lines already in the buffer without
+        // reading from the stream (reading would invalidate the previous lines)
+        while (out_lines.size() < max_lines && getBufferedLine(line))
+            out_lines.push_back(line);
+    } // end if
+
+    return !out_lines.empty();
+}
+
+/**
+ * @brief Sink that stores loaded samples into an `ExternalDataset`.
+ */
+template <typename T>
+class EDLDatasetSink : public IExternalDatasetSink<T>
+{
+public:
+    EDLDatasetSink(ExternalDataset<T> &dataset) :
+        m_dataset(dataset) {}
+
+    void reserveSamples(bool is_input, std::uint64_t component_index, std::uint64_t sample_count) override
+    {
+        std::vector<std::vector<std::vector<T>>> &data = is_input ? m_dataset.inputs : m_dataset.outputs;
+        if (data.size() <= component_index)
+            data.resize(component_index + 1);
+        if (data[component_index].size() < sample_count)
+            data[component_index].resize(sample_count);
+    }
+
+    T *getSampleBuffer(bool is_input, std::uint64_t component_index,
+                       std::uint64_t sample_index, std::uint64_t sample_size) override
+    {
+        std::vector<T> &sample = (is_input ? m_dataset.inputs : m_dataset.outputs)[component_index][sample_index];
+        sample.resize(sample_size);
+        return sample.data();
+    }
+
+private:
+    ExternalDataset<T> &m_dataset;
+};
+
 template <typename T>
 class EDLTypedHelper
 {
@@ -70,16 +261,51 @@ private:
     std::uint64_t m_pad_to_length;
     T m_pad_value;
     std::filesystem::path m_working_path;
+    std::size_t m_max_threads;
+    IExternalDatasetSink<T> *m_p_sink;
+    bool m_b_is_input;
+    std::uint64_t m_component_index;
+
+    /**
+     * @brief Location of the samples referenced by a CSV sample.
+     */
+    struct CSVSample
+    {
+        std::filesystem::path csv_path;
+        std::uint64_t csv_line_offset;
+        std::uint64_t csv_num_samples;
+    };
 
 public:
+    /**
+     * @brief Loads or scans a dataset file.
+     * @param[in] filename Name of the file to load.
+     * @param[in] p_sink Sink where to store the loaded samples. If `null`, samples
+     * are only counted and not parsed.
+     * @param[in] max_threads Maximum number of threads to use for parsing. If 0,
+     * the number of hardware threads is used.
+     * @throws Standard C++ exception derived from std::exception on error describing the
+     * failure.
+     * @return The number of samples found for each component.
+     */
+    static ExternalDatasetShape loadFile(const std::string &filename,
+                                         IExternalDatasetSink<T> *p_sink,
+                                         std::size_t max_threads);
+
     /**
      * @brief Reads the next data block as described by the control line
      * from the specified stream.
-     * @param[out] out_data Structure where to store the read data.
+     * @param[in] p_sink Sink where to store the read data. If `null`, samples
+     * are only counted and not parsed.
+     * @param[in] is_input Whether the data block is for an input or an output component.
+     * @param[in,out] sample_counts Number of samples read so far for each component. It
+     * is updated with the samples read for the component of the data block.
      * @param is Input data stream.
      * @param[in] control_line_tokens Control line defining the data block.
      * @param[in] working_path The current working directory. Any relative
      * paths will be resolved relative to this.
+     * @param[in] max_threads Maximum number of threads to use for parsing. If 0,
+     * the number of hardware threads is used.
      * @param[in,out] line_num Increases every time a line is extracted from
      * the input stream \p is.
      * @throws Standard C++ exception derived from std::exception on error describing the
@@ -92,10 +318,13 @@ public:
      * The stream reading pointer will be advanced to the next line after the
      * data block.
      */
-    static void readDataBlock(std::vector<std::vector<std::vector<T>>> &out_data,
-                              std::istream &is,
+    static void readDataBlock(IExternalDatasetSink<T> *p_sink,
+                              bool is_input,
+                              std::vector<std::uint64_t> &sample_counts,
+                              EDLLineReader &is,
                               const std::vector<std::string_view> &control_line_tokens,
                               const std::filesystem::path &working_path,
+                              std::size_t max_threads,
                               std::uint64_t &line_num);
 
 private:
@@ -106,14 +335,25 @@ private:
      * @param[in] pad_value Value to use for padding.
      * @param[in] working_path The current working directory. Any relative
      * paths will be resolved relative to this.
+     * @param[in] max_threads Maximum number of threads to use for parsing. If 0,
+     * the number of hardware threads is used.
+     * @param[in] p_sink Sink where to store the read samples. If `null`, samples
+     * are only counted and not parsed.
+     * @param[in] is_input Whether samples read are for an input or an output component.
+     * @param[in] component_index Index of the component for the samples read.
      */
     EDLTypedHelper(std::uint64_t pad_to_length,
                    const T &pad_value,
-                   const std::filesystem::path &working_path);
+                   const std::filesystem::path &working_path,
+                   std::size_t max_threads,
+                   IExternalDatasetSink<T> *p_sink,
+                   bool is_input,
+                   std::uint64_t component_index);
 
     /**
      * @brief Reads data block as defined by `local` kind.
-     * @param[out] out_data Collection where to store the read samples.
+     * @param[in,out] sample_count Index for the next sample read. Increases every time
+     * a sample is read.
      * @param is Input data stream.
      * @param[in] line_offset Line offset inside the input stream from where to start reading.
      * Line offset is relative to the current reading position in the stream.
@@ -134,15 +374,19 @@ private:
      * number of samples requested is read, or the end of the stream is found. To
      * read all the samples left in the stream, pass `std::numeric_limits<std::uint64_t>::max()`
      * into \p num_samples .
+     *
+     * Lines are extracted in batches and the samples in each batch are parsed
+     * concurrently in contiguous chunks.
      */
-    void readLocalDataBlock(std::vector<std::vector<T>> &out_data,
-                            std::istream &is,
+    void readLocalDataBlock(std::uint64_t &sample_count,
+                            EDLLineReader &is,
                             std::uint64_t line_offset,
                             std::uint64_t num_samples,
                             std::uint64_t &line_num);
     /**
      * @brief Reads data block as defined by `csv` kind.
-     * @param[out] out_data Collection where to store the read samples.
+     * @param[in,out] sample_count Index for the next sample read. Increases every time
+     * a sample is read.
      * @param is Input data stream.
      * @param[in] line_offset Line offset inside the input stream from where to start reading.
      * Line offset is relative to the current reading position in the stream.
@@ -165,50 +409,88 @@ private:
      * into \p num_samples .
      *
      * Note that a CSV sample points to a CSV file that may contain one or more data samples.
+     *
+     * All the CSV samples in the block are collected first. Then, the referenced CSV
+     * files are parsed concurrently, each one once, into a buffer per file. Finally,
+     * the buffers are concatenated into the sink in the order in which the CSV samples
+     * appear in the block.
      */
-    void readCSVDataBlock(std::vector<std::vector<T>> &out_data,
-                          std::istream &is,
+    void readCSVDataBlock(std::uint64_t &sample_count,
+                          EDLLineReader &is,
                           std::uint64_t line_offset,
                           std::uint64_t num_samples,
                           std::uint64_t &line_num);
 
+    /**
+     * @brief Reads the samples referenced by a CSV sample.
+     * @param[in] csv_sample CSV sample to read.
+     * @param[in] p_sink Sink where to store the read samples. If `null`, samples
+     * are only counted and not parsed.
+     * @param[in,out] sample_count Index for the next sample read. Increases every time
+     * a sample is read.
+     * @param[in] max_threads Maximum number of threads to use for parsing.
+     */
+    void readCSVSample(const CSVSample &csv_sample,
+                       IExternalDatasetSink<T> *p_sink,
+                       std::uint64_t &sample_count,
+                       std::size_t max_threads) const;
+
     /**
      * @brief Parses a local data sample from a CSV line.
+     * @param[out] out_sample Vector where to store the data sample, where each element
+     * is a scalar of type template `T`, parsed from the input CSV line. Previous contents
+     * are cleared, but capacity is kept.
      * @param[in] s_csv_line_sample Line from which to extract the data sample.
      * @throws Standard C++ exception derived from std::exception on error describing the
      * failure.
-     * @return Vector containing the data sample, where each element is a scalar of
-     * type template `T`, parsed from the input CSV line.
      * @details Tokens from the CSV line that cannot be directly read into a value of
      * type `T` will be converted to string and read as ASCII values, one element per
      * byte. Multibyte strings should work normally as each byte in a multibyte character
      * will be saved.
+     *
+     * Tokens are parsed in place from \p s_csv_line_sample without intermediate
+     * allocations per token.
+     */
+    void parseDataSample(std::vector<T> &out_sample, std::string_view s_csv_line_sample) const;
+    /**
+     * @brief Parses a token as a numeric value of type `T`.
+     * @param[out] out_value Value parsed from the token.
+     * @param[in] sv_token Token to parse.
+     * @return `true` if a value was parsed, `false` otherwise.
+     * @details This behaves as extracting a `T` from a `std::istream`: leading
+     * blankspaces and a leading `+` sign are skipped, and parsing stops at the
+     * first character that is not part of the value.
      */
-    std::vector<T> parseDataSample(std::string_view s_csv_line_sample);
+    static bool parseTokenAsValue(T &out_value, std::string_view sv_token);
     /**
      * @brief Parses a token value as a string, turning it into
      * equivalent ASCII values.
+     * @param[out] out_values Vector where to append the parsed values.
      * @param[in] sv_token String to parse.
-     * @return A vector of elements of template type `T` where each element corresponds
-     * to a character ASCII value from the input string, cast into `T`.
-     * @details Quotations surrounding the input will be ignored. This is, for example,
-     * if input is `"foo"`, the return value will be [ 102, 111, 111 ], where the leading
+     * @return The number of elements appended to \p out_values .
+     * @details Each element appended corresponds to a character ASCII value from the
+     * input string, cast into `T`.
+     *
+     * Quotations surrounding the input will be ignored. This is, for example,
+     * if input is `"foo"`, the values appended will be [ 102, 111, 111 ], where the leading
      * and ending quations are ignored.
      *
      * Leading and ending blankspaces (outside of quotations) will also be ignored.
      */
-    static std::vector<T> parseTokenAsString(std::string_view sv_token);
+    static std::size_t parseTokenAsString(std::vector<T> &out_values, std::string_view sv_token);
 };
 
 template <typename T>
-void EDLTypedHelper<T>::readDataBlock(std::vector<std::vector<std::vector<T>>> &out_data,
-                                      std::istream &is,
+void EDLTypedHelper<T>::readDataBlock(IExternalDatasetSink<T> *p_sink,
+                                      bool is_input,
+                                      std::vector<std::uint64_t> &sample_counts,
+                                      EDLLineReader &is,
                                       const std::vector<std::string_view> &control_line_tokens,
                                       const std::filesystem::path &working_path,
+                                      std::size_t max_threads,
                                       std::uint64_t &line_num)
 {
     assert(control_line_tokens.size() >= EDLHelper::ControlLine::ControlTokenSize);
-    assert(is.good());
     assert(std::filesystem::exists(working_path) && std::filesystem::is_directory(working_path));
 
     // parse the control line
@@ -326,21 +608,24 @@ void EDLTypedHelper<T>::readDataBlock(std::vector<std::vector<std::vector<T>>> &
         throw std::runtime_error(ss.str());
     } // end if
 
-    while (out_data.size() <= component_index)
-        out_data.emplace_back(std::vector<std::vector<T>>());
+    if (sample_counts.size() <= component_index)
+        sample_counts.resize(component_index + 1, 0);
+    if (p_sink)
+        p_sink->reserveSamples(is_input, component_index, sample_counts[component_index]);
 
-    EDLTypedHelper<T> helper(pad_to_length, pad_value, working_path);
+    EDLTypedHelper<T> helper(pad_to_length, pad_value, working_path, max_threads,
+                             p_sink, is_input, component_index);
 
     // identify `kind` of data: `local` or `csv`
     if (control_line_tokens[EDLHelper::ControlLine::Index_ControlKind] == EDLHelper::ControlLineKindLocal)
     {
-        helper.readLocalDataBlock(out_data[component_index],
+        helper.readLocalDataBlock(sample_counts[component_index],
                                   is, 0, num_samples,
                                   line_num);
     } // end if
     else if (control_line_tokens[EDLHelper::ControlLine::Index_ControlKind] == EDLHelper::ControlLineKindCSV)
     {
-        helper.readCSVDataBlock(out_data[component_index],
+        helper.readCSVDataBlock(sample_counts[component_index],
                                 is, 0, num_samples,
                                 line_num);
     } // end else if
@@ -355,101 +640,150 @@ void EDLTypedHelper<T>::readDataBlock(std::vector<std::vector<std::vector<T>>> &
 template <typename T>
 EDLTypedHelper<T>::EDLTypedHelper(std::uint64_t pad_to_length,
                                   const T &pad_value,
-                                  const std::filesystem::path &working_path) :
+                                  const std::filesystem::path &working_path,
+                                  std::size_t max_threads,
+                                  IExternalDatasetSink<T> *p_sink,
+                                  bool is_input,
+                                  std::uint64_t component_index) :
     m_pad_to_length(pad_to_length),
-    m_pad_value(pad_value)
+    m_pad_value(pad_value),
+    m_max_threads(max_threads),
+    m_p_sink(p_sink),
+    m_b_is_input(is_input),
+    m_component_index(component_index)
 {
     m_working_path = std::filesystem::canonical(working_path);
 }
 
 template <typename T>
-void EDLTypedHelper<T>::readLocalDataBlock(std::vector<std::vector<T>> &out_data,
-                                           std::istream &is,
+void EDLTypedHelper<T>::readLocalDataBlock(std::uint64_t &sample_count,
+                                           EDLLineReader &is,
                                            std::uint64_t line_offset,
                                            std::uint64_t num_samples,
                                            std::uint64_t &line_num)
 {
-    assert(is.good());
-
     std::uint64_t samples_read = 0;
+    std::string_view s_line;
+    std::vector<std::string_view> lines;
+    std::vector<std::string_view> sample_lines;
 
     // skip the line offset
-    while (is && line_num < line_offset)
-    {
-        std::string s_line;
-        if (std::getline(is, s_line))
-            ++line_num;
-    } // end while
+    while (line_num < line_offset && is.getLine(s_line))
+        ++line_num;
 
     // read samples until we reach number of samples requested or end of file
-    while (is && samples_read < num_samples)
+    // (every sample takes at least one line, so, never extract more lines than samples left)
+    while (samples_read < num_samples && is.getLines(lines, num_samples - samples_read))
     {
-        std::string s_line;
-        if (std::getline(is, s_line))
+        // select the lines in the batch that contain samples
+        sample_lines.clear();
+        for (std::size_t line_i = 0; line_i < lines.size(); ++line_i)
         {
             ++line_num;
-            if (!EDLHelper::isCommentOrEmpty(s_line))
-            {
-                auto sample = parseDataSample(s_line);
-                out_data.emplace_back(std::move(sample));
+            if (!EDLHelper::isCommentOrEmpty(lines[line_i]))
+                sample_lines.push_back(lines[line_i]);
+        } // end for
 
-                ++samples_read;
-            } // end if
+        if (m_p_sink)
+        {
+            // parse the samples concurrently and store them in place
+            std::uint64_t first_sample = sample_count;
+            m_p_sink->reserveSamples(m_b_is_input, m_component_index, first_sample + sample_lines.size());
+            hebench::Utilities::parallelForChunks(
+                sample_lines.size(),
+                [this, &sample_lines, first_sample](std::uint64_t first, std::uint64_t last) {
+                    std::vector<T> sample; // scratch buffer reused for every sample in the chunk
+                    for (std::uint64_t sample_i = first; sample_i < last; ++sample_i)
+                    {
+                        parseDataSample(sample, sample_lines[sample_i]);
+                        T *p_sample = m_p_sink->getSampleBuffer(m_b_is_input, m_component_index,
+                                                                first_sample + sample_i, sample.size());
+                        if (p_sample)
+                            std::copy(sample.begin(), sample.end(), p_sample);
+                    } // end for
+                },
+                EDLHelper::MinSamplesPerChunk,
+                m_max_threads);
         } // end if
+
+        sample_count += sample_lines.size();
+        samples_read += sample_lines.size();
     } // end while
 }
 
 template <typename T>
-void EDLTypedHelper<T>::readCSVDataBlock(std::vector<std::vector<T>> &out_data,
-                                         std::istream &is,
+void EDLTypedHelper<T>::readCSVDataBlock(std::uint64_t &sample_count,
+                                         EDLLineReader &is,
                                          std::uint64_t line_offset,
                                          std::uint64_t num_samples,
                                          std::uint64_t &line_num)
 {
-    assert(is.good());
-
     std::string err_msg;
     std::uint64_t samples_read = 0;
+    std::string_view s_line;
+    std::vector<CSVSample> csv_samples;
 
     // skip the line offset
-    while (is && line_num < line_offset)
-    {
-        std::string s_line;
-        if (std::getline(is, s_line))
-            ++line_num;
-    } // end while
+    while (line_num < line_offset && is.getLine(s_line))
+        ++line_num;
 
     // read samples until we reach number of samples requested or end of file
-    while (is && samples_read < num_samples)
+    while (samples_read < num_samples && is.getLine(s_line))
     {
-        std::string s_line;
-        if (std::getline(is, s_line))
+        ++line_num;
+        if (!EDLHelper::isCommentOrEmpty(s_line))
         {
-            ++line_num;
-            if (!EDLHelper::isCommentOrEmpty(s_line))
+            auto csv_sample_tokens = hebench::Utilities::CSVTokenizer::tokenizeLine(s_line);
+            if (csv_sample_tokens.size() < EDLHelper::CSVLine::CSVTokenSize)
             {
-                auto csv_sample_tokens = hebench::Utilities::CSVTokenizer::tokenizeLine(s_line);
-                if (csv_sample_tokens.size() < EDLHelper::CSVLine::CSVTokenSize)
+                std::stringstream ss;
+                ss << "Invalid CSV sample detected. A CSV sample must follow the following format: <filename>[, <from_line>[, <num_samples>]]";
+                throw std::runtime_error(ss.str());
+            } // end if
+
+            std::uint64_t csv_line_offset  = 0;
+            std::uint64_t csv_num_samples  = std::numeric_limits<std::uint64_t>::max();
+            std::filesystem::path csv_path = csv_sample_tokens[EDLHelper::CSVLine::Index_CSVFilename];
+            if (csv_path.is_relative())
+                csv_path = this->m_working_path / csv_path;
+            csv_path = std::filesystem::canonical(csv_path);
+
+            if (csv_sample_tokens.size() > EDLHelper::CSVLine::Index_CSVFromLine)
+            {
+                // read custom batch sizes
+                err_msg.clear();
+                try
+                {
+                    const std::string &s_csv_line_offset = csv_sample_tokens[EDLHelper::CSVLine::Index_CSVFromLine];
+                    std::stringstream ss                 = std::stringstream(s_csv_line_offset);
+                    if (!(ss >> csv_line_offset))
+                        throw std::runtime_error("Invalid value \"" + s_csv_line_offset + "\".");
+                }
+                catch (std::exception &ex)
+                {
+                    err_msg = std::string(": ") + ex.what();
+                }
+                catch (...)
+                {
+                    err_msg = ".";
+                }
+                if (!err_msg.empty())
                 {
                     std::stringstream ss;
-                    ss << "Invalid CSV sample detected. A CSV sample must follow the following format: <filename>[, <from_line>[, <num_samples>]]";
+                    ss << "Error reading <from_line> from CSV sample" << err_msg;
                     throw std::runtime_error(ss.str());
                 } // end if
+            } // end if
 
-                std::uint64_t csv_line_offset  = 0;
-                std::uint64_t csv_num_samples  = std::numeric_limits<std::uint64_t>::max();
-                std::filesystem::path csv_path = csv_sample_tokens[EDLHelper::CSVLine::Index_CSVFilename];
-                if (csv_path.is_relative())
-                    csv_path = this->m_working_path / csv_path;
-                csv_path = std::filesystem::canonical(csv_path);
-
-                std::ifstream fnum_csv;
+            if (csv_sample_tokens.size() > EDLHelper::CSVLine::Index_CSVNumSamples)
+            {
                 err_msg.clear();
                 try
                 {
-                    fnum_csv.open(csv_path, std::ifstream::in);
-                    if (!fnum_csv.is_open())
-                        throw std::ios_base::failure("Unable to open file for reading: " + std::string(csv_path));
+                    const std::string &s_csv_num_samples = csv_sample_tokens[EDLHelper::CSVLine::Index_CSVNumSamples];
+                    std::stringstream ss                 = std::stringstream(s_csv_num_samples);
+                    if (!(ss >> csv_num_samples))
+                        throw std::runtime_error("Invalid value \"" + s_csv_num_samples + "\".");
                 }
                 catch (std::exception &ex)
                 {
@@ -462,84 +796,127 @@ void EDLTypedHelper<T>::readCSVDataBlock(std::vector<std::vector<T>> &out_data,
                 if (!err_msg.empty())
                 {
                     std::stringstream ss;
-                    ss << "Error occurred attempting to parse CSV sample" << err_msg;
+                    ss << "Error reading <num_samples> from CSV sample" << err_msg;
                     throw std::runtime_error(ss.str());
                 } // end if
+            } // end if
+
+            csv_samples.push_back({ csv_path, csv_line_offset, csv_num_samples });
+
+            // CSV sample line read
+            ++samples_read;
+        } // end if
+    } // end while
+
+    // split available threads among the referenced CSV files
+    std::size_t max_threads      = EDLHelper::getThreadCount(m_max_threads);
+    std::size_t file_threads     = std::min<std::size_t>(max_threads, csv_samples.size());
+    std::size_t threads_per_file = file_threads > 0 ? std::max<std::size_t>(max_threads / file_threads, 1) : 1;
 
-                if (csv_sample_tokens.size() > EDLHelper::CSVLine::Index_CSVFromLine)
+    // read each referenced CSV file once, concurrently: parse its samples into a
+    // buffer of its own, or only count them if there is no sink
+    std::vector<ExternalDataset<T>> csv_datasets(m_p_sink ? csv_samples.size() : 0);
+    std::vector<std::uint64_t> csv_sample_counts(csv_samples.size(), 0);
+    hebench::Utilities::parallelForChunks(
+        csv_samples.size(),
+        [this, &csv_samples, &csv_datasets, &csv_sample_counts, threads_per_file](std::uint64_t first, std::uint64_t last) {
+            for (std::uint64_t csv_i = first; csv_i < last; ++csv_i)
+            {
+                if (m_p_sink)
                 {
-                    // read custom batch sizes
-                    err_msg.clear();
-                    try
-                    {
-                        const std::string &s_csv_line_offset = csv_sample_tokens[EDLHelper::CSVLine::Index_CSVFromLine];
-                        std::stringstream ss                 = std::stringstream(s_csv_line_offset);
-                        if (!(ss >> csv_line_offset))
-                            throw std::runtime_error("Invalid value \"" + s_csv_line_offset + "\".");
-                    }
-                    catch (std::exception &ex)
-                    {
-                        err_msg = std::string(": ") + ex.what();
-                    }
-                    catch (...)
-                    {
-                        err_msg = ".";
-                    }
-                    if (!err_msg.empty())
-                    {
-                        std::stringstream ss;
-                        ss << "Error reading <from_line> from CSV sample" << err_msg;
-                        throw std::runtime_error(ss.str());
-                    } // end if
+                    EDLDatasetSink<T> csv_sink(csv_datasets[csv_i]);
+                    readCSVSample(csv_samples[csv_i], &csv_sink, csv_sample_counts[csv_i], threads_per_file);
                 } // end if
+                else
+                    readCSVSample(csv_samples[csv_i], nullptr, csv_sample_counts[csv_i], threads_per_file);
+            } // end for
+        },
+        1,
+        file_threads);
+
+    // find where the samples of each CSV file go
+    std::uint64_t first_sample = sample_count;
+    std::vector<std::uint64_t> csv_first_samples(csv_samples.size());
+    for (std::size_t csv_i = 0; csv_i < csv_samples.size(); ++csv_i)
+    {
+        csv_first_samples[csv_i] = sample_count;
+        sample_count += csv_sample_counts[csv_i];
+    } // end for
 
-                if (csv_sample_tokens.size() > EDLHelper::CSVLine::Index_CSVNumSamples)
+    if (m_p_sink && sample_count > first_sample)
+    {
+        // concatenate the buffers into the sink concurrently
+        m_p_sink->reserveSamples(m_b_is_input, m_component_index, sample_count);
+        hebench::Utilities::parallelForChunks(
+            csv_samples.size(),
+            [this, &csv_datasets, &csv_sample_counts, &csv_first_samples](std::uint64_t first, std::uint64_t last) {
+                for (std::uint64_t csv_i = first; csv_i < last; ++csv_i)
                 {
-                    err_msg.clear();
-                    try
-                    {
-                        const std::string &s_csv_num_samples = csv_sample_tokens[EDLHelper::CSVLine::Index_CSVNumSamples];
-                        std::stringstream ss                 = std::stringstream(s_csv_num_samples);
-                        if (!(ss >> csv_num_samples))
-                            throw std::runtime_error("Invalid value \"" + s_csv_num_samples + "\".");
-                    }
-                    catch (std::exception &ex)
-                    {
-                        err_msg = std::string(": ") + ex.what();
-                    }
-                    catch (...)
+                    if (csv_sample_counts[csv_i] <= 0)
+                        continue;
+                    std::vector<std::vector<T>> &samples = (m_b_is_input ? csv_datasets[csv_i].inputs : csv_datasets[csv_i].outputs)[m_component_index];
+                    for (std::uint64_t sample_i = 0; sample_i < csv_sample_counts[csv_i]; ++sample_i)
                     {
-                        err_msg = ".";
-                    }
-                    if (!err_msg.empty())
-                    {
-                        std::stringstream ss;
-                        ss << "Error reading <num_samples> from CSV sample" << err_msg;
-                        throw std::runtime_error(ss.str());
-                    } // end if
-                } // end if
+                        T *p_sample = m_p_sink->getSampleBuffer(m_b_is_input, m_component_index,
+                                                                csv_first_samples[csv_i] + sample_i, samples[sample_i].size());
+                        if (p_sample)
+                            std::copy(samples[sample_i].begin(), samples[sample_i].end(), p_sample);
+                    } // end for
+                    // release the buffer as soon as it is no longer needed
+                    samples = std::vector<std::vector<T>>();
+                } // end for
+            },
+            1,
+            file_threads);
+    } // end if
+}
 
-                // CSV file specified in line successfully opened.
-                // Treat contents of CSV file as local data block (with header already parsed).
-                EDLTypedHelper<T> helper(m_pad_to_length, m_pad_value, csv_path.parent_path());
-                std::uint64_t csv_line_num = 0;
-                helper.readLocalDataBlock(out_data,
-                                          fnum_csv,
-                                          csv_line_offset, csv_num_samples,
-                                          csv_line_num);
-
-                // CSV sample line read
-                ++samples_read;
-            } // end if
-        } // end if
-    } // end while
+template <typename T>
+void EDLTypedHelper<T>::readCSVSample(const CSVSample &csv_sample,
+                                      IExternalDatasetSink<T> *p_sink,
+                                      std::uint64_t &sample_count,
+                                      std::size_t max_threads) const
+{
+    std::ifstream fnum_csv;
+    std::string err_msg;
+    try
+    {
+        fnum_csv.open(csv_sample.csv_path, std::ifstream::in);
+        if (!fnum_csv.is_open())
+            throw std::ios_base::failure("Unable to open file for reading: " + std::string(csv_sample.csv_path));
+    }
+    catch (std::exception &ex)
+    {
+        err_msg = std::string(": ") + ex.what();
+    }
+    catch (...)
+    {
+        err_msg = ".";
+    }
+    if (!err_msg.empty())
+    {
+        std::stringstream ss;
+        ss << "Error occurred attempting to parse CSV sample" << err_msg;
+        throw std::runtime_error(ss.str());
+    } // end if
+
+    // CSV file specified in line successfully opened.
+    // Treat contents of CSV file as local data block (with header already parsed).
+    EDLTypedHelper<T> helper(m_pad_to_length, m_pad_value, csv_sample.csv_path.parent_path(), max_threads,
+                             p_sink, m_b_is_input, m_component_index);
+    EDLLineReader csv_reader(fnum_csv);
+    std::uint64_t csv_line_num = 0;
+    helper.readLocalDataBlock(sample_count,
+                              csv_reader,
+                              csv_sample.csv_line_offset, csv_sample.csv_num_samples,
+                              csv_line_num);
 }
 
 template <typename T>
-std::vector<T> EDLTypedHelper<T>::parseDataSample(std::string_view s_csv_line_sample)
+void EDLTypedHelper<T>::parseDataSample(std::vector<T> &out_sample, std::string_view s_csv_line_sample) const
 {
-    std::vector<T> retval;
-    auto csv_tokens = hebench::Utilities::CSVTokenizer::tokenizeLine(s_csv_line_sample);
+    out_sample.clear();
+    auto csv_tokens = hebench::Utilities::CSVTokenizer::tokenizeLineInPlace(s_csv_line_sample);
 
     std::uint64_t size_since_last_pad = 0;
     for (std::size_t i = 0; i < csv_tokens.size(); ++i)
@@ -551,33 +928,27 @@ std::vector<T> EDLTypedHelper<T>::parseDataSample(std::string_view s_csv_line_sa
                 // if pad requested and size has been satisfied, no padding is added
                 while (size_since_last_pad < m_pad_to_length)
                 {
-                    retval.emplace_back(m_pad_value);
+                    out_sample.emplace_back(m_pad_value);
                     ++size_since_last_pad;
                 } // end while
             else
                 // if no pad requested, empty values are set to the pad value
-                retval.emplace_back(m_pad_value);
+                out_sample.emplace_back(m_pad_value);
             // reset pad to start a new section
             size_since_last_pad = 0;
         } // end if
         else
         {
             // read the next value
-            std::vector<T> value(1);
-            std::stringstream ss = std::stringstream(csv_tokens[i]);
-            try
-            {
-                if (!(ss >> value.front()))
-                    throw std::runtime_error("Invalid value.");
-            }
-            catch (...)
+            T value;
+            if (EDLTypedHelper<T>::parseTokenAsValue(value, csv_tokens[i]))
             {
+                out_sample.emplace_back(value);
+                ++size_since_last_pad;
+            } // end if
+            else
                 // error reading value, attempt to read it as a string
-                value = EDLTypedHelper<T>::parseTokenAsString(csv_tokens[i]);
-            }
-
-            retval.insert(retval.end(), value.begin(), value.end());
-            size_since_last_pad += value.size();
+                size_since_last_pad += EDLTypedHelper<T>::parseTokenAsString(out_sample, csv_tokens[i]);
         } // end else
     } // end for
 
@@ -585,18 +956,59 @@ std::vector<T> EDLTypedHelper<T>::parseDataSample(std::string_view s_csv_line_sa
     if (m_pad_to_length > 0)
         while (size_since_last_pad < m_pad_to_length)
         {
-            retval.emplace_back(m_pad_value);
+            out_sample.emplace_back(m_pad_value);
             ++size_since_last_pad;
         } // end while
-
-    return retval;
 }
 
 template <typename T>
-std::vector<T> EDLTypedHelper<T>::parseTokenAsString(std::string_view sv_token)
+bool EDLTypedHelper<T>::parseTokenAsValue(T &out_value, std::string_view sv_token)
 {
-    std::vector<T> retval;
+    // match stream extraction: skip leading blanks and explicit positive sign
+    hebench::Utilities::ltrim(sv_token);
+    if (!sv_token.empty() && sv_token.front() == '+')
+    {
+        sv_token.remove_prefix(1);
+        if (!sv_token.empty() && sv_token.front() == '-')
+            return false;
+    } // end if
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        // streams do not read "inf" or "nan", so, leave those to be read as strings
+        std::size_t digit_pos = (!sv_token.empty() && sv_token.front() == '-') ? 1 : 0;
+        if (digit_pos >= sv_token.size()
+            || (sv_token[digit_pos] != '.' && (sv_token[digit_pos] < '0' || sv_token[digit_pos] > '9')))
+            return false;
+    } // end if
+
+    auto result = std::from_chars(sv_token.data(), sv_token.data() + sv_token.size(), out_value);
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (result.ec == std::errc::result_out_of_range)
+        {
+            // streams read values that underflow, but reject those that overflow:
+            // leave this uncommon case to stream extraction
+            std::stringstream ss(std::string(sv_token.data(), result.ptr - sv_token.data()));
+            return static_cast<bool>(ss >> out_value);
+        } // end if
+        if (result.ec != std::errc())
+            return false;
+        // streams consume an exponent marker before failing on a missing exponent
+        // (as in "1e" or "1e+"), whereas std::from_chars stops before the marker
+        std::string_view sv_parsed(sv_token.data(), result.ptr - sv_token.data());
+        if (result.ptr != sv_token.data() + sv_token.size()
+            && (*result.ptr == 'e' || *result.ptr == 'E')
+            && sv_parsed.find_first_of("eE") == std::string_view::npos)
+            return false;
+        return true;
+    } // end if
+    else
+        return result.ec == std::errc();
+}
 
+template <typename T>
+std::size_t EDLTypedHelper<T>::parseTokenAsString(std::vector<T> &out_values, std::string_view sv_token)
+{
     hebench::Utilities::trim(sv_token);
 
     if (!sv_token.empty())
@@ -604,27 +1016,23 @@ std::vector<T> EDLTypedHelper<T>::parseTokenAsString(std::string_view sv_token)
         // remove surrounding quotations, if any
         if (sv_token.front() == '\"')
             sv_token.remove_prefix(1);
-        if (sv_token.back() == '\"')
+        if (!sv_token.empty() && sv_token.back() == '\"')
             sv_token.remove_suffix(1);
 
-        retval.reserve(sv_token.length());
         for (auto it = sv_token.begin(); it != sv_token.end(); ++it)
-            retval.emplace_back(static_cast<T>(*it));
+            out_values.emplace_back(static_cast<T>(*it));
     } // end if
 
-    return retval;
+    return sv_token.size();
 }
 
-//------------------------------
-// class ExternalDatasetLoader
-//------------------------------
-
-template <typename T, typename E>
-ExternalDataset<T> ExternalDatasetLoader<T, E>::loadFromCSV(const std::string &filename,
-                                                            std::uint64_t max_loaded_size)
+template <typename T>
+ExternalDatasetShape EDLTypedHelper<T>::loadFile(const std::string &filename,
+                                                 IExternalDatasetSink<T> *p_sink,
+                                                 std::size_t max_threads)
 {
     std::uint64_t line_num = 0;
-    ExternalDataset<T> retval;
+    ExternalDatasetShape retval;
 
     std::ifstream fnum;
 
@@ -633,48 +1041,48 @@ ExternalDataset<T> ExternalDatasetLoader<T, E>::loadFromCSV(const std::string &f
     fnum.open(filepath, std::ifstream::in);
     if (!fnum.is_open())
         throw std::ios_base::failure("Unable to open file for reading: " + std::string(filepath));
-
-    //EDLTypedHelper<T> helper(pad_to_length, pad_value, filename);
+    EDLLineReader reader(fnum);
 
     std::string err_msg;
     try
     {
-
-        while (fnum)
+        std::string_view sv_line;
+        while (reader.getLine(sv_line))
         {
-            std::string s_line;
-            if (std::getline(fnum, s_line))
+            ++line_num; // new line
+            if (!EDLHelper::isCommentOrEmpty(sv_line))
             {
-                ++line_num; // new line
-                if (!EDLHelper::isCommentOrEmpty(s_line))
+                // read control line
+                // (keep a copy: reading the data block overwrites the reader buffer)
+                std::string s_line(sv_line);
+                auto csv_tokens = hebench::Utilities::CSVTokenizer::tokenizeLineInPlace(s_line);
+                if (csv_tokens.size() < EDLHelper::ControlLine::ControlTokenSize)
                 {
-                    // read control line
-                    auto csv_tokens = hebench::Utilities::CSVTokenizer::tokenizeLineInPlace(s_line);
-                    if (csv_tokens.size() < EDLHelper::ControlLine::ControlTokenSize)
-                    {
-                        std::stringstream ss;
-                        ss << "ExternalDatasetLoader: in file " << filename << ":" << line_num << ": Invalid number of items in control line. Expected "
-                           << EDLHelper::ControlLine::ControlTokenSize << ", but " << csv_tokens.size() << " found.";
-                        throw std::runtime_error(ss.str());
-                    } // end if
-                    std::vector<std::vector<std::vector<T>>> *data = nullptr;
-                    if (csv_tokens[EDLHelper::ControlLine::Index_ControlIdentifier] == EDLHelper::ControlLineInput)
-                        data = &retval.inputs;
-                    else if (csv_tokens[EDLHelper::ControlLine::Index_ControlIdentifier] == EDLHelper::ControlLineOutput)
-                        data = &retval.outputs;
-                    else
-                    {
-                        std::stringstream ss;
-                        ss << "ExternalDatasetLoader: in file " << filename << ":" << line_num << ": Invalid control line identifier: \""
-                           << csv_tokens[EDLHelper::ControlLine::Index_ControlIdentifier] << "\".";
-                        throw std::runtime_error(ss.str());
-                    } // end else
-                    EDLTypedHelper<T>::readDataBlock(*data,
-                                                     fnum,
-                                                     csv_tokens,
-                                                     filepath.parent_path(),
-                                                     line_num);
+                    std::stringstream ss;
+                    ss << "ExternalDatasetLoader: in file " << filename << ":" << line_num << ": Invalid number of items in control line. Expected "
+                       << EDLHelper::ControlLine::ControlTokenSize << ", but " << csv_tokens.size() << " found.";
+                    throw std::runtime_error(ss.str());
                 } // end if
+                bool is_input;
+                if (csv_tokens[EDLHelper::ControlLine::Index_ControlIdentifier] == EDLHelper::ControlLineInput)
+                    is_input = true;
+                else if (csv_tokens[EDLHelper::ControlLine::Index_ControlIdentifier] == EDLHelper::ControlLineOutput)
+                    is_input = false;
+                else
+                {
+                    std::stringstream ss;
+                    ss << "ExternalDatasetLoader: in file " << filename << ":" << line_num << ": Invalid control line identifier: \""
+                       << csv_tokens[EDLHelper::ControlLine::Index_ControlIdentifier] << "\".";
+                    throw std::runtime_error(ss.str());
+                } // end else
+                EDLTypedHelper<T>::readDataBlock(p_sink,
+                                                 is_input,
+                                                 is_input ? retval.input_sample_counts : retval.output_sample_counts,
+                                                 reader,
+                                                 csv_tokens,
+                                                 filepath.parent_path(),
+                                                 max_threads,
+                                                 line_num);
             } // end if
         } // end while
     }
@@ -696,6 +1104,25 @@ ExternalDataset<T> ExternalDatasetLoader<T, E>::loadFromCSV(const std::string &f
 
     fnum.close();
 
+    return retval;
+}
+
+//------------------------------
+// class ExternalDatasetLoader
+//------------------------------
+
+template <typename T, typename E>
+ExternalDataset<T> ExternalDatasetLoader<T, E>::loadFromCSV(const std::string &filename,
+                                                            std::uint64_t max_loaded_size,
+                                                            std::size_t max_threads)
+{
+    ExternalDataset<T> retval;
+
+    EDLDatasetSink<T> sink(retval);
+    EDLTypedHelper<T>::loadFile(filename, &sink, max_threads);
+
+    std::filesystem::path filepath = std::filesystem::canonical(filename);
+
     // validate read size
     std::uint64_t loaded_size = 0;
     if (max_loaded_size > 0)
@@ -719,5 +1146,22 @@ ExternalDataset<T> ExternalDatasetLoader<T, E>::loadFromCSV(const std::string &f
     return retval;
 }
 
+template <typename T, typename E>
+ExternalDatasetShape ExternalDatasetLoader<T, E>::loadFromCSV(const std::string &filename,
+                                                              IExternalDatasetSink<T> &sink,
+                                                              std::size_t max_threads)
+{
+    // count the samples first, so that the sink can allocate all its storage
+    sink.onShape(EDLTypedHelper<T>::loadFile(filename, nullptr, max_threads));
+    return EDLTypedHelper<T>::loadFile(filename, &sink, max_threads);
+}
+
+template <typename T, typename E>
+ExternalDatasetShape ExternalDatasetLoader<T, E>::scanCSV(const std::string &filename,
+                                                          std::size_t max_threads)
+{
+    return EDLTypedHelper<T>::loadFile(filename, nullptr, max_threads);
+}
+
 } // namespace DataLoader
 } // namespace hebench
@@ -65,3 +65,26 @@ void load_from_csv(std::string data, std::filesystem::path file_path, std::uint6
     }
     }
 }
+
+void convert_csv_to_binary(std::string data, std::filesystem::path file_path, std::filesystem::path output_path)
+{
+    std::uint8_t data_load_type_evaluated = get_type_from_data(data);
+    switch (data_load_type_evaluated)
+    {
+    case i32:
+        BinaryDatasetFormat::convertFromCSV<std::int32_t>(file_path.string(), output_path.string());
+        break;
+    case i64:
+        BinaryDatasetFormat::convertFromCSV<std::int64_t>(file_path.string(), output_path.string());
+        break;
+    case f32:
+        BinaryDatasetFormat::convertFromCSV<float>(file_path.string(), output_path.string());
+        break;
+    case f64:
+        BinaryDatasetFormat::convertFromCSV<double>(file_path.string(), output_path.string());
+        break;
+    case data_fail:
+        signal_error("Unknown 'data_type' has been specified.");
+        break;
+    }
+}
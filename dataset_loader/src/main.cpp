@@ -9,6 +9,26 @@ int main(int argc, char **argv)
     {
         signal_error("Missing CSV file path.\n", true);
     }
+    else if (strcmp(argv[convert_arg], convert_cstr_short) == 0 || strcmp(argv[convert_arg], convert_cstr_long) == 0)
+    {
+        if (argc != convert_args_count)
+        {
+            signal_error("Conversion requires an input file, a data type and an output file.\n", true);
+        }
+        std::filesystem::path file_path = argv[convert_file_path_arg];
+        if (!std::filesystem::exists(file_path))
+        {
+            signal_error("The provided file does not exist.");
+        }
+        try
+        {
+            convert_csv_to_binary(argv[convert_type_arg], file_path, argv[convert_output_path_arg]);
+        }
+        catch (const std::exception &exc)
+        {
+            signal_error(exc.what());
+        }
+    }
     else if (argc == min_args_allowed)
     {
         if (strcmp(argv[help_arg], help_cstr_short) == 0 || strcmp(argv[help_arg], help_cstr_long) == 0)
@@ -0,0 +1,160 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "hebench_dataset_binary.h"
+
+using namespace hebench::DataLoader;
+
+namespace {
+
+using hebench::UnitTest::check;
+using hebench::UnitTest::checkThrows;
+
+template <typename T>
+std::vector<std::vector<std::vector<T>>> createComponents(std::mt19937_64 &rand,
+                                                          const std::vector<std::pair<std::size_t, std::size_t>> &shape)
+{
+    std::uniform_int_distribution<int> rand_value(-1000, 1000);
+    std::vector<std::vector<std::vector<T>>> retval(shape.size());
+    for (std::size_t component_i = 0; component_i < shape.size(); ++component_i)
+    {
+        retval[component_i].resize(shape[component_i].first);
+        for (std::vector<T> &sample : retval[component_i])
+        {
+            sample.resize(shape[component_i].second);
+            for (T &value : sample)
+                value = static_cast<T>(rand_value(rand)) / static_cast<T>(4);
+        } // end for
+    } // end for
+    return retval;
+}
+
+template <typename T>
+void checkComponent(const MappedBinaryDataset &mapped,
+                    const BinaryDatasetFormat::BinaryDatasetComponent &component,
+                    const std::vector<std::vector<T>> &expected)
+{
+    check(component.sample_count == expected.size(), "Component sample count does not match.");
+    for (std::size_t sample_i = 0; sample_i < expected.size(); ++sample_i)
+    {
+        check(component.sample_size == expected[sample_i].size(), "Component sample size does not match.");
+        const T *p_data = reinterpret_cast<const T *>(mapped.getSampleData(component, sample_i));
+        check(reinterpret_cast<std::uintptr_t>(p_data) % alignof(T) == 0, "Sample data is misaligned.");
+        check(expected[sample_i].empty() || std::memcmp(p_data, expected[sample_i].data(), expected[sample_i].size() * sizeof(T)) == 0,
+              "Sample data does not match.");
+    } // end for
+}
+
+template <typename T>
+void testRoundTrip(const std::string &filename)
+{
+    std::mt19937_64 rand(3);
+    ExternalDataset<T> dataset;
+    dataset.inputs  = createComponents<T>(rand, { { 5, 17 }, { 1, 3 }, { 8, 1 } });
+    dataset.outputs = createComponents<T>(rand, { { 40, 17 } });
+    BinaryDatasetFormat::saveToFile<T>(filename, dataset);
+
+    check(BinaryDatasetFormat::isBinaryDatasetFile(filename), "Binary dataset not detected.");
+
+    MappedBinaryDataset mapped(filename);
+    check(mapped.getDataType() == BinaryDatasetFormat::getDataType<T>(), "Data type does not match.");
+    check(mapped.getElementSize() == sizeof(T), "Element size does not match.");
+    check(mapped.getInputCount() == dataset.inputs.size(), "Input count does not match.");
+    check(mapped.getOutputCount() == dataset.outputs.size(), "Output count does not match.");
+    check(mapped.getMappedSize() == std::filesystem::file_size(filename), "Mapped size does not match file size.");
+    for (std::size_t i = 0; i < dataset.inputs.size(); ++i)
+        checkComponent(mapped, mapped.getInput(i), dataset.inputs[i]);
+    for (std::size_t i = 0; i < dataset.outputs.size(); ++i)
+        checkComponent(mapped, mapped.getOutput(i), dataset.outputs[i]);
+
+    ExternalDatasetShape shape = mapped.getShape();
+    check(shape.input_sample_counts == std::vector<std::uint64_t>({ 5, 1, 8 })
+              && shape.output_sample_counts == std::vector<std::uint64_t>({ 40 }),
+          "Dataset shape does not match.");
+
+    // samples in a component must have the same size
+    dataset.inputs[0][2].push_back(static_cast<T>(1));
+    checkThrows<std::invalid_argument>([&]() { BinaryDatasetFormat::saveToFile<T>(filename, dataset); },
+                                       "Dataset with samples of different sizes must be rejected.");
+}
+
+/**
+ * @brief Saves a valid dataset, modifies its header and checks that mapping it fails.
+ */
+void checkCorruptHeaderRejected(const std::string &filename,
+                                const std::function<void(BinaryDatasetFormat::BinaryDatasetFileHeader &)> &corrupt,
+                                const std::string &name)
+{
+    std::mt19937_64 rand(7);
+    ExternalDataset<double> dataset;
+    dataset.inputs  = createComponents<double>(rand, { { 4, 8 } });
+    dataset.outputs = createComponents<double>(rand, { { 4, 2 } });
+    BinaryDatasetFormat::saveToFile<double>(filename, dataset);
+
+    BinaryDatasetFormat::BinaryDatasetFileHeader file_header;
+    {
+        std::fstream fnum(filename, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+        fnum.read(reinterpret_cast<char *>(&file_header), sizeof(file_header));
+        corrupt(file_header);
+        fnum.seekp(0);
+        fnum.write(reinterpret_cast<const char *>(&file_header), sizeof(file_header));
+        check(fnum.good(), "Error writing corrupt binary dataset.");
+    }
+
+    checkThrows<std::runtime_error>([&]() { MappedBinaryDataset mapped(filename); },
+                                    "Binary dataset with " + name + " must be rejected.");
+}
+
+void testCorruptFiles(const std::string &filename)
+{
+    using BinaryDatasetFileHeader = BinaryDatasetFormat::BinaryDatasetFileHeader;
+
+    checkCorruptHeaderRejected(
+        filename, [](BinaryDatasetFileHeader &h) { h.magic[0] = 'X'; }, "invalid signature");
+    checkCorruptHeaderRejected(
+        filename, [](BinaryDatasetFileHeader &h) { ++h.version_major; }, "unsupported version");
+    checkCorruptHeaderRejected(
+        filename, [](BinaryDatasetFileHeader &h) { h.data_type = 17; }, "unknown data type");
+    // element size must match the data type, not only fit the file
+    checkCorruptHeaderRejected(
+        filename, [](BinaryDatasetFileHeader &h) { h.element_size = 4; }, "element size smaller than data type");
+    checkCorruptHeaderRejected(
+        filename, [](BinaryDatasetFileHeader &h) { h.element_size = 16; }, "element size larger than data type");
+    checkCorruptHeaderRejected(
+        filename, [](BinaryDatasetFileHeader &h) { h.data_type = BinaryDatasetFormat::DataType::Int32; }, "data type mismatching element size");
+    checkCorruptHeaderRejected(
+        filename, [](BinaryDatasetFileHeader &h) { h.output_count = 1000; }, "invalid component table");
+
+    // truncated file
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 8);
+    checkThrows<std::runtime_error>([&]() { MappedBinaryDataset mapped(filename); },
+                                    "Truncated binary dataset must be rejected.");
+}
+
+} // namespace
+
+int main()
+{
+    hebench::UnitTest::TemporaryDirectory tmp_dir("hebench_dataset_binary_test");
+    std::string filename = (tmp_dir.getPath() / "dataset.hebd").string();
+    return hebench::UnitTest::runTests({ [&filename]() { testRoundTrip<std::int32_t>(filename); },
+                                         [&filename]() { testRoundTrip<std::int64_t>(filename); },
+                                         [&filename]() { testRoundTrip<float>(filename); },
+                                         [&filename]() { testRoundTrip<double>(filename); },
+                                         [&filename]() { testCorruptFiles(filename); } });
+}
@@ -0,0 +1,177 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "hebench/modules/general/include/hebench_utilities.h"
+#include "hebench_dataset_loader.h"
+
+using namespace hebench::DataLoader;
+
+namespace {
+
+using hebench::UnitTest::check;
+
+/**
+ * @brief Reference sample parser: tokenizes into strings and reads each token
+ * through stream extraction, as the dataset loader did before parsing in place.
+ */
+template <typename T>
+std::vector<T> parseSampleBaseline(std::string_view s_csv_line_sample,
+                                   std::uint64_t pad_to_length,
+                                   T pad_value)
+{
+    std::vector<T> retval;
+    auto csv_tokens = hebench::Utilities::CSVTokenizer::tokenizeLine(s_csv_line_sample);
+
+    std::uint64_t size_since_last_pad = 0;
+    for (std::size_t i = 0; i < csv_tokens.size(); ++i)
+    {
+        if (csv_tokens[i].empty())
+        {
+            if (pad_to_length > 0)
+                while (size_since_last_pad < pad_to_length)
+                {
+                    retval.emplace_back(pad_value);
+                    ++size_since_last_pad;
+                } // end while
+            else
+                retval.emplace_back(pad_value);
+            size_since_last_pad = 0;
+        } // end if
+        else
+        {
+            T value;
+            std::stringstream ss(csv_tokens[i]);
+            if (ss >> value)
+            {
+                retval.emplace_back(value);
+                ++size_since_last_pad;
+            } // end if
+            else
+            {
+                // read as string
+                std::string_view sv_token = csv_tokens[i];
+                hebench::Utilities::trim(sv_token);
+                if (!sv_token.empty() && sv_token.front() == '\"')
+                    sv_token.remove_prefix(1);
+                if (!sv_token.empty() && sv_token.back() == '\"')
+                    sv_token.remove_suffix(1);
+                for (char c : sv_token)
+                    retval.emplace_back(static_cast<T>(c));
+                size_since_last_pad += sv_token.size();
+            } // end else
+        } // end else
+    } // end for
+
+    if (pad_to_length > 0)
+        while (size_since_last_pad < pad_to_length)
+        {
+            retval.emplace_back(pad_value);
+            ++size_since_last_pad;
+        } // end while
+
+    return retval;
+}
+
+template <typename T>
+void checkSample(const std::string &filename,
+                 const std::string &s_sample,
+                 std::uint64_t pad_to_length,
+                 const std::string &s_pad_value)
+{
+    {
+        std::ofstream fnum(filename);
+        fnum << "input, 0, 1, local";
+        if (pad_to_length > 0)
+            fnum << ", " << pad_to_length << ", " << s_pad_value;
+        fnum << std::endl
+             << s_sample << std::endl
+             << "output, 0, 1, local" << std::endl
+             << "0" << std::endl;
+        check(fnum.good(), "Error writing CSV dataset.");
+    }
+
+    T pad_value = static_cast<T>(0);
+    if (pad_to_length > 0)
+        std::stringstream(s_pad_value) >> pad_value;
+
+    ExternalDataset<T> dataset = ExternalDatasetLoader<T>::loadFromCSV(filename);
+    std::vector<T> expected    = parseSampleBaseline<T>(s_sample, pad_to_length, pad_value);
+    check(dataset.inputs.size() == 1 && dataset.inputs.front().size() == 1,
+          "Dataset shape does not match for sample \"" + s_sample + "\".");
+    const std::vector<T> &sample = dataset.inputs.front().front();
+    check(sample.size() == expected.size(),
+          "Sample size does not match for sample \"" + s_sample + "\": expected "
+              + std::to_string(expected.size()) + ", got " + std::to_string(sample.size()) + ".");
+    for (std::size_t i = 0; i < expected.size(); ++i)
+        check(sample[i] == expected[i],
+              "Value " + std::to_string(i) + " does not match for sample \"" + s_sample + "\": expected "
+                  + std::to_string(expected[i]) + ", got " + std::to_string(sample[i]) + ".");
+}
+
+template <typename T>
+void testParser(const std::string &filename)
+{
+    static const std::vector<std::string> samples = {
+        // plain values
+        "1, 2, 3",
+        "-17,0,42",
+        // whitespace
+        "  1  ,\t2\t, 3 ",
+        "4 5, 6",
+        // signs
+        "+5, -7, +-3, --2, -+2, +",
+        // quoted fields
+        "1, foo, \"34\", 5",
+        "\"a,b\", 3",
+        "\" 7 \", \"\"",
+        // empty fields and trailing commas
+        "1, 2,",
+        ",1",
+        "1,,2",
+        ",,",
+        " , 3",
+        // malformed numbers
+        "12abc, abc12, 1.2.3, ., -, -.",
+        "1e, 1e+, 1E-, 2e5x",
+        "0x1A, 010, 1e5, 1E-3, .5, 5., -.5",
+        "inf, -inf, nan, infinity",
+        // integer limits and overflow
+        "2147483647, -2147483648, 2147483648, -2147483649",
+        "9223372036854775807, -9223372036854775808, 9223372036854775808, -9223372036854775809",
+        "99999999999999999999, -99999999999999999999",
+        // floating point limits
+        "1e38, 1e39, 1e308, 1e309, 1e400, -1e400",
+        "1e-30, 1e-40, 1e-300, 1e-320, 1e-400"
+    };
+
+    for (const std::string &s_sample : samples)
+    {
+        checkSample<T>(filename, s_sample, 0, "0");
+        checkSample<T>(filename, s_sample, 3, "-1");
+        checkSample<T>(filename, s_sample, 8, "9");
+    } // end for
+}
+
+} // namespace
+
+int main()
+{
+    hebench::UnitTest::TemporaryDirectory tmp_dir("hebench_dataset_csv_parser_test");
+    std::string filename = (tmp_dir.getPath() / "dataset.csv").string();
+    return hebench::UnitTest::runTests({ [&filename]() { testParser<std::int32_t>(filename); },
+                                         [&filename]() { testParser<std::int64_t>(filename); },
+                                         [&filename]() { testParser<float>(filename); },
+                                         [&filename]() { testParser<double>(filename); } });
+}
@@ -0,0 +1,194 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "hebench_dataset_loader.h"
+#include "hebench_parallel_for.h"
+
+using namespace hebench::DataLoader;
+
+namespace {
+
+using hebench::UnitTest::check;
+using hebench::UnitTest::checkThrows;
+
+void testParallelForChunks()
+{
+    for (std::uint64_t count : { 0, 1, 5, 63, 1000 })
+        for (std::uint64_t min_chunk_size : { 0, 1, 64 })
+            for (std::size_t max_threads : { 0, 1, 3, 16 })
+            {
+                // every index is visited exactly once, in contiguous chunks
+                std::vector<std::atomic<int>> visits(count);
+                std::atomic<std::uint64_t> chunk_count(0);
+                hebench::Utilities::parallelForChunks(
+                    count,
+                    [&visits, &chunk_count](std::uint64_t first, std::uint64_t last) {
+                        check(first < last, "Empty chunk.");
+                        for (std::uint64_t i = first; i < last; ++i)
+                            ++visits[i];
+                        ++chunk_count;
+                    },
+                    min_chunk_size,
+                    max_threads);
+                for (const std::atomic<int> &visit : visits)
+                    check(visit == 1, "Index not visited exactly once.");
+                check(chunk_count <= max_threads || max_threads == 0,
+                      "More chunks than threads requested.");
+                check(min_chunk_size <= 1 || chunk_count <= 1 || count / chunk_count >= min_chunk_size,
+                      "Chunks smaller than the minimum size.");
+            } // end for
+
+    checkThrows<std::runtime_error>(
+        []() {
+            hebench::Utilities::parallelForChunks(
+                100,
+                [](std::uint64_t first, std::uint64_t) {
+                    if (first > 0)
+                        throw std::runtime_error("Chunk failed.");
+                },
+                1,
+                4);
+        },
+        "Exception thrown by a chunk must be rethrown.");
+}
+
+void testParallelFindFirst()
+{
+    struct FoundState
+    {
+        std::uint64_t index = 0;
+        std::size_t checks  = 0;
+    };
+
+    for (std::uint64_t count : { 0, 1, 5, 63, 1000 })
+        for (std::size_t max_threads : { 1, 3, 16 })
+            for (std::uint64_t found_at : { std::uint64_t(0), count / 2, count - 1, count })
+            {
+                if (found_at > count)
+                    continue;
+                // several indices satisfy the predicate, the lowest must be found
+                std::vector<std::atomic<int>> checks(count);
+                auto predicate = [&checks, found_at](std::uint64_t i, FoundState &state) {
+                    ++checks[i];
+                    ++state.checks;
+                    state.index = i;
+                    return i >= found_at && i % 3 == found_at % 3;
+                };
+                FoundState found_state;
+                std::uint64_t found_i = hebench::Utilities::parallelFindFirst(count, predicate, found_state, 1, max_threads);
+
+                check(found_i == found_at, "Lowest index satisfying the predicate not found.");
+                // indices before the one found are checked exactly once, which
+                // includes the index found: its details are kept from that check
+                for (std::uint64_t i = 0; i < found_i && i < count; ++i)
+                    check(checks[i] == 1, "Index before the one found not checked exactly once.");
+                if (found_i < count)
+                    check(checks[found_i] == 1 && found_state.index == found_i && found_state.checks > 0,
+                          "State of the index found not kept from its only check.");
+                else
+                    check(found_state.checks == 0, "State must be left untouched if no index is found.");
+            } // end for
+
+    FoundState found_state;
+    checkThrows<std::runtime_error>(
+        [&found_state]() {
+            hebench::Utilities::parallelFindFirst(
+                100,
+                [](std::uint64_t i, FoundState &) -> bool {
+                    if (i == 70)
+                        throw std::runtime_error("Predicate failed.");
+                    return false;
+                },
+                found_state,
+                1,
+                4);
+        },
+        "Exception thrown by the predicate must be rethrown.");
+}
+
+std::vector<std::vector<std::int64_t>> writeCSVFile(const std::string &filename, std::mt19937_64 &rand,
+                                                    std::size_t sample_count)
+{
+    std::uniform_int_distribution<std::int64_t> rand_value(-1000, 1000);
+    std::uniform_int_distribution<std::size_t> rand_size(1, 6);
+    std::vector<std::vector<std::int64_t>> retval(sample_count);
+    std::ofstream fnum(filename);
+    for (std::vector<std::int64_t> &sample : retval)
+    {
+        sample.resize(rand_size(rand));
+        for (std::size_t i = 0; i < sample.size(); ++i)
+        {
+            sample[i] = rand_value(rand);
+            fnum << (i > 0 ? ", " : "") << sample[i];
+        } // end for
+        fnum << std::endl;
+    } // end for
+    check(fnum.good(), "Error writing CSV file.");
+    return retval;
+}
+
+void testCSVDataBlock()
+{
+    hebench::UnitTest::TemporaryDirectory tmp_dir("hebench_dataset_parallel_load_test");
+    std::mt19937_64 rand(5);
+
+    // samples referenced by CSV samples are loaded in the order of the CSV samples,
+    // even though the referenced files are read concurrently
+    std::vector<std::vector<std::int64_t>> expected;
+    std::vector<std::vector<std::int64_t>> csv_data;
+    csv_data = writeCSVFile((tmp_dir.getPath() / "a.csv").string(), rand, 700);
+    expected.insert(expected.end(), csv_data.begin(), csv_data.end());
+    writeCSVFile((tmp_dir.getPath() / "empty.csv").string(), rand, 0);
+    csv_data = writeCSVFile((tmp_dir.getPath() / "b.csv").string(), rand, 300);
+    expected.insert(expected.end(), csv_data.begin() + 10, csv_data.begin() + 60);
+    csv_data = writeCSVFile((tmp_dir.getPath() / "c.csv").string(), rand, 3);
+    expected.insert(expected.end(), csv_data.begin(), csv_data.end());
+
+    std::string filename = (tmp_dir.getPath() / "dataset.csv").string();
+    {
+        std::ofstream fnum(filename);
+        fnum << "input, 0, 4, csv" << std::endl
+             << "a.csv" << std::endl
+             << "empty.csv" << std::endl
+             << "b.csv, 10, 50" << std::endl
+             << "c.csv" << std::endl
+             << "output, 0, 1, local" << std::endl
+             << "0" << std::endl;
+        check(fnum.good(), "Error writing CSV dataset.");
+    }
+
+    for (std::size_t max_threads : { 1, 2, 16 })
+    {
+        ExternalDataset<std::int64_t> dataset = ExternalDatasetLoader<std::int64_t>::loadFromCSV(filename, 0, max_threads);
+        check(dataset.inputs.size() == 1 && dataset.inputs.front() == expected,
+              "Samples from CSV files do not match with " + std::to_string(max_threads) + " threads.");
+        check(dataset.outputs.size() == 1 && dataset.outputs.front().size() == 1,
+              "Local samples do not match with " + std::to_string(max_threads) + " threads.");
+
+        ExternalDatasetShape shape = ExternalDatasetLoader<std::int64_t>::scanCSV(filename, max_threads);
+        check(shape.input_sample_counts == std::vector<std::uint64_t>({ expected.size() })
+                  && shape.output_sample_counts == std::vector<std::uint64_t>({ 1 }),
+              "Scanned shape does not match with " + std::to_string(max_threads) + " threads.");
+    } // end for
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testParallelForChunks,
+                                         testParallelFindFirst,
+                                         testCSVDataBlock });
+}
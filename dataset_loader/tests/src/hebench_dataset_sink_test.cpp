@@ -0,0 +1,137 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "hebench_dataset_loader.h"
+
+using namespace hebench::DataLoader;
+
+namespace {
+
+using hebench::UnitTest::check;
+using hebench::UnitTest::checkThrows;
+
+/**
+ * @brief Sink that allocates all its storage from the dataset shape and
+ * records the order of the calls it receives.
+ */
+class ShapeSink : public IExternalDatasetSink<double>
+{
+public:
+    ShapeSink(bool throw_on_shape = false) :
+        m_b_throw_on_shape(throw_on_shape), m_shape_calls(0), m_stored_samples(0) {}
+
+    void onShape(const ExternalDatasetShape &shape) override
+    {
+        check(m_stored_samples == 0, "Shape must be notified before any sample is stored.");
+        ++m_shape_calls;
+        m_shape = shape;
+        if (m_b_throw_on_shape)
+            throw std::runtime_error("Shape rejected.");
+        m_dataset.inputs.resize(shape.input_sample_counts.size());
+        for (std::size_t i = 0; i < shape.input_sample_counts.size(); ++i)
+            m_dataset.inputs[i].resize(shape.input_sample_counts[i]);
+        m_dataset.outputs.resize(shape.output_sample_counts.size());
+        for (std::size_t i = 0; i < shape.output_sample_counts.size(); ++i)
+            m_dataset.outputs[i].resize(shape.output_sample_counts[i]);
+    }
+
+    void reserveSamples(bool is_input, std::uint64_t component_index, std::uint64_t sample_count) override
+    {
+        check(m_shape_calls == 1, "Samples reserved before the shape was notified.");
+        const std::vector<std::uint64_t> &counts = is_input ? m_shape.input_sample_counts : m_shape.output_sample_counts;
+        check(component_index < counts.size() && sample_count <= counts[component_index],
+              "Reserved samples exceed the notified shape.");
+    }
+
+    double *getSampleBuffer(bool is_input, std::uint64_t component_index,
+                            std::uint64_t sample_index, std::uint64_t sample_size) override
+    {
+        ++m_stored_samples;
+        std::vector<double> &sample = (is_input ? m_dataset.inputs : m_dataset.outputs)[component_index][sample_index];
+        sample.resize(sample_size);
+        return sample.data();
+    }
+
+    const ExternalDataset<double> &getDataset() const { return m_dataset; }
+    const ExternalDatasetShape &getShape() const { return m_shape; }
+    std::size_t getShapeCalls() const { return m_shape_calls; }
+    std::uint64_t getStoredSamples() const { return m_stored_samples; }
+
+private:
+    bool m_b_throw_on_shape;
+    std::size_t m_shape_calls;
+    std::atomic<std::uint64_t> m_stored_samples;
+    ExternalDatasetShape m_shape;
+    ExternalDataset<double> m_dataset;
+};
+
+void writeDataset(const hebench::UnitTest::TemporaryDirectory &tmp_dir, const std::string &filename)
+{
+    {
+        std::ofstream fnum((tmp_dir.getPath() / "samples.csv").string());
+        for (int i = 0; i < 200; ++i)
+            fnum << i << ", " << i * 0.5 << std::endl;
+        check(fnum.good(), "Error writing CSV file.");
+    }
+    std::ofstream fnum(filename);
+    fnum << "# comment" << std::endl
+         << "input, 0, 3, local" << std::endl
+         << "1, 2" << std::endl
+         << std::endl
+         << "3, 4" << std::endl
+         << "5, 6" << std::endl
+         << "input, 1, 1, csv" << std::endl
+         << "samples.csv" << std::endl
+         << "output, 0, 2, local" << std::endl
+         << "7" << std::endl
+         << "8" << std::endl;
+    check(fnum.good(), "Error writing CSV dataset.");
+}
+
+void testOnShape()
+{
+    hebench::UnitTest::TemporaryDirectory tmp_dir("hebench_dataset_sink_test");
+    std::string filename = (tmp_dir.getPath() / "dataset.csv").string();
+    writeDataset(tmp_dir, filename);
+
+    ExternalDataset<double> expected = ExternalDatasetLoader<double>::loadFromCSV(filename);
+    for (std::size_t max_threads : { 1, 4 })
+    {
+        ShapeSink sink;
+        ExternalDatasetShape shape = ExternalDatasetLoader<double>::loadFromCSV(filename, sink, max_threads);
+        check(sink.getShapeCalls() == 1, "Shape must be notified exactly once.");
+        check(sink.getShape().input_sample_counts == std::vector<std::uint64_t>({ 3, 200 })
+                  && sink.getShape().output_sample_counts == std::vector<std::uint64_t>({ 2 }),
+              "Notified shape does not match the dataset.");
+        check(shape.input_sample_counts == sink.getShape().input_sample_counts
+                  && shape.output_sample_counts == sink.getShape().output_sample_counts,
+              "Returned shape does not match the notified shape.");
+        check(sink.getDataset().inputs == expected.inputs && sink.getDataset().outputs == expected.outputs,
+              "Samples stored in the sink do not match the loaded dataset.");
+    } // end for
+
+    // sink can abort loading from the shape, before any sample is stored
+    ShapeSink sink(true);
+    checkThrows<std::runtime_error>([&]() { ExternalDatasetLoader<double>::loadFromCSV(filename, sink); },
+                                    "Exception from the shape notification must abort loading.");
+    check(sink.getShapeCalls() == 1 && sink.getStoredSamples() == 0,
+          "No samples must be stored when the shape is rejected.");
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testOnShape });
+}
@@ -160,6 +160,36 @@ extern "C"
     void *loadReportFromCSV(const char *p_csv_content, char error_description[MAX_DESCRIPTION_BUFFER_SIZE]);
     void *loadReportFromCSVFile(const char *filename, char error_description[MAX_DESCRIPTION_BUFFER_SIZE]);
 
+    // binary
+
+    /**
+     * @brief Saves the report to a file in binary report format.
+     * @param p_report
+     * @param filename
+     * @returns `true` on success.
+     * @details Binary reports are versioned, little-endian files with fixed-width
+     * events that can be memory mapped and used without parsing. Binary reports
+     * hold the same information as CSV reports.
+     */
+    int32_t save2Binary(void *p_report, const char *filename);
+    /**
+     * @brief Loads a report from a binary report file.
+     * @param filename
+     * @param error_description
+     * @return Handle to the loaded report, or `null` on error.
+     * @details The file is memory mapped, thus, it must remain unchanged while the
+     * report is in use. Events are read directly from the mapped file until the
+     * report events are modified.
+     */
+    void *loadReportFromBinaryFile(const char *filename, char error_description[MAX_DESCRIPTION_BUFFER_SIZE]);
+    /**
+     * @brief Determines whether a file is a binary report.
+     * @param filename
+     * @return Greater than 0 if the file starts with the binary report signature,
+     * 0 otherwise or on error.
+     */
+    int32_t isBinaryReportFile(const char *filename);
+
     // misc/utilities
 
     /**
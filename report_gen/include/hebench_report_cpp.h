@@ -208,6 +208,37 @@ public:
     static TimingReport loadReportFromCSV(const std::string &s_csv_content);
     static TimingReport loadReportFromCSVFile(const std::string &filename);
 
+    // binary
+
+    /**
+     * @brief Saves this report to a file in binary report format.
+     * @details Binary reports hold the same information as CSV reports, but
+     * they are smaller and can be loaded without parsing.
+     */
+    void save2Binary(const std::string &filename);
+
+    /**
+     * @brief Loads a report from a binary report file.
+     * @details The file is memory mapped and it must remain unchanged while the
+     * loaded report is in use.
+     */
+    static TimingReport loadReportFromBinaryFile(const std::string &filename);
+    /**
+     * @brief Loads a report from a file in either CSV or binary report format.
+     * @details Format is detected from the file contents.
+     */
+    static TimingReport loadReportFromFile(const std::string &filename);
+    static bool isBinaryReportFile(const std::string &filename);
+
+    /**
+     * @brief Converts a CSV report file into a binary report file.
+     */
+    static void convertCSV2Binary(const std::string &csv_filename, const std::string &binary_filename);
+    /**
+     * @brief Converts a binary report file into a CSV report file.
+     */
+    static void convertBinary2CSV(const std::string &binary_filename, const std::string &csv_filename);
+
     template <class TimeInterval = std::ratio<1, 1>>
     static double computeElapsedWallTime(const TimingReportEventC &event);
     template <class TimeInterval = std::ratio<1, 1>>
@@ -24,6 +24,8 @@ struct ProgramConfig
     char time_unit_stats;
     char time_unit_overview;
     char time_unit_summary;
+    std::uint64_t sketch_threshold;
+    std::filesystem::path convert_file;
 
     static constexpr const char *TimeUnit         = "--time_unit";
     static constexpr const char *TimeUnitStats    = "--time_unit_stats";
@@ -31,8 +33,11 @@ struct ProgramConfig
     static constexpr const char *TimeUnitSummary  = "--time_unit_summary";
     static constexpr const char *ShowOverview     = "--show_overview";
     static constexpr const char *SilentRun        = "--silent_run";
+    static constexpr const char *SketchThreshold  = "--sketch_threshold";
+    static constexpr const char *ConvertFile      = "--convert_to";
 
-    static constexpr bool DefaultShowOverView = true;
+    static constexpr bool DefaultShowOverView             = true;
+    static constexpr std::uint64_t DefaultSketchThreshold = 0;
 
     void initializeConfig(const hebench::ArgsParser &parser);
     void showConfig(std::ostream &os) const;
@@ -73,6 +78,13 @@ void ProgramConfig::initializeConfig(const hebench::ArgsParser &parser)
 
     parser.getValue<bool>(b_show_overview, ShowOverview, DefaultShowOverView);
     b_silent = parser.hasArgument(SilentRun);
+    parser.getValue<std::uint64_t>(sketch_threshold, SketchThreshold, DefaultSketchThreshold);
+    if (parser.hasArgument(ConvertFile))
+    {
+        std::string s_convert_file;
+        parser.getValue<std::string>(s_convert_file, ConvertFile);
+        convert_file = s_convert_file;
+    } // end if
 
     std::string s_tmp;
 
@@ -121,7 +133,14 @@ void ProgramConfig::showConfig(std::ostream &os) const
        << "    Show overview: " << (b_show_overview ? "Yes" : "No") << std::endl
        << "    Overview time unit: " << (time_unit_overview == 0 ? fallback_time_unit : getTimeUnitName(time_unit_overview)) << std::endl
        << "    Summary time unit: " << (time_unit_summary == 0 ? fallback_time_unit : getTimeUnitName(time_unit_summary)) << std::endl
-       << "    Statistics time unit: " << (time_unit_stats == 0 ? fallback_time_unit : getTimeUnitName(time_unit_stats)) << std::endl;
+       << "    Statistics time unit: " << (time_unit_stats == 0 ? fallback_time_unit : getTimeUnitName(time_unit_stats)) << std::endl
+       << "    Sketch threshold (events): ";
+    if (sketch_threshold > 0)
+        os << sketch_threshold << std::endl;
+    else
+        os << "(exact statistics)" << std::endl;
+    if (!convert_file.empty())
+        os << "    Convert to: " << convert_file << std::endl;
     os << "==================" << std::endl;
 }
 
@@ -165,6 +184,19 @@ void initArgsParser(hebench::ArgsParser &parser, int argc, char **argv)
     parser.addArgument(ProgramConfig::ShowOverview, "--overview", 1, "<true | false | 1 | 0>",
                        "    [OPTIONAL] Specifies whether or not to display report overview to\n"
                        "    standard output. If option is missing, default is \"true\".");
+    parser.addArgument(ProgramConfig::ConvertFile, "-ct", 1, "<output_file>",
+                       "    [OPTIONAL] When present, instead of compiling, the input report is\n"
+                       "    converted and saved to the specified output file. If the output file\n"
+                       "    extension is \".hebr\", the report is saved in binary report format.\n"
+                       "    Otherwise, it is saved in CSV format. Input report format is detected\n"
+                       "    automatically. Binary reports are smaller and faster to compile than\n"
+                       "    CSV reports.");
+    parser.addArgument(ProgramConfig::SketchThreshold, "-st", 1, "<number_of_events>",
+                       "    [OPTIONAL] Number of events in a report above which percentiles and\n"
+                       "    trimmed statistics are estimated using streaming quantile sketches\n"
+                       "    (within 0.5% relative error) instead of sorting all the events. This\n"
+                       "    keeps memory bounded when compiling very large reports. If missing\n"
+                       "    or \"0\", exact statistics are always computed.");
     parser.addArgument(ProgramConfig::SilentRun, "--silent", 0, "",
                        "    [OPTIONAL] When present, this flag indicates that the run must be\n"
                        "    silent. Only specifically requested outputs will be displayed to\n"
@@ -194,20 +226,35 @@ int main(int argc, char **argv)
             std::cout << std::endl;
         } // end if
 
-        hebench::ReportGen::Compiler::ReportCompilerConfigC compile_config;
         std::string s_input_file = config.input_file.string();
         std::vector<char> c_error_msg(1024, 0);
 
-        compile_config.input_file         = s_input_file.c_str();
-        compile_config.b_show_overview    = config.b_show_overview ? 1 : 0;
-        compile_config.b_silent           = config.b_silent ? 1 : 0;
-        compile_config.time_unit          = config.time_unit;
-        compile_config.time_unit_stats    = config.time_unit_stats;
-        compile_config.time_unit_overview = config.time_unit_overview;
-        compile_config.time_unit_summary  = config.time_unit_summary;
+        if (!config.convert_file.empty())
+        {
+            std::string s_convert_file = config.convert_file.string();
+            if (!hebench::ReportGen::Compiler::convertReport(s_input_file.c_str(), s_convert_file.c_str(),
+                                                             c_error_msg.data(), c_error_msg.size()))
+                throw std::runtime_error(c_error_msg.data());
+            if (!config.b_silent)
+                std::cout << "Report saved to:" << std::endl
+                          << "  " << config.convert_file << std::endl;
+        } // end if
+        else
+        {
+            hebench::ReportGen::Compiler::ReportCompilerConfigC compile_config;
+
+            compile_config.input_file         = s_input_file.c_str();
+            compile_config.b_show_overview    = config.b_show_overview ? 1 : 0;
+            compile_config.b_silent           = config.b_silent ? 1 : 0;
+            compile_config.time_unit          = config.time_unit;
+            compile_config.time_unit_stats    = config.time_unit_stats;
+            compile_config.time_unit_overview = config.time_unit_overview;
+            compile_config.time_unit_summary  = config.time_unit_summary;
+            compile_config.sketch_threshold   = config.sketch_threshold;
 
-        if (!hebench::ReportGen::Compiler::compile(&compile_config, c_error_msg.data(), c_error_msg.size()))
-            throw std::runtime_error(c_error_msg.data());
+            if (!hebench::ReportGen::Compiler::compile(&compile_config, c_error_msg.data(), c_error_msg.size()))
+                throw std::runtime_error(c_error_msg.data());
+        } // end else
     }
     catch (hebench::ArgsParser::HelpShown &)
     {
@@ -55,6 +55,13 @@ extern "C"
      * @brief Time unit for report summaries. If `0`, the fallback `time_unit` will be used.
      */
         char time_unit_summary;
+        /**
+     * @brief Number of events in a report above which statistics are estimated
+     * using streaming quantile sketches instead of sorting all the events.
+     * @details Estimated percentiles and trimmed statistics are within 0.5% relative
+     * error of the exact values. If `0`, exact statistics are always computed.
+     */
+        uint64_t sketch_threshold;
     };
 
     /**
@@ -72,6 +79,23 @@ extern "C"
  */
     int32_t compile(const ReportCompilerConfigC *p_config, char *s_error, size_t s_error_size);
 
+    /**
+ * @brief Converts a report file between CSV and binary report formats.
+ * @param[in] input_filename Report file to convert. Format is detected from the
+ * file contents.
+ * @param[in] output_filename File where to write the converted report. If the
+ * file extension is `.hebr`, the report is written in binary format, otherwise, it is
+ * written in CSV format.
+ * @param[out] s_error Pointer to buffer to receive any error message. If `null`, error messages
+ * are ignored.
+ * @param[in] s_error_size Size, in bytes, of the memory pointed to by \p s_error.
+ * @return true on success.
+ * @details Binary reports hold the same information as CSV reports, but they are
+ * smaller and `compile()` reads them directly from a memory mapped file without
+ * parsing.
+ */
+    int32_t convertReport(const char *input_filename, const char *output_filename, char *s_error, size_t s_error_size);
+
     } // namespace Compiler
     } // namespace ReportGen
     } // namespace hebench
@@ -0,0 +1,108 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_ReportQuantileSketch_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_ReportQuantileSketch_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <vector>
+
+namespace hebench {
+namespace ReportGen {
+
+/**
+ * @brief Streaming sketch to estimate quantiles of non-negative values with bounded
+ * relative error.
+ * @details Values are counted into logarithmically spaced buckets such that any
+ * quantile estimate is within the specified relative accuracy of the exact value
+ * (for all quantiles that are not in collapsed buckets, see below).
+ *
+ * The sketch can be fed incrementally, one (weighted) value at a time, and sketches
+ * can be merged. Memory usage is bounded by the maximum number of buckets, regardless
+ * of the number of values added. When more buckets are needed, the lowest buckets
+ * are collapsed together, which only degrades accuracy of the lowest quantiles, while
+ * keeping tail quantiles, such as p99.9 and p99.99, accurate.
+ *
+ * Values less than or equal to zero (or smaller than the minimum trackable value)
+ * are counted in a special zero bucket.
+ */
+class QuantileSketch
+{
+public:
+    static constexpr double DefaultRelativeAccuracy    = 0.005;
+    static constexpr std::size_t DefaultMaxBucketCount = 4096;
+
+    /**
+     * @brief Creates a new, empty sketch.
+     * @param[in] relative_accuracy Maximum relative error for quantile estimates.
+     * Must be in the range `(0, 1)`.
+     * @param[in] max_bucket_count Maximum number of buckets to maintain. Must be positive.
+     * @throws std::invalid_argument on invalid parameters.
+     */
+    QuantileSketch(double relative_accuracy = DefaultRelativeAccuracy,
+                   std::size_t max_bucket_count = DefaultMaxBucketCount);
+
+    /**
+     * @brief Adds a value to the sketch.
+     * @param[in] value Value to add.
+     * @param[in] weight Number of times that \p value occurs.
+     */
+    void add(double value, std::uint64_t weight = 1);
+    /**
+     * @brief Adds all the values from another sketch into this sketch.
+     * @param[in] other Sketch to merge into this one.
+     * @throws std::invalid_argument if \p other has a different relative accuracy.
+     */
+    void merge(const QuantileSketch &other);
+    void clear();
+
+    /**
+     * @brief Estimates the specified quantile.
+     * @param[in] quantile Quantile to estimate in the range `[0, 1]`.
+     * @return Estimation for the requested quantile, or `0` if sketch is empty.
+     * @details Quantile is estimated for the value at rank `quantile * (N - 1)`
+     * where `N` is the number of values added.
+     */
+    double getQuantile(double quantile) const;
+    /**
+     * @brief Estimates average and variance after trimming the specified fraction
+     * of the values from each side of the distribution.
+     * @param[out] ave Estimated trimmed average.
+     * @param[out] variance Estimated trimmed sample variance.
+     * @param[out] total Estimated sum of the values remaining after trimming.
+     * @param[in] trim_fraction Fraction of values to trim from each side in range `[0, 0.5)`.
+     * @return Number of values remaining after trimming.
+     */
+    std::uint64_t getTrimmedStats(double &ave, double &variance, double &total,
+                                  double trim_fraction) const;
+
+    std::uint64_t getCount() const { return m_count; }
+    double getMin() const { return m_min; }
+    double getMax() const { return m_max; }
+    double getRelativeAccuracy() const { return m_relative_accuracy; }
+    std::size_t getBucketCount() const { return m_buckets.size(); }
+
+private:
+    std::int64_t computeBucketIndex(double value) const;
+    double computeBucketValue(std::int64_t bucket_index) const;
+    double getValueAtRank(std::uint64_t rank) const;
+    void addToBucket(std::int64_t bucket_index, std::uint64_t weight);
+
+    double m_relative_accuracy;
+    double m_gamma; // bucket boundary growth factor
+    double m_log_gamma;
+    double m_min_trackable;
+    std::size_t m_max_bucket_count;
+    std::vector<std::uint64_t> m_buckets; // contiguous bucket counts
+    std::int64_t m_bucket_offset; // bucket index for m_buckets[0]
+    std::uint64_t m_zero_count; // number of values in the zero bucket
+    std::uint64_t m_count;
+    double m_min;
+    double m_max;
+};
+
+} // namespace ReportGen
+} // namespace hebench
+
+#endif // defined _HEBench_ReportQuantileSketch_H_0596d40a3cce4b108a81595c50eb286d
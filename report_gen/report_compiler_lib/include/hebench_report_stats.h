@@ -31,6 +31,8 @@ struct StatisticsResult
     double pct_10; // 10-th percentile
     double pct_90; // 90-th percentile
     double pct_99; // 99-th percentile
+    double pct_999; // 99.9-th percentile
+    double pct_9999; // 99.99-th percentile
     double ave_trim; // trimmed by 10% on each side
     double variance_trim;
     double samples_per_unit; // = total / input_sample_count
@@ -57,6 +59,8 @@ struct ReportEventTypeStats
     double cpu_time_10; // 10-th percentile
     double cpu_time_90; // 90-th percentile
     double cpu_time_99; // 99-th percentile
+    double cpu_time_999; // 99.9-th percentile
+    double cpu_time_9999; // 99.99-th percentile
     double cpu_time_ave_trim; // trimmed mean by 10% on each side
     double cpu_time_variance_trim;
     double wall_time_ave;
@@ -68,6 +72,8 @@ struct ReportEventTypeStats
     double wall_time_10; // 10-th percentile
     double wall_time_90; // 90-th percentile
     double wall_time_99; // 99-th percentile
+    double wall_time_999; // 99.9-th percentile
+    double wall_time_9999; // 99.99-th percentile
     double wall_time_ave_trim; // trimmed mean by 10% on each side
     double wall_time_variance_trim;
     double ops_per_sec;
@@ -88,7 +94,19 @@ struct ReportEventTypeStats
 class ReportStats
 {
 public:
-    ReportStats(const cpp::TimingReport &report);
+    /**
+     * @brief Computes the statistics for the events in a report.
+     * @param[in] report Report from which to compute statistics.
+     * @param[in] sketch_threshold If the number of events in \p report exceeds this
+     * value, percentiles and trimmed statistics are estimated using a QuantileSketch
+     * per event type instead of sorting all events. Use `0` to always compute exact
+     * statistics.
+     * @details Estimations from the sketch are within QuantileSketch::DefaultRelativeAccuracy
+     * of the exact values, and memory used is constant per event type regardless of
+     * the number of events in the report. Average, variance, minimum and maximum are
+     * always exact.
+     */
+    ReportStats(const cpp::TimingReport &report, std::uint64_t sketch_threshold = 0);
 
     const std::string &getHeader() const { return m_header; }
     const std::string &getFooter() const { return m_footer; }
@@ -99,6 +117,10 @@ public:
     std::uint64_t getMainEventTypeStatsIndex() const;
     std::uint32_t getMainEventTypeID() const { return m_main_event_type_id; }
     const ReportEventTypeStats &getMainEventTypeStats() const;
+    /**
+     * @brief Whether statistics were estimated using quantile sketches.
+     */
+    bool isSketched() const { return m_b_sketched; }
 
     /**
      * @brief Generates complete CSV stats for this report.
@@ -133,6 +155,7 @@ private:
     std::string m_header;
     std::string m_footer;
     std::size_t m_main_event_type_id;
+    bool m_b_sketched;
     std::unordered_map<std::uint32_t, std::size_t> m_event_types_2_stat_idx; // maps event type id to index of stats in m_event_stats
     std::vector<std::shared_ptr<ReportEventTypeStats>> m_event_stats;
 };
@@ -37,6 +37,7 @@ struct ReportCompilerConfig
     char time_unit_stats;
     char time_unit_overview;
     char time_unit_summary;
+    std::uint64_t sketch_threshold;
 
     void showConfig(std::ostream &os) const;
     static void showVersion(std::ostream &os);
@@ -78,6 +79,13 @@ std::vector<std::filesystem::path> extractInputFiles(const std::string &filename
 {
     std::vector<std::filesystem::path> retval;
 
+    // binary reports are never lists of files
+    if (TimingReport::isBinaryReportFile(filename))
+    {
+        retval.emplace_back(filename);
+        return retval;
+    } // end if
+
     // Open file and see if each line contains a valid, existing filename.
     // Throw exception if a file does not exist after the first one.
 
@@ -154,6 +162,7 @@ extern "C"
             config.time_unit_stats    = p_config->time_unit_stats;
             config.time_unit_overview = p_config->time_unit_overview;
             config.time_unit_summary  = p_config->time_unit_summary;
+            config.sketch_threshold   = p_config->sketch_threshold;
 
             if (!config.b_silent)
             {
@@ -211,7 +220,7 @@ extern "C"
 
                 try
                 {
-                    p_report = std::make_shared<TimingReport>(TimingReport::loadReportFromCSVFile(csv_filenames[csv_file_i]));
+                    p_report = std::make_shared<TimingReport>(TimingReport::loadReportFromFile(csv_filenames[csv_file_i]));
                 }
                 catch (...)
                 {
@@ -265,7 +274,11 @@ extern "C"
                             std::cout << "Computing statistics..." << std::endl;
                         } // end if
 
-                        hebench::ReportGen::ReportStats report_stats(report);
+                        hebench::ReportGen::ReportStats report_stats(report, config.sketch_threshold);
+                        if (!config.b_silent && report_stats.isSketched())
+                        {
+                            std::cout << "Report contains " << report.getEventCount() << " events: percentiles and trimmed statistics are estimated." << std::endl;
+                        } // end if
 
                         if (!config.b_silent)
                         {
@@ -369,6 +382,43 @@ extern "C"
 
         return retval;
     }
+
+    int32_t convertReport(const char *input_filename, const char *output_filename, char *s_error, size_t s_error_size)
+    {
+        static const std::string BinaryReportExtension = ".hebr";
+
+        int retval = 1;
+
+        std::stringstream ss_err;
+
+        try
+        {
+            if (!input_filename || !output_filename)
+                throw std::runtime_error("Invalid null file names.");
+
+            std::filesystem::path output_path = output_filename;
+            if (output_path.extension() == BinaryReportExtension)
+                TimingReport::loadReportFromFile(input_filename).save2Binary(output_path);
+            else
+                TimingReport::loadReportFromFile(input_filename).save2CSV(output_path);
+        }
+        catch (std::exception &ex)
+        {
+            ss_err << ex.what();
+            retval = 0;
+        }
+        catch (...)
+        {
+            ss_err << "Unexpected error occurred.";
+            retval = 0;
+        }
+
+        if (!retval)
+            // report error message
+            hebench::Utilities::copyString(s_error, s_error_size, ss_err.str());
+
+        return retval;
+    }
 }
 
 } // namespace Compiler
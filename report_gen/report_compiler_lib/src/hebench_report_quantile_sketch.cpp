@@ -0,0 +1,202 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "hebench_report_quantile_sketch.h"
+
+namespace hebench {
+namespace ReportGen {
+
+QuantileSketch::QuantileSketch(double relative_accuracy, std::size_t max_bucket_count)
+{
+    if (!(relative_accuracy > 0.0 && relative_accuracy < 1.0))
+    {
+        std::stringstream ss;
+        ss << "Invalid `relative_accuracy`. Expected value in range (0, 1), but " << relative_accuracy << " received.";
+        throw std::invalid_argument(ss.str());
+    } // end if
+    if (max_bucket_count <= 0)
+        throw std::invalid_argument("Invalid `max_bucket_count`. Value must be positive.");
+
+    m_relative_accuracy = relative_accuracy;
+    m_gamma             = (1.0 + relative_accuracy) / (1.0 - relative_accuracy);
+    m_log_gamma         = std::log(m_gamma);
+    m_min_trackable     = std::numeric_limits<double>::min();
+    m_max_bucket_count  = max_bucket_count;
+    clear();
+}
+
+void QuantileSketch::clear()
+{
+    m_buckets.clear();
+    m_bucket_offset = 0;
+    m_zero_count    = 0;
+    m_count         = 0;
+    m_min           = std::numeric_limits<double>::infinity();
+    m_max           = -std::numeric_limits<double>::infinity();
+}
+
+std::int64_t QuantileSketch::computeBucketIndex(double value) const
+{
+    // bucket i holds values in range (gamma^(i-1), gamma^i]
+    return static_cast<std::int64_t>(std::ceil(std::log(value) / m_log_gamma));
+}
+
+double QuantileSketch::computeBucketValue(std::int64_t bucket_index) const
+{
+    // value with the same relative distance to both bucket boundaries
+    return 2.0 * std::pow(m_gamma, static_cast<double>(bucket_index)) / (m_gamma + 1.0);
+}
+
+void QuantileSketch::addToBucket(std::int64_t bucket_index, std::uint64_t weight)
+{
+    if (m_buckets.empty())
+    {
+        m_bucket_offset = bucket_index;
+        m_buckets.assign(1, 0);
+    } // end if
+
+    std::int64_t low  = std::min(m_bucket_offset, bucket_index);
+    std::int64_t high = std::max(m_bucket_offset + static_cast<std::int64_t>(m_buckets.size()) - 1, bucket_index);
+    if (high - low + 1 > static_cast<std::int64_t>(m_max_bucket_count))
+        // collapse the lowest buckets to keep memory bounded
+        low = high - static_cast<std::int64_t>(m_max_bucket_count) + 1;
+
+    if (low != m_bucket_offset)
+    {
+        // re-index existing buckets into the new range
+        std::vector<std::uint64_t> buckets(high - low + 1, 0);
+        for (std::size_t i = 0; i < m_buckets.size(); ++i)
+        {
+            std::int64_t new_index = std::max(m_bucket_offset + static_cast<std::int64_t>(i), low);
+            buckets[new_index - low] += m_buckets[i];
+        } // end for
+        m_buckets.swap(buckets);
+        m_bucket_offset = low;
+    } // end if
+    else if (high - low + 1 > static_cast<std::int64_t>(m_buckets.size()))
+        m_buckets.resize(high - low + 1, 0);
+
+    m_buckets[std::max(bucket_index, low) - low] += weight;
+}
+
+void QuantileSketch::add(double value, std::uint64_t weight)
+{
+    if (weight <= 0)
+        return;
+
+    if (value < m_min_trackable)
+        m_zero_count += weight;
+    else
+        addToBucket(computeBucketIndex(value), weight);
+    m_count += weight;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+}
+
+void QuantileSketch::merge(const QuantileSketch &other)
+{
+    if (other.m_relative_accuracy != m_relative_accuracy)
+        throw std::invalid_argument("Cannot merge sketches with different relative accuracy.");
+
+    for (std::size_t i = 0; i < other.m_buckets.size(); ++i)
+        if (other.m_buckets[i] > 0)
+            addToBucket(other.m_bucket_offset + static_cast<std::int64_t>(i), other.m_buckets[i]);
+    m_zero_count += other.m_zero_count;
+    m_count += other.m_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+double QuantileSketch::getValueAtRank(std::uint64_t rank) const
+{
+    double retval;
+    if (rank < m_zero_count)
+        retval = 0.0;
+    else
+    {
+        std::uint64_t cumulative_count = m_zero_count;
+        std::size_t bucket_i           = 0;
+        while (bucket_i + 1 < m_buckets.size() && cumulative_count + m_buckets[bucket_i] <= rank)
+            cumulative_count += m_buckets[bucket_i++];
+        retval = computeBucketValue(m_bucket_offset + static_cast<std::int64_t>(bucket_i));
+    } // end else
+    // the exact extremes are known
+    return std::clamp(retval, m_min, m_max);
+}
+
+double QuantileSketch::getQuantile(double quantile) const
+{
+    if (m_count <= 0)
+        return 0.0;
+
+    quantile                = std::clamp(quantile, 0.0, 1.0);
+    double rank             = quantile * (m_count - 1);
+    std::uint64_t rank_low  = static_cast<std::uint64_t>(std::floor(rank));
+    std::uint64_t rank_high = static_cast<std::uint64_t>(std::ceil(rank));
+    double value_low        = getValueAtRank(rank_low);
+    double value_high       = rank_high == rank_low ? value_low : getValueAtRank(rank_high);
+    return value_low + (rank - rank_low) * (value_high - value_low);
+}
+
+std::uint64_t QuantileSketch::getTrimmedStats(double &ave, double &variance, double &total,
+                                              double trim_fraction) const
+{
+    ave      = 0.0;
+    variance = 0.0;
+    total    = 0.0;
+
+    std::uint64_t trim_start = static_cast<std::uint64_t>(m_count * std::clamp(trim_fraction, 0.0, 0.5));
+    std::uint64_t trim_end   = m_count - trim_start;
+    if (trim_end <= trim_start)
+        return 0;
+
+    // number of values from the specified ranks that fall in the non-trimmed ranks
+    auto compute_overlap = [trim_start, trim_end](std::uint64_t rank_begin, std::uint64_t rank_end) -> std::uint64_t {
+        rank_begin = std::max(rank_begin, trim_start);
+        rank_end   = std::min(rank_end, trim_end);
+        return rank_end > rank_begin ? rank_end - rank_begin : 0;
+    };
+
+    // first pass: average
+    std::uint64_t cumulative_count = m_zero_count;
+    for (std::size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        std::uint64_t count = compute_overlap(cumulative_count, cumulative_count + m_buckets[i]);
+        if (count > 0)
+            total += count * std::clamp(computeBucketValue(m_bucket_offset + static_cast<std::int64_t>(i)), m_min, m_max);
+        cumulative_count += m_buckets[i];
+    } // end for
+    std::uint64_t retval = trim_end - trim_start;
+    ave                  = total / retval;
+
+    // second pass: variance
+    if (retval > 1)
+    {
+        double zero_diff = std::clamp(0.0, m_min, m_max) - ave;
+        variance         = compute_overlap(0, m_zero_count) * zero_diff * zero_diff;
+        cumulative_count = m_zero_count;
+        for (std::size_t i = 0; i < m_buckets.size(); ++i)
+        {
+            std::uint64_t count = compute_overlap(cumulative_count, cumulative_count + m_buckets[i]);
+            if (count > 0)
+            {
+                double diff = std::clamp(computeBucketValue(m_bucket_offset + static_cast<std::int64_t>(i)), m_min, m_max) - ave;
+                variance += count * diff * diff;
+            } // end if
+            cumulative_count += m_buckets[i];
+        } // end for
+        variance /= (retval - 1);
+    } // end if
+
+    return retval;
+}
+
+} // namespace ReportGen
+} // namespace hebench
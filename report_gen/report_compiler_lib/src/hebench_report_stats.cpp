@@ -9,27 +9,161 @@
 #include <limits>
 #include <sstream>
 #include <unordered_set>
+#include <utility>
 
-#include "hebench/modules/general/include/hebench_math_utils.h"
 #include "hebench/modules/general/include/hebench_utilities.h"
+#include "hebench_report_quantile_sketch.h"
 #include "hebench_report_stats.h"
 
 namespace hebench {
 namespace ReportGen {
 
-void computeStats(StatisticsResult &result, const double *data, std::size_t count)
+/**
+ * @brief Retrieves the value at the specified rank of the expanded samples represented
+ * by sorted (value, weight) pairs.
+ * @param[in] sorted_data (value, weight) pairs sorted by value.
+ * @param[in] cumulative_weights Running sum of the weights in \p sorted_data.
+ * @param[in] rank Zero-based rank of the requested sample. Must be less than the total weight.
+ */
+double getValueAtRank(const std::vector<std::pair<double, std::uint64_t>> &sorted_data,
+                      const std::vector<std::uint64_t> &cumulative_weights,
+                      std::uint64_t rank)
+{
+    assert(!cumulative_weights.empty() && rank < cumulative_weights.back());
+    auto it = std::upper_bound(cumulative_weights.begin(), cumulative_weights.end(), rank);
+    return sorted_data[it - cumulative_weights.begin()].first;
+}
+
+/**
+ * @brief Computes the percentile of the expanded samples represented by sorted
+ * (value, weight) pairs, where each value is repeated as many times as its weight.
+ * @param[in] sorted_data (value, weight) pairs sorted by value.
+ * @param[in] cumulative_weights Running sum of the weights in \p sorted_data.
+ * @param[in] percentile Requested percentile in the range `[0, 1]`.
+ * @details Percentile is linearly interpolated between the closest ranks, where
+ * fractional rank is `percentile * (N - 1)` for a total weight of `N`.
+ */
+double computePercentile(const std::vector<std::pair<double, std::uint64_t>> &sorted_data,
+                         const std::vector<std::uint64_t> &cumulative_weights,
+                         double percentile)
+{
+    if (cumulative_weights.empty() || cumulative_weights.back() <= 0)
+        return 0.0;
+
+    double rank             = percentile * (cumulative_weights.back() - 1);
+    std::uint64_t rank_low  = static_cast<std::uint64_t>(std::floor(rank));
+    std::uint64_t rank_high = static_cast<std::uint64_t>(std::ceil(rank));
+    double value_low        = getValueAtRank(sorted_data, cumulative_weights, rank_low);
+    double value_high       = rank_high == rank_low ?
+                                  value_low :
+                                  getValueAtRank(sorted_data, cumulative_weights, rank_high);
+    return value_low + (rank - rank_low) * (value_high - value_low);
+}
+
+/**
+ * @brief Running statistics on weighted samples.
+ * @details Each new value is added with the number of samples it represents, so
+ * the cost of adding a value does not depend on its weight. Results are those of
+ * the expanded collection of samples where each value is repeated as many times as
+ * its weight, up to rounding.
+ */
+class WeightedEventStats
+{
+public:
+    WeightedEventStats() :
+        m_count(0), m_total(0.0), m_mean(0.0), m_m2(0.0), m_min(0.0), m_max(0.0)
+    {
+    }
+
+    /**
+     * @brief Adds a new value to the statistics.
+     * @param[in] value Value to add.
+     * @param[in] weight Number of samples represented by \p value .
+     */
+    void newEvent(double value, std::uint64_t weight = 1)
+    {
+        if (weight > 0)
+        {
+            if (m_count == 0)
+            {
+                m_min = value;
+                m_max = value;
+            } // end if
+            else
+            {
+                m_min = std::min(m_min, value);
+                m_max = std::max(m_max, value);
+            } // end else
+            // weighted incremental update of mean and sum of squared differences (West, 1979)
+            m_count += weight;
+            m_total += value * weight;
+            double delta = value - m_mean;
+            m_mean += delta * weight / m_count;
+            m_m2 += delta * weight * (value - m_mean);
+        } // end if
+    }
+
+    /**
+     * @brief Number of samples added (sum of the weights).
+     */
+    std::uint64_t getCount() const { return m_count; }
+    double getTotal() const { return m_total; }
+    double getMean() const { return m_mean; }
+    /**
+     * @brief Sample variance.
+     */
+    double getVariance() const { return m_count > 1 ? m_m2 / (m_count - 1) : 0.0; }
+    double getMin() const { return m_min; }
+    double getMax() const { return m_max; }
+
+private:
+    std::uint64_t m_count;
+    double m_total;
+    double m_mean;
+    double m_m2;
+    double m_min;
+    double m_max;
+};
+
+/**
+ * @brief Computes statistics on weighted data.
+ * @param[out] result Statistics computed.
+ * @param[in] data Values, in order of occurrence.
+ * @param[in] weights Number of samples represented by each value in \p data.
+ * If null, every value represents a single sample.
+ * @param[in] count Number of elements in \p data and \p weights.
+ * @details Results are the same as for the expanded collection of samples where each
+ * value is repeated as many times as its weight, but time and memory used scale
+ * with the number of values instead of the number of samples.
+ */
+void computeStats(StatisticsResult &result, const double *data, const std::uint64_t *weights, std::size_t count)
 {
-    std::vector<double> sorted_data(data, data + count);
+    // sort (value, weight) pairs instead of the expanded samples
+    std::vector<std::pair<double, std::uint64_t>> sorted_data(count);
+    for (std::size_t i = 0; i < count; ++i)
+        sorted_data[i] = std::make_pair(data[i], weights ? weights[i] : 1);
     std::sort(sorted_data.begin(), sorted_data.end());
-    std::size_t trim_start = sorted_data.size() / 10;
-    //std::size_t trim_count = sorted_data.size() - 2 * trim_start;
+    std::vector<std::uint64_t> cumulative_weights(count);
+    std::uint64_t total_weight = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        total_weight += sorted_data[i].second;
+        cumulative_weights[i] = total_weight;
+    } // end for
+    std::uint64_t trim_start = total_weight / 10;
+    std::uint64_t trim_end   = total_weight - trim_start;
 
-    hebench::Utilities::Math::EventStats basic_stats;
+    WeightedEventStats basic_stats;
+    WeightedEventStats trimmed_stats;
     for (std::size_t i = 0; i < count; ++i)
-        basic_stats.newEvent(data[i]);
-    hebench::Utilities::Math::EventStats trimmed_stats;
-    for (std::size_t i = trim_start; i < sorted_data.size() - trim_start; ++i)
-        trimmed_stats.newEvent(sorted_data[i]);
+    {
+        basic_stats.newEvent(sorted_data[i].first, sorted_data[i].second);
+        // overlap between the ranks of this value and the non-trimmed ranks
+        std::uint64_t rank_begin = std::max(cumulative_weights[i] - sorted_data[i].second, trim_start);
+        std::uint64_t rank_end   = std::min(cumulative_weights[i], trim_end);
+        if (rank_end > rank_begin)
+            trimmed_stats.newEvent(sorted_data[i].first, rank_end - rank_begin);
+    } // end for
 
     std::memset(&result, 0, sizeof(StatisticsResult));
     result.total    = basic_stats.getTotal();
@@ -38,11 +172,13 @@ void computeStats(StatisticsResult &result, const double *data, std::size_t coun
     result.min      = basic_stats.getMin();
     result.max      = basic_stats.getMax();
 
-    result.median = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.5);
-    result.pct_1  = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.01); // 1-th percentile
-    result.pct_10 = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.1); // 10-th percentile
-    result.pct_90 = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.9); // 90-th percentile
-    result.pct_99 = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.95); // 99-th percentile
+    result.median   = computePercentile(sorted_data, cumulative_weights, 0.5);
+    result.pct_1    = computePercentile(sorted_data, cumulative_weights, 0.01); // 1-th percentile
+    result.pct_10   = computePercentile(sorted_data, cumulative_weights, 0.1); // 10-th percentile
+    result.pct_90   = computePercentile(sorted_data, cumulative_weights, 0.9); // 90-th percentile
+    result.pct_99   = computePercentile(sorted_data, cumulative_weights, 0.95); // 99-th percentile
+    result.pct_999  = computePercentile(sorted_data, cumulative_weights, 0.999); // 99.9-th percentile
+    result.pct_9999 = computePercentile(sorted_data, cumulative_weights, 0.9999); // 99.99-th percentile
 
     result.ave_trim              = trimmed_stats.getMean(); // trimmed by 10% on each side
     result.variance_trim         = trimmed_stats.getVariance();
@@ -51,6 +187,83 @@ void computeStats(StatisticsResult &result, const double *data, std::size_t coun
     result.input_sample_count    = basic_stats.getCount();
 }
 
+/**
+ * @brief Computes statistics from incrementally accumulated data.
+ * @param[out] result Statistics computed.
+ * @param[in] basic_stats Moments accumulated over all the samples.
+ * @param[in] sketch Quantile sketch fed with all the samples.
+ * @details Total, average, variance, minimum and maximum are exact. Percentiles and
+ * trimmed statistics are estimated from the sketch.
+ */
+void computeStats(StatisticsResult &result,
+                  const WeightedEventStats &basic_stats,
+                  const QuantileSketch &sketch)
+{
+    double total_trim;
+    std::memset(&result, 0, sizeof(StatisticsResult));
+    result.total    = basic_stats.getTotal();
+    result.ave      = basic_stats.getMean();
+    result.variance = basic_stats.getVariance();
+    result.min      = basic_stats.getMin();
+    result.max      = basic_stats.getMax();
+
+    result.median   = sketch.getQuantile(0.5);
+    result.pct_1    = sketch.getQuantile(0.01); // 1-th percentile
+    result.pct_10   = sketch.getQuantile(0.1); // 10-th percentile
+    result.pct_90   = sketch.getQuantile(0.9); // 90-th percentile
+    result.pct_99   = sketch.getQuantile(0.95); // 99-th percentile
+    result.pct_999  = sketch.getQuantile(0.999); // 99.9-th percentile
+    result.pct_9999 = sketch.getQuantile(0.9999); // 99.99-th percentile
+
+    std::uint64_t count_trim     = sketch.getTrimmedStats(result.ave_trim, result.variance_trim, total_trim, 0.1); // trimmed by 10% on each side
+    result.samples_per_unit      = (basic_stats.getTotal() == 0.0 ? 0.0 : basic_stats.getCount() / basic_stats.getTotal()); // = total / iterations
+    result.samples_per_unit_trim = (total_trim == 0.0 ? 0.0 : count_trim / total_trim); // = total_trim / iterations_trim
+    result.input_sample_count    = basic_stats.getCount();
+}
+
+/**
+ * @brief Fills out the stats for an event type from the statistics of its timings.
+ * @param[out] result Event type stats to fill out.
+ * @param[in] cpu_stats Statistics for the CPU timings of the event type.
+ * @param[in] wall_stats Statistics for the wall timings of the event type.
+ */
+void fillEventTypeStats(ReportEventTypeStats &result,
+                        const StatisticsResult &cpu_stats,
+                        const StatisticsResult &wall_stats)
+{
+    result.cpu_time_ave           = cpu_stats.ave;
+    result.cpu_time_variance      = cpu_stats.variance;
+    result.cpu_time_min           = cpu_stats.min;
+    result.cpu_time_max           = cpu_stats.max;
+    result.cpu_time_median        = cpu_stats.median;
+    result.cpu_time_1             = cpu_stats.pct_1;
+    result.cpu_time_10            = cpu_stats.pct_10;
+    result.cpu_time_90            = cpu_stats.pct_90;
+    result.cpu_time_99            = cpu_stats.pct_99;
+    result.cpu_time_999           = cpu_stats.pct_999;
+    result.cpu_time_9999          = cpu_stats.pct_9999;
+    result.cpu_time_ave_trim      = cpu_stats.ave_trim;
+    result.cpu_time_variance_trim = cpu_stats.variance_trim;
+
+    result.wall_time_ave           = wall_stats.ave;
+    result.wall_time_variance      = wall_stats.variance;
+    result.wall_time_min           = wall_stats.min;
+    result.wall_time_max           = wall_stats.max;
+    result.wall_time_median        = wall_stats.median;
+    result.wall_time_1             = wall_stats.pct_1;
+    result.wall_time_10            = wall_stats.pct_10;
+    result.wall_time_90            = wall_stats.pct_90;
+    result.wall_time_99            = wall_stats.pct_99;
+    result.wall_time_999           = wall_stats.pct_999;
+    result.wall_time_9999          = wall_stats.pct_9999;
+    result.wall_time_ave_trim      = wall_stats.ave_trim;
+    result.wall_time_variance_trim = wall_stats.variance_trim;
+    result.ops_per_sec             = wall_stats.samples_per_unit;
+    result.ops_per_sec_trim        = wall_stats.samples_per_unit_trim;
+    result.total_time              = wall_stats.total;
+    result.input_sample_count      = wall_stats.input_sample_count;
+}
+
 /**
  * @brief Extracts and maintains the timing report events of the same type.
  * @details Maintains a collection of timing report events of the same type
@@ -67,6 +280,7 @@ public:
      */
     EventType(const cpp::TimingReport &report, std::uint32_t event_id);
     EventType(const std::vector<double> &cpu_events, const std::vector<double> &wall_events,
+              const std::vector<std::uint64_t> &weights,
               std::uint32_t event_id, const std::string_view &event_name);
 
     /**
@@ -85,6 +299,12 @@ public:
      * @brief Collection of contained wall-timed events of the same type extracted from the report.
      */
     const std::vector<double> &getWallEvents() const { return m_wall_events; }
+    /**
+     * @brief Number of input samples represented by each contained event.
+     * @details Each CPU and wall event value is the time per input sample of the
+     * event in the report and it is weighted by the corresponding entry here.
+     */
+    const std::vector<std::uint64_t> &getWeights() const { return m_weights; }
 
     /**
      * @brief Computes statistics for this event type based on the contained events.
@@ -111,6 +331,7 @@ private:
     std::string m_name;
     std::vector<double> m_cpu_events;
     std::vector<double> m_wall_events;
+    std::vector<std::uint64_t> m_weights;
 };
 
 EventType::EventType(const cpp::TimingReport &report, std::uint32_t event_id)
@@ -137,8 +358,9 @@ EventType::EventType(const cpp::TimingReport &report, std::uint32_t event_id)
                     {
                         try
                         {
-                            m_wall_events.insert(m_wall_events.end(), event.input_sample_count, wall_time);
-                            m_cpu_events.insert(m_cpu_events.end(), event.input_sample_count, cpu_time);
+                            m_wall_events.push_back(wall_time);
+                            m_cpu_events.push_back(cpu_time);
+                            m_weights.push_back(event.input_sample_count);
                         }
                         catch (...)
                         {
@@ -159,57 +381,109 @@ EventType::EventType(const cpp::TimingReport &report, std::uint32_t event_id)
 }
 
 EventType::EventType(const std::vector<double> &cpu_events, const std::vector<double> &wall_events,
+                     const std::vector<std::uint64_t> &weights,
                      std::uint32_t event_id, const std::string_view &event_name)
 {
     if (cpu_events.size() != wall_events.size())
         throw std::invalid_argument("Number of CPU events and Wall events cannot differ.");
+    if (weights.size() != wall_events.size())
+        throw std::invalid_argument("Number of weights and events cannot differ.");
 
     m_id          = event_id;
     m_name        = std::string(event_name.begin(), event_name.end());
     m_cpu_events  = cpu_events;
     m_wall_events = wall_events;
+    m_weights     = weights;
 }
 
 void EventType::computeStats(ReportEventTypeStats &result) const
 {
-    StatisticsResult stats;
-
-    hebench::ReportGen::computeStats(stats, this->getCPUEvents().data(), this->getCPUEvents().size());
-    result.cpu_time_ave           = stats.ave;
-    result.cpu_time_variance      = stats.variance;
-    result.cpu_time_min           = stats.min;
-    result.cpu_time_max           = stats.max;
-    result.cpu_time_median        = stats.median;
-    result.cpu_time_1             = stats.pct_1;
-    result.cpu_time_10            = stats.pct_10;
-    result.cpu_time_90            = stats.pct_90;
-    result.cpu_time_99            = stats.pct_99;
-    result.cpu_time_ave_trim      = stats.ave_trim;
-    result.cpu_time_variance_trim = stats.variance_trim;
-
-    hebench::ReportGen::computeStats(stats, this->getWallEvents().data(), this->getWallEvents().size());
-    result.wall_time_ave           = stats.ave;
-    result.wall_time_variance      = stats.variance;
-    result.wall_time_min           = stats.min;
-    result.wall_time_max           = stats.max;
-    result.wall_time_median        = stats.median;
-    result.wall_time_1             = stats.pct_1;
-    result.wall_time_10            = stats.pct_10;
-    result.wall_time_90            = stats.pct_90;
-    result.wall_time_99            = stats.pct_99;
-    result.wall_time_ave_trim      = stats.ave_trim;
-    result.wall_time_variance_trim = stats.variance_trim;
-    result.ops_per_sec             = stats.samples_per_unit;
-    result.ops_per_sec_trim        = stats.samples_per_unit_trim;
-    result.total_time              = stats.total;
-    result.input_sample_count      = stats.input_sample_count;
+    StatisticsResult cpu_stats;
+    StatisticsResult wall_stats;
+
+    hebench::ReportGen::computeStats(cpu_stats, this->getCPUEvents().data(), this->getWeights().data(), this->getCPUEvents().size());
+    hebench::ReportGen::computeStats(wall_stats, this->getWallEvents().data(), this->getWeights().data(), this->getWallEvents().size());
+    fillEventTypeStats(result, cpu_stats, wall_stats);
+
+    result.event_id    = this->getID();
+    result.name        = this->getName();
+    result.description = std::string();
+}
+
+/**
+ * @brief Accumulates the timings of events of the same type incrementally.
+ * @details Events are not stored. Instead, exact moments and a quantile sketch
+ * are maintained for the CPU and wall timings, thus, memory used is constant
+ * regardless of the number of events added.
+ */
+class EventTypeSketch
+{
+public:
+    EventTypeSketch(std::uint32_t event_id, const std::string_view &event_name);
+
+    /**
+     * @brief ID of the event type.
+     */
+    std::uint32_t getID() const { return m_id; }
+    /**
+     * @brief Name of the event type as per the report.
+     */
+    const std::string &getName() const { return m_name; }
+
+    /**
+     * @brief Adds the timings for a new event of this type.
+     * @param[in] cpu_time CPU time per input sample of the event.
+     * @param[in] wall_time Wall time per input sample of the event.
+     * @param[in] weight Number of input samples in the event.
+     */
+    void newEvent(double cpu_time, double wall_time, std::uint64_t weight);
+
+    /**
+     * @brief Computes statistics for this event type based on the added events.
+     * @param[out] result ReportEventTypeStats to receive the statistical computation
+     * results.
+     * @details All timings for the stats are in seconds.
+     */
+    void computeStats(ReportEventTypeStats &result) const;
+
+private:
+    std::uint32_t m_id;
+    std::string m_name;
+    WeightedEventStats m_cpu_stats;
+    WeightedEventStats m_wall_stats;
+    QuantileSketch m_cpu_sketch;
+    QuantileSketch m_wall_sketch;
+};
+
+EventTypeSketch::EventTypeSketch(std::uint32_t event_id, const std::string_view &event_name)
+{
+    m_id   = event_id;
+    m_name = std::string(event_name.begin(), event_name.end());
+}
+
+void EventTypeSketch::newEvent(double cpu_time, double wall_time, std::uint64_t weight)
+{
+    m_cpu_stats.newEvent(cpu_time, weight);
+    m_wall_stats.newEvent(wall_time, weight);
+    m_cpu_sketch.add(cpu_time, weight);
+    m_wall_sketch.add(wall_time, weight);
+}
+
+void EventTypeSketch::computeStats(ReportEventTypeStats &result) const
+{
+    StatisticsResult cpu_stats;
+    StatisticsResult wall_stats;
+
+    hebench::ReportGen::computeStats(cpu_stats, m_cpu_stats, m_cpu_sketch);
+    hebench::ReportGen::computeStats(wall_stats, m_wall_stats, m_wall_sketch);
+    fillEventTypeStats(result, cpu_stats, wall_stats);
 
     result.event_id    = this->getID();
     result.name        = this->getName();
     result.description = std::string();
 }
 
-ReportStats::ReportStats(const cpp::TimingReport &report)
+ReportStats::ReportStats(const cpp::TimingReport &report, std::uint64_t sketch_threshold)
 {
     if (report.getEventCount() <= 0)
         throw std::invalid_argument("Report belongs to a failed benchmark.");
@@ -217,14 +491,52 @@ ReportStats::ReportStats(const cpp::TimingReport &report)
     m_header             = report.getHeader();
     m_footer             = report.getFooter();
     m_main_event_type_id = report.getMainEventType();
+    m_b_sketched         = sketch_threshold > 0 && report.getEventCount() > sketch_threshold;
     m_event_stats.reserve(report.getEventTypeCount());
 
+    if (m_b_sketched)
+    {
+        // feed the timings into a sketch per event type (use a single pass over the report)
+        std::unordered_map<std::uint32_t, std::unique_ptr<EventTypeSketch>> event_sketches;
+        std::vector<std::uint32_t> event_ids;
+        event_ids.reserve(report.getEventTypeCount());
+        for (std::uint64_t event_i = 0; event_i < report.getEventCount(); ++event_i)
+        {
+            hebench::ReportGen::TimingReportEventC event;
+            report.getEvent(event, event_i);
+            std::unique_ptr<EventTypeSketch> &p_sketch = event_sketches[event.event_type_id];
+            if (!p_sketch)
+            {
+                p_sketch = std::make_unique<EventTypeSketch>(event.event_type_id, report.getEventTypeHeader(event.event_type_id));
+                event_ids.push_back(event.event_type_id);
+            } // end if
+            p_sketch->newEvent(cpp::TimingReport::computeElapsedCPUTime(event) / event.input_sample_count,
+                               cpp::TimingReport::computeElapsedWallTime(event) / event.input_sample_count,
+                               event.input_sample_count);
+        } // end for
+
+        // sort by event ID
+        std::sort(event_ids.begin(), event_ids.end());
+
+        for (std::size_t event_id_i = 0; event_id_i < event_ids.size(); ++event_id_i)
+        {
+            std::uint32_t event_id                        = event_ids[event_id_i];
+            m_event_types_2_stat_idx[event_id]            = event_id_i;
+            std::shared_ptr<ReportEventTypeStats> p_stats = std::make_shared<ReportEventTypeStats>();
+            event_sketches[event_id]->computeStats(*p_stats);
+            m_event_stats.push_back(p_stats);
+        } // end for
+
+        return;
+    } // end if
+
     std::vector<std::uint32_t> event_ids; // used to keep track of all event ids
     event_ids.reserve(report.getEventTypeCount());
 
     // map event ID to the event timings
     std::unordered_map<std::uint32_t, std::vector<double>> cpu_events;
     std::unordered_map<std::uint32_t, std::vector<double>> wall_events;
+    std::unordered_map<std::uint32_t, std::vector<std::uint64_t>> event_weights; // input samples per event
 
     // retrieve the timings and group by event (use a single pass over the report)
     bool b_added;
@@ -247,11 +559,10 @@ ReportStats::ReportStats(const cpp::TimingReport &report)
         } // end if
         if (b_added)
             event_ids.push_back(event.event_type_id);
-        for (std::uint64_t i = 0; i < event.input_sample_count; ++i)
-        {
-            cpu_events[event.event_type_id].push_back(cpu_time);
-            wall_events[event.event_type_id].push_back(wall_time);
-        } // end for
+        // keep a single weighted value per event instead of replicating it per input sample
+        cpu_events[event.event_type_id].push_back(cpu_time);
+        wall_events[event.event_type_id].push_back(wall_time);
+        event_weights[event.event_type_id].push_back(event.input_sample_count);
     } // end for
 
     // sort by event ID
@@ -261,7 +572,8 @@ ReportStats::ReportStats(const cpp::TimingReport &report)
     for (std::size_t event_id_i = 0; event_id_i < event_ids.size(); ++event_id_i)
     {
         std::uint32_t event_id = event_ids[event_id_i];
-        EventType event_type(cpu_events[event_id], wall_events[event_id], event_id, report.getEventTypeHeader(event_id));
+        EventType event_type(cpu_events[event_id], wall_events[event_id], event_weights[event_id],
+                             event_id, report.getEventTypeHeader(event_id));
         m_event_types_2_stat_idx[event_type.getID()]  = event_id_i; // record the event type ID and match it to the index of the stats
         std::shared_ptr<ReportEventTypeStats> p_stats = std::make_shared<ReportEventTypeStats>();
         event_type.computeStats(*p_stats);
@@ -309,17 +621,34 @@ void ReportStats::generateCSV(std::ostream &os, char ch_prefix)
        << std::endl
        << "Main event," << this->getMainEventTypeStats().event_id << "," << this->getMainEventTypeStats().name << std::endl
        << std::endl
-       << ",,,,,Wall Time,,,,,,,,,,,,,CPU Time" << std::endl
+       << ",,,,,Wall Time,,,,,,,,,,,,,CPU Time,,,,,,,,,,,,,,Wall Time,,CPU Time" << std::endl
        << "ID,Event,Total Wall Time,Samples per sec,Samples per sec trimmed,"
        // wall
        << "Average,Standard Deviation,Time Unit,Time Factor,Min,Max,Median,Trimmed Average,Trimmed Standard Deviation,1-th percentile,10-th percentile,90-th percentile,99-th percentile,"
        // cpu
-       << "Average,Standard Deviation,Time Unit,Time Factor,Min,Max,Median,Trimmed Average,Trimmed Standard Deviation,1-th percentile,10-th percentile,90-th percentile,99-th percentile,Input Samples" << std::endl;
+       << "Average,Standard Deviation,Time Unit,Time Factor,Min,Max,Median,Trimmed Average,Trimmed Standard Deviation,1-th percentile,10-th percentile,90-th percentile,99-th percentile,Input Samples,"
+       // tail percentiles
+       << "99.9-th percentile,99.99-th percentile,99.9-th percentile,99.99-th percentile" << std::endl;
     if (!os)
         throw std::ios_base::failure("Error writing statistics report header to stream.");
     for (std::uint64_t event_stats_i = 0; event_stats_i < m_event_stats.size(); ++event_stats_i)
         if (m_event_stats[event_stats_i])
-            generateCSV(os, *m_event_stats[event_stats_i], ch_prefix);
+        {
+            const ReportEventTypeStats &stats = *m_event_stats[event_stats_i];
+            generateCSV(os, stats, ch_prefix, false);
+            // append tail percentiles using the same time units as the rest of the row
+            hebench::ReportGen::TimingPrefixedSeconds prefix_wall;
+            hebench::ReportGen::TimingPrefixedSeconds prefix_cpu;
+            hebench::ReportGen::cpp::TimingPrefixUtility::setTimingPrefix(prefix_wall, stats.wall_time_ave, ch_prefix);
+            hebench::ReportGen::cpp::TimingPrefixUtility::setTimingPrefix(prefix_cpu, stats.cpu_time_ave, ch_prefix);
+            os << "," << hebench::Utilities::convertDoubleToStr(stats.wall_time_999 * prefix_wall.time_interval_ratio_den)
+               << "," << hebench::Utilities::convertDoubleToStr(stats.wall_time_9999 * prefix_wall.time_interval_ratio_den)
+               << "," << hebench::Utilities::convertDoubleToStr(stats.cpu_time_999 * prefix_cpu.time_interval_ratio_den)
+               << "," << hebench::Utilities::convertDoubleToStr(stats.cpu_time_9999 * prefix_cpu.time_interval_ratio_den)
+               << std::endl;
+            if (!os)
+                throw std::ios_base::failure("Error writing statistics row to stream.");
+        } // end if
 }
 
 void ReportStats::generateCSV(std::ostream &os, const ReportEventTypeStats &stats, char ch_prefix, bool new_line)
@@ -302,6 +302,45 @@ TimingReport TimingReport::loadReportFromCSVFile(const std::string &filename)
     return retval;
 }
 
+void TimingReport::save2Binary(const std::string &filename)
+{
+    if (!hebench::ReportGen::save2Binary(m_lib_handle, filename.c_str()))
+        throw std::runtime_error(INTERNAL_LOG_MSG("Error saving report to binary file."));
+}
+
+TimingReport TimingReport::loadReportFromBinaryFile(const std::string &filename)
+{
+    TimingReport retval;
+
+    char error_description[MAX_DESCRIPTION_BUFFER_SIZE];
+    retval.m_lib_handle = hebench::ReportGen::loadReportFromBinaryFile(filename.c_str(), error_description);
+    if (!retval.m_lib_handle)
+        throw std::runtime_error(INTERNAL_LOG_MSG(error_description));
+
+    return retval;
+}
+
+TimingReport TimingReport::loadReportFromFile(const std::string &filename)
+{
+    return isBinaryReportFile(filename) ? loadReportFromBinaryFile(filename) : loadReportFromCSVFile(filename);
+}
+
+bool TimingReport::isBinaryReportFile(const std::string &filename)
+{
+    return hebench::ReportGen::isBinaryReportFile(filename.c_str()) > 0;
+}
+
+void TimingReport::convertCSV2Binary(const std::string &csv_filename, const std::string &binary_filename)
+{
+    loadReportFromCSVFile(csv_filename).save2Binary(binary_filename);
+}
+
+void TimingReport::convertBinary2CSV(const std::string &binary_filename, const std::string &csv_filename)
+{
+    // events are streamed from the mapped binary file into the CSV file
+    loadReportFromBinaryFile(binary_filename).save2CSV(csv_filename);
+}
+
 } // namespace cpp
 } // namespace ReportGen
 } // namespace hebench
@@ -0,0 +1,160 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_TimingReportBinary_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_TimingReportBinary_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "hebench_report_types.h"
+
+namespace hebench {
+namespace ReportGen {
+
+/**
+ * @brief Binary timing report file layout.
+ * @details All values are stored little-endian. Offsets are absolute from the
+ * start of the file. A binary report file is organized as:
+ *
+ * @code
+ * BinaryReportFileHeader
+ * text block (report header, report footer, event type headers, event descriptions)
+ * BinaryReportEventType[event_type_count]  (aligned to 8 bytes)
+ * BinaryReportString[description_count]    (aligned to 8 bytes)
+ * BinaryReportEvent[event_count]           (aligned to 64 bytes)
+ * @endcode
+ *
+ * Events have fixed width, so, the event array can be accessed directly from a memory
+ * mapped file without any parsing. Strings in the text block are not null-terminated.
+ * Description at index 0 is always the empty description.
+ */
+namespace BinaryReportFormat {
+
+static constexpr char Magic[8]                = { 'H', 'E', 'B', 'R', 'E', 'P', 'R', 'T' };
+static constexpr std::uint32_t ByteOrderMark  = 0x01020304;
+static constexpr std::uint16_t VersionMajor   = 1;
+static constexpr std::uint16_t VersionMinor   = 0;
+static constexpr std::uint64_t EventAlignment = 64;
+static constexpr const char *DefaultExtension = ".hebr";
+
+struct BinaryReportString
+{
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+struct BinaryReportFileHeader
+{
+    char magic[8];
+    std::uint32_t byte_order_mark;
+    std::uint16_t version_major;
+    std::uint16_t version_minor;
+    std::uint64_t file_size;
+    std::uint32_t main_event_type_id;
+    std::uint32_t event_type_count;
+    std::uint64_t description_count;
+    std::uint64_t event_count;
+    BinaryReportString header;
+    BinaryReportString footer;
+    std::uint64_t event_types_offset;
+    std::uint64_t descriptions_offset;
+    std::uint64_t events_offset;
+    std::uint64_t reserved[3];
+};
+
+struct BinaryReportEventType
+{
+    std::uint32_t event_type_id;
+    std::uint32_t reserved;
+    BinaryReportString header;
+};
+
+struct BinaryReportEvent
+{
+    std::uint32_t event_type_id;
+    std::uint32_t description_id; // index into description table
+    std::int64_t time_interval_ratio_num;
+    std::int64_t time_interval_ratio_den;
+    double wall_time_start;
+    double wall_time_end;
+    double cpu_time_start;
+    double cpu_time_end;
+    std::uint64_t input_sample_count;
+};
+
+static_assert(sizeof(BinaryReportString) == 16, "Unexpected padding in binary report string.");
+static_assert(sizeof(BinaryReportFileHeader) == 128, "Unexpected padding in binary report file header.");
+static_assert(sizeof(BinaryReportEventType) == 24, "Unexpected padding in binary report event type.");
+static_assert(sizeof(BinaryReportEvent) == 64, "Unexpected padding in binary report event.");
+
+/**
+ * @brief Determines whether the host stores values in little-endian order.
+ */
+bool isHostLittleEndian();
+/**
+ * @brief Determines whether the specified file starts with the binary report signature.
+ * @return `true` if file is a binary report, `false` otherwise (including when the file
+ * cannot be opened).
+ */
+bool isBinaryReportFile(const std::string &filename);
+
+} // namespace BinaryReportFormat
+
+/**
+ * @brief Read-only view of a memory mapped binary report file.
+ * @details The file is validated on construction: the header, the string references
+ * and the table bounds are checked. Events are accessed directly from the mapped
+ * memory.
+ */
+class MappedBinaryReport
+{
+public:
+    MappedBinaryReport(const MappedBinaryReport &)            = delete;
+    MappedBinaryReport &operator=(const MappedBinaryReport &) = delete;
+
+public:
+    /**
+     * @brief Maps the specified binary report file into memory.
+     * @param[in] filename Name of binary report file to map.
+     * @throws std::ios_base::failure if the file cannot be mapped.
+     * @throws std::runtime_error if the file is not a valid binary report.
+     */
+    MappedBinaryReport(const std::string &filename);
+    ~MappedBinaryReport();
+
+    const BinaryReportFormat::BinaryReportFileHeader &getFileHeader() const { return *m_p_file_header; }
+    std::string_view getHeader() const { return getString(m_p_file_header->header); }
+    std::string_view getFooter() const { return getString(m_p_file_header->footer); }
+
+    std::uint64_t getEventTypeCount() const { return m_p_file_header->event_type_count; }
+    const BinaryReportFormat::BinaryReportEventType &getEventType(std::uint64_t index) const { return m_p_event_types[index]; }
+    std::string_view getEventTypeHeader(std::uint64_t index) const { return getString(m_p_event_types[index].header); }
+
+    std::uint64_t getEventCount() const { return m_p_file_header->event_count; }
+    const BinaryReportFormat::BinaryReportEvent *getEvents() const { return m_p_events; }
+    /**
+     * @brief Retrieves a copy of the event at the specified index.
+     * @param[out] out_event Event where to store the copy.
+     * @param[in] index Index of the event to retrieve. Must be less than `getEventCount()`.
+     */
+    void getEvent(TimingReportEventC &out_event, std::uint64_t index) const;
+    std::string_view getDescription(std::uint64_t description_id) const;
+
+private:
+    std::string_view getString(const BinaryReportFormat::BinaryReportString &s) const;
+
+    void *m_p_mapped;
+    std::uint64_t m_mapped_size;
+    const BinaryReportFormat::BinaryReportFileHeader *m_p_file_header;
+    const BinaryReportFormat::BinaryReportEventType *m_p_event_types;
+    const BinaryReportFormat::BinaryReportString *m_p_descriptions;
+    const BinaryReportFormat::BinaryReportEvent *m_p_events;
+};
+
+} // namespace ReportGen
+} // namespace hebench
+
+#endif // defined _HEBench_TimingReportBinary_H_0596d40a3cce4b108a81595c50eb286d
@@ -5,19 +5,98 @@
 #ifndef _HEBench_TimingReport_H_0596d40a3cce4b108a81595c50eb286d
 #define _HEBench_TimingReport_H_0596d40a3cce4b108a81595c50eb286d
 
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <deque>
 #include <iostream>
 #include <memory>
 #include <ratio>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "hebench_report.h"
+#include "hebench_report_binary.h"
 
 namespace hebench {
 namespace ReportGen {
 
+/**
+ * @brief Compact storage for timing events.
+ * @details Events are stored as a structure of arrays, allocated in fixed-size chunks
+ * of events. Event descriptions and time interval ratios, which are commonly shared
+ * by many events, are interned in lookup tables, and each event only stores the index
+ * into these tables.
+ *
+ * Once capacity has been reserved, adding events performs no memory allocations,
+ * unless the event carries a description that has not been seen before.
+ */
+class TimingEventStore
+{
+public:
+    static constexpr std::size_t ChunkSize = 1024; // number of events per chunk
+
+    TimingEventStore();
+    TimingEventStore(const TimingEventStore &)            = delete;
+    TimingEventStore(TimingEventStore &&)                 = default;
+    TimingEventStore &operator=(const TimingEventStore &) = delete;
+    TimingEventStore &operator=(TimingEventStore &&)      = default;
+
+    void push(const TimingReportEventC &event);
+    /**
+     * @brief Retrieves a copy of the event at the specified index.
+     * @param[out] out_event Event where to store the copy.
+     * @param[in] index Index of the event to retrieve.
+     * @details \p index must be less than `size()`.
+     */
+    void get(TimingReportEventC &out_event, std::size_t index) const;
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_chunks.size() * ChunkSize; }
+    bool empty() const { return m_size <= 0; }
+    void reserve(std::size_t new_capacity);
+    /**
+     * @brief Removes all events.
+     * @details Allocated capacity is not released.
+     */
+    void clear() { m_size = 0; }
+
+    std::uint32_t getEventTypeID(std::size_t index) const { return chunk(index).event_type_id[index % ChunkSize]; }
+    const std::string &getDescription(std::size_t index) const { return m_descriptions[chunk(index).description_id[index % ChunkSize]]; }
+    const std::pair<std::int64_t, std::int64_t> &getTimeRatio(std::size_t index) const { return m_time_ratios[chunk(index).time_ratio_id[index % ChunkSize]]; }
+    double getWallTimeStart(std::size_t index) const { return chunk(index).wall_time_start[index % ChunkSize]; }
+    double getWallTimeEnd(std::size_t index) const { return chunk(index).wall_time_end[index % ChunkSize]; }
+    double getCPUTimeStart(std::size_t index) const { return chunk(index).cpu_time_start[index % ChunkSize]; }
+    double getCPUTimeEnd(std::size_t index) const { return chunk(index).cpu_time_end[index % ChunkSize]; }
+    std::uint64_t getInputSampleCount(std::size_t index) const { return chunk(index).input_sample_count[index % ChunkSize]; }
+
+private:
+    struct EventChunk
+    {
+        std::array<std::uint32_t, ChunkSize> event_type_id;
+        std::array<std::uint32_t, ChunkSize> description_id;
+        std::array<std::uint32_t, ChunkSize> time_ratio_id;
+        std::array<double, ChunkSize> wall_time_start;
+        std::array<double, ChunkSize> wall_time_end;
+        std::array<double, ChunkSize> cpu_time_start;
+        std::array<double, ChunkSize> cpu_time_end;
+        std::array<std::uint64_t, ChunkSize> input_sample_count;
+    };
+
+    const EventChunk &chunk(std::size_t index) const { return *m_chunks[index / ChunkSize]; }
+    std::uint32_t internDescription(const char *description);
+    std::uint32_t internTimeRatio(std::int64_t num, std::int64_t den);
+
+    std::vector<std::unique_ptr<EventChunk>> m_chunks;
+    std::size_t m_size;
+    // description table: element addresses in a deque are stable, so, map keys can view them
+    std::deque<std::string> m_descriptions; // index 0 is always the empty description
+    std::unordered_map<std::string_view, std::uint32_t> m_description_ids;
+    std::vector<std::pair<std::int64_t, std::int64_t>> m_time_ratios;
+};
+
 class TimingReportImpl
 {
 public:
@@ -38,8 +117,15 @@ public:
 
     std::uint32_t getMainEventID() const { return m_main_event; }
 
-    void newEvent(std::shared_ptr<TimingReportEventC> p_event, const std::string &set_header = std::string());
-    const std::vector<std::shared_ptr<TimingReportEventC>> &getEvents() const { return m_events; }
+    void newEvent(const TimingReportEventC &event, const std::string &set_header = std::string());
+    /**
+     * @brief Retrieves a copy of the event at the specified index.
+     * @param[out] out_event Event where to store the copy.
+     * @param[in] index Index of the event to retrieve. Must be less than `getEventCount()`.
+     */
+    void getEvent(TimingReportEventC &out_event, std::size_t index) const;
+    std::size_t getEventCount() const { return m_p_mapped_events ? m_p_mapped_events->getEventCount() : m_events.size(); }
+    std::size_t getEventCapacity() const { return m_p_mapped_events ? m_p_mapped_events->getEventCount() : m_events.capacity(); }
     void reserveCapacityForEvents(std::size_t new_capacity);
     void clear();
 
@@ -54,9 +140,23 @@ public:
     void prependFooter(const std::string &footer, bool new_line);
 
     std::ostream &convert2CSV(std::ostream &os) const;
+    /**
+     * @brief Writes this report to a stream in binary report format.
+     * @param os Binary output stream.
+     * @details See BinaryReportFormat for details on the format.
+     */
+    std::ostream &convert2Binary(std::ostream &os) const;
 
     static TimingReportImpl loadCSV(std::istream &is);
     static TimingReportImpl loadCSV(const std::string &csv_content);
+    /**
+     * @brief Loads a report from a binary report file.
+     * @param[in] filename Binary report file to load.
+     * @details The file is memory mapped and events are read directly from the
+     * mapped file without parsing. Events are copied into memory only if the
+     * loaded report is modified.
+     */
+    static TimingReportImpl loadBinary(const std::string &filename);
 
     static void setTimingPrefix(TimingPrefixedSeconds &prefix, double seconds, char ch_prefix);
     static void computeTimingPrefix(TimingPrefixedSeconds &prefix, double seconds);
@@ -135,16 +235,26 @@ private:
      */
     static std::string readTextBlock(std::istream &is, std::string &s_block,
                                      const std::vector<std::string> tags);
-    static void parseTimingEvent(std::string &s_out_event_header,
-                                 std::shared_ptr<TimingReportEventC> &p_out_event,
+    /**
+     * @brief Parses a timing event from the specified CSV line.
+     * @return `true` if an event was parsed, `false` if \p s_line is empty.
+     */
+    static bool parseTimingEvent(std::string &s_out_event_header,
+                                 TimingReportEventC &out_event,
                                  const std::string &s_line);
+    /**
+     * @brief Copies events from the mapped binary report into memory and releases
+     * the mapping. Does nothing if events are not mapped.
+     */
+    void detachMappedEvents();
 
     std::string m_header;
     std::string m_footer;
     std::uint32_t m_main_event;
     std::unordered_map<std::uint32_t, std::string> m_event_headers; // maps event id to event header
     std::vector<std::uint32_t> m_event_types; // all keys to map m_event_headers
-    std::vector<std::shared_ptr<TimingReportEventC>> m_events;
+    TimingEventStore m_events;
+    std::shared_ptr<const MappedBinaryReport> m_p_mapped_events; // if set, events are read from here instead of m_events
 };
 
 } // namespace ReportGen
@@ -372,11 +372,7 @@ extern "C"
             if (!p || !p_event)
                 throw std::invalid_argument("");
 
-            std::shared_ptr<TimingReportEventC> sp_event = std::make_shared<TimingReportEventC>();
-            if (!sp_event)
-                throw std::bad_alloc();
-            *sp_event = *p_event;
-            p->newEvent(sp_event);
+            p->newEvent(*p_event);
 
             retval = 1;
         }
@@ -394,10 +390,10 @@ extern "C"
         try
         {
             TimingReportImpl *p = reinterpret_cast<TimingReportImpl *>(p_report);
-            if (!p || !p_event || index >= p->getEvents().size())
+            if (!p || !p_event || index >= p->getEventCount())
                 throw std::invalid_argument("");
 
-            *p_event = *p->getEvents()[index];
+            p->getEvent(*p_event, index);
 
             retval = 1;
         }
@@ -418,7 +414,7 @@ extern "C"
             if (!p)
                 throw std::invalid_argument("");
 
-            retval = p->getEvents().size();
+            retval = p->getEventCount();
         }
         catch (...)
         {
@@ -437,7 +433,7 @@ extern "C"
             if (!p)
                 throw std::invalid_argument("");
 
-            retval = p->getEvents().capacity();
+            retval = p->getEventCapacity();
         }
         catch (...)
         {
@@ -515,6 +511,32 @@ extern "C"
         return retval;
     }
 
+    int32_t save2Binary(void *p_report, const char *filename)
+    {
+        int32_t retval = 0;
+        try
+        {
+            TimingReportImpl *p = reinterpret_cast<TimingReportImpl *>(p_report);
+            if (!p || !filename || filename[0] == '\0')
+                throw std::invalid_argument("");
+
+            std::ofstream fnum;
+            fnum.open(filename, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+            if (!fnum.is_open())
+                throw std::ios_base::failure("Error opening file");
+
+            p->convert2Binary(fnum);
+
+            retval = 1;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
+
     int32_t convert2CSV(void *p_report, char **pp_csv_content)
     {
         int32_t retval      = 0;
@@ -617,6 +639,54 @@ extern "C"
         }
         return p_retval;
     }
+
+    void *loadReportFromBinaryFile(const char *filename, char error_description[MAX_DESCRIPTION_BUFFER_SIZE])
+    {
+        TimingReportImpl *p_retval = nullptr;
+        try
+        {
+            if (!filename || filename[0] == '\0')
+                throw std::invalid_argument("Invalid empty filename.");
+            p_retval = new TimingReportImpl(TimingReportImpl::loadBinary(filename));
+        }
+        catch (std::exception &ex)
+        {
+            if (p_retval)
+            {
+                delete p_retval;
+                p_retval = nullptr;
+            }
+            hebench::Utilities::copyString(error_description, MAX_DESCRIPTION_BUFFER_SIZE, ex.what());
+        }
+        catch (...)
+        {
+            if (p_retval)
+            {
+                delete p_retval;
+                p_retval = nullptr;
+            }
+            hebench::Utilities::copyString(error_description, MAX_DESCRIPTION_BUFFER_SIZE, "Unknown error.");
+        }
+        return p_retval;
+    }
+
+    int32_t isBinaryReportFile(const char *filename)
+    {
+        int32_t retval = 0;
+        try
+        {
+            if (!filename || filename[0] == '\0')
+                throw std::invalid_argument("");
+
+            retval = BinaryReportFormat::isBinaryReportFile(filename) ? 1 : 0;
+        }
+        catch (...)
+        {
+            retval = 0;
+        }
+
+        return retval;
+    }
 }
 
 int32_t setTimingPrefix(TimingPrefixedSeconds *p_prefix, double seconds, char prefix)
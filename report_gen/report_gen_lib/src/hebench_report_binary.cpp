@@ -0,0 +1,176 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hebench_report_binary.h"
+
+namespace hebench {
+namespace ReportGen {
+namespace BinaryReportFormat {
+
+bool isHostLittleEndian()
+{
+    const std::uint32_t value = ByteOrderMark;
+    std::uint8_t first_byte;
+    std::memcpy(&first_byte, &value, sizeof(first_byte));
+    return first_byte == (ByteOrderMark & 0xFF);
+}
+
+bool isBinaryReportFile(const std::string &filename)
+{
+    char magic[sizeof(Magic)];
+    std::ifstream fnum(filename, std::ios_base::in | std::ios_base::binary);
+    return fnum.is_open()
+           && fnum.read(magic, sizeof(magic))
+           && std::equal(magic, magic + sizeof(magic), Magic);
+}
+
+} // namespace BinaryReportFormat
+
+//--------------------------
+// class MappedBinaryReport
+//--------------------------
+
+MappedBinaryReport::MappedBinaryReport(const std::string &filename) :
+    m_p_mapped(nullptr),
+    m_mapped_size(0),
+    m_p_file_header(nullptr),
+    m_p_event_types(nullptr),
+    m_p_descriptions(nullptr),
+    m_p_events(nullptr)
+{
+    using namespace BinaryReportFormat;
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::ios_base::failure("Could not open file \"" + filename + "\": " + std::strerror(errno));
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(BinaryReportFileHeader)))
+    {
+        ::close(fd);
+        throw std::runtime_error("File \"" + filename + "\" is not a valid binary report: file too small.");
+    } // end if
+
+    m_mapped_size = static_cast<std::uint64_t>(file_stat.st_size);
+    m_p_mapped    = ::mmap(nullptr, m_mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // mapping remains valid after closing the file
+    if (m_p_mapped == MAP_FAILED)
+    {
+        m_p_mapped = nullptr;
+        throw std::ios_base::failure("Could not map file \"" + filename + "\" into memory: " + std::strerror(errno));
+    } // end if
+
+    try
+    {
+        const std::uint8_t *p_data = reinterpret_cast<const std::uint8_t *>(m_p_mapped);
+        m_p_file_header            = reinterpret_cast<const BinaryReportFileHeader *>(p_data);
+
+        if (!std::equal(m_p_file_header->magic, m_p_file_header->magic + sizeof(Magic), Magic))
+            throw std::runtime_error("File \"" + filename + "\" is not a binary report.");
+        if (m_p_file_header->byte_order_mark != ByteOrderMark)
+            throw std::runtime_error("Binary report \"" + filename + "\" has a byte order not supported by this host.");
+        if (m_p_file_header->version_major != VersionMajor)
+        {
+            std::stringstream ss;
+            ss << "Binary report \"" << filename << "\" has unsupported version " << m_p_file_header->version_major
+               << "." << m_p_file_header->version_minor << ". Expected version " << VersionMajor << ".x.";
+            throw std::runtime_error(ss.str());
+        } // end if
+        if (m_p_file_header->file_size != m_mapped_size)
+            throw std::runtime_error("Binary report \"" + filename + "\" is truncated or corrupted.");
+
+        // validate tables
+        auto check_table = [this, &filename](std::uint64_t offset, std::uint64_t count,
+                                             std::uint64_t element_size, std::uint64_t alignment) {
+            if (offset % alignment != 0 || offset > m_mapped_size
+                || count > (m_mapped_size - offset) / element_size)
+                throw std::runtime_error("Binary report \"" + filename + "\" has invalid table bounds.");
+        };
+        check_table(m_p_file_header->event_types_offset, m_p_file_header->event_type_count,
+                    sizeof(BinaryReportEventType), alignof(BinaryReportEventType));
+        check_table(m_p_file_header->descriptions_offset, m_p_file_header->description_count,
+                    sizeof(BinaryReportString), alignof(BinaryReportString));
+        check_table(m_p_file_header->events_offset, m_p_file_header->event_count,
+                    sizeof(BinaryReportEvent), EventAlignment);
+        if (m_p_file_header->description_count <= 0)
+            throw std::runtime_error("Binary report \"" + filename + "\" is missing the description table.");
+        m_p_event_types  = reinterpret_cast<const BinaryReportEventType *>(p_data + m_p_file_header->event_types_offset);
+        m_p_descriptions = reinterpret_cast<const BinaryReportString *>(p_data + m_p_file_header->descriptions_offset);
+        m_p_events       = reinterpret_cast<const BinaryReportEvent *>(p_data + m_p_file_header->events_offset);
+
+        // validate all strings (events are not touched to avoid paging in the whole file)
+        getString(m_p_file_header->header);
+        getString(m_p_file_header->footer);
+        for (std::uint64_t i = 0; i < m_p_file_header->event_type_count; ++i)
+            getString(m_p_event_types[i].header);
+        for (std::uint64_t i = 0; i < m_p_file_header->description_count; ++i)
+            getString(m_p_descriptions[i]);
+
+        // events are read sequentially by most consumers
+        ::madvise(m_p_mapped, m_mapped_size, MADV_SEQUENTIAL);
+    }
+    catch (...)
+    {
+        ::munmap(m_p_mapped, m_mapped_size);
+        m_p_mapped = nullptr;
+        throw;
+    }
+}
+
+MappedBinaryReport::~MappedBinaryReport()
+{
+    if (m_p_mapped)
+        ::munmap(m_p_mapped, m_mapped_size);
+}
+
+std::string_view MappedBinaryReport::getString(const BinaryReportFormat::BinaryReportString &s) const
+{
+    if (s.offset > m_mapped_size || s.size > m_mapped_size - s.offset)
+        throw std::runtime_error("Binary report string out of file bounds.");
+    return std::string_view(reinterpret_cast<const char *>(m_p_mapped) + s.offset, s.size);
+}
+
+std::string_view MappedBinaryReport::getDescription(std::uint64_t description_id) const
+{
+    if (description_id >= m_p_file_header->description_count)
+        throw std::runtime_error("Binary report event references an invalid description.");
+    return getString(m_p_descriptions[description_id]);
+}
+
+void MappedBinaryReport::getEvent(TimingReportEventC &out_event, std::uint64_t index) const
+{
+    assert(index < getEventCount());
+
+    const BinaryReportFormat::BinaryReportEvent &event = m_p_events[index];
+
+    out_event.event_type_id           = event.event_type_id;
+    out_event.cpu_time_start          = event.cpu_time_start;
+    out_event.cpu_time_end            = event.cpu_time_end;
+    out_event.wall_time_start         = event.wall_time_start;
+    out_event.wall_time_end           = event.wall_time_end;
+    out_event.time_interval_ratio_num = event.time_interval_ratio_num;
+    out_event.time_interval_ratio_den = event.time_interval_ratio_den;
+    out_event.input_sample_count      = event.input_sample_count;
+
+    std::string_view s_description = getDescription(event.description_id);
+    std::size_t description_size   = std::min<std::size_t>(s_description.size(), MAX_TIME_REPORT_EVENT_DESCRIPTION_SIZE - 1);
+    std::copy(s_description.begin(), s_description.begin() + description_size, out_event.description);
+    out_event.description[description_size] = '\0';
+}
+
+} // namespace ReportGen
+} // namespace hebench
@@ -7,6 +7,7 @@
 #include <cstring>
 #include <limits>
 #include <sstream>
+#include <unordered_map>
 
 #include "hebench/modules/general/include/hebench_math_utils.h"
 #include "hebench/modules/general/include/hebench_utilities.h"
@@ -20,6 +21,99 @@ std::string to_string(const std::string_view &s)
     return std::string(s.begin(), s.end());
 }
 
+//------------------------
+// class TimingEventStore
+//------------------------
+
+TimingEventStore::TimingEventStore() :
+    m_size(0)
+{
+    m_descriptions.emplace_back();
+    m_description_ids[m_descriptions.front()] = 0;
+}
+
+void TimingEventStore::reserve(std::size_t new_capacity)
+{
+    std::size_t chunk_count = (new_capacity + ChunkSize - 1) / ChunkSize;
+    if (chunk_count > m_chunks.size())
+    {
+        m_chunks.reserve(chunk_count);
+        while (m_chunks.size() < chunk_count)
+            m_chunks.emplace_back(std::make_unique<EventChunk>());
+    } // end if
+}
+
+void TimingEventStore::push(const TimingReportEventC &event)
+{
+    if (m_size >= capacity())
+        // grow geometrically to amortize chunk table reallocations
+        reserve(std::max(capacity() * 2, ChunkSize));
+
+    EventChunk &event_chunk           = *m_chunks[m_size / ChunkSize];
+    std::size_t i                     = m_size % ChunkSize;
+    event_chunk.event_type_id[i]      = event.event_type_id;
+    event_chunk.description_id[i]     = internDescription(event.description);
+    event_chunk.time_ratio_id[i]      = internTimeRatio(event.time_interval_ratio_num, event.time_interval_ratio_den);
+    event_chunk.wall_time_start[i]    = event.wall_time_start;
+    event_chunk.wall_time_end[i]      = event.wall_time_end;
+    event_chunk.cpu_time_start[i]     = event.cpu_time_start;
+    event_chunk.cpu_time_end[i]       = event.cpu_time_end;
+    event_chunk.input_sample_count[i] = event.input_sample_count;
+    ++m_size;
+}
+
+void TimingEventStore::get(TimingReportEventC &out_event, std::size_t index) const
+{
+    assert(index < m_size);
+
+    const EventChunk &event_chunk     = chunk(index);
+    std::size_t i                     = index % ChunkSize;
+    const auto &time_ratio            = m_time_ratios[event_chunk.time_ratio_id[i]];
+    out_event.event_type_id           = event_chunk.event_type_id[i];
+    out_event.cpu_time_start          = event_chunk.cpu_time_start[i];
+    out_event.cpu_time_end            = event_chunk.cpu_time_end[i];
+    out_event.wall_time_start         = event_chunk.wall_time_start[i];
+    out_event.wall_time_end           = event_chunk.wall_time_end[i];
+    out_event.time_interval_ratio_num = time_ratio.first;
+    out_event.time_interval_ratio_den = time_ratio.second;
+    out_event.input_sample_count      = event_chunk.input_sample_count[i];
+    hebench::Utilities::copyString(out_event.description, MAX_TIME_REPORT_EVENT_DESCRIPTION_SIZE,
+                                   m_descriptions[event_chunk.description_id[i]]);
+}
+
+std::uint32_t TimingEventStore::internDescription(const char *description)
+{
+    // most events carry no description
+    if (!description || description[0] == '\0')
+        return 0;
+
+    std::string_view s_description(description,
+                                   std::find(description, description + MAX_TIME_REPORT_EVENT_DESCRIPTION_SIZE, '\0') - description);
+    auto it = m_description_ids.find(s_description);
+    if (it != m_description_ids.end())
+        return it->second;
+
+    std::uint32_t retval = static_cast<std::uint32_t>(m_descriptions.size());
+    m_descriptions.emplace_back(s_description);
+    m_description_ids[m_descriptions.back()] = retval;
+    return retval;
+}
+
+std::uint32_t TimingEventStore::internTimeRatio(std::int64_t num, std::int64_t den)
+{
+    // very few different ratios are expected: linear search is good enough
+    for (std::size_t i = 0; i < m_time_ratios.size(); ++i)
+        if (m_time_ratios[i].first == num && m_time_ratios[i].second == den)
+            return static_cast<std::uint32_t>(i);
+
+    m_time_ratios.emplace_back(num, den);
+    return static_cast<std::uint32_t>(m_time_ratios.size() - 1);
+}
+
+//------------------------
+// class TimingReportImpl
+//------------------------
+
 TimingReportImpl::TimingReportImpl() :
     m_main_event(std::numeric_limits<decltype(m_main_event)>::max())
 {
@@ -34,26 +128,51 @@ void TimingReportImpl::newEventType(std::uint32_t set_id, const std::string &set
         m_main_event = set_id;
 }
 
-void TimingReportImpl::newEvent(std::shared_ptr<TimingReportEventC> p_event, const std::string &set_header)
+void TimingReportImpl::newEvent(const TimingReportEventC &event, const std::string &set_header)
 {
-    if (p_event)
-    {
-        if (m_event_headers.count(p_event->event_type_id) <= 0 || !set_header.empty())
-            newEventType(p_event->event_type_id, set_header);
-        m_events.push_back(p_event);
-    } // end if
+    detachMappedEvents();
+    if (m_event_headers.count(event.event_type_id) <= 0 || !set_header.empty())
+        newEventType(event.event_type_id, set_header);
+    m_events.push(event);
+}
+
+void TimingReportImpl::getEvent(TimingReportEventC &out_event, std::size_t index) const
+{
+    if (m_p_mapped_events)
+        m_p_mapped_events->getEvent(out_event, index);
+    else
+        m_events.get(out_event, index);
 }
 
 void TimingReportImpl::reserveCapacityForEvents(std::size_t new_capacity)
 {
+    detachMappedEvents();
     m_events.reserve(new_capacity);
 }
 
 void TimingReportImpl::clear()
 {
+    m_p_mapped_events.reset();
     m_events.clear();
 }
 
+void TimingReportImpl::detachMappedEvents()
+{
+    if (m_p_mapped_events)
+    {
+        std::shared_ptr<const MappedBinaryReport> p_mapped_events = std::move(m_p_mapped_events);
+
+        TimingReportEventC event;
+        m_events.clear();
+        m_events.reserve(p_mapped_events->getEventCount());
+        for (std::uint64_t i = 0; i < p_mapped_events->getEventCount(); ++i)
+        {
+            p_mapped_events->getEvent(event, i);
+            m_events.push(event);
+        } // end for
+    } // end if
+}
+
 void TimingReportImpl::appendHeader(const std::string &header, bool new_line)
 {
     std::stringstream ss;
@@ -100,13 +219,13 @@ std::ostream &TimingReportImpl::convert2CSV(std::ostream &os) const
         throw std::ios_base::failure("Output stream is in an invalid state.");
 
     os << TagVersion << std::endl // report version
-       << "Events recorded," << m_events.size() << std::endl
+       << "Events recorded," << getEventCount() << std::endl
        << "Main event," << m_main_event << std::endl
        << TagReportHeader << std::endl // header start
        << getHeader() << std::endl;
     if (!os)
         throw std::ios_base::failure("Error writing report header to stream.");
-    if (m_events.empty())
+    if (getEventCount() <= 0)
     {
         os << TagFailedTest << std::endl // this report is of a test that failed validation
            << "Failed" << std::endl;
@@ -121,19 +240,20 @@ std::ostream &TimingReportImpl::convert2CSV(std::ostream &os) const
         if (!os)
             throw std::ios_base::failure("Error writing table header to stream.");
 
-        for (std::size_t i = 0; i < m_events.size(); ++i)
+        TimingReportEventC event;
+        for (std::size_t i = 0; i < getEventCount(); ++i)
         {
-            const TimingReportEventC &timing_event = *m_events[i];
-            os << "," << i << "," << timing_event.event_type_id << ",";
-            if (m_event_headers.count(timing_event.event_type_id) > 0)
-                os << m_event_headers.at(timing_event.event_type_id);
-            os << "," << timing_event.description << ","
-               << timing_event.time_interval_ratio_num << "," << timing_event.time_interval_ratio_den << ","
-               << hebench::Utilities::convertDoubleToStr(timing_event.wall_time_start) << "," << hebench::Utilities::convertDoubleToStr(timing_event.wall_time_end) << ","
-               << hebench::Utilities::convertDoubleToStr(timing_event.wall_time_end - timing_event.wall_time_start) << ","
-               << hebench::Utilities::convertDoubleToStr(timing_event.cpu_time_start) << "," << hebench::Utilities::convertDoubleToStr(timing_event.cpu_time_end) << ","
-               << hebench::Utilities::convertDoubleToStr(timing_event.cpu_time_end - timing_event.cpu_time_start) << ","
-               << timing_event.input_sample_count;
+            getEvent(event, i);
+            os << "," << i << "," << event.event_type_id << ",";
+            if (m_event_headers.count(event.event_type_id) > 0)
+                os << m_event_headers.at(event.event_type_id);
+            os << "," << event.description << ","
+               << event.time_interval_ratio_num << "," << event.time_interval_ratio_den << ","
+               << hebench::Utilities::convertDoubleToStr(event.wall_time_start) << "," << hebench::Utilities::convertDoubleToStr(event.wall_time_end) << ","
+               << hebench::Utilities::convertDoubleToStr(event.wall_time_end - event.wall_time_start) << ","
+               << hebench::Utilities::convertDoubleToStr(event.cpu_time_start) << "," << hebench::Utilities::convertDoubleToStr(event.cpu_time_end) << ","
+               << hebench::Utilities::convertDoubleToStr(event.cpu_time_end - event.cpu_time_start) << ","
+               << event.input_sample_count;
 
             os << std::endl;
 
@@ -235,15 +355,15 @@ void TimingReportImpl::parseHeadingValue(std::string &s_out_heading, double &out
         throw std::runtime_error("Invalid CSV format. Expected type double for heading \"" + s_out_heading + "\", but read \"" + s_value + "\".");
 }
 
-void TimingReportImpl::parseTimingEvent(std::string &s_out_event_header,
-                                        std::shared_ptr<TimingReportEventC> &p_out_event,
+bool TimingReportImpl::parseTimingEvent(std::string &s_out_event_header,
+                                        TimingReportEventC &out_event,
                                         const std::string &s_line)
 {
     std::stringstream ss;
     std::size_t value_start, value_length;
     std::string_view s_line_view;
     std::string s_value;
-    std::shared_ptr<TimingReportEventC> retval;
+    bool retval = false;
 
     s_out_event_header.clear();
     if (!s_line.empty())
@@ -406,20 +526,20 @@ void TimingReportImpl::parseTimingEvent(std::string &s_out_event_header,
             throw std::runtime_error(ss.str());
         } // end if
 
-        retval                = std::make_shared<TimingReportEventC>();
-        retval->event_type_id = id;
-        hebench::Utilities::copyString(retval->description, MAX_TIME_REPORT_EVENT_DESCRIPTION_SIZE, event_description);
-        retval->cpu_time_start          = cpu_start_time;
-        retval->cpu_time_end            = cpu_end_time;
-        retval->wall_time_start         = wall_start_time;
-        retval->wall_time_end           = wall_end_time;
-        retval->input_sample_count      = input_sample_count;
-        retval->time_interval_ratio_num = time_interval_num;
-        retval->time_interval_ratio_den = time_interval_den;
-
+        out_event.event_type_id = id;
+        hebench::Utilities::copyString(out_event.description, MAX_TIME_REPORT_EVENT_DESCRIPTION_SIZE, event_description);
+        out_event.cpu_time_start          = cpu_start_time;
+        out_event.cpu_time_end            = cpu_end_time;
+        out_event.wall_time_start         = wall_start_time;
+        out_event.wall_time_end           = wall_end_time;
+        out_event.input_sample_count      = input_sample_count;
+        out_event.time_interval_ratio_num = time_interval_num;
+        out_event.time_interval_ratio_den = time_interval_den;
+
+        retval = true;
     } // end if
 
-    p_out_event = retval;
+    return retval;
 }
 
 std::istream &TimingReportImpl::getTrimmedLine(std::istream &is, std::string &s_out, const std::string &extra_trim)
@@ -537,16 +657,16 @@ TimingReportImpl TimingReportImpl::loadCSV(std::istream &is)
             if (s_line != TagReportFooter)
             {
                 std::string s_event_header;
-                std::shared_ptr<TimingReportEventC> p_event;
-                parseTimingEvent(s_event_header, p_event, s_line);
-                retval.newEvent(p_event, s_event_header);
+                TimingReportEventC event;
+                if (parseTimingEvent(s_event_header, event, s_line))
+                    retval.newEvent(event, s_event_header);
             } // end if
         } // end while
 
-        if (retval.getEvents().size() != events_count)
+        if (retval.getEventCount() != events_count)
         {
             std::stringstream ss;
-            ss << "Inconsistent number of events read from CSV. Expected " << events_count << ", but read " << retval.getEvents().size() << ".";
+            ss << "Inconsistent number of events read from CSV. Expected " << events_count << ", but read " << retval.getEventCount() << ".";
             throw std::runtime_error(ss.str());
         } // end if
     } // end else
@@ -565,6 +685,144 @@ TimingReportImpl TimingReportImpl::loadCSV(std::istream &is)
     return retval;
 }
 
+std::ostream &TimingReportImpl::convert2Binary(std::ostream &os) const
+{
+    using namespace BinaryReportFormat;
+
+    if (!os)
+        throw std::ios_base::failure("Output stream is in an invalid state.");
+    if (!isHostLittleEndian())
+        throw std::runtime_error("Binary report format is only supported on little-endian hosts.");
+
+    TimingReportEventC event;
+
+    // intern event descriptions (most events have none)
+    std::vector<std::string> descriptions(1); // index 0 is always the empty description
+    std::unordered_map<std::string, std::uint32_t> description_ids;
+    for (std::size_t i = 0; i < getEventCount(); ++i)
+    {
+        getEvent(event, i);
+        if (event.description[0] != '\0' && description_ids.count(event.description) <= 0)
+        {
+            description_ids[event.description] = static_cast<std::uint32_t>(descriptions.size());
+            descriptions.emplace_back(event.description);
+        } // end if
+    } // end for
+
+    // compute file layout
+
+    BinaryReportFileHeader file_header;
+    std::memset(&file_header, 0, sizeof(file_header));
+    std::copy(Magic, Magic + sizeof(Magic), file_header.magic);
+    file_header.byte_order_mark    = ByteOrderMark;
+    file_header.version_major      = VersionMajor;
+    file_header.version_minor      = VersionMinor;
+    file_header.main_event_type_id = m_main_event;
+    file_header.event_type_count   = static_cast<std::uint32_t>(m_event_types.size());
+    file_header.description_count  = descriptions.size();
+    file_header.event_count        = getEventCount();
+
+    std::uint64_t offset = sizeof(BinaryReportFileHeader);
+    auto layout_string   = [&offset](BinaryReportString &s, std::size_t size) {
+        s.offset = offset;
+        s.size   = size;
+        offset += size;
+    };
+    auto align = [](std::uint64_t value, std::uint64_t alignment) -> std::uint64_t {
+        return (value + alignment - 1) / alignment * alignment;
+    };
+
+    layout_string(file_header.header, m_header.size());
+    layout_string(file_header.footer, m_footer.size());
+    std::vector<BinaryReportEventType> event_types(m_event_types.size());
+    for (std::size_t i = 0; i < m_event_types.size(); ++i)
+    {
+        event_types[i].event_type_id = m_event_types[i];
+        event_types[i].reserved      = 0;
+        layout_string(event_types[i].header, m_event_headers.at(m_event_types[i]).size());
+    } // end for
+    std::vector<BinaryReportString> description_table(descriptions.size());
+    for (std::size_t i = 0; i < descriptions.size(); ++i)
+        layout_string(description_table[i], descriptions[i].size());
+
+    file_header.event_types_offset  = align(offset, alignof(BinaryReportEventType));
+    offset                          = file_header.event_types_offset + event_types.size() * sizeof(BinaryReportEventType);
+    file_header.descriptions_offset = align(offset, alignof(BinaryReportString));
+    offset                          = file_header.descriptions_offset + description_table.size() * sizeof(BinaryReportString);
+    file_header.events_offset       = align(offset, EventAlignment);
+    file_header.file_size           = file_header.events_offset + file_header.event_count * sizeof(BinaryReportEvent);
+
+    // write
+
+    std::uint64_t written = 0;
+    auto write_bytes      = [&os, &written](const void *p_data, std::size_t size) {
+        os.write(reinterpret_cast<const char *>(p_data), size);
+        written += size;
+    };
+    auto write_padding = [&os, &written](std::uint64_t next_offset) {
+        assert(next_offset >= written);
+        static const char zeros[EventAlignment] = {};
+        os.write(zeros, next_offset - written);
+        written = next_offset;
+    };
+
+    write_bytes(&file_header, sizeof(file_header));
+    write_bytes(m_header.data(), m_header.size());
+    write_bytes(m_footer.data(), m_footer.size());
+    for (std::size_t i = 0; i < m_event_types.size(); ++i)
+    {
+        const std::string &s_header = m_event_headers.at(m_event_types[i]);
+        write_bytes(s_header.data(), s_header.size());
+    } // end for
+    for (std::size_t i = 0; i < descriptions.size(); ++i)
+        write_bytes(descriptions[i].data(), descriptions[i].size());
+    write_padding(file_header.event_types_offset);
+    write_bytes(event_types.data(), event_types.size() * sizeof(BinaryReportEventType));
+    write_padding(file_header.descriptions_offset);
+    write_bytes(description_table.data(), description_table.size() * sizeof(BinaryReportString));
+    write_padding(file_header.events_offset);
+    if (!os)
+        throw std::ios_base::failure("Error writing binary report header to stream.");
+
+    BinaryReportEvent binary_event;
+    for (std::size_t i = 0; i < getEventCount(); ++i)
+    {
+        getEvent(event, i);
+        binary_event.event_type_id           = event.event_type_id;
+        binary_event.description_id          = event.description[0] == '\0' ? 0 : description_ids.at(event.description);
+        binary_event.time_interval_ratio_num = event.time_interval_ratio_num;
+        binary_event.time_interval_ratio_den = event.time_interval_ratio_den;
+        binary_event.wall_time_start         = event.wall_time_start;
+        binary_event.wall_time_end           = event.wall_time_end;
+        binary_event.cpu_time_start          = event.cpu_time_start;
+        binary_event.cpu_time_end            = event.cpu_time_end;
+        binary_event.input_sample_count      = event.input_sample_count;
+        write_bytes(&binary_event, sizeof(binary_event));
+    } // end for
+    if (!os)
+        throw std::ios_base::failure("Error writing binary report events to stream.");
+
+    return os;
+}
+
+TimingReportImpl TimingReportImpl::loadBinary(const std::string &filename)
+{
+    TimingReportImpl retval;
+
+    std::shared_ptr<const MappedBinaryReport> p_mapped = std::make_shared<MappedBinaryReport>(filename);
+
+    retval.setHeader(to_string(p_mapped->getHeader()));
+    retval.setFooter(to_string(p_mapped->getFooter()));
+    for (std::uint64_t i = 0; i < p_mapped->getEventTypeCount(); ++i)
+        retval.newEventType(p_mapped->getEventType(i).event_type_id,
+                            to_string(p_mapped->getEventTypeHeader(i)));
+    retval.m_main_event = p_mapped->getFileHeader().main_event_type_id;
+    if (p_mapped->getEventCount() > 0)
+        retval.m_p_mapped_events = p_mapped;
+
+    return retval;
+}
+
 void TimingReportImpl::setTimingPrefix(TimingPrefixedSeconds &prefix, double seconds, char ch_prefix)
 {
     switch (ch_prefix)
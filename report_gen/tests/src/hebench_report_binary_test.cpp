@@ -0,0 +1,136 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+
+#include "hebench_unit_test.h"
+
+#include "hebench_report_cpp.h"
+
+using namespace hebench::ReportGen;
+
+namespace {
+
+using hebench::UnitTest::check;
+using hebench::UnitTest::checkThrows;
+
+void checkEvent(const TimingReportEventC &event, const TimingReportEventC &expected)
+{
+    check(event.event_type_id == expected.event_type_id, "Event type ID does not match.");
+    check(event.cpu_time_start == expected.cpu_time_start && event.cpu_time_end == expected.cpu_time_end,
+          "Event CPU time does not match.");
+    check(event.wall_time_start == expected.wall_time_start && event.wall_time_end == expected.wall_time_end,
+          "Event wall time does not match.");
+    check(event.time_interval_ratio_num == expected.time_interval_ratio_num
+              && event.time_interval_ratio_den == expected.time_interval_ratio_den,
+          "Event time interval ratio does not match.");
+    check(event.input_sample_count == expected.input_sample_count, "Event input sample count does not match.");
+    check(std::strcmp(event.description, expected.description) == 0, "Event description does not match.");
+}
+
+void checkReport(const cpp::TimingReport &report, const cpp::TimingReport &expected)
+{
+    check(report.getHeader() == expected.getHeader(), "Report header does not match.");
+    check(report.getFooter() == expected.getFooter(), "Report footer does not match.");
+    check(report.getMainEventType() == expected.getMainEventType(), "Main event type does not match.");
+    check(report.getEventTypeCount() == expected.getEventTypeCount(), "Event type count does not match.");
+    for (std::uint64_t i = 0; i < expected.getEventTypeCount(); ++i)
+    {
+        std::uint32_t event_type_id = expected.getEventType(i);
+        check(report.hasEventType(event_type_id), "Event type missing.");
+        check(report.getEventTypeHeader(event_type_id) == expected.getEventTypeHeader(event_type_id),
+              "Event type header does not match.");
+    } // end for
+    check(report.getEventCount() == expected.getEventCount(), "Event count does not match.");
+    for (std::uint64_t i = 0; i < expected.getEventCount(); ++i)
+    {
+        TimingReportEventC event;
+        TimingReportEventC expected_event;
+        report.getEvent(event, i);
+        expected.getEvent(expected_event, i);
+        checkEvent(event, expected_event);
+    } // end for
+}
+
+cpp::TimingReport createReport(std::size_t event_count)
+{
+    std::mt19937_64 rand(5);
+    std::uniform_real_distribution<double> rand_time(0.0, 1.0e6);
+    std::uniform_int_distribution<std::uint64_t> rand_samples(1, 100);
+
+    cpp::TimingReport report("Workload, Element-wise addition\nParameters, \"a, b\"");
+    report.setFooter("Notes, footer with non-ASCII text: \xc2\xb5s");
+    report.addEventType(2, "Load");
+    report.addEventType(5, "Operation", true);
+    report.addEventType(9, "Store");
+    const std::uint32_t event_type_ids[] = { 2, 5, 9 };
+    for (std::size_t event_i = 0; event_i < event_count; ++event_i)
+    {
+        TimingReportEventC event;
+        std::memset(&event, 0, sizeof(TimingReportEventC));
+        event.event_type_id           = event_type_ids[event_i % 3];
+        event.cpu_time_start          = rand_time(rand);
+        event.cpu_time_end            = event.cpu_time_start + rand_time(rand);
+        event.wall_time_start         = rand_time(rand);
+        event.wall_time_end           = event.wall_time_start + rand_time(rand);
+        event.time_interval_ratio_num = 1;
+        event.time_interval_ratio_den = event_i % 2 == 0 ? 1000000 : 1000000000;
+        event.input_sample_count      = rand_samples(rand);
+        // descriptions repeat, so they are shared in the binary description table
+        if (event_i % 4 == 1)
+            std::strcpy(event.description, "batch");
+        else if (event_i % 4 == 3)
+            std::strcpy(event.description, ("sample " + std::to_string(event_i % 7)).c_str());
+        report.addEvent(event);
+    } // end for
+    return report;
+}
+
+void testRoundTrip(const std::filesystem::path &tmp_dir)
+{
+    std::string csv_filename    = (tmp_dir / "report.csv").string();
+    std::string binary_filename = (tmp_dir / "report.hebr").string();
+    std::string csv2_filename   = (tmp_dir / "report2.csv").string();
+
+    for (std::size_t event_count : { std::size_t(1), std::size_t(1000) })
+    {
+        cpp::TimingReport report = createReport(event_count);
+        report.save2CSV(csv_filename);
+        report.save2Binary(binary_filename);
+
+        check(cpp::TimingReport::isBinaryReportFile(binary_filename), "Binary report not detected.");
+        check(!cpp::TimingReport::isBinaryReportFile(csv_filename), "CSV report detected as binary.");
+
+        // binary report holds the same information as the original report
+        checkReport(cpp::TimingReport::loadReportFromBinaryFile(binary_filename), report);
+        checkReport(cpp::TimingReport::loadReportFromFile(binary_filename), report);
+
+        // CSV -> binary -> CSV produces the same CSV
+        cpp::TimingReport::convertCSV2Binary(csv_filename, binary_filename);
+        cpp::TimingReport::convertBinary2CSV(binary_filename, csv2_filename);
+        check(cpp::TimingReport::loadReportFromCSVFile(csv2_filename).convert2CSV()
+                  == cpp::TimingReport::loadReportFromCSVFile(csv_filename).convert2CSV(),
+              "CSV round trip through binary report does not match.");
+        checkReport(cpp::TimingReport::loadReportFromFile(csv2_filename),
+                    cpp::TimingReport::loadReportFromCSVFile(csv_filename));
+    } // end for
+
+    // truncated files are rejected
+    std::filesystem::resize_file(binary_filename, std::filesystem::file_size(binary_filename) / 2);
+    checkThrows<std::exception>([&]() { cpp::TimingReport::loadReportFromBinaryFile(binary_filename); },
+                                "Truncated binary report must be rejected.");
+}
+
+} // namespace
+
+int main()
+{
+    hebench::UnitTest::TemporaryDirectory tmp_dir("hebench_report_binary_test");
+    return hebench::UnitTest::runTests({ [&tmp_dir]() { testRoundTrip(tmp_dir.getPath()); } });
+}
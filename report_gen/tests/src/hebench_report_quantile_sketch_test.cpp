@@ -0,0 +1,279 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "hebench/modules/general/include/hebench_math_utils.h"
+#include "hebench_report_cpp.h"
+#include "hebench_report_quantile_sketch.h"
+#include "hebench_report_stats.h"
+
+using namespace hebench::ReportGen;
+
+namespace {
+
+// allowance for rounding in the interpolation between ranks
+constexpr double RoundingTolerance = 1e-12;
+
+const std::vector<double> Quantiles = { 0.0, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999, 0.9999, 1.0 };
+
+using hebench::UnitTest::check;
+using hebench::UnitTest::checkThrows;
+
+void checkRelative(double value, double expected, double relative_accuracy, const std::string &name)
+{
+    if (std::abs(value - expected) > (relative_accuracy + RoundingTolerance) * std::abs(expected))
+    {
+        std::stringstream ss;
+        ss.precision(17);
+        ss << name << ": expected " << expected << " within relative accuracy " << relative_accuracy
+           << ", but " << value << " received.";
+        throw std::runtime_error(ss.str());
+    } // end if
+}
+
+std::vector<double> generateLogNormal(std::uint64_t seed, std::size_t count)
+{
+    std::mt19937_64 rand(seed);
+    std::lognormal_distribution<double> dist(3.0, 1.5);
+    std::vector<double> retval(count);
+    for (double &value : retval)
+        value = dist(rand);
+    return retval;
+}
+
+double computeExactQuantile(std::vector<double> data, double quantile)
+{
+    std::sort(data.begin(), data.end());
+    return hebench::Utilities::Math::computePercentile(data.data(), data.size(), quantile);
+}
+
+void testAccuracy(double relative_accuracy)
+{
+    std::vector<double> data = generateLogNormal(7, 20000);
+    QuantileSketch sketch(relative_accuracy);
+    for (double value : data)
+        sketch.add(value);
+
+    check(sketch.getCount() == data.size(), "Sketch count does not match number of values added.");
+    check(sketch.getMin() == *std::min_element(data.begin(), data.end()), "Sketch minimum is not exact.");
+    check(sketch.getMax() == *std::max_element(data.begin(), data.end()), "Sketch maximum is not exact.");
+    for (double quantile : Quantiles)
+        checkRelative(sketch.getQuantile(quantile), computeExactQuantile(data, quantile),
+                      relative_accuracy, "Quantile " + std::to_string(quantile));
+}
+
+void testTrimmedStats()
+{
+    std::vector<double> data = generateLogNormal(11, 10000);
+    QuantileSketch sketch;
+    for (double value : data)
+        sketch.add(value);
+
+    std::sort(data.begin(), data.end());
+    std::size_t trim_start = data.size() / 10;
+    hebench::Utilities::Math::EventStats trimmed_stats;
+    for (std::size_t i = trim_start; i < data.size() - trim_start; ++i)
+        trimmed_stats.newEvent(data[i]);
+
+    double ave, variance, total;
+    std::uint64_t count = sketch.getTrimmedStats(ave, variance, total, 0.1);
+    check(count == trimmed_stats.getCount(), "Trimmed count does not match.");
+    checkRelative(ave, trimmed_stats.getMean(), QuantileSketch::DefaultRelativeAccuracy, "Trimmed average");
+    checkRelative(total, trimmed_stats.getTotal(), QuantileSketch::DefaultRelativeAccuracy, "Trimmed total");
+    // variance of the bucket values is not bounded by the relative accuracy: loose check
+    checkRelative(variance, trimmed_stats.getVariance(), 0.1, "Trimmed variance");
+}
+
+void testWeightsAndMerge()
+{
+    std::vector<double> data_a = generateLogNormal(13, 3000);
+    std::vector<double> data_b = generateLogNormal(17, 5000);
+
+    // a weighted value behaves as the value repeated
+    QuantileSketch weighted;
+    QuantileSketch repeated;
+    for (std::size_t i = 0; i < data_a.size(); ++i)
+    {
+        std::uint64_t weight = 1 + i % 4;
+        weighted.add(data_a[i], weight);
+        for (std::uint64_t j = 0; j < weight; ++j)
+            repeated.add(data_a[i]);
+    } // end for
+    check(weighted.getCount() == repeated.getCount(), "Weighted count does not match.");
+    for (double quantile : Quantiles)
+        check(weighted.getQuantile(quantile) == repeated.getQuantile(quantile),
+              "Weighted quantile does not match repeated values.");
+    weighted.add(1.0, 0);
+    check(weighted.getCount() == repeated.getCount(), "Value with zero weight was counted.");
+
+    // merged sketches behave as a single sketch fed with all values
+    QuantileSketch sketch_a;
+    QuantileSketch sketch_b;
+    QuantileSketch sketch_all;
+    for (double value : data_a)
+    {
+        sketch_a.add(value);
+        sketch_all.add(value);
+    } // end for
+    for (double value : data_b)
+    {
+        sketch_b.add(value);
+        sketch_all.add(value);
+    } // end for
+    sketch_a.merge(sketch_b);
+    check(sketch_a.getCount() == sketch_all.getCount(), "Merged count does not match.");
+    check(sketch_a.getMin() == sketch_all.getMin() && sketch_a.getMax() == sketch_all.getMax(),
+          "Merged extremes do not match.");
+    for (double quantile : Quantiles)
+        check(sketch_a.getQuantile(quantile) == sketch_all.getQuantile(quantile),
+              "Merged quantile does not match.");
+
+    checkThrows<std::invalid_argument>([&]() { sketch_a.merge(QuantileSketch(0.01)); },
+                                       "Merging sketches with different relative accuracy must fail.");
+}
+
+void testEdgeCases()
+{
+    QuantileSketch sketch;
+    check(sketch.getQuantile(0.5) == 0.0, "Empty sketch must estimate 0.");
+
+    // zeroes are counted in the zero bucket
+    sketch.add(0.0, 10);
+    sketch.add(5.0, 10);
+    check(sketch.getQuantile(0.0) == 0.0, "Zero bucket must estimate 0.");
+    check(sketch.getQuantile(0.25) == 0.0, "Zero bucket must estimate 0.");
+    checkRelative(sketch.getQuantile(0.75), 5.0, QuantileSketch::DefaultRelativeAccuracy, "Quantile above zero bucket");
+
+    // collapsing the lowest buckets keeps the tail accurate
+    std::vector<double> data;
+    for (int exponent = -200; exponent <= 200; ++exponent)
+        data.push_back(std::pow(1.5, exponent));
+    QuantileSketch collapsed(QuantileSketch::DefaultRelativeAccuracy, 256);
+    for (double value : data)
+        collapsed.add(value);
+    check(collapsed.getBucketCount() <= 256, "Bucket count exceeds the maximum.");
+    // 256 buckets only span the largest few values
+    for (double quantile : { 0.9925, 0.995, 1.0 })
+        checkRelative(collapsed.getQuantile(quantile), computeExactQuantile(data, quantile),
+                      QuantileSketch::DefaultRelativeAccuracy, "Tail quantile after collapsing");
+
+    for (double relative_accuracy : { 0.0, 1.0, -0.5 })
+    {
+        checkThrows<std::invalid_argument>([&]() { QuantileSketch invalid(relative_accuracy); },
+                                           "Invalid relative accuracy must be rejected.");
+    } // end for
+}
+
+void testSketchedReportStats()
+{
+    constexpr std::uint32_t EventID = 1;
+
+    std::mt19937_64 rand(19);
+    std::lognormal_distribution<double> rand_time(6.0, 0.75);
+    std::uniform_int_distribution<std::uint64_t> rand_samples(1, 8);
+
+    cpp::TimingReport report;
+    report.addEventType(EventID, "Operation", true);
+    for (std::size_t event_i = 0; event_i < 5000; ++event_i)
+    {
+        TimingReportEventC event;
+        std::memset(&event, 0, sizeof(TimingReportEventC));
+        event.event_type_id           = EventID;
+        event.wall_time_start         = 0.0;
+        event.wall_time_end           = rand_time(rand);
+        event.cpu_time_start          = 0.0;
+        event.cpu_time_end            = rand_time(rand);
+        event.time_interval_ratio_num = 1;
+        event.time_interval_ratio_den = 1000000;
+        event.input_sample_count      = rand_samples(rand);
+        report.addEvent(event);
+    } // end for
+
+    ReportStats exact_stats(report);
+    ReportStats sketched_stats(report, 1000);
+    check(!exact_stats.isSketched(), "Exact statistics expected.");
+    check(sketched_stats.isSketched(), "Sketched statistics expected.");
+
+    const ReportEventTypeStats &exact    = exact_stats.getMainEventTypeStats();
+    const ReportEventTypeStats &sketched = sketched_stats.getMainEventTypeStats();
+    constexpr double Accuracy            = QuantileSketch::DefaultRelativeAccuracy;
+    // average, variance and extremes are always exact (up to summation order)
+    checkRelative(sketched.wall_time_ave, exact.wall_time_ave, 1e-12, "Sketched wall average");
+    checkRelative(sketched.wall_time_variance, exact.wall_time_variance, 1e-9, "Sketched wall variance");
+    check(sketched.wall_time_min == exact.wall_time_min && sketched.wall_time_max == exact.wall_time_max,
+          "Sketched wall extremes are not exact.");
+    check(sketched.input_sample_count == exact.input_sample_count, "Sketched input sample count does not match.");
+    checkRelative(sketched.wall_time_median, exact.wall_time_median, Accuracy, "Sketched wall median");
+    checkRelative(sketched.wall_time_1, exact.wall_time_1, Accuracy, "Sketched wall 1-th percentile");
+    checkRelative(sketched.wall_time_10, exact.wall_time_10, Accuracy, "Sketched wall 10-th percentile");
+    checkRelative(sketched.wall_time_90, exact.wall_time_90, Accuracy, "Sketched wall 90-th percentile");
+    checkRelative(sketched.wall_time_99, exact.wall_time_99, Accuracy, "Sketched wall 99-th percentile");
+    checkRelative(sketched.wall_time_999, exact.wall_time_999, Accuracy, "Sketched wall 99.9-th percentile");
+    checkRelative(sketched.wall_time_9999, exact.wall_time_9999, Accuracy, "Sketched wall 99.99-th percentile");
+    checkRelative(sketched.wall_time_ave_trim, exact.wall_time_ave_trim, Accuracy, "Sketched wall trimmed average");
+    checkRelative(sketched.cpu_time_median, exact.cpu_time_median, Accuracy, "Sketched CPU median");
+    checkRelative(sketched.cpu_time_9999, exact.cpu_time_9999, Accuracy, "Sketched CPU 99.99-th percentile");
+    checkRelative(sketched.ops_per_sec_trim, exact.ops_per_sec_trim, 2.0 * Accuracy, "Sketched trimmed throughput");
+}
+
+void testHeavyEvents()
+{
+    // events representing a huge number of input samples are added in a single step
+    constexpr std::uint32_t EventID          = 1;
+    constexpr std::uint64_t InputSampleCount = 1ULL << 40;
+
+    static const double wall_times_per_sample[] = { 2.0, 3.0, 7.0 };
+
+    cpp::TimingReport report;
+    report.addEventType(EventID, "Operation", true);
+    for (double wall_time_per_sample : wall_times_per_sample)
+    {
+        TimingReportEventC event;
+        std::memset(&event, 0, sizeof(TimingReportEventC));
+        event.event_type_id           = EventID;
+        event.wall_time_start         = 0.0;
+        event.wall_time_end           = wall_time_per_sample * InputSampleCount;
+        event.cpu_time_start          = 0.0;
+        event.cpu_time_end            = wall_time_per_sample * InputSampleCount;
+        event.time_interval_ratio_num = 1;
+        event.time_interval_ratio_den = 1;
+        event.input_sample_count      = InputSampleCount;
+        report.addEvent(event);
+    } // end for
+
+    ReportStats sketched_stats(report, 1);
+    check(sketched_stats.isSketched(), "Sketched statistics expected.");
+    const ReportEventTypeStats &sketched = sketched_stats.getMainEventTypeStats();
+    check(sketched.input_sample_count == 3 * InputSampleCount, "Sketched input sample count does not match.");
+    checkRelative(sketched.wall_time_ave, 4.0, 1e-12, "Sketched wall average");
+    // sample variance of the expanded samples: sum of squared deviations over (N - 1)
+    checkRelative(sketched.wall_time_variance, 14.0 * InputSampleCount / (3.0 * InputSampleCount - 1.0), 1e-9,
+                  "Sketched wall variance");
+    checkRelative(sketched.wall_time_median, 3.0, QuantileSketch::DefaultRelativeAccuracy, "Sketched wall median");
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ []() { testAccuracy(QuantileSketch::DefaultRelativeAccuracy); },
+                                         []() { testAccuracy(0.02); },
+                                         testTrimmedStats,
+                                         testWeightsAndMerge,
+                                         testEdgeCases,
+                                         testSketchedReportStats,
+                                         testHeavyEvents });
+}
@@ -0,0 +1,173 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "hebench/modules/general/include/hebench_math_utils.h"
+#include "hebench_report_cpp.h"
+#include "hebench_report_stats.h"
+
+using namespace hebench::ReportGen;
+
+namespace {
+
+using hebench::UnitTest::check;
+
+void checkEqual(double value, double expected, const std::string &name)
+{
+    if (value != expected)
+    {
+        std::stringstream ss;
+        ss.precision(17);
+        ss << name << ": expected " << expected << ", but " << value << " received.";
+        throw std::runtime_error(ss.str());
+    } // end if
+}
+
+void checkNear(double value, double expected, const std::string &name)
+{
+    // moments are accumulated once per weighted value instead of once per sample
+    constexpr double Tolerance = 1e-10;
+    if (std::abs(value - expected) > Tolerance * std::max(std::abs(expected), 1e-6))
+    {
+        std::stringstream ss;
+        ss.precision(17);
+        ss << name << ": expected " << expected << ", but " << value << " received.";
+        throw std::runtime_error(ss.str());
+    } // end if
+}
+
+/**
+ * @brief Reference statistics computed on the expanded samples, where each event
+ * is repeated as many times as its input sample count, using the common library
+ * functions directly, as ReportStats did before weighting events.
+ */
+StatisticsResult computeExpandedStats(const std::vector<double> &data)
+{
+    std::vector<double> sorted_data(data);
+    std::sort(sorted_data.begin(), sorted_data.end());
+    std::size_t trim_start = sorted_data.size() / 10;
+
+    hebench::Utilities::Math::EventStats basic_stats;
+    for (double value : data)
+        basic_stats.newEvent(value);
+    hebench::Utilities::Math::EventStats trimmed_stats;
+    for (std::size_t i = trim_start; i < sorted_data.size() - trim_start; ++i)
+        trimmed_stats.newEvent(sorted_data[i]);
+
+    StatisticsResult result;
+    std::memset(&result, 0, sizeof(StatisticsResult));
+    result.total         = basic_stats.getTotal();
+    result.ave           = basic_stats.getMean();
+    result.variance      = basic_stats.getVariance();
+    result.min           = basic_stats.getMin();
+    result.max           = basic_stats.getMax();
+    result.median        = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.5);
+    result.pct_1         = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.01);
+    result.pct_10        = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.1);
+    result.pct_90        = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.9);
+    result.pct_99        = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.95);
+    result.pct_999       = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.999);
+    result.pct_9999      = hebench::Utilities::Math::computePercentile(sorted_data.data(), sorted_data.size(), 0.9999);
+    result.ave_trim      = trimmed_stats.getMean();
+    result.variance_trim = trimmed_stats.getVariance();
+    return result;
+}
+
+void testWeightedStats(std::uint64_t seed, std::size_t event_count, std::uint64_t max_sample_count)
+{
+    constexpr std::uint32_t EventID = 3;
+
+    std::mt19937_64 rand(seed);
+    std::uniform_int_distribution<std::uint64_t> rand_samples(1, max_sample_count);
+    // few distinct values so that ties occur often
+    std::uniform_int_distribution<int> rand_time(1, 40);
+
+    cpp::TimingReport report;
+    report.addEventType(EventID, "Operation", true);
+    std::vector<double> expanded_wall;
+    std::vector<double> expanded_cpu;
+    for (std::size_t event_i = 0; event_i < event_count; ++event_i)
+    {
+        TimingReportEventC event;
+        std::memset(&event, 0, sizeof(TimingReportEventC));
+        event.event_type_id           = EventID;
+        event.wall_time_start         = 100.0 * event_i;
+        event.wall_time_end           = event.wall_time_start + rand_time(rand);
+        event.cpu_time_start          = 100.0 * event_i;
+        event.cpu_time_end            = event.cpu_time_start + rand_time(rand);
+        event.time_interval_ratio_num = 1;
+        event.time_interval_ratio_den = 1000;
+        event.input_sample_count      = rand_samples(rand);
+        report.addEvent(event);
+
+        double wall_time = cpp::TimingReport::computeElapsedWallTime(event) / event.input_sample_count;
+        double cpu_time  = cpp::TimingReport::computeElapsedCPUTime(event) / event.input_sample_count;
+        expanded_wall.insert(expanded_wall.end(), event.input_sample_count, wall_time);
+        expanded_cpu.insert(expanded_cpu.end(), event.input_sample_count, cpu_time);
+    } // end for
+
+    ReportStats report_stats(report);
+    check(!report_stats.isSketched(), "Exact statistics expected.");
+    const ReportEventTypeStats &stats = report_stats.getEventTypeStatsByID(EventID);
+    StatisticsResult wall             = computeExpandedStats(expanded_wall);
+    StatisticsResult cpu              = computeExpandedStats(expanded_cpu);
+
+    check(stats.input_sample_count == expanded_wall.size(), "Input sample count does not match.");
+    checkNear(stats.total_time, wall.total, "Total time");
+    checkNear(stats.wall_time_ave, wall.ave, "Wall average");
+    checkNear(stats.wall_time_variance, wall.variance, "Wall variance");
+    checkEqual(stats.wall_time_min, wall.min, "Wall minimum");
+    checkEqual(stats.wall_time_max, wall.max, "Wall maximum");
+    checkEqual(stats.wall_time_median, wall.median, "Wall median");
+    checkEqual(stats.wall_time_1, wall.pct_1, "Wall 1-th percentile");
+    checkEqual(stats.wall_time_10, wall.pct_10, "Wall 10-th percentile");
+    checkEqual(stats.wall_time_90, wall.pct_90, "Wall 90-th percentile");
+    checkEqual(stats.wall_time_99, wall.pct_99, "Wall 99-th percentile");
+    checkEqual(stats.wall_time_999, wall.pct_999, "Wall 99.9-th percentile");
+    checkEqual(stats.wall_time_9999, wall.pct_9999, "Wall 99.99-th percentile");
+    checkNear(stats.wall_time_ave_trim, wall.ave_trim, "Wall trimmed average");
+    checkNear(stats.wall_time_variance_trim, wall.variance_trim, "Wall trimmed variance");
+    checkNear(stats.cpu_time_ave, cpu.ave, "CPU average");
+    checkNear(stats.cpu_time_variance, cpu.variance, "CPU variance");
+    checkEqual(stats.cpu_time_median, cpu.median, "CPU median");
+    checkEqual(stats.cpu_time_1, cpu.pct_1, "CPU 1-th percentile");
+    checkEqual(stats.cpu_time_90, cpu.pct_90, "CPU 90-th percentile");
+    checkEqual(stats.cpu_time_9999, cpu.pct_9999, "CPU 99.99-th percentile");
+    checkNear(stats.cpu_time_ave_trim, cpu.ave_trim, "CPU trimmed average");
+}
+
+void testUnweightedStats()
+{
+    // unweighted events must match the expanded computation trivially
+    testWeightedStats(1, 500, 1);
+}
+
+void testRandomWeightedStats()
+{
+    // weighted events, including tiny reports where interpolation matters most
+    for (std::uint64_t seed = 2; seed < 40; ++seed)
+        testWeightedStats(seed, 1 + seed % 7, 5);
+    for (std::uint64_t seed = 40; seed < 60; ++seed)
+        testWeightedStats(seed, 1000, 100);
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testUnweightedStats,
+                                         testRandomWeightedStats });
+}
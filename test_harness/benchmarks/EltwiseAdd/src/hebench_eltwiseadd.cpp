@@ -186,9 +186,17 @@ DataLoader::Ptr DataLoader::create(std::uint64_t vector_size,
                                    std::uint64_t batch_size_b,
                                    hebench::APIBridge::DataType data_type)
 {
-    DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
-    retval->init(vector_size, batch_size_a, batch_size_b, data_type);
-    return retval;
+    DataLoaderCache::Key key;
+    key.workload        = "EltwiseAdd";
+    key.data_type       = data_type;
+    key.workload_params = { vector_size };
+    key.sample_sizes    = { batch_size_a, batch_size_b };
+
+    return DataLoaderCache::getDataLoader<DataLoader>(key, [&]() {
+        DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
+        retval->init(vector_size, batch_size_a, batch_size_b, data_type);
+        return retval;
+    });
 }
 
 DataLoader::Ptr DataLoader::create(std::uint64_t expected_vector_size,
@@ -197,9 +205,18 @@ DataLoader::Ptr DataLoader::create(std::uint64_t expected_vector_size,
                                    hebench::APIBridge::DataType data_type,
                                    const std::string &dataset_filename)
 {
-    DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
-    retval->init(expected_vector_size, max_batch_size_a, max_batch_size_b, data_type, dataset_filename);
-    return retval;
+    DataLoaderCache::Key key;
+    key.workload         = "EltwiseAdd";
+    key.data_type        = data_type;
+    key.workload_params  = { expected_vector_size };
+    key.sample_sizes     = { max_batch_size_a, max_batch_size_b };
+    key.dataset_filename = dataset_filename;
+
+    return DataLoaderCache::getDataLoader<DataLoader>(key, [&]() {
+        DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
+        retval->init(expected_vector_size, max_batch_size_a, max_batch_size_b, data_type, dataset_filename);
+        return retval;
+    });
 }
 
 DataLoader::DataLoader() :
@@ -232,7 +249,7 @@ void DataLoader::init(std::uint64_t vector_size,
                             sample_vector_sizes.data(), // vector size for each parameter
                             OutputDim0, // number of result components
                             sample_vector_sizes.data() + InputDim0, // number of result samples
-                            true); // allocate memory for ground truth?
+                            !isLazyResults()); // allocate memory for ground truth?
 
     // at this point all NativeDataBuffers have been allocated and pointed to the correct locations
 
@@ -246,28 +263,17 @@ void DataLoader::init(std::uint64_t vector_size,
             // generate the data
             DataGeneratorHelper::generateRandomVectorU(data_type,
                                                        getParameterData(vector_i).p_buffers[i].p,
-                                                       vector_size, -10.0, 10.0);
+                                                       vector_size, -10.0, 10.0,
+                                                       vector_i, i);
         } // end for
     } // end for
 
     // output
-    //#pragma omp parallel for collapse(2)
-    for (std::uint64_t a_i = 0; a_i < batch_sizes[0]; ++a_i)
+    if (!isLazyResults())
     {
-        for (std::uint64_t b_i = 0; b_i < batch_sizes[1]; ++b_i)
-        {
-            // find the index for the result buffer based on the input indices
-            std::uint64_t ppi[] = { a_i, b_i };
-            std::uint64_t r_i   = getResultIndex(ppi);
-
-            // generate the data
-            DataGeneratorHelper::vectorEltwiseAdd(data_type,
-                                                  getResultData(0).p_buffers[r_i].p, // C
-                                                  getParameterData(0).p_buffers[a_i].p, // A
-                                                  getParameterData(1).p_buffers[b_i].p, // B
-                                                  vector_size);
-        } // end for
-    } // end for
+        // compute all ground truths now; otherwise, computed on demand
+        computeResults();
+    } // end if
 
     // all data has been generated at this point
 }
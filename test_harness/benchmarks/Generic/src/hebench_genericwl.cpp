@@ -134,9 +134,21 @@ DataLoader::Ptr DataLoader::create(const std::vector<std::uint64_t> &input_sizes
                                    hebench::APIBridge::DataType data_type,
                                    const std::string &dataset_filename)
 {
-    DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
-    retval->init(input_sizes, max_batch_sizes, output_sizes, data_type, dataset_filename);
-    return retval;
+    DataLoaderCache::Key key;
+    key.workload         = "GenericWL";
+    key.data_type        = data_type;
+    key.sample_sizes     = max_batch_sizes;
+    key.dataset_filename = dataset_filename;
+    // input and output sample sizes identify the shape of the generic workload
+    key.workload_params.push_back(input_sizes.size());
+    key.workload_params.insert(key.workload_params.end(), input_sizes.begin(), input_sizes.end());
+    key.workload_params.insert(key.workload_params.end(), output_sizes.begin(), output_sizes.end());
+
+    return DataLoaderCache::getDataLoader<DataLoader>(key, [&]() {
+        DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
+        retval->init(input_sizes, max_batch_sizes, output_sizes, data_type, dataset_filename);
+        return retval;
+    });
 }
 
 DataLoader::DataLoader()
@@ -296,9 +296,17 @@ DataLoader::Ptr DataLoader::create(PolynomialDegree polynomial_degree,
                                    std::uint64_t batch_size_input,
                                    hebench::APIBridge::DataType data_type)
 {
-    DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
-    retval->init(polynomial_degree, vector_size, batch_size_input, data_type);
-    return retval;
+    DataLoaderCache::Key key;
+    key.workload        = "LogisticRegression";
+    key.data_type       = data_type;
+    key.workload_params = { static_cast<std::uint64_t>(polynomial_degree), vector_size };
+    key.sample_sizes    = { batch_size_input };
+
+    return DataLoaderCache::getDataLoader<DataLoader>(key, [&]() {
+        DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
+        retval->init(polynomial_degree, vector_size, batch_size_input, data_type);
+        return retval;
+    });
 }
 
 DataLoader::Ptr DataLoader::create(PolynomialDegree polynomial_degree,
@@ -307,9 +315,18 @@ DataLoader::Ptr DataLoader::create(PolynomialDegree polynomial_degree,
                                    hebench::APIBridge::DataType data_type,
                                    const std::string &dataset_filename)
 {
-    DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
-    retval->init(polynomial_degree, vector_size, batch_size_input, data_type, dataset_filename);
-    return retval;
+    DataLoaderCache::Key key;
+    key.workload         = "LogisticRegression";
+    key.data_type        = data_type;
+    key.workload_params  = { static_cast<std::uint64_t>(polynomial_degree), vector_size };
+    key.sample_sizes     = { batch_size_input };
+    key.dataset_filename = dataset_filename;
+
+    return DataLoaderCache::getDataLoader<DataLoader>(key, [&]() {
+        DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
+        retval->init(polynomial_degree, vector_size, batch_size_input, data_type, dataset_filename);
+        return retval;
+    });
 }
 
 DataLoader::DataLoader() :
@@ -352,7 +369,7 @@ void DataLoader::init(PolynomialDegree polynomial_degree,
                             vector_sample_sizes, // number of elements in each vector of the input
                             OutputDim0, // number of output components
                             vector_sample_sizes + InputDim0, // number of elements in each vector of the output
-                            true); // allocate memory for results?
+                            !isLazyResults()); // allocate memory for results?
 
     // at this point all NativeDataBuffers have been allocated and pointed to the correct locations
 
@@ -367,26 +384,17 @@ void DataLoader::init(PolynomialDegree polynomial_degree,
             DataGeneratorHelper::generateRandomVectorN(data_type,
                                                        getParameterData(vector_i).p_buffers[i].p,
                                                        getParameterData(vector_i).p_buffers[i].size / PartialDataLoader::sizeOf(data_type),
-                                                       0.0, 1.0);
+                                                       0.0, 1.0,
+                                                       vector_i, i);
         } // end for
     } // end for
 
     // output
-    //#pragma omp parallel for
-    for (std::uint64_t input_i = 0; input_i < batch_sizes[2]; ++input_i)
+    if (!isLazyResults())
     {
-        // find the index for the result buffer based on the input indices
-        std::uint64_t ppi[] = { 0, 0, input_i };
-        std::uint64_t r_i   = getResultIndex(ppi);
-
-        // generate the data
-        DataGeneratorHelper::logisticRegressionInference(data_type, polynomial_degree,
-                                                         getResultData(0).p_buffers[r_i].p, // result
-                                                         getParameterData(Index_W).p_buffers[0].p, // W
-                                                         getParameterData(Index_b).p_buffers[0].p, // b
-                                                         getParameterData(Index_X).p_buffers[input_i].p, // X
-                                                         vector_size);
-    } // end for
+        // compute all ground truths now; otherwise, computed on demand
+        computeResults();
+    } // end if
 
     // all data has been generated at this point
 }
@@ -2,6 +2,7 @@
 // Copyright (C) 2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <stdexcept>
@@ -127,7 +128,8 @@ private:
 public:
     static void generateRandomMatrixN(hebench::APIBridge::DataType data_type,
                                       void *mat_result, std::uint64_t rows, std::uint64_t cols,
-                                      double mean, double stddev);
+                                      double mean, double stddev,
+                                      std::uint64_t param_index, std::uint64_t sample_index);
     static void matMul(hebench::APIBridge::DataType data_type,
                        void *mat_result, const void *mat_a, const void *mat_b,
                        std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b);
@@ -136,6 +138,70 @@ protected:
     DataGeneratorHelper() {}
 
 private:
+    // register tile: rows of A by columns of B accumulated in local variables
+    static constexpr std::uint64_t TileRows = 4;
+    template <class T>
+    static constexpr std::uint64_t TileCols = 64 / sizeof(T);
+    // cache blocks: a block of B of BlockDepth rows by BlockCols<T> columns fits in L2
+    static constexpr std::uint64_t BlockDepth = 256;
+    template <class T>
+    static constexpr std::uint64_t BlockCols = (256 * 1024) / (BlockDepth * sizeof(T)) / TileCols<T> * TileCols<T>;
+
+    /**
+     * @brief Accumulates the product of a tile of A by a tile of B into the
+     * corresponding tile of the result.
+     * @details Tile is `rows` by `cols` elements with top-left corner at `(row_a, col_b)`,
+     * and the product covers columns of A `[col_a_begin, col_a_end)`. When `rows` and
+     * `cols` match the register tile size, compiler fully unrolls and vectorizes the
+     * inner loops. Each element of the result is accumulated in increasing order of
+     * `col_a`, independently of the tiling, so, results are deterministic.
+     */
+    template <class T, std::uint64_t rows, std::uint64_t cols>
+    static void matMulTile(T *mat_result, const T *mat_a, const T *mat_b,
+                           std::uint64_t cols_a, std::uint64_t cols_b,
+                           std::uint64_t row_a, std::uint64_t col_b,
+                           std::uint64_t col_a_begin, std::uint64_t col_a_end)
+    {
+        T acc[rows][cols];
+        for (std::uint64_t r = 0; r < rows; ++r)
+            for (std::uint64_t c = 0; c < cols; ++c)
+                acc[r][c] = mat_result[(row_a + r) * cols_b + col_b + c];
+        for (std::uint64_t col_a = col_a_begin; col_a < col_a_end; ++col_a)
+        {
+            const T *p_row_b = mat_b + col_a * cols_b + col_b;
+            for (std::uint64_t r = 0; r < rows; ++r)
+            {
+                T a = mat_a[(row_a + r) * cols_a + col_a];
+                for (std::uint64_t c = 0; c < cols; ++c)
+                    acc[r][c] += a * p_row_b[c];
+            } // end for
+        } // end for
+        for (std::uint64_t r = 0; r < rows; ++r)
+            for (std::uint64_t c = 0; c < cols; ++c)
+                mat_result[(row_a + r) * cols_b + col_b + c] = acc[r][c];
+    }
+
+    /**
+     * @brief Same as the fixed size matMulTile(), for tiles at the edges of the
+     * result, smaller than the register tile.
+     */
+    template <class T>
+    static void matMulTile(T *mat_result, const T *mat_a, const T *mat_b,
+                           std::uint64_t cols_a, std::uint64_t cols_b,
+                           std::uint64_t row_a, std::uint64_t col_b,
+                           std::uint64_t col_a_begin, std::uint64_t col_a_end,
+                           std::uint64_t rows, std::uint64_t cols)
+    {
+        for (std::uint64_t r = 0; r < rows; ++r)
+            for (std::uint64_t c = 0; c < cols; ++c)
+            {
+                T acc = mat_result[(row_a + r) * cols_b + col_b + c];
+                for (std::uint64_t col_a = col_a_begin; col_a < col_a_end; ++col_a)
+                    acc += mat_a[(row_a + r) * cols_a + col_a] * mat_b[col_a * cols_b + col_b + c];
+                mat_result[(row_a + r) * cols_b + col_b + c] = acc;
+            } // end for
+    }
+
     template <class T>
     static void matMul(T *mat_result, const T *mat_a, const T *mat_b,
                        std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b)
@@ -146,28 +212,51 @@ private:
             throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid null `mat_a`"));
         if (!mat_b)
             throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid null `mat_b`"));
-        // perform matrix multiplication (straight-forward way,
-        // maybe optimize later)
-        for (std::uint64_t row_a = 0; row_a < rows_a; ++row_a)
-            for (std::uint64_t col_b = 0; col_b < cols_b; ++col_b)
+
+        // perform blocked matrix multiplication:
+        // each element of the result is the sum of products in increasing order of
+        // columns of A, same as the straight-forward triple loop, so, floating point
+        // results do not depend on the block sizes
+        std::fill(mat_result, mat_result + rows_a * cols_b, static_cast<T>(0));
+        for (std::uint64_t block_col_b = 0; block_col_b < cols_b; block_col_b += BlockCols<T>)
+        {
+            std::uint64_t block_col_b_end = std::min(block_col_b + BlockCols<T>, cols_b);
+            for (std::uint64_t block_col_a = 0; block_col_a < cols_a; block_col_a += BlockDepth)
             {
-                mat_result[row_a * cols_b + col_b] = 0;
-                for (std::uint64_t col_a = 0; col_a < cols_a; ++col_a)
+                std::uint64_t block_col_a_end = std::min(block_col_a + BlockDepth, cols_a);
+                for (std::uint64_t row_a = 0; row_a < rows_a; row_a += TileRows)
                 {
-                    std::uint64_t row_b = col_a;
-                    mat_result[row_a * cols_b + col_b] += mat_a[row_a * cols_a + col_a] * mat_b[row_b * cols_b + col_b];
+                    std::uint64_t tile_rows = std::min(TileRows, rows_a - row_a);
+                    for (std::uint64_t col_b = block_col_b; col_b < block_col_b_end; col_b += TileCols<T>)
+                    {
+                        std::uint64_t tile_cols = std::min(TileCols<T>, block_col_b_end - col_b);
+                        if (tile_rows == TileRows && tile_cols == TileCols<T>)
+                            matMulTile<T, TileRows, TileCols<T>>(mat_result, mat_a, mat_b,
+                                                                 cols_a, cols_b,
+                                                                 row_a, col_b,
+                                                                 block_col_a, block_col_a_end);
+                        else
+                            matMulTile<T>(mat_result, mat_a, mat_b,
+                                          cols_a, cols_b,
+                                          row_a, col_b,
+                                          block_col_a, block_col_a_end,
+                                          tile_rows, tile_cols);
+                    } // end for
                 } // end for
             } // end for
+        } // end for
     }
 };
 
 void DataGeneratorHelper::generateRandomMatrixN(APIBridge::DataType data_type,
                                                 void *mat_result, std::uint64_t rows, std::uint64_t cols,
-                                                double mean, double stddev)
+                                                double mean, double stddev,
+                                                std::uint64_t param_index, std::uint64_t sample_index)
 {
     hebench::TestHarness::DataGeneratorHelper::generateRandomVectorN(data_type,
                                                                      mat_result, rows * cols,
-                                                                     mean, stddev);
+                                                                     mean, stddev,
+                                                                     param_index, sample_index);
 }
 
 void DataGeneratorHelper::matMul(hebench::APIBridge::DataType data_type,
@@ -216,9 +305,17 @@ DataLoader::Ptr DataLoader::create(std::uint64_t rows_a, std::uint64_t cols_a, s
                                    std::uint64_t batch_size_mat_b,
                                    hebench::APIBridge::DataType data_type)
 {
-    DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
-    retval->init(rows_a, cols_a, cols_b, batch_size_mat_a, batch_size_mat_b, data_type);
-    return retval;
+    DataLoaderCache::Key key;
+    key.workload        = "MatrixMultiply";
+    key.data_type       = data_type;
+    key.workload_params = { rows_a, cols_a, cols_b };
+    key.sample_sizes    = { batch_size_mat_a, batch_size_mat_b };
+
+    return DataLoaderCache::getDataLoader<DataLoader>(key, [&]() {
+        DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
+        retval->init(rows_a, cols_a, cols_b, batch_size_mat_a, batch_size_mat_b, data_type);
+        return retval;
+    });
 }
 
 DataLoader::Ptr DataLoader::create(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b,
@@ -227,12 +324,21 @@ DataLoader::Ptr DataLoader::create(std::uint64_t rows_a, std::uint64_t cols_a, s
                                    hebench::APIBridge::DataType data_type,
                                    const std::string &dataset_filename)
 {
-    DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
-    retval->init(rows_a, cols_a, cols_b,
-                 expected_sample_size_mat_a, expected_sample_size_mat_b,
-                 data_type,
-                 dataset_filename);
-    return retval;
+    DataLoaderCache::Key key;
+    key.workload         = "MatrixMultiply";
+    key.data_type        = data_type;
+    key.workload_params  = { rows_a, cols_a, cols_b };
+    key.sample_sizes     = { expected_sample_size_mat_a, expected_sample_size_mat_b };
+    key.dataset_filename = dataset_filename;
+
+    return DataLoaderCache::getDataLoader<DataLoader>(key, [&]() {
+        DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
+        retval->init(rows_a, cols_a, cols_b,
+                     expected_sample_size_mat_a, expected_sample_size_mat_b,
+                     data_type,
+                     dataset_filename);
+        return retval;
+    });
 }
 
 DataLoader::DataLoader() :
@@ -277,7 +383,7 @@ void DataLoader::init(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t
     PartialDataLoader::init(data_type,
                             InputDim0, batch_sizes, sample_vector_sizes,
                             OutputDim0, sample_vector_sizes + InputDim0,
-                            true);
+                            !isLazyResults());
 
     // at this point all NativeDataBuffers have been allocated and pointed to the correct locations
 
@@ -293,29 +399,17 @@ void DataLoader::init(std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t
                                                        getParameterData(mat_i).p_buffers[i].p,
                                                        mat_dims[mat_i].first, // rows
                                                        mat_dims[mat_i].second, // columns
-                                                       0.0, 10.0);
+                                                       0.0, 10.0,
+                                                       mat_i, i);
         } // end for
     } // end for
 
     // output
-    //#pragma omp parallel for collapse(2)
-    for (std::uint64_t m0_i = 0; m0_i < batch_sizes[0]; ++m0_i)
+    if (!isLazyResults())
     {
-        for (std::uint64_t m1_i = 0; m1_i < batch_sizes[1]; ++m1_i)
-        {
-            // find the index for the result buffer based on the input indices
-            std::uint64_t ppi[] = { m0_i, m1_i };
-            std::uint64_t r_i   = getResultIndex(ppi);
-
-            // generate the data
-            DataGeneratorHelper::matMul(data_type,
-                                        getResultData(0).p_buffers[r_i].p,
-                                        getParameterData(0).p_buffers[m0_i].p,
-                                        getParameterData(1).p_buffers[m1_i].p,
-                                        mat_dims[0].first, mat_dims[0].second, // dims for m0
-                                        mat_dims[1].second); // dims for m1
-        } // end for
-    } // end for
+        // compute all ground truths now; otherwise, computed on demand
+        computeResults();
+    } // end if
 
     // all data has been generated at this point
 }
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <utility>
@@ -19,7 +20,9 @@
 #include "hebench/api_bridge/types.h"
 
 #include "benchmarks/datagen_helper/include/datagen_helper.h"
+#include "include/hebench_benchmark_description.h"
 #include "include/hebench_benchmark_factory.h"
+#include "include/hebench_utilities_harness.h"
 
 namespace hebench {
 namespace TestHarness {
@@ -111,15 +114,43 @@ private:
 
 template <typename T>
 /**
-* @brief Finds whether values in two arrays are within a certain percentage of each other.
-* @param[in] a Pointer to start of first array to compare.
-* @param[in] b Pointer to start of second array to compare.
-* @param[in] element_count Number of elements in array \p a.
+* @brief Finds whether two collections of items hold the same items, in any order.
+* @param[in] X Pointer to start of first collection to compare (ground truth).
+* @param[in] Y Pointer to start of second collection to compare.
+* @param[in] n Number of items in \p X.
+* @param[in] m Number of items in \p Y.
+* @param[in] k Number of elements per item.
+* @param[in] tolerance Tolerance for the comparison of elements.
+* @param[out] p_stats If not null, the error statistics of the elements of items
+* in \p Y with respect to the elements of their matches in \p X are merged into the
+* object pointed. Items without a match are not included.
+* @return A vector of pairs where each pair identifies an item that has no match in the
+* other collection: `first` is `true` if the item is in \p X, `false` if it is in \p Y;
+* `second` is the index of the item. Items in \p X are listed first, in increasing order
+* of index. The return vector is empty if both collections hold the same items.
+* @details Collections are compared as multisets: each item in one collection is
+* matched with, at most, one item in the other. Items are matched exactly first, using a
+* hash multiset, in expected linear time. Items left without exact match are then matched
+* if all of their elements are within \p tolerance of each other: candidates for each
+* item are found by quantizing its first element into buckets, and the exact matching
+* is extended into a maximum matching with augmenting paths. Thus, an item is never
+* reported as mismatched because a greedy or exact match took its only candidate.
+*
+* Elements are within tolerance as defined by `isMemberOf()`.
+*/
+typename std::enable_if<std::is_integral<T>::value
+                            || std::is_floating_point<T>::value,
+                        std::vector<std::pair<bool, std::uint64_t>>>::type
+almostEqualSet(const T *X, const T *Y,
+               std::uint64_t n, std::uint64_t m, std::uint64_t k,
+               const BenchmarkDescription::ValidationTolerance &tolerance,
+               hebench::Utilities::ValidationErrorStats *p_stats = nullptr);
+template <typename T>
+/**
+* @brief Finds whether two collections of items hold the same items, in any order,
+* with a relative tolerance of \p pct .
 * @param[in] pct Per-one for comparison: this is percent divided by 100.
-* @return A vector of `uint64` where each element in this vector is the index of the
-* values in \p a and \p b that were not within \p pct * 100 of each other. The return
-* vector is empty if all values were within range of each other.
-* @details Parameter \p a must hold, at least, \p count elements.
+* @details Equivalent to `almostEqualSet()` with a relative tolerance of \p pct .
 */
 typename std::enable_if<std::is_integral<T>::value
                             || std::is_floating_point<T>::value,
@@ -130,14 +161,32 @@ almostEqualSet(const T *X, const T *Y,
 
 template <typename T>
 /**
-* @brief Finds whether values in two arrays are within a certain percentage of each other.
-* @param[in] a Pointer to start of the array.
-* @param[in] element value to be found in a.
-* @param[in] element_count Number of elements in array \p a.
-* @param[in] item_count Number of items per element in array \p a.
+* @brief Finds whether an item is within tolerance of any item in a collection.
+* @param[in] dataset Pointer to start of the collection of items.
+* @param[in] value Item to be found in \p dataset.
+* @param[in] n Number of items in \p dataset.
+* @param[in] k Number of elements per item.
+* @param[in] tolerance Tolerance for the comparison of elements.
+* @return Returns a `boolean` `true` if all elements of \p value are within
+* \p tolerance of the elements of an item in \p dataset, `false` otherwise.
+* @details Two elements `a` and `b` are within tolerance if they compare equal or if
+* they are within any of the criteria of \p tolerance :
+*
+* - Relative: `|a - b| <= relative * max(|a|, |b|)`.
+* - Absolute: `|a - b| <= absolute`.
+* - ULP: there are, at most, `ulp` representable values between `a` and `b`, as
+* counted by `hebench::Utilities::getOrderedBits()`. NaN is not within any distance.
+*/
+typename std::enable_if<std::is_integral<T>::value
+                            || std::is_floating_point<T>::value,
+                        bool>::type
+isMemberOf(const T *dataset, const T *value, std::size_t n, std::size_t k,
+           const BenchmarkDescription::ValidationTolerance &tolerance);
+template <typename T>
+/**
+* @brief Finds whether an item is within a certain percentage of any item in a collection.
 * @param[in] pct Per-one for comparison: this is percent divided by 100.
-* @return Returns a `boolean` `true` if \p element is a member of \p a, `false` otherwise.
-* @details Parameter \p a must hold, at least, \p count elements.
+* @details Equivalent to `isMemberOf()` with a relative tolerance of \p pct .
 */
 typename std::enable_if<std::is_integral<T>::value
                             || std::is_floating_point<T>::value,
@@ -145,82 +194,20 @@ typename std::enable_if<std::is_integral<T>::value
 isMemberOf(const T *dataset, const T *value, std::size_t n, std::size_t k,
            double pct = 0.05);
 
+/**
+ * @brief Validates a set intersection result against its ground truth as a multiset.
+ * @param[in] tolerance Tolerance for the comparison of elements.
+ * @param[out] p_stats If not null, the error statistics of the result are merged
+ * into the object pointed.
+ * @sa almostEqualSet()
+ */
 bool validateResult(IDataLoader::Ptr dataset,
                     const std::uint64_t *param_data_pack_indices,
                     const std::vector<hebench::APIBridge::NativeDataBuffer *> &p_outputs,
                     std::uint64_t k_count,
-                    hebench::APIBridge::DataType data_type);
-
-// Simple Set Intersection inline impl.
-
-template <typename T>
-typename std::enable_if<std::is_integral<T>::value
-                            || std::is_floating_point<T>::value,
-                        bool>::type
-isMemberOf(const T *dataset, const T *value, std::size_t n, std::size_t k,
-           double pct)
-{
-    bool retval = false;
-    for (size_t i = 0; !retval && i < n; ++i)
-    {
-        std::uint64_t members = 0;
-        bool flag             = true;
-        for (size_t j = 0; flag && j < k; ++j)
-        {
-            flag = hebench::Utilities::Math::almostEqual(dataset[(i * k) + j], value[j], pct);
-            if (flag)
-            {
-                ++members;
-            }
-        }
-        retval = members == k;
-    }
-    return retval;
-}
-
-template <typename T>
-typename std::enable_if<std::is_integral<T>::value
-                            || std::is_floating_point<T>::value,
-                        std::vector<std::pair<bool, std::uint64_t>>>::type
-almostEqualSet(const T *X, const T *Y,
-               std::uint64_t n, std::uint64_t m, std::uint64_t k,
-               double pct)
-{
-    std::vector<std::pair<bool, std::uint64_t>> retval;
-    retval.reserve(n + m);
-    if (X != Y)
-    {
-        if (!X)
-        {
-            // X has no elements
-            for (std::uint64_t i = 0; i < m; ++i)
-                retval.push_back(std::pair(false, i));
-        } // end if
-        else if (!Y)
-        {
-            // Y has no elements
-            for (std::uint64_t i = 0; i < n; ++i)
-                retval.push_back(std::pair(true, i));
-        } // end else if
-        else
-        {
-            // check if X c Y
-            for (std::uint64_t i = 0; i < n; ++i)
-            {
-                if (!isMemberOf(Y, X + (i * k), m, k, pct))
-                    retval.push_back(std::pair(true, i));
-            } // end for
-            // check if Y c X
-            for (std::uint64_t i = 0; i < m; ++i)
-            {
-                if (!isMemberOf(X, Y + (i * k), n, k, pct))
-                    retval.push_back(std::pair(false, i));
-            } // end for
-            // if retval.empty(), then X == Y
-        } // end else
-    } // end if
-    return retval;
-}
+                    hebench::APIBridge::DataType data_type,
+                    const BenchmarkDescription::ValidationTolerance &tolerance,
+                    hebench::Utilities::ValidationErrorStats *p_stats = nullptr);
 
 } // namespace SimpleSetIntersection
 } // namespace TestHarness
@@ -193,11 +193,16 @@ bool Benchmark::validateResult(IDataLoader::Ptr dataset,
     assert(dataset->getParameterCount() == BenchmarkDescriptorCategory::OpParameterCount
            && dataset->getResultCount() == BenchmarkDescriptorCategory::OpResultCount);
 
-    return hebench::TestHarness::SimpleSetIntersection::validateResult(dataset,
-                                                                       param_data_pack_indices,
-                                                                       outputs,
-                                                                       m_k_count,
-                                                                       data_type);
+    hebench::Utilities::ValidationErrorStats stats;
+    bool retval = hebench::TestHarness::SimpleSetIntersection::validateResult(dataset,
+                                                                              param_data_pack_indices,
+                                                                              outputs,
+                                                                              m_k_count,
+                                                                              data_type,
+                                                                              this->getBenchmarkConfiguration().validation_tolerance,
+                                                                              &stats);
+    mergeValidationStats(stats);
+    return retval;
 }
 
 } // namespace Offline
@@ -3,9 +3,14 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <cassert>
+#include <cmath>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "../include/hebench_simple_set_intersection.h"
@@ -15,6 +20,219 @@ namespace hebench {
 namespace TestHarness {
 namespace SimpleSetIntersection {
 
+//-------------------
+// Set item helpers
+//-------------------
+
+namespace {
+
+typedef hebench::TestHarness::BenchmarkDescription::ValidationTolerance ValidationTolerance;
+
+/**
+ * @brief Finds whether two elements are within a single criterion of a tolerance.
+ * @details This is the predicate that ItemBucket quantizes: any pair of elements
+ * for which it returns `true` falls in the same or neighbor buckets. Elements that
+ * compare equal are always within tolerance. Otherwise, infinite values are not
+ * within relative or absolute tolerance of any other value, and NaN is not within
+ * tolerance of any value.
+ * @sa isMemberOf()
+ */
+template <typename T>
+bool isWithinCriterion(T a, T b, const ValidationTolerance &tolerance, ValidationTolerance::Model criterion)
+{
+    if (a == b)
+        return true;
+    double x = static_cast<double>(a);
+    double y = static_cast<double>(b);
+    switch (criterion)
+    {
+    case ValidationTolerance::Model::Relative:
+        return std::isfinite(x) && std::isfinite(y)
+               && std::abs(x - y) <= tolerance.relative * std::max(std::abs(x), std::abs(y));
+
+    case ValidationTolerance::Model::Absolute:
+        return std::isfinite(x) && std::isfinite(y)
+               && std::abs(x - y) <= tolerance.absolute;
+
+    default:
+    {
+        if (std::isnan(x) || std::isnan(y))
+            return false;
+        std::uint64_t bits_a = hebench::Utilities::getOrderedBits(a);
+        std::uint64_t bits_b = hebench::Utilities::getOrderedBits(b);
+        return (bits_a > bits_b ? bits_a - bits_b : bits_b - bits_a) <= tolerance.ulp;
+    }
+    } // end switch
+}
+
+/**
+ * @brief Finds whether two elements are within tolerance: for `Model::Mixed`,
+ * elements are within tolerance if they are within any of its criteria.
+ */
+template <typename T>
+bool isWithinTolerance(T a, T b, const ValidationTolerance &tolerance)
+{
+    if (tolerance.model != ValidationTolerance::Model::Mixed)
+        return isWithinCriterion(a, b, tolerance, tolerance.model);
+    return isWithinCriterion(a, b, tolerance, ValidationTolerance::Model::Relative)
+           || isWithinCriterion(a, b, tolerance, ValidationTolerance::Model::Absolute)
+           || isWithinCriterion(a, b, tolerance, ValidationTolerance::Model::ULP);
+}
+
+/**
+ * @brief Hash function for set items to use as keys in unordered containers.
+ * @details Keys are pointers to the first element of an item of `k` contiguous
+ * elements. Items are not copied, so, pointed memory must outlive the container.
+ * Elements that compare equal hash to the same value (`-0.0` and `0.0` included).
+ */
+template <typename T>
+class ItemHash
+{
+public:
+    ItemHash(std::uint64_t k) :
+        m_k(k) {}
+    std::size_t operator()(const T *item) const
+    {
+        std::size_t retval = 0;
+        for (std::uint64_t i = 0; i < m_k; ++i)
+        {
+            std::size_t h = std::hash<T>()(item[i] == static_cast<T>(0) ? static_cast<T>(0) : item[i]);
+            retval ^= h + 0x9e3779b97f4a7c15ULL + (retval << 6) + (retval >> 2);
+        } // end for
+        return retval;
+    }
+
+private:
+    std::uint64_t m_k;
+};
+
+/**
+ * @brief Equality comparison for set items to use as keys in unordered containers.
+ * @details Items are equal if all of their `k` elements compare equal.
+ * @sa ItemHash
+ */
+template <typename T>
+class ItemEqual
+{
+public:
+    ItemEqual(std::uint64_t k) :
+        m_k(k) {}
+    bool operator()(const T *a, const T *b) const { return std::equal(a, a + m_k, b); }
+
+private:
+    std::uint64_t m_k;
+};
+
+/**
+ * @brief Quantizes values into buckets for matching within a tolerance criterion.
+ * @details Any two values within tolerance, as defined by `isWithinCriterion()`,
+ * fall in the same or neighbor buckets, so, only those buckets need probing to find
+ * all candidate matches for a value:
+ *
+ * - Relative: magnitudes are split in logarithmic steps of width `-log(1 - relative)`,
+ * widened slightly to absorb rounding. Values within tolerance,
+ * `|a - b| <= relative * max(|a|, |b|)`, have the same sign. Zero and non-finite
+ * values only match within their own bucket. A tolerance of 1 or more can match
+ * values of different signs: all values then fall in a single bucket.
+ * - Absolute: values are split in linear steps of width `absolute`, widened slightly.
+ * - ULP: the ordered bits of values, as returned by `hebench::Utilities::getOrderedBits()`,
+ * are split in steps of `ulp + 1`. An absolute tolerance of 0 is bucketed as 0 ULP.
+ */
+template <typename T>
+class ItemBucket
+{
+public:
+    /**
+     * @param[in] tolerance Tolerance for matching.
+     * @param[in] criterion Criterion of \p tolerance to bucket. Must not be
+     * `Model::Mixed`: each criterion of a mixed tolerance is bucketed separately.
+     */
+    ItemBucket(const ValidationTolerance &tolerance, ValidationTolerance::Model criterion) :
+        m_criterion(criterion),
+        m_b_single(false),
+        m_width(0.0),
+        m_ulp_span(1),
+        m_neighbor_distance(1)
+    {
+        switch (criterion)
+        {
+        case ValidationTolerance::Model::Relative:
+            m_b_single          = tolerance.relative >= 1.0;
+            m_width             = m_b_single ? 0.0 : -std::log1p(-std::max(tolerance.relative, 0.0)) * (1.0 + 1e-6) + 1e-12;
+            m_neighbor_distance = 2;
+            break;
+
+        case ValidationTolerance::Model::Absolute:
+            m_width = tolerance.absolute * (1.0 + 1e-6);
+            if (!(m_width > 0.0))
+                m_criterion = ValidationTolerance::Model::ULP;
+            break;
+
+        default:
+            m_b_single = tolerance.ulp == std::numeric_limits<std::uint64_t>::max();
+            m_ulp_span = tolerance.ulp + 1;
+            break;
+        } // end switch
+    }
+
+    /**
+     * @brief Bucket key for the specified value.
+     * @param[in] value Value to quantize.
+     * @param[out] has_neighbors Set to `true` if values in buckets `key - getNeighborDistance()`
+     * and `key + getNeighborDistance()` may also match \p value; `false` if only
+     * bucket `key` must be probed.
+     */
+    std::uint64_t operator()(T value, bool &has_neighbors) const
+    {
+        static constexpr std::uint64_t SpecialKey = static_cast<std::uint64_t>(1) << 63;
+
+        has_neighbors = false;
+        if (m_b_single)
+            return 0;
+        if (m_criterion == ValidationTolerance::Model::ULP)
+        {
+            has_neighbors = true;
+            return hebench::Utilities::getOrderedBits(value) / m_ulp_span;
+        } // end if
+
+        double x = static_cast<double>(value);
+        if (!std::isfinite(x))
+            return SpecialKey;
+        if (m_criterion == ValidationTolerance::Model::Absolute)
+        {
+            has_neighbors = true;
+            return static_cast<std::uint64_t>(toBucket(x / m_width));
+        } // end if
+        // relative: keys of the same sign are 2 apart and the sign is in the lowest bit
+        if (x == 0.0)
+            return SpecialKey + 1;
+        has_neighbors = true;
+        return static_cast<std::uint64_t>(toBucket(std::log(std::abs(x)) / m_width) * 2 + (x < 0.0 ? 1 : 0));
+    }
+
+    /**
+     * @brief Distance between the keys of neighbor buckets.
+     */
+    std::uint64_t getNeighborDistance() const { return m_neighbor_distance; }
+
+private:
+    // buckets are clamped far from the special keys: clamping merges buckets at the
+    // ends of the range, which keeps values within tolerance in neighbor buckets
+    static std::int64_t toBucket(double x)
+    {
+        static constexpr double MaxBucket = static_cast<double>(static_cast<std::int64_t>(1) << 60);
+        return static_cast<std::int64_t>(std::clamp(std::floor(x), -MaxBucket, MaxBucket));
+    }
+
+    ValidationTolerance::Model m_criterion;
+    bool m_b_single;
+    double m_width;
+    std::uint64_t m_ulp_span;
+    std::uint64_t m_neighbor_distance;
+};
+
+} // namespace
+
 //------------------------------------
 // class BenchmarkDescriptionCategory
 //------------------------------------
@@ -138,48 +356,42 @@ protected:
 
 private:
     template <class T>
-    static bool isMemberOf(const T *dataset, const T *value, std::uint64_t n, std::uint64_t k)
+    static void mySetIntersection(T *result, const T *dataset_X, const T *dataset_Y, std::uint64_t n, std::uint64_t m, std::uint64_t k)
     {
-        bool retval = false;
-        for (size_t i = 0; !retval && i < n; ++i)
+        typedef std::unordered_set<const T *, ItemHash<T>, ItemEqual<T>> ItemSet;
+
+        // hash the smaller set and iterate over the larger one:
+        // result keeps the order of items in the larger set (Y if both have the same size)
+        if (n <= m)
         {
-            std::uint64_t members = 0;
-            bool flag             = true;
-            for (size_t j = 0; flag && j < k; ++j)
-            {
-                flag = dataset[(i * k) + j] == value[j];
-                if (flag)
-                {
-                    ++members;
-                }
-            }
-            retval = members == k;
-        }
-        return retval;
-    }
+            std::swap(dataset_X, dataset_Y);
+            std::swap(n, m);
+        } // end if
 
-    template <class T>
-    static void mySetIntersection(T *result, const T *dataset_X, const T *dataset_Y, std::uint64_t n, std::uint64_t m, std::uint64_t k)
-    {
         size_t idx_result = 0;
 
         // initialize result with all zeros
         std::fill(result, result + m * k, static_cast<T>(0));
 
+        // hash items in Y (smaller set) for constant time lookup
+        ItemSet set_Y(m, ItemHash<T>(k), ItemEqual<T>(k));
+        for (size_t idx_y = 0; idx_y < m; ++idx_y)
+            set_Y.insert(dataset_Y + (idx_y * k));
+
+        // items already added to result, to skip duplicates in X
+        ItemSet set_result(m, ItemHash<T>(k), ItemEqual<T>(k));
         for (size_t idx_x = 0; idx_x < n; ++idx_x)
         {
-            if (isMemberOf(dataset_Y, dataset_X + (idx_x * k), m, k))
+            const T *p_item_x = dataset_X + (idx_x * k);
+            if (set_Y.count(p_item_x) > 0
+                && set_result.insert(p_item_x).second)
             {
-                // check for duplicates
-                if (!isMemberOf(result, dataset_X + (idx_x * k), m, k))
-                {
-                    std::copy(dataset_X + (idx_x * k),
-                              dataset_X + (idx_x * k) + k,
-                              result + (idx_result * k));
-                    ++idx_result;
-                } // end if
-            }
-        }
+                // result keeps order of items in X
+                std::copy(p_item_x, p_item_x + k,
+                          result + (idx_result * k));
+                ++idx_result;
+            } // end if
+        } // end for
     }
 
     template <class T>
@@ -192,14 +404,7 @@ private:
         if (k == 0)
             throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid null `k`"));
 
-        if (n > m)
-        {
-            mySetIntersection(result, x, y, n, m, k);
-        }
-        else
-        {
-            mySetIntersection(result, y, x, m, n, k);
-        }
+        mySetIntersection(result, x, y, n, m, k);
     }
 };
 
@@ -255,9 +460,17 @@ DataLoader::Ptr DataLoader::create(std::uint64_t set_size_x,
                                    std::uint64_t element_size_k,
                                    hebench::APIBridge::DataType data_type)
 {
-    DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
-    retval->init(set_size_x, set_size_y, batch_size_x, batch_size_y, element_size_k, data_type);
-    return retval;
+    DataLoaderCache::Key key;
+    key.workload        = "SimpleSetIntersection";
+    key.data_type       = data_type;
+    key.workload_params = { set_size_x, set_size_y, element_size_k };
+    key.sample_sizes    = { batch_size_x, batch_size_y };
+
+    return DataLoaderCache::getDataLoader<DataLoader>(key, [&]() {
+        DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
+        retval->init(set_size_x, set_size_y, batch_size_x, batch_size_y, element_size_k, data_type);
+        return retval;
+    });
 }
 
 DataLoader::Ptr DataLoader::create(std::uint64_t set_size_x,
@@ -268,9 +481,18 @@ DataLoader::Ptr DataLoader::create(std::uint64_t set_size_x,
                                    hebench::APIBridge::DataType data_type,
                                    const std::string &dataset_filename)
 {
-    DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
-    retval->init(set_size_x, set_size_y, batch_size_x, batch_size_y, element_size_k, data_type, dataset_filename);
-    return retval;
+    DataLoaderCache::Key key;
+    key.workload         = "SimpleSetIntersection";
+    key.data_type        = data_type;
+    key.workload_params  = { set_size_x, set_size_y, element_size_k };
+    key.sample_sizes     = { batch_size_x, batch_size_y };
+    key.dataset_filename = dataset_filename;
+
+    return DataLoaderCache::getDataLoader<DataLoader>(key, [&]() {
+        DataLoader::Ptr retval = DataLoader::Ptr(new DataLoader());
+        retval->init(set_size_x, set_size_y, batch_size_x, batch_size_y, element_size_k, data_type, dataset_filename);
+        return retval;
+    });
 }
 
 DataLoader::DataLoader() :
@@ -325,65 +547,49 @@ void DataLoader::init(std::uint64_t set_size_x,
         DataGeneratorHelper::generateRandomVectorU(data_type,
                                                    getParameterData(Param_SetX).p_buffers[sample_i].p,
                                                    sample_set_sizes[Param_SetX],
-                                                   -16384.0, 16384.0);
+                                                   -16384.0, 16384.0,
+                                                   Param_SetX, sample_i);
     } // end for
 
     // generate setY data
 
     for (std::uint64_t sample_i = 0; sample_i < batch_sizes[Param_SetY]; ++sample_i)
     {
-        std::vector<std::uint64_t> indices_y = DataGeneratorHelper::generateRandomIntersectionIndicesU(set_size_y);
+        // random choices for this sample come from its own stream, so that the
+        // generated data does not depend on the state of the global random generator
+        CounterBasedRandom::Engine engine = DataGeneratorHelper::createRandomEngine(Param_SetY, sample_i);
+
+        // generate (possibly unique) items for the whole set, then overwrite the common items
+        std::uint8_t *p_setY = reinterpret_cast<std::uint8_t *>(getParameterData(Param_SetY).p_buffers[sample_i].p);
+        DataGeneratorHelper::generateRandomVectorU(data_type,
+                                                   p_setY,
+                                                   sample_set_sizes[Param_SetY],
+                                                   -16384.0, 16384.0,
+                                                   Param_SetY, sample_i);
+
+        std::vector<std::uint64_t> indices_y = DataGeneratorHelper::generateRandomIntersectionIndicesU(set_size_y, 0, engine);
         std::vector<std::uint64_t> indices_x;
-        std::vector<std::uint64_t>::iterator it_indices_y;
         if (!indices_y.empty())
         {
             // if indices_y is empty, there's no point to execute the following statements
-            std::sort(indices_y.begin(), indices_y.end());
             // This will randomly select indices in X, same amount than the ones in indices_y.
-            indices_x    = DataGeneratorHelper::generateRandomIntersectionIndicesU(set_size_x, indices_y.size());
-            it_indices_y = indices_y.begin();
+            indices_x = DataGeneratorHelper::generateRandomIntersectionIndicesU(set_size_x, indices_y.size(), engine);
         }
         // find which sample from X to copy
-        std::uint64_t sample_from_X = DataGeneratorHelper::generateRandomIntU(0, getParameterData(Param_SetX).buffer_count - 1);
+        std::uint64_t sample_from_X = DataGeneratorHelper::generateRandomIntU(0, getParameterData(Param_SetX).buffer_count - 1, engine);
         std::uint8_t *p_setX        = reinterpret_cast<std::uint8_t *>(getParameterData(Param_SetX).p_buffers[sample_from_X].p);
-        std::uint8_t *p_setY        = reinterpret_cast<std::uint8_t *>(getParameterData(Param_SetY).p_buffers[sample_i].p);
-        for (std::uint64_t item_y = 0; item_y < set_size_y; ++item_y)
+        for (std::size_t i = 0; i < indices_y.size(); ++i)
         {
-            std::uint8_t *p_setY_item = p_setY + item_y * element_size_k * sizeOf(data_type);
-            if (!indices_x.empty() && item_y == *it_indices_y)
-            {
-                // we found a common item to set
-                std::uint8_t *p_setX_item = p_setX + indices_x.back() * element_size_k * sizeOf(data_type);
-                std::copy(p_setX_item, p_setX_item + element_size_k * sizeOf(data_type),
-                          p_setY_item);
-                indices_x.pop_back();
-                ++it_indices_y;
-            } // end if
-            else
-            {
-                // generate (possibly unique item)
-                DataGeneratorHelper::generateRandomVectorU(data_type,
-                                                           p_setY_item,
-                                                           element_size_k,
-                                                           -16384.0, 16384.0);
-            } // end else
+            // copy a common item from X
+            std::uint8_t *p_setX_item = p_setX + indices_x[i] * element_size_k * sizeOf(data_type);
+            std::uint8_t *p_setY_item = p_setY + indices_y[i] * element_size_k * sizeOf(data_type);
+            std::copy(p_setX_item, p_setX_item + element_size_k * sizeOf(data_type),
+                      p_setY_item);
         } // end for
     } // end for
 
-    for (std::uint64_t sampleX_i = 0; sampleX_i < batch_sizes[Param_SetX]; ++sampleX_i)
-        for (std::uint64_t sampleY_i = 0; sampleY_i < batch_sizes[Param_SetY]; ++sampleY_i)
-        {
-            // find the index for the result buffer based on the input indices
-            std::uint64_t ppi[] = { sampleX_i, sampleY_i };
-            std::uint64_t z_i   = getResultIndex(ppi);
-
-            // generate the data
-            DataGeneratorHelper::vectorSimpleSetIntersection(data_type,
-                                                             getResultData(0).p_buffers[z_i].p, // Z
-                                                             getParameterData(0).p_buffers[sampleX_i].p, // X
-                                                             getParameterData(1).p_buffers[sampleY_i].p, // Y
-                                                             set_size_x, set_size_y, element_size_k);
-        } // end for
+    // output
+    computeResults();
 
     // all data has been generated at this point
 }
@@ -440,11 +646,282 @@ void DataLoader::computeResult(std::vector<hebench::APIBridge::NativeDataBuffer
                                                      m_set_size_x, m_set_size_y, m_element_size_k);
 }
 
+//--------------------------
+// Set comparison functions
+//--------------------------
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value
+                            || std::is_floating_point<T>::value,
+                        bool>::type
+isMemberOf(const T *dataset, const T *value, std::size_t n, std::size_t k,
+           const BenchmarkDescription::ValidationTolerance &tolerance)
+{
+    bool retval = false;
+    for (size_t i = 0; !retval && i < n; ++i)
+    {
+        bool flag = true;
+        for (size_t j = 0; flag && j < k; ++j)
+            flag = isWithinTolerance(dataset[(i * k) + j], value[j], tolerance);
+        retval = flag;
+    } // end for
+    return retval;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value
+                            || std::is_floating_point<T>::value,
+                        bool>::type
+isMemberOf(const T *dataset, const T *value, std::size_t n, std::size_t k,
+           double pct)
+{
+    BenchmarkDescription::ValidationTolerance tolerance;
+    tolerance.model    = BenchmarkDescription::ValidationTolerance::Model::Relative;
+    tolerance.relative = pct;
+    return isMemberOf(dataset, value, n, k, tolerance);
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value
+                            || std::is_floating_point<T>::value,
+                        std::vector<std::pair<bool, std::uint64_t>>>::type
+almostEqualSet(const T *X, const T *Y,
+               std::uint64_t n, std::uint64_t m, std::uint64_t k,
+               const BenchmarkDescription::ValidationTolerance &tolerance,
+               hebench::Utilities::ValidationErrorStats *p_stats)
+{
+    using Model = BenchmarkDescription::ValidationTolerance::Model;
+
+    std::vector<std::pair<bool, std::uint64_t>> retval;
+    retval.reserve(n + m);
+    if (X == Y)
+    {
+        // same collection
+        if (p_stats)
+            p_stats->element_count += n * k;
+    } // end if
+    else if (!X)
+    {
+        // X has no elements
+        for (std::uint64_t i = 0; i < m; ++i)
+            retval.push_back(std::pair(false, i));
+    } // end else if
+    else if (!Y)
+    {
+        // Y has no elements
+        for (std::uint64_t i = 0; i < n; ++i)
+            retval.push_back(std::pair(true, i));
+    } // end else if
+    else
+    {
+        constexpr std::uint64_t NoMatch = std::numeric_limits<std::uint64_t>::max();
+
+        // index of the item matched in the other collection
+        std::vector<std::uint64_t> match_X(n, NoMatch);
+        std::vector<std::uint64_t> match_Y(m, NoMatch);
+        bool has_unmatched_Y = false;
+
+        // match items exactly: remove each item of Y from a multiset of items of X
+        {
+            std::unordered_multimap<const T *, std::uint64_t, ItemHash<T>, ItemEqual<T>> items_X(n, ItemHash<T>(k), ItemEqual<T>(k));
+            for (std::uint64_t i = 0; i < n; ++i)
+                items_X.emplace(X + (i * k), i);
+            for (std::uint64_t i = 0; i < m; ++i)
+            {
+                auto it = items_X.find(Y + (i * k));
+                if (it != items_X.end())
+                {
+                    match_X[it->second] = i;
+                    match_Y[i]          = it->second;
+                    items_X.erase(it);
+                } // end if
+                else
+                    has_unmatched_Y = true;
+            } // end for
+            // tolerance matching is only needed if both collections have unmatched items
+            has_unmatched_Y = has_unmatched_Y && !items_X.empty();
+        }
+
+        // match remaining items within tolerance: extend the exact matching into a maximum
+        // matching with augmenting paths, which may go through exactly matched items
+        if (has_unmatched_Y)
+        {
+            // bucket items of X by their first element for each criterion of the tolerance
+            std::vector<ItemBucket<T>> item_buckets;
+            if (tolerance.model == Model::Mixed)
+                for (Model criterion : { Model::Relative, Model::Absolute, Model::ULP })
+                    item_buckets.emplace_back(tolerance, criterion);
+            else
+                item_buckets.emplace_back(tolerance, tolerance.model);
+            std::vector<std::unordered_map<std::uint64_t, std::vector<std::uint64_t>>> buckets_X(item_buckets.size());
+            for (std::size_t criterion_i = 0; criterion_i < item_buckets.size(); ++criterion_i)
+                for (std::uint64_t i = 0; i < n; ++i)
+                {
+                    bool has_neighbors;
+                    buckets_X[criterion_i][item_buckets[criterion_i](X[i * k], has_neighbors)].push_back(i);
+                } // end for
+
+            // candidate matches in X for items of Y, found when first needed
+            std::vector<std::vector<std::uint64_t>> candidates(m);
+            std::vector<bool> has_candidates(m, false);
+            std::vector<std::uint64_t> candidate_of_X(n, NoMatch);
+            auto get_candidates = [&](std::uint64_t y_i) -> const std::vector<std::uint64_t> & {
+                if (!has_candidates[y_i])
+                {
+                    const T *p_item_Y = Y + (y_i * k);
+                    for (std::size_t criterion_i = 0; criterion_i < item_buckets.size(); ++criterion_i)
+                    {
+                        bool has_neighbors;
+                        std::uint64_t key      = item_buckets[criterion_i](p_item_Y[0], has_neighbors);
+                        std::uint64_t distance = has_neighbors ? item_buckets[criterion_i].getNeighborDistance() : 0;
+                        // unsigned keys wrap around at the ends of the range
+                        for (std::uint64_t probe_key : { key - distance, key, key + distance })
+                        {
+                            auto it = buckets_X[criterion_i].find(probe_key);
+                            if (it != buckets_X[criterion_i].end())
+                                for (std::uint64_t x_i : it->second)
+                                    if (candidate_of_X[x_i] != y_i
+                                        && isMemberOf(X + (x_i * k), p_item_Y, 1, k, tolerance))
+                                    {
+                                        candidate_of_X[x_i] = y_i;
+                                        candidates[y_i].push_back(x_i);
+                                    } // end if
+                            if (distance == 0)
+                                break;
+                        } // end for
+                    } // end for
+                    has_candidates[y_i] = true;
+                } // end if
+                return candidates[y_i];
+            };
+
+            std::vector<std::uint64_t> visited_X(n, NoMatch);
+            std::vector<std::pair<std::uint64_t, std::size_t>> path; // (item of Y, next candidate)
+            for (std::uint64_t y_i = 0; y_i < m; ++y_i)
+            {
+                if (match_Y[y_i] != NoMatch)
+                    continue;
+                bool found = false;
+                path.clear();
+                path.emplace_back(y_i, 0);
+                while (!found && !path.empty())
+                {
+                    const std::vector<std::uint64_t> &path_candidates = get_candidates(path.back().first);
+                    if (path.back().second >= path_candidates.size())
+                    {
+                        // dead end
+                        path.pop_back();
+                        continue;
+                    } // end if
+                    std::uint64_t x_i = path_candidates[path.back().second++];
+                    if (visited_X[x_i] != y_i)
+                    {
+                        visited_X[x_i] = y_i;
+                        if (match_X[x_i] == NoMatch)
+                            found = true;
+                        else
+                            path.emplace_back(match_X[x_i], 0);
+                    } // end if
+                } // end while
+                // flip the matches along the augmenting path
+                if (found)
+                    for (const auto &step : path)
+                    {
+                        std::uint64_t x_i   = candidates[step.first][step.second - 1];
+                        match_X[x_i]        = step.first;
+                        match_Y[step.first] = x_i;
+                    } // end for
+            } // end for
+        } // end if
+
+        if (p_stats)
+        {
+            // exact matches have no error
+            hebench::Utilities::ValidationErrorStats stats;
+            for (std::uint64_t i = 0; i < m; ++i)
+                if (match_Y[i] != NoMatch)
+                {
+                    if (ItemEqual<T>(k)(X + (match_Y[i] * k), Y + (i * k)))
+                        stats.element_count += k;
+                    else
+                        hebench::Utilities::findNotWithinTolerance(X + (match_Y[i] * k), Y + (i * k), k, tolerance, &stats);
+                } // end if
+            p_stats->merge(stats);
+        } // end if
+
+        for (std::uint64_t i = 0; i < n; ++i)
+            if (match_X[i] == NoMatch)
+                retval.push_back(std::pair(true, i));
+        for (std::uint64_t i = 0; i < m; ++i)
+            if (match_Y[i] == NoMatch)
+                retval.push_back(std::pair(false, i));
+        // if retval.empty(), then X == Y
+    } // end else
+    return retval;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value
+                            || std::is_floating_point<T>::value,
+                        std::vector<std::pair<bool, std::uint64_t>>>::type
+almostEqualSet(const T *X, const T *Y,
+               std::uint64_t n, std::uint64_t m, std::uint64_t k,
+               double pct)
+{
+    BenchmarkDescription::ValidationTolerance tolerance;
+    tolerance.model    = BenchmarkDescription::ValidationTolerance::Model::Relative;
+    tolerance.relative = pct;
+    return almostEqualSet(X, Y, n, m, k, tolerance);
+}
+
+template std::vector<std::pair<bool, std::uint64_t>> almostEqualSet<std::int32_t>(const std::int32_t *, const std::int32_t *,
+                                                                                  std::uint64_t, std::uint64_t, std::uint64_t,
+                                                                                  const BenchmarkDescription::ValidationTolerance &,
+                                                                                  hebench::Utilities::ValidationErrorStats *);
+template std::vector<std::pair<bool, std::uint64_t>> almostEqualSet<std::int64_t>(const std::int64_t *, const std::int64_t *,
+                                                                                  std::uint64_t, std::uint64_t, std::uint64_t,
+                                                                                  const BenchmarkDescription::ValidationTolerance &,
+                                                                                  hebench::Utilities::ValidationErrorStats *);
+template std::vector<std::pair<bool, std::uint64_t>> almostEqualSet<float>(const float *, const float *,
+                                                                           std::uint64_t, std::uint64_t, std::uint64_t,
+                                                                           const BenchmarkDescription::ValidationTolerance &,
+                                                                           hebench::Utilities::ValidationErrorStats *);
+template std::vector<std::pair<bool, std::uint64_t>> almostEqualSet<double>(const double *, const double *,
+                                                                            std::uint64_t, std::uint64_t, std::uint64_t,
+                                                                            const BenchmarkDescription::ValidationTolerance &,
+                                                                            hebench::Utilities::ValidationErrorStats *);
+template std::vector<std::pair<bool, std::uint64_t>> almostEqualSet<std::int32_t>(const std::int32_t *, const std::int32_t *,
+                                                                                  std::uint64_t, std::uint64_t, std::uint64_t,
+                                                                                  double);
+template std::vector<std::pair<bool, std::uint64_t>> almostEqualSet<std::int64_t>(const std::int64_t *, const std::int64_t *,
+                                                                                  std::uint64_t, std::uint64_t, std::uint64_t,
+                                                                                  double);
+template std::vector<std::pair<bool, std::uint64_t>> almostEqualSet<float>(const float *, const float *,
+                                                                           std::uint64_t, std::uint64_t, std::uint64_t,
+                                                                           double);
+template std::vector<std::pair<bool, std::uint64_t>> almostEqualSet<double>(const double *, const double *,
+                                                                            std::uint64_t, std::uint64_t, std::uint64_t,
+                                                                            double);
+template bool isMemberOf<std::int32_t>(const std::int32_t *, const std::int32_t *, std::size_t, std::size_t,
+                                       const BenchmarkDescription::ValidationTolerance &);
+template bool isMemberOf<std::int64_t>(const std::int64_t *, const std::int64_t *, std::size_t, std::size_t,
+                                       const BenchmarkDescription::ValidationTolerance &);
+template bool isMemberOf<float>(const float *, const float *, std::size_t, std::size_t,
+                                const BenchmarkDescription::ValidationTolerance &);
+template bool isMemberOf<double>(const double *, const double *, std::size_t, std::size_t,
+                                 const BenchmarkDescription::ValidationTolerance &);
+template bool isMemberOf<std::int32_t>(const std::int32_t *, const std::int32_t *, std::size_t, std::size_t, double);
+template bool isMemberOf<std::int64_t>(const std::int64_t *, const std::int64_t *, std::size_t, std::size_t, double);
+template bool isMemberOf<float>(const float *, const float *, std::size_t, std::size_t, double);
+template bool isMemberOf<double>(const double *, const double *, std::size_t, std::size_t, double);
+
 bool validateResult(IDataLoader::Ptr dataset,
                     const std::uint64_t *param_data_pack_indices,
                     const std::vector<hebench::APIBridge::NativeDataBuffer *> &outputs,
                     std::uint64_t k_count,
-                    hebench::APIBridge::DataType data_type)
+                    hebench::APIBridge::DataType data_type,
+                    const BenchmarkDescription::ValidationTolerance &tolerance,
+                    hebench::Utilities::ValidationErrorStats *p_stats)
 {
     static constexpr const std::size_t MaxErrorPrint = 10;
     bool retval                                      = true;
@@ -501,28 +978,28 @@ bool validateResult(IDataLoader::Ptr dataset,
                 is_valid = almostEqualSet(reinterpret_cast<const std::int32_t *>(p_truth),
                                           reinterpret_cast<const std::int32_t *>(p_output),
                                           n, n, k_count,
-                                          0.01);
+                                          tolerance, p_stats);
                 break;
 
             case hebench::APIBridge::DataType::Int64:
                 is_valid = almostEqualSet(reinterpret_cast<const std::int64_t *>(p_truth),
                                           reinterpret_cast<const std::int64_t *>(p_output),
                                           n, n, k_count,
-                                          0.01);
+                                          tolerance, p_stats);
                 break;
 
             case hebench::APIBridge::DataType::Float32:
                 is_valid = almostEqualSet(reinterpret_cast<const float *>(p_truth),
                                           reinterpret_cast<const float *>(p_output),
                                           n, n, k_count,
-                                          0.01);
+                                          tolerance, p_stats);
                 break;
 
             case hebench::APIBridge::DataType::Float64:
                 is_valid = almostEqualSet(reinterpret_cast<const double *>(p_truth),
                                           reinterpret_cast<const double *>(p_output),
                                           n, n, k_count,
-                                          0.01);
+                                          tolerance, p_stats);
                 break;
 
             default:
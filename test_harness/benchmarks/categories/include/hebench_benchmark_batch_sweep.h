@@ -0,0 +1,173 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Benchmark_BatchSweep_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Benchmark_BatchSweep_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hebench/modules/logging/include/logging.h"
+
+#include "include/hebench_benchmark_description.h"
+#include "include/hebench_ibenchmark.h"
+#include "include/hebench_utilities_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+class Engine;
+
+/**
+ * @brief Searches for the offline batch size with the best throughput.
+ * @details The sweep runs an offline benchmark repeatedly, with a different sample
+ * size for one of the operation parameters each time, and measures the throughput
+ * of the main event, in results per second, for each batch size.
+ *
+ * Batch sizes grow geometrically until the marginal throughput gain with respect to
+ * the previous batch size falls below a threshold, or the maximum batch size is
+ * reached. With Strategy::Bisection, the interval between the last two batch sizes
+ * is then bisected to locate the smallest batch size that reaches the throughput
+ * plateau.
+ *
+ * The optimum is the smallest batch size tested whose throughput is within the
+ * threshold of the best throughput measured.
+ */
+class BatchSweep
+{
+private:
+    IL_DECLARE_CLASS_NAME(BatchSweep)
+
+public:
+    enum class Strategy
+    {
+        None,
+        Geometric,
+        Bisection
+    };
+
+    struct Config
+    {
+        Strategy strategy;
+        /**
+         * @brief Index of the operation parameter whose sample size is swept.
+         */
+        std::size_t param_index;
+        std::uint64_t min_batch_size;
+        std::uint64_t max_batch_size;
+        /**
+         * @brief Factor by which the batch size grows on each geometric step.
+         * Must be greater than `1`.
+         */
+        double growth_factor;
+        /**
+         * @brief Relative throughput gain, as per-one, below which throughput is
+         * considered saturated.
+         */
+        double min_gain;
+    };
+
+    /**
+     * @brief Throughput measured for a single batch size.
+     */
+    struct Point
+    {
+        std::uint64_t batch_size;
+        double throughput; // results per second
+    };
+
+    /**
+     * @brief Lowercase name of the specified strategy, as used in command line.
+     */
+    static std::string getStrategyName(Strategy strategy);
+    /**
+     * @brief Retrieves the strategy from its name.
+     * @throws std::invalid_argument if \p name does not correspond to any strategy.
+     */
+    static Strategy getStrategy(const std::string &name);
+
+    /**
+     * @brief Computes the throughput of the main event in a report.
+     * @return Number of samples processed per second by all main events, or `0`
+     * if the report has no main events.
+     */
+    static double computeThroughput(const hebench::Utilities::TimingReportEx &report);
+
+    /**
+     * @brief Sweeps the batch size of an offline benchmark.
+     * @param engine Engine to use to describe and create the benchmark for every
+     * batch size.
+     * @param[in] index Index of the registered backend benchmark description.
+     * @param[in] bench_config Configuration for the benchmark. The sample size for
+     * `sweep_config.param_index` is replaced for each batch size tested.
+     * @param run_config Configuration for every run.
+     * @param[in] sweep_config Configuration for the sweep.
+     * @param out_report Report where to write the results. Receives the header and
+     * events of the run with the optimum batch size, followed by the throughput for
+     * every batch size tested.
+     * @returns `true` if all runs succeeded.
+     * @returns `false` if validation failed for any run. The sweep stops on the
+     * first failed run.
+     * @throws std::invalid_argument if the benchmark is not in the offline category
+     * or `sweep_config.param_index` is not an operation parameter.
+     * @details If the backend does not honor the requested sample size for the swept
+     * parameter, the sweep stops after the first run.
+     */
+    static bool run(Engine &engine,
+                    std::size_t index,
+                    const BenchmarkDescription::Configuration &bench_config,
+                    IBenchmark::RunConfig &run_config,
+                    const Config &sweep_config,
+                    hebench::Utilities::TimingReportEx &out_report);
+
+    BatchSweep(const Config &config);
+
+    /**
+     * @brief Batch size to test next.
+     * @return Batch size to test next, or `0` if the sweep is complete.
+     */
+    std::uint64_t next() const { return m_b_done ? 0 : m_next; }
+    /**
+     * @brief Records the throughput measured for a batch size and advances the sweep.
+     * @param[in] batch_size Batch size actually tested. This is usually the value
+     * returned by next(), unless the backend chose a different size.
+     * @param[in] throughput Throughput measured, in results per second.
+     * @details If \p batch_size differs from next(), the sweep completes.
+     */
+    void record(std::uint64_t batch_size, double throughput);
+    /**
+     * @brief Stops the sweep.
+     */
+    void stop() { m_b_done = true; }
+
+    /**
+     * @brief Points measured so far, in the order they were recorded.
+     */
+    const std::vector<Point> &getPoints() const { return m_points; }
+    /**
+     * @brief Index, in getPoints(), of the optimum batch size.
+     * @throws std::logic_error if no points have been recorded.
+     */
+    std::size_t getOptimumIndex() const;
+    /**
+     * @brief Appends the throughput for every batch size tested and the optimum
+     * to the footer of a report.
+     */
+    void appendSweepReport(hebench::Utilities::TimingReportEx &out_report) const;
+
+private:
+    Config m_config;
+    std::vector<Point> m_points;
+    std::uint64_t m_next;
+    bool m_b_done;
+    bool m_b_bisecting;
+    Point m_lo; // bisection: largest batch size known to be below the plateau
+    Point m_hi; // bisection: smallest batch size known to reach the plateau
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Benchmark_BatchSweep_H_0596d40a3cce4b108a81595c50eb286d
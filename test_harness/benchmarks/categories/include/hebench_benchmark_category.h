@@ -6,6 +6,7 @@
 #define _HEBench_Harness_Benchmark_Category_H_0596d40a3cce4b108a81595c50eb286d
 
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -88,7 +89,9 @@ protected:
      * The default implementation provided assumes that \p dataset contains the
      * results pre-computed and the data type for all arguments and results is
      * \p data_type. If this is not the case for the derived class, clients should
-     * provide their own override version of this method.
+     * provide their own override version of this method. Elements are compared
+     * using the validation tolerance from the benchmark configuration, and their
+     * error statistics are accumulated to be reported by appendValidationStats().
      */
     virtual bool validateResult(IDataLoader::Ptr dataset,
                                 const std::uint64_t *param_data_pack_indices,
@@ -124,6 +127,26 @@ protected:
                            const std::uint64_t *param_data_pack_indices,
                            const std::vector<hebench::APIBridge::NativeDataBuffer *> &outputs,
                            hebench::APIBridge::DataType data_type) const;
+    /**
+     * @brief Appends the validation tolerance and the error statistics of all
+     * results validated so far to the footer of the specified report.
+     * @details Nothing is appended if no elements were validated, either by the
+     * default implementation of validateResult() or by overrides that report
+     * their statistics through mergeValidationStats().
+     */
+    void appendValidationStats(hebench::Utilities::TimingReportEx &out_report) const;
+    /**
+     * @brief Accumulates the error statistics of a validated result to be reported
+     * by appendValidationStats().
+     * @details Overrides of validateResult() that do not call the default
+     * implementation should call this method to include their results in the
+     * report. Thread safe.
+     */
+    void mergeValidationStats(const hebench::Utilities::ValidationErrorStats &stats) const;
+
+private:
+    mutable std::mutex m_validation_stats_mutex;
+    mutable hebench::Utilities::ValidationErrorStats m_validation_stats;
 };
 
 } // namespace TestHarness
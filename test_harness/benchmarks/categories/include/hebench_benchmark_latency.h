@@ -5,6 +5,7 @@
 #ifndef _HEBench_Harness_Benchmark_Latency_H_0596d40a3cce4b108a81595c50eb286d
 #define _HEBench_Harness_Benchmark_Latency_H_0596d40a3cce4b108a81595c50eb286d
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -62,9 +63,114 @@ protected:
                      const IBenchmarkDescriptor::DescriptionToken &description_token);
 
 private:
+    struct PostprocessEventIDs
+    {
+        std::uint32_t store;
+        std::uint32_t decryption;
+        std::uint32_t decoding;
+    };
+    struct LatencyStream;
+    struct PipelineItem;
+
     bool run(hebench::Utilities::TimingReportEx &out_report,
              IDataLoader::Ptr p_dataset,
              IBenchmark::RunConfig &run_config);
+    /**
+     * @brief Issues operations on the arrival schedule requested by \p run_config
+     * for each of the requested offered loads and post-processes their results.
+     * @param out_report Object where to append the timing events and the latency
+     * versus throughput curve.
+     * @param[in] p_dataset Dataset used for validation.
+     * @param[in] run_config Configuration for the run.
+     * @param[in] h_inputs_remote Remote handle to the loaded inputs of the operation.
+     * @param[in] params Parameter indexers for the operation.
+     * @param[in] min_test_time_ms Time, in milliseconds, to test each offered load.
+     * @returns `true` if all results were valid or validation was not requested.
+     * @returns `false` on the first result that fails validation.
+     * @details Operations that arrive while the backend is busy wait until the
+     * previous operation completes. The time waited is reported as queueing delay,
+     * separately from the time spent inside `operate()`.
+     */
+    bool runOpenLoop(hebench::Utilities::TimingReportEx &out_report,
+                     IDataLoader::Ptr p_dataset,
+                     IBenchmark::RunConfig &run_config,
+                     const hebench::APIBridge::Handle &h_inputs_remote,
+                     const std::vector<hebench::APIBridge::ParameterIndexer> &params,
+                     std::uint64_t min_test_time_ms);
+    /**
+     * @brief Calls `operate()` concurrently from one thread per stream until the
+     * test time elapses and post-processes the results of all streams.
+     * @param out_report Object where to append the timing events and the per
+     * stream and aggregate latency and throughput.
+     * @param[in] p_dataset Dataset used for validation.
+     * @param[in] run_config Configuration for the run.
+     * @param[in] h_inputs_remote Remote handles to the loaded inputs of the
+     * operation, one per stream.
+     * @param[in] params Parameter indexers for the operation.
+     * @param[in] min_test_time_ms Minimum time, in milliseconds, for each stream to run.
+     * @returns `true` if all results were valid or validation was not requested.
+     * @returns `false` on the first result that fails validation.
+     * @details All streams start at the same time. Each stream performs, at least,
+     * two operations.
+     */
+    bool runMultiStream(hebench::Utilities::TimingReportEx &out_report,
+                        IDataLoader::Ptr p_dataset,
+                        IBenchmark::RunConfig &run_config,
+                        const std::vector<RAIIHandle> &h_inputs_remote,
+                        const std::vector<hebench::APIBridge::ParameterIndexer> &params,
+                        std::uint64_t min_test_time_ms);
+    /**
+     * @brief Pushes a stream of samples end-to-end through a pipeline of stages
+     * until the test time elapses.
+     * @param out_report Object where to append the timing events of every stage, the
+     * end-to-end events, and the pipeline throughput and stage statistics.
+     * @param[in] p_dataset Dataset used for validation.
+     * @param[in] run_config Configuration for the run.
+     * @param[in] packed_parameters Raw parameters to encode for each sample: encrypted
+     * parameters first, plain parameters last.
+     * @param[in] params Parameter indexers for the operation.
+     * @param[in] min_test_time_ms Minimum time, in milliseconds, to keep feeding
+     * samples into the pipeline.
+     * @returns `true` if all results were valid or validation was not requested.
+     * @returns `false` on the first result that fails validation.
+     * @details Every sample goes through encoding, encryption, loading, operation,
+     * storing, decryption and decoding. Each stage runs in its own thread, and
+     * stages communicate through bounded queues of `run_config.pipeline_queue_size`
+     * items, so, a slow stage stalls the stages before it.
+     */
+    bool runPipelined(hebench::Utilities::TimingReportEx &out_report,
+                      IDataLoader::Ptr p_dataset,
+                      IBenchmark::RunConfig &run_config,
+                      const std::vector<hebench::APIBridge::DataPackCollection> &packed_parameters,
+                      const std::vector<hebench::APIBridge::ParameterIndexer> &params,
+                      std::uint64_t min_test_time_ms);
+    /**
+     * @brief Appends the validation outcome of a completed run to the report footer.
+     */
+    void completeValidation(hebench::Utilities::TimingReportEx &out_report,
+                            const IBenchmark::RunConfig &run_config) const;
+    /**
+     * @brief Retrieves, decrypts, decodes and validates the specified operation results.
+     * @param out_report Object where to append the timing events of the post-processing.
+     * @param[in] p_dataset Dataset used for validation.
+     * @param[in] run_config Configuration for the run.
+     * @param[in,out] h_remote_results Remote handles to the results of the operation.
+     * Each handle is destroyed as soon as it is no longer needed and this collection is
+     * empty on return.
+     * @param[in] event_ids IDs for the post-processing events.
+     * @param[in] result_offset Number of results already post-processed before
+     * \p h_remote_results. Used for reporting.
+     * @param[in] b_show_progress Specifies whether to print out progress of each stage.
+     * @returns `true` if all results were valid or validation was not requested.
+     * @returns `false` on the first result that fails validation.
+     */
+    bool postprocessResults(hebench::Utilities::TimingReportEx &out_report,
+                            IDataLoader::Ptr p_dataset,
+                            IBenchmark::RunConfig &run_config,
+                            std::vector<RAIIHandle> &h_remote_results,
+                            const PostprocessEventIDs &event_ids,
+                            std::uint64_t result_offset,
+                            bool b_show_progress);
 };
 
 } // namespace TestHarness
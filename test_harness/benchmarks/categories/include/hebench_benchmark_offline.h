@@ -62,9 +62,42 @@ protected:
                      const IBenchmarkDescriptor::DescriptionToken &description_token);
 
 private:
+    /**
+     * @brief Fraction of invalid results used to express the confidence achieved
+     * when only a selection of the results is validated.
+     */
+    static constexpr double ValidationInvalidFraction = 0.01;
+
     bool run(hebench::Utilities::TimingReportEx &out_report,
              IDataLoader::Ptr p_dataset,
              IBenchmark::RunConfig &run_config);
+
+    /**
+     * @brief Selects the results to validate according to the validation policy.
+     * @param[in] p_dataset Dataset for the test. Results are indexed as in
+     * IDataLoader::getResultFor().
+     * @param[in] run_config Configuration specifying the validation policy.
+     * @return Indices of the results to validate, in increasing order. Empty if
+     * all results must be validated.
+     * @details Random selections are repeatable for the same random seed.
+     */
+    static std::vector<std::uint64_t> selectResultsToValidate(IDataLoader::Ptr p_dataset,
+                                                              const IBenchmark::RunConfig &run_config);
+    /**
+     * @brief Computes the confidence that fewer than a fraction of all results are
+     * invalid, given that all results in a random selection were valid.
+     * @param[in] result_count Total number of results.
+     * @param[in] validated_count Number of results selected at random without
+     * replacement, all of which were valid.
+     * @param[in] invalid_fraction Fraction of invalid results to test for.
+     * @return Confidence level in range `[0, 1]`.
+     * @details The probability of finding no invalid results in the selection if,
+     * at least, `invalid_fraction` of the results were invalid follows the hypergeometric
+     * distribution. Confidence is the complement of this probability.
+     */
+    static double computeValidationConfidence(std::uint64_t result_count,
+                                              std::uint64_t validated_count,
+                                              double invalid_fraction);
 };
 
 } // namespace TestHarness
@@ -0,0 +1,111 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Benchmark_OpenLoop_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Benchmark_OpenLoop_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "hebench/modules/logging/include/logging.h"
+
+#include "include/hebench_ibenchmark.h"
+#include "include/hebench_utilities_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Generates the arrival times of operations for open-loop latency tests.
+ * @details Arrival times are measured in seconds from the start of the schedule.
+ * The first operation always arrives at time `0`.
+ */
+class ArrivalSchedule
+{
+private:
+    IL_DECLARE_CLASS_NAME(ArrivalSchedule)
+
+public:
+    /**
+     * @brief Initializes a new arrival schedule.
+     * @param[in] process Arrival process. Must not be IBenchmark::ArrivalProcess::Closed.
+     * @param[in] rate Mean number of arrivals per second. Must be positive.
+     * @param[in] seed Seed for the random inter-arrival times of Poisson processes.
+     * @throws std::invalid_argument if \p process or \p rate are invalid.
+     */
+    ArrivalSchedule(IBenchmark::ArrivalProcess process, double rate, std::uint64_t seed);
+
+    /**
+     * @brief Time of the next arrival in the schedule.
+     */
+    double peek() const { return m_next_arrival; }
+    /**
+     * @brief Advances the schedule to the following arrival.
+     * @returns Time of the arrival consumed.
+     */
+    double pop();
+
+private:
+    IBenchmark::ArrivalProcess m_process;
+    double m_rate;
+    std::uint64_t m_arrival_count;
+    double m_next_arrival;
+    std::mt19937_64 m_rand_gen;
+    std::exponential_distribution<double> m_interarrival;
+};
+
+/**
+ * @brief Measurements of an open-loop latency test at a single offered load.
+ * @details All times are in milliseconds. The response time of an operation is
+ * its queueing delay plus its service time.
+ *
+ * Operations that arrived but were never issued before the test ended are not
+ * dropped from the statistics, since that would hide the delays of a saturated
+ * backend (coordinated omission): each is charged the time it waited until the end
+ * of the test as its queueing delay and response time. These are lower bounds, so,
+ * statistics of a load point with unserved operations are lower bounds as well.
+ */
+struct OpenLoopLoadPoint
+{
+    OpenLoopLoadPoint(double rate = 0.0) :
+        offered_rate(rate), elapsed_ms(0.0) {}
+
+    double offered_rate; // operations per second
+    double elapsed_ms; // from the first arrival until the last operation completed
+    std::vector<double> queueing_delays; // operations issued
+    std::vector<double> service_times; // operations issued
+    std::vector<double> unserved_delays; // operations that arrived, but were not issued before the test ended
+
+    /**
+     * @brief Number of operations completed per second.
+     */
+    double getAchievedRate() const;
+    /**
+     * @brief Whether operations were left unserved because the backend could not
+     * keep up with the offered load.
+     */
+    bool isSaturated() const { return !unserved_delays.empty(); }
+    /**
+     * @brief Queueing delays of all operations that arrived, including unserved ones.
+     */
+    std::vector<double> getQueueingDelays() const;
+    /**
+     * @brief Response times of all operations that arrived, including unserved ones.
+     */
+    std::vector<double> getResponseTimes() const;
+
+    /**
+     * @brief Appends the latency versus throughput curve for the specified load
+     * points to the footer of a report.
+     */
+    static void appendLatencyCurve(hebench::Utilities::TimingReportEx &out_report,
+                                   IBenchmark::ArrivalProcess process,
+                                   const std::vector<OpenLoopLoadPoint> &load_points);
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Benchmark_OpenLoop_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,135 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Benchmark_Pipeline_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Benchmark_Pipeline_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hebench/modules/general/include/nocopy.h"
+
+#include "include/hebench_utilities_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Queue with bounded capacity used to pass items between the stages of
+ * pipelined tests.
+ * @details Pushing into a full queue blocks until there is room, and popping from
+ * an empty queue blocks until an item is available or the queue is closed.
+ */
+template <class T>
+class BoundedQueue
+{
+public:
+    DISABLE_COPY(BoundedQueue)
+    DISABLE_MOVE(BoundedQueue)
+
+public:
+    BoundedQueue(std::size_t capacity) :
+        m_capacity(capacity > 0 ? capacity : 1), m_b_closed(false) {}
+
+    /**
+     * @brief Adds an item to the end of the queue, waiting for room if the queue is full.
+     * @returns `true` if the item was added.
+     * @returns `false` if the queue is closed. The item is left untouched.
+     */
+    bool push(T &&item)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_not_full.wait(lock, [this]() { return m_b_closed || m_items.size() < m_capacity; });
+        if (m_b_closed)
+            return false;
+        m_items.push_back(std::move(item));
+        lock.unlock();
+        m_cv_not_empty.notify_one();
+        return true;
+    }
+    /**
+     * @brief Removes the item at the front of the queue, waiting for an item if the
+     * queue is empty.
+     * @returns `true` if an item was retrieved into \p out_item.
+     * @returns `false` if the queue is closed and empty.
+     */
+    bool pop(T &out_item)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_not_empty.wait(lock, [this]() { return m_b_closed || !m_items.empty(); });
+        if (m_items.empty())
+            return false;
+        out_item = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_cv_not_full.notify_one();
+        return true;
+    }
+    /**
+     * @brief Closes the queue.
+     * @details Pushing into a closed queue fails, while items already in the queue
+     * can still be popped. All threads waiting on the queue are released.
+     */
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_b_closed = true;
+        }
+        m_cv_not_full.notify_all();
+        m_cv_not_empty.notify_all();
+    }
+
+private:
+    std::size_t m_capacity;
+    bool m_b_closed;
+    std::deque<T> m_items;
+    std::mutex m_mutex;
+    std::condition_variable m_cv_not_full;
+    std::condition_variable m_cv_not_empty;
+};
+
+/**
+ * @brief Measurements of a single stage during a pipelined test.
+ * @details All times are in milliseconds.
+ */
+struct PipelineStageStats
+{
+    PipelineStageStats(const std::string &stage_name = std::string()) :
+        name(stage_name), item_count(0), busy_ms(0.0), backpressure_ms(0.0), starvation_ms(0.0) {}
+
+    std::string name;
+    std::uint64_t item_count;
+    double busy_ms; // processing items
+    double backpressure_ms; // waiting for room in the queue to the next stage
+    double starvation_ms; // waiting for items from the previous stage
+
+    /**
+     * @brief Appends the end-to-end throughput and the occupancy, backpressure
+     * and starvation of each stage to the footer of a report.
+     * @param out_report Report where to append.
+     * @param[in] queue_size Capacity of the queues between stages.
+     * @param[in] completion_times Time, in milliseconds from the start of the test,
+     * at which each item left the pipeline, in order.
+     * @param[in] stages Measurements for each stage, in pipeline order.
+     * @details Occupancy, backpressure and starvation are percentages of the test
+     * time, from the start of the test until the last item left the pipeline.
+     * Sustained throughput excludes the time to fill the pipeline: it is measured
+     * from the completion of the first item to the completion of the last one.
+     */
+    static void appendPipelineReport(hebench::Utilities::TimingReportEx &out_report,
+                                     std::uint64_t queue_size,
+                                     const std::vector<double> &completion_times,
+                                     const std::vector<PipelineStageStats> &stages);
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Benchmark_Pipeline_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,114 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Benchmark_SteadyState_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Benchmark_SteadyState_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <vector>
+
+#include "hebench/modules/logging/include/logging.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Detects when the times of repeated operations reach a steady state.
+ * @details Operation times are added as they complete. The series is steady when
+ * the last `window_size` times show neither a change point nor a trend:
+ *
+ * - Change point: for every way of splitting the window in two, the means of both
+ * sides are not significantly different according to a two-sample t test with
+ * pooled variance. The significance level is corrected for the number of splits
+ * tested (Bonferroni).
+ * - Trend: the slope of the least squares line through the window is not
+ * significantly different from zero according to a t test.
+ *
+ * Slow first operations, caused by one-time setup costs, cache misses or page faults,
+ * show as a change point near the start of the window until they leave the window,
+ * while operations that speed up gradually show as a trend.
+ */
+class SteadyStateDetector
+{
+private:
+    IL_DECLARE_CLASS_NAME(SteadyStateDetector)
+
+public:
+    static constexpr std::size_t DefaultWindowSize = 5;
+    static constexpr double DefaultSignificance    = 0.05;
+
+    /**
+     * @brief Initializes a new detector.
+     * @param[in] window_size Number of most recent operations tested for steady
+     * state. Must be, at least, `3`.
+     * @param[in] significance Significance level of the change point and trend
+     * tests, in range `(0, 1)`.
+     * @throws std::invalid_argument on invalid parameters.
+     */
+    SteadyStateDetector(std::size_t window_size = DefaultWindowSize,
+                        double significance     = DefaultSignificance);
+
+    /**
+     * @brief Adds the time of a completed operation and tests for steady state.
+     * @param[in] elapsed_ms Wall time of the operation in milliseconds.
+     */
+    void add(double elapsed_ms);
+    /**
+     * @brief Whether the last operations added are in steady state.
+     */
+    bool isSteady() const { return m_b_steady; }
+
+    std::uint64_t getCount() const { return m_count; }
+    std::size_t getWindowSize() const { return m_window_size; }
+    /**
+     * @brief Change point statistic of the last full window tested.
+     */
+    double getChangePointStatistic() const { return m_change_point_statistic; }
+    /**
+     * @brief Value of the statistic above which a change point is significant.
+     */
+    double getChangePointCritical() const { return m_change_point_critical; }
+    /**
+     * @brief Trend statistic of the last full window tested.
+     */
+    double getTrendStatistic() const { return m_trend_statistic; }
+    /**
+     * @brief Value of the statistic above which a trend is significant.
+     */
+    double getTrendCritical() const { return m_trend_critical; }
+
+    /**
+     * @brief Computes the change point statistic of a series.
+     * @param[in] series Series to test. Must have, at least, `3` values.
+     * @param[out] change_point Number of values before the most likely change point.
+     * @return Largest absolute t statistic comparing the means before and after every
+     * split point in the series. Infinity if the means differ and the series has
+     * no variance around them.
+     */
+    static double computeChangePointStatistic(const std::vector<double> &series,
+                                              std::size_t &change_point);
+    /**
+     * @brief Computes the trend statistic of a series.
+     * @param[in] series Series to test. Must have, at least, `3` values.
+     * @return Absolute t statistic of the slope of the least squares line through
+     * the series against the position of each value. Infinity if the series is a
+     * perfect line with non-zero slope.
+     */
+    static double computeTrendStatistic(const std::vector<double> &series);
+
+private:
+    std::size_t m_window_size;
+    double m_change_point_critical;
+    double m_trend_critical;
+    std::vector<double> m_window; // circular buffer with the last operation times
+    std::uint64_t m_count;
+    double m_change_point_statistic;
+    double m_trend_statistic;
+    bool m_b_steady;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Benchmark_SteadyState_H_0596d40a3cce4b108a81595c50eb286d
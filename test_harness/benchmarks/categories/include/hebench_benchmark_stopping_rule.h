@@ -0,0 +1,152 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_Harness_Benchmark_StoppingRule_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_Harness_Benchmark_StoppingRule_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdint>
+#include <string>
+
+#include "hebench/modules/logging/include/logging.h"
+#include "hebench_report_quantile_sketch.h"
+
+#include "include/hebench_ibenchmark.h"
+#include "include/hebench_utilities_harness.h"
+
+namespace hebench {
+namespace TestHarness {
+
+/**
+ * @brief Decides when the operation loop of a test stops.
+ * @details The time of every operation is added to the rule as it completes. The
+ * rule keeps a running mean and variance of the operation times and, optionally, a
+ * streaming estimate of their distribution to track the median.
+ *
+ * When the stopping criteria are not adaptive, the loop stops once the fixed test
+ * time has elapsed and the minimum number of operations has completed, as always.
+ * Otherwise, the loop stops as soon as the relative half-width of the confidence
+ * interval for the mean (and the median, if requested) falls below the target
+ * precision, or when any of the maximum bounds is reached, but never before the
+ * minimum bounds.
+ *
+ * The confidence interval for the mean uses the Student t distribution. The one
+ * for the median is distribution free, based on the order statistics around the
+ * median rank, estimated from the streaming sketch.
+ */
+class StoppingRule
+{
+private:
+    IL_DECLARE_CLASS_NAME(StoppingRule)
+
+public:
+    enum class StopReason
+    {
+        None,
+        TestTime,
+        Precision,
+        MaxTime,
+        MaxIterations
+    };
+
+    /**
+     * @brief Initializes a new stopping rule.
+     * @param[in] criteria Stopping criteria for the test.
+     * @param[in] test_time_ms Fixed test time, in milliseconds, used when the
+     * criteria are not adaptive.
+     * @param[in] min_count Minimum number of operations required by the test,
+     * regardless of the criteria.
+     * @throws std::invalid_argument on invalid criteria.
+     */
+    StoppingRule(const IBenchmark::StoppingCriteria &criteria,
+                 std::uint64_t test_time_ms,
+                 std::uint64_t min_count);
+
+    bool isAdaptive() const { return m_criteria.precision > 0.0; }
+
+    /**
+     * @brief Adds the time of a completed operation.
+     * @param[in] elapsed_ms Wall time of the operation in milliseconds.
+     */
+    void add(double elapsed_ms);
+    /**
+     * @brief Determines whether the operation loop must stop.
+     * @details Once this returns `true`, the reason is available through
+     * getStopReason().
+     */
+    bool isDone();
+
+    std::uint64_t getCount() const { return m_count; }
+    /**
+     * @brief Sum of the times of all operations added, in milliseconds.
+     */
+    double getElapsedMs() const { return m_elapsed_ms; }
+    double getMean() const { return m_mean; }
+    /**
+     * @brief Sample variance of the operation times.
+     */
+    double getVariance() const { return m_count > 1 ? m_m2 / (m_count - 1) : 0.0; }
+    /**
+     * @brief Half-width of the confidence interval for the mean, relative to the
+     * mean, as per-one.
+     * @return Relative half-width, or infinity if fewer than two operations were added.
+     */
+    double getMeanPrecision() const;
+    /**
+     * @brief Half-width of the confidence interval for the median, relative to the
+     * median, as per-one.
+     * @return Relative half-width, or infinity if there are not enough operations, or
+     * the median is not tracked.
+     */
+    double getMedianPrecision() const;
+    StopReason getStopReason() const { return m_stop_reason; }
+
+    /**
+     * @brief Critical value of the two-sided Student t distribution.
+     * @param[in] confidence_level Confidence level as per-one in range `(0, 1)`.
+     * @param[in] dof Degrees of freedom. Must be positive.
+     * @return Value `t` such that the probability of `|T| <= t` is \p confidence_level .
+     * @details Computed by bisection on the distribution function, evaluated through
+     * the regularized incomplete beta function, to a relative precision of `1e-12`.
+     */
+    static double computeStudentCritical(double confidence_level, std::uint64_t dof);
+    static std::string getStopReasonName(StopReason reason);
+
+    /**
+     * @brief Describes the stopping criteria in a single line for console output.
+     */
+    std::string describe() const;
+    /**
+     * @brief Appends the criteria and the achieved precision to the footer of a report.
+     * @details Nothing is appended when the criteria are not adaptive.
+     */
+    void appendStoppingReport(hebench::Utilities::TimingReportEx &out_report) const;
+
+private:
+    double getConfidenceLevel() const { return isAdaptive() ? m_criteria.confidence_level : 0.95; }
+    /**
+     * @brief Critical value of the two-sided Student t distribution for the
+     * confidence level of the rule.
+     * @details The last value is cached, along with its degrees of freedom, since
+     * the confidence level of the rule does not change.
+     */
+    double getStudentCritical(std::uint64_t dof) const;
+
+    IBenchmark::StoppingCriteria m_criteria;
+    std::uint64_t m_test_time_ms;
+    std::uint64_t m_min_count;
+    std::uint64_t m_count;
+    double m_elapsed_ms;
+    double m_mean;
+    double m_m2; // sum of squared differences from the mean (Welford)
+    hebench::ReportGen::QuantileSketch m_sketch;
+    StopReason m_stop_reason;
+    double m_normal_critical; // two-sided critical value of the normal distribution
+    mutable std::uint64_t m_student_dof; // 0 if no Student t critical value is cached
+    mutable double m_student_critical;
+};
+
+} // namespace TestHarness
+} // namespace hebench
+
+#endif // defined _HEBench_Harness_Benchmark_StoppingRule_H_0596d40a3cce4b108a81595c50eb286d
@@ -0,0 +1,299 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include "hebench/api_bridge/api.h"
+#include "include/hebench_engine.h"
+
+#include "../include/hebench_benchmark_batch_sweep.h"
+
+namespace hebench {
+namespace TestHarness {
+
+//------------------
+// class BatchSweep
+//------------------
+
+std::string BatchSweep::getStrategyName(Strategy strategy)
+{
+    std::string retval;
+
+    switch (strategy)
+    {
+    case Strategy::None:
+        retval = "none";
+        break;
+
+    case Strategy::Geometric:
+        retval = "geometric";
+        break;
+
+    case Strategy::Bisection:
+        retval = "bisection";
+        break;
+
+    default:
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Unknown batch sweep strategy."));
+        break;
+    } // end switch
+
+    return retval;
+}
+
+BatchSweep::Strategy BatchSweep::getStrategy(const std::string &name)
+{
+    for (Strategy strategy : { Strategy::None, Strategy::Geometric, Strategy::Bisection })
+        if (getStrategyName(strategy) == name)
+            return strategy;
+    throw std::invalid_argument(IL_LOG_MSG_CLASS("Unknown batch sweep strategy: \"" + name + "\"."));
+}
+
+double BatchSweep::computeThroughput(const hebench::Utilities::TimingReportEx &report)
+{
+    if (report.getEventTypeCount() <= 0)
+        return 0.0;
+
+    std::uint32_t main_event_id = report.getMainEventType();
+    std::uint64_t sample_count  = 0;
+    double elapsed_s            = 0.0;
+    for (std::uint64_t event_i = 0; event_i < report.getEventCount(); ++event_i)
+    {
+        hebench::ReportGen::TimingReportEventC event;
+        report.getEvent(event, event_i);
+        if (event.event_type_id == main_event_id)
+        {
+            sample_count += event.input_sample_count;
+            elapsed_s += hebench::Utilities::TimingReportEx::computeElapsedWallTime(event);
+        } // end if
+    } // end for
+
+    return elapsed_s > 0.0 ? sample_count / elapsed_s : 0.0;
+}
+
+bool BatchSweep::run(Engine &engine,
+                     std::size_t index,
+                     const BenchmarkDescription::Configuration &bench_config,
+                     IBenchmark::RunConfig &run_config,
+                     const Config &sweep_config,
+                     hebench::Utilities::TimingReportEx &out_report)
+{
+    BatchSweep sweep(sweep_config);
+    // report of the run for each recorded point
+    std::vector<std::unique_ptr<hebench::Utilities::TimingReportEx>> reports;
+
+    while (sweep.next() > 0)
+    {
+        std::uint64_t batch_size = sweep.next();
+
+        BenchmarkDescription::Configuration config = bench_config;
+        if (config.default_sample_sizes.size() <= sweep_config.param_index)
+            config.default_sample_sizes.resize(sweep_config.param_index + 1, 0);
+        config.default_sample_sizes[sweep_config.param_index] = batch_size;
+
+        IBenchmarkDescriptor::DescriptionToken::Ptr p_token = engine.describeBenchmark(index, config);
+
+        const BenchmarkDescription::Backend &backend_desc = p_token->getBackendDescription();
+        if (backend_desc.descriptor.category != hebench::APIBridge::Category::Offline)
+            throw std::invalid_argument(IL_LOG_MSG_CLASS("Batch sweep is only supported for benchmarks in \"Offline\" category."));
+        if (sweep_config.param_index >= backend_desc.operation_params_count)
+            throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid parameter index for batch sweep: "
+                                                         + std::to_string(sweep_config.param_index) + ". Workload has "
+                                                         + std::to_string(backend_desc.operation_params_count) + " operation parameters."));
+        // sample size actually used by the benchmark
+        std::uint64_t actual_batch_size = backend_desc.descriptor.cat_params.offline.data_count[sweep_config.param_index];
+
+        std::stringstream ss;
+        ss << "Batch sweep: parameter " << sweep_config.param_index << ", batch size " << actual_batch_size;
+        std::cout << std::endl
+                  << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+        reports.emplace_back(std::make_unique<hebench::Utilities::TimingReportEx>(p_token->getDescription().header));
+        bool b_valid;
+        {
+            // engine only allows one benchmark at a time:
+            // benchmark is destroyed at the end of this scope
+            IBenchmark::Ptr p_bench = engine.createBenchmark(p_token, *reports.back());
+            b_valid                 = p_bench->run(*reports.back(), run_config);
+        }
+        if (!b_valid)
+            return false;
+
+        double throughput = computeThroughput(*reports.back());
+        ss                = std::stringstream();
+        ss << "Batch sweep: throughput " << throughput << " results/s";
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+        if (actual_batch_size != batch_size)
+        {
+            ss = std::stringstream();
+            ss << "Backend does not support flexible sample size for parameter " << sweep_config.param_index
+               << " (requested " << batch_size << "). Batch sweep stopped.";
+            std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+        } // end if
+        sweep.record(actual_batch_size, throughput);
+    } // end while
+
+    // report the run with the optimum batch size
+
+    const hebench::Utilities::TimingReportEx &optimum_report = *reports.at(sweep.getOptimumIndex());
+    out_report.setHeader(optimum_report.getHeader());
+    std::uint32_t main_event_id = optimum_report.getMainEventType();
+    for (std::uint64_t type_i = 0; type_i < optimum_report.getEventTypeCount(); ++type_i)
+    {
+        std::uint32_t event_type_id = optimum_report.getEventType(type_i);
+        out_report.addEventType(event_type_id,
+                                optimum_report.getEventTypeHeader(event_type_id),
+                                event_type_id == main_event_id);
+    } // end for
+    out_report.setEventCapacity(out_report.getEventCapacity() + optimum_report.getEventCount());
+    for (std::uint64_t event_i = 0; event_i < optimum_report.getEventCount(); ++event_i)
+    {
+        hebench::ReportGen::TimingReportEventC event;
+        optimum_report.getEvent(event, event_i);
+        out_report.addEvent(event);
+    } // end for
+    if (!optimum_report.getFooter().empty())
+        out_report.appendFooter(optimum_report.getFooter());
+    sweep.appendSweepReport(out_report);
+
+    std::stringstream ss;
+    ss << "Batch sweep optimum: batch size " << sweep.getPoints()[sweep.getOptimumIndex()].batch_size
+       << ", throughput " << sweep.getPoints()[sweep.getOptimumIndex()].throughput << " results/s";
+    std::cout << std::endl
+              << IOS_MSG_OK << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+    return true;
+}
+
+BatchSweep::BatchSweep(const Config &config) :
+    m_config(config),
+    m_next(config.min_batch_size),
+    m_b_done(false),
+    m_b_bisecting(false),
+    m_lo({ 0, 0.0 }),
+    m_hi({ 0, 0.0 })
+{
+    if (config.strategy != Strategy::Geometric
+        && config.strategy != Strategy::Bisection)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid batch sweep strategy: `config.strategy`."));
+    if (config.min_batch_size < 1 || config.max_batch_size < config.min_batch_size)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid batch size range for batch sweep: `config.min_batch_size` must be positive and not greater than `config.max_batch_size`."));
+    if (!std::isfinite(config.growth_factor) || config.growth_factor <= 1.0)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Batch sweep growth factor must be greater than 1: `config.growth_factor`."));
+    if (!std::isfinite(config.min_gain) || config.min_gain < 0.0)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Batch sweep minimum gain cannot be negative: `config.min_gain`."));
+}
+
+void BatchSweep::record(std::uint64_t batch_size, double throughput)
+{
+    if (m_b_done)
+        throw std::logic_error(IL_LOG_MSG_CLASS("Batch sweep already completed."));
+
+    m_points.push_back({ batch_size, throughput });
+
+    if (batch_size != m_next)
+        // backend did not honor the requested batch size
+        m_b_done = true;
+    else if (m_b_bisecting)
+    {
+        double best_throughput = 0.0;
+        for (const Point &point : m_points)
+            best_throughput = std::max(best_throughput, point.throughput);
+
+        if (throughput * (1.0 + m_config.min_gain) >= best_throughput)
+            m_hi = m_points.back(); // already on the plateau
+        else
+            m_lo = m_points.back();
+
+        if (m_hi.batch_size - m_lo.batch_size <= 1)
+            m_b_done = true;
+        else
+            m_next = m_lo.batch_size + (m_hi.batch_size - m_lo.batch_size) / 2;
+    } // end else if
+    else
+    {
+        // geometric growth
+        bool b_saturated = false;
+        if (m_points.size() > 1)
+        {
+            const Point &prev = m_points[m_points.size() - 2];
+            b_saturated       = throughput < prev.throughput * (1.0 + m_config.min_gain);
+        } // end if
+
+        if (b_saturated
+            && m_config.strategy == Strategy::Bisection
+            && m_points.size() > 2
+            && m_points[m_points.size() - 2].batch_size - m_points[m_points.size() - 3].batch_size > 1)
+        {
+            // the previous batch size already reached the plateau, but the one
+            // before it did not: the smallest batch size on the plateau is between them
+            m_b_bisecting = true;
+            m_lo          = m_points[m_points.size() - 3];
+            m_hi          = m_points[m_points.size() - 2];
+            m_next        = m_lo.batch_size + (m_hi.batch_size - m_lo.batch_size) / 2;
+        } // end if
+        else if (b_saturated || batch_size >= m_config.max_batch_size)
+            m_b_done = true;
+        else
+        {
+            std::uint64_t next_batch_size =
+                static_cast<std::uint64_t>(std::ceil(static_cast<double>(batch_size) * m_config.growth_factor));
+            m_next = std::min(m_config.max_batch_size, std::max(batch_size + 1, next_batch_size));
+        } // end else
+    } // end else
+}
+
+std::size_t BatchSweep::getOptimumIndex() const
+{
+    if (m_points.empty())
+        throw std::logic_error(IL_LOG_MSG_CLASS("No batch sizes recorded."));
+
+    double best_throughput = 0.0;
+    for (const Point &point : m_points)
+        best_throughput = std::max(best_throughput, point.throughput);
+
+    std::size_t retval = m_points.size();
+    for (std::size_t i = 0; i < m_points.size(); ++i)
+    {
+        if (m_points[i].throughput * (1.0 + m_config.min_gain) >= best_throughput
+            && (retval >= m_points.size() || m_points[i].batch_size < m_points[retval].batch_size))
+            retval = i;
+    } // end for
+
+    return retval;
+}
+
+void BatchSweep::appendSweepReport(hebench::Utilities::TimingReportEx &out_report) const
+{
+    std::vector<Point> points = m_points;
+    std::sort(points.begin(), points.end(),
+              [](const Point &a, const Point &b) { return a.batch_size < b.batch_size; });
+    const Point &optimum = m_points[getOptimumIndex()];
+
+    std::stringstream ss;
+    ss << "Batch sweep, " << getStrategyName(m_config.strategy) << std::endl
+       << "Swept parameter, " << m_config.param_index << std::endl
+       << "Minimum throughput gain (%), " << m_config.min_gain * 100.0 << std::endl
+       << "Throughput vs batch size" << std::endl
+       << "Batch size, Throughput (results/s), Gain (%)" << std::endl;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        ss << points[i].batch_size << ", " << points[i].throughput << ", ";
+        if (i > 0 && points[i - 1].throughput > 0.0)
+            ss << (points[i].throughput / points[i - 1].throughput - 1.0) * 100.0;
+        ss << std::endl;
+    } // end for
+    ss << "Optimum batch size, " << optimum.batch_size << std::endl
+       << "Optimum throughput (results/s), " << optimum.throughput << std::endl;
+    out_report.appendFooter(ss.str());
+}
+
+} // namespace TestHarness
+} // namespace hebench
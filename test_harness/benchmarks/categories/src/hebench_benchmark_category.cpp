@@ -9,12 +9,30 @@
 #include "hebench/api_bridge/api.h"
 
 #include "../include/hebench_benchmark_category.h"
-#include "hebench/modules/general/include/hebench_math_utils.h"
 #include "include/hebench_utilities_harness.h"
 
 namespace hebench {
 namespace TestHarness {
 
+namespace {
+
+std::string describeTolerance(const BenchmarkDescription::ValidationTolerance &tolerance)
+{
+    using Model = BenchmarkDescription::ValidationTolerance::Model;
+
+    std::stringstream ss;
+    ss << BenchmarkDescription::ValidationTolerance::getModelName(tolerance.model);
+    if (tolerance.model == Model::Relative || tolerance.model == Model::Mixed)
+        ss << ", relative " << tolerance.relative;
+    if (tolerance.model == Model::Absolute || tolerance.model == Model::Mixed)
+        ss << ", absolute " << tolerance.absolute;
+    if (tolerance.model == Model::ULP || tolerance.model == Model::Mixed)
+        ss << ", ULP " << tolerance.ulp;
+    return ss.str();
+}
+
+} // namespace
+
 //-------------------
 // struct RAIIHandle
 //-------------------
@@ -99,6 +117,9 @@ bool PartialBenchmarkCategory::validateResult(IDataLoader::Ptr dataset,
     static constexpr const std::size_t MaxErrorPrint = 10;
     bool retval                                      = true;
     std::vector<std::uint64_t> is_valid;
+    const BenchmarkDescription::ValidationTolerance &tolerance =
+        this->getBenchmarkConfiguration().validation_tolerance;
+    hebench::Utilities::ValidationErrorStats stats;
 
     // extract the pointers to the actual results
 
@@ -146,31 +167,35 @@ bool PartialBenchmarkCategory::validateResult(IDataLoader::Ptr dataset,
             switch (data_type)
             {
             case hebench::APIBridge::DataType::Int32:
-                is_valid = hebench::Utilities::Math::almostEqual(reinterpret_cast<const std::int32_t *>(p_truth),
-                                                                 reinterpret_cast<const std::int32_t *>(p_output),
-                                                                 count,
-                                                                 0.01);
+                is_valid = hebench::Utilities::findNotWithinTolerance(reinterpret_cast<const std::int32_t *>(p_truth),
+                                                                      reinterpret_cast<const std::int32_t *>(p_output),
+                                                                      count,
+                                                                      tolerance,
+                                                                      &stats);
                 break;
 
             case hebench::APIBridge::DataType::Int64:
-                is_valid = hebench::Utilities::Math::almostEqual(reinterpret_cast<const std::int64_t *>(p_truth),
-                                                                 reinterpret_cast<const std::int64_t *>(p_output),
-                                                                 count,
-                                                                 0.01);
+                is_valid = hebench::Utilities::findNotWithinTolerance(reinterpret_cast<const std::int64_t *>(p_truth),
+                                                                      reinterpret_cast<const std::int64_t *>(p_output),
+                                                                      count,
+                                                                      tolerance,
+                                                                      &stats);
                 break;
 
             case hebench::APIBridge::DataType::Float32:
-                is_valid = hebench::Utilities::Math::almostEqual(reinterpret_cast<const float *>(p_truth),
-                                                                 reinterpret_cast<const float *>(p_output),
-                                                                 count,
-                                                                 0.01);
+                is_valid = hebench::Utilities::findNotWithinTolerance(reinterpret_cast<const float *>(p_truth),
+                                                                      reinterpret_cast<const float *>(p_output),
+                                                                      count,
+                                                                      tolerance,
+                                                                      &stats);
                 break;
 
             case hebench::APIBridge::DataType::Float64:
-                is_valid = hebench::Utilities::Math::almostEqual(reinterpret_cast<const double *>(p_truth),
-                                                                 reinterpret_cast<const double *>(p_output),
-                                                                 count,
-                                                                 0.01);
+                is_valid = hebench::Utilities::findNotWithinTolerance(reinterpret_cast<const double *>(p_truth),
+                                                                      reinterpret_cast<const double *>(p_output),
+                                                                      count,
+                                                                      tolerance,
+                                                                      &stats);
                 break;
 
             default:
@@ -182,11 +207,14 @@ bool PartialBenchmarkCategory::validateResult(IDataLoader::Ptr dataset,
             retval = retval && is_valid.empty();
         } // end for
 
+        mergeValidationStats(stats);
+
         if (!retval)
         {
             std::stringstream ss;
             ss << "Result component, " << (index - 1) << std::endl
-               << "Elements not within 1% of each other, " << is_valid.size() << std::endl
+               << "Validation tolerance, " << describeTolerance(tolerance) << std::endl
+               << "Elements not within tolerance, " << is_valid.size() << std::endl
                << "Failed indices, ";
             for (std::size_t i = 0; i < is_valid.size() && i < MaxErrorPrint; ++i)
             {
@@ -207,6 +235,35 @@ bool PartialBenchmarkCategory::validateResult(IDataLoader::Ptr dataset,
     return retval;
 }
 
+void PartialBenchmarkCategory::appendValidationStats(hebench::Utilities::TimingReportEx &out_report) const
+{
+    hebench::Utilities::ValidationErrorStats stats;
+    {
+        std::lock_guard<std::mutex> lock(m_validation_stats_mutex);
+        stats = m_validation_stats;
+    }
+
+    if (stats.element_count > 0)
+    {
+        std::stringstream ss;
+        ss << "Validation tolerance, " << describeTolerance(this->getBenchmarkConfiguration().validation_tolerance) << std::endl
+           << "Validated elements, " << stats.element_count << std::endl
+           << "Max absolute error, " << stats.max_abs_error << std::endl
+           << "Max relative error, " << stats.max_rel_error << std::endl
+           << "RMSE, " << stats.getRMSE() << std::endl;
+        out_report.appendFooter(ss.str());
+    } // end if
+}
+
+void PartialBenchmarkCategory::mergeValidationStats(const hebench::Utilities::ValidationErrorStats &stats) const
+{
+    if (stats.element_count > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_validation_stats_mutex);
+        m_validation_stats.merge(stats);
+    } // end if
+}
+
 void PartialBenchmarkCategory::logResult(std::ostream &os,
                                          IDataLoader::Ptr dataset,
                                          const std::uint64_t *param_data_pack_indices,
@@ -3,12 +3,18 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <filesystem>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 
 #include "hebench/modules/timer/include/timer.h"
 
@@ -17,10 +23,37 @@
 #include "include/hebench_engine.h"
 
 #include "../include/hebench_benchmark_latency.h"
+#include "../include/hebench_benchmark_open_loop.h"
+#include "../include/hebench_benchmark_pipeline.h"
+#include "../include/hebench_benchmark_stopping_rule.h"
 
 namespace hebench {
 namespace TestHarness {
 
+/**
+ * @brief Timing events, latencies and results collected by a single stream
+ * during a multi-stream latency test.
+ */
+struct BenchmarkLatency::LatencyStream
+{
+    std::vector<hebench::ReportGen::TimingReportEventC> events;
+    std::vector<double> latencies; // milliseconds
+    std::vector<RAIIHandle> h_remote_results;
+    std::chrono::steady_clock::time_point time_start;
+    std::chrono::steady_clock::time_point time_end;
+};
+
+/**
+ * @brief Sample travelling through the stages of a pipelined latency test.
+ */
+struct BenchmarkLatency::PipelineItem
+{
+    std::uint64_t index;
+    std::vector<RAIIHandle> h_inputs; // local inputs, one per non-empty pack, until loaded
+    RAIIHandle h_data; // output of the last stage the sample went through
+    hebench::ReportGen::TimingReportEventC event_start; // first stage event
+};
+
 BenchmarkLatency::BenchmarkLatency(std::shared_ptr<Engine> p_engine,
                                    const IBenchmarkDescriptor::DescriptionToken &description_token) :
     PartialBenchmarkCategory(p_engine, description_token)
@@ -209,13 +242,22 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Loading data to remote backend...") << std::endl;
 
-    RAIIHandle h_inputs_remote;
-    timer.start();
-    validateRetCode(hebench::APIBridge::load(handle(),
-                                             h_inputs_local.data(), h_inputs_local.size(),
-                                             &h_inputs_remote.handle));
-    p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
-    out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+    // each stream of a multi-stream test operates on its own copy of the inputs in
+    // the remote backend: other tests only need one copy
+    bool b_multi_stream = run_config.arrival_process == IBenchmark::ArrivalProcess::Closed
+                          && !run_config.b_pipelined
+                          && run_config.latency_stream_count > 1;
+    std::uint64_t stream_count = b_multi_stream ? run_config.latency_stream_count : 1;
+    std::vector<RAIIHandle> h_inputs_remote(stream_count);
+    for (std::size_t stream_i = 0; stream_i < h_inputs_remote.size(); ++stream_i)
+    {
+        timer.start();
+        validateRetCode(hebench::APIBridge::load(handle(),
+                                                 h_inputs_local.data(), h_inputs_local.size(),
+                                                 &h_inputs_remote[stream_i].handle));
+        p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
+        out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+    } // end for
 
     std::cout << IOS_MSG_OK << std::endl;
 
@@ -226,9 +268,9 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
     h_inputs_local.clear();
     h_inputs.clear(); // input handles cleaned up automatically here
-    packed_parameters.clear();
-    packed_parameters_data_packs.clear();
     param_packs.clear();
+    // packed parameters only point to the dataset samples: they are kept until
+    // the end of the test to encode the samples again during pipelined tests
 
     // prepare parameter indexers for operation
 
@@ -273,7 +315,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
             RAIIHandle h_result_remote;
             timer.start();
             validateRetCode(hebench::APIBridge::operate(handle(),
-                                                        h_inputs_remote.handle,
+                                                        h_inputs_remote.front().handle,
                                                         params.data(), params.size(),
                                                         &h_result_remote.handle));
             p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
@@ -294,9 +336,57 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
             this->getBackendDescription().descriptor.cat_params.min_test_time_ms :
             this->getBenchmarkConfiguration().default_min_test_time_ms;
 
+    if (run_config.arrival_process != IBenchmark::ArrivalProcess::Closed)
+    {
+        // open loop: operations are issued on an arrival schedule instead of back to back
+        bool b_valid = runOpenLoop(out_report, p_dataset, run_config,
+                                   h_inputs_remote.front().handle, params,
+                                   min_test_time_ms);
+
+        h_inputs_remote.clear(); // input handles cleaned up automatically here
+        completeValidation(out_report, run_config);
+
+        std::cout << IOS_MSG_DONE << hebench::Logging::GlobalLogger::log("Test Completed.") << std::endl;
+
+        return b_valid;
+    } // end if
+
+    if (run_config.b_pipelined)
+    {
+        // pipelined: every phase is timed end-to-end for a stream of samples
+        h_inputs_remote.clear(); // stages load their own inputs
+        bool b_valid = runPipelined(out_report, p_dataset, run_config,
+                                    packed_parameters, params,
+                                    min_test_time_ms);
+
+        completeValidation(out_report, run_config);
+
+        std::cout << IOS_MSG_DONE << hebench::Logging::GlobalLogger::log("Test Completed.") << std::endl;
+
+        return b_valid;
+    } // end if
+
+    if (b_multi_stream)
+    {
+        // concurrent streams: operations are issued from several threads at the same time
+        bool b_valid = runMultiStream(out_report, p_dataset, run_config,
+                                      h_inputs_remote, params,
+                                      min_test_time_ms);
+
+        h_inputs_remote.clear(); // input handles cleaned up automatically here
+        completeValidation(out_report, run_config);
+
+        std::cout << IOS_MSG_DONE << hebench::Logging::GlobalLogger::log("Test Completed.") << std::endl;
+
+        return b_valid;
+    } // end if
+
+    StoppingRule stopping_rule(run_config.stopping_criteria, min_test_time_ms, 2);
+
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Starting latency test.") << std::endl
               << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Requested time: " + std::to_string(this->getBackendDescription().descriptor.cat_params.min_test_time_ms) + " ms") << std::endl
-              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Actual time: " + std::to_string(min_test_time_ms) + " ms") << std::endl;
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Actual time: " + std::to_string(min_test_time_ms) + " ms") << std::endl
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Stopping rule: " + stopping_rule.describe()) << std::endl;
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Testing...") << std::endl;
 
@@ -306,23 +396,46 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     out_report.addEventType(event_id, event_name, true);
 
     // measure the operation after warm up
+    std::uint64_t result_window   = run_config.latency_result_window;
+    std::uint64_t result_sampling = run_config.latency_result_sampling > 1 ? run_config.latency_result_sampling : 1;
+    PostprocessEventIDs postprocess_event_ids;
+    if (result_window > 0)
+    {
+        // bounded memory: results are post-processed in windows during the test,
+        // so, event IDs for post-processing are needed beforehand
+        postprocess_event_ids.store      = getEventIDNext();
+        postprocess_event_ids.decryption = getEventIDNext();
+        postprocess_event_ids.decoding   = getEventIDNext();
+
+        ss = std::stringstream();
+        ss << "Bounded memory: post-processing results in windows of " << result_window;
+        if (result_sampling > 1)
+            ss << " (sampling 1 out of every " << result_sampling << " results)";
+        ss << ".";
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    } // end if
+
     std::vector<RAIIHandle> h_remote_results;
-    h_remote_results.reserve(20); // initial capacity for 20 iterations
+    h_remote_results.reserve(result_window > 0 ? result_window : 20); // initial capacity for 20 iterations
     out_report.setEventCapacity(out_report.getEventCapacity() + h_remote_results.capacity());
-    std::uint64_t op_count = 0;
-    double elapsed_ms      = 0.0;
-    while (op_count < 2 || elapsed_ms < min_test_time_ms)
+    std::uint64_t op_count          = 0;
+    std::uint64_t postprocess_count = 0; // number of results post-processed so far
+    double elapsed_ms               = 0.0;
+    bool b_valid                    = true;
+    while (!stopping_rule.isDone())
     {
         hebench::APIBridge::Handle h_result_remote;
         timer.start();
         validateRetCode(hebench::APIBridge::operate(handle(),
-                                                    h_inputs_remote.handle,
+                                                    h_inputs_remote.front().handle,
                                                     params.data(), params.size(),
                                                     &h_result_remote));
         p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
         elapsed_ms += p_timing_event->elapsedWallTime<std::milli>();
+        stopping_rule.add(p_timing_event->elapsedWallTime<std::milli>());
         // check if we have enough capacity
-        if (h_remote_results.capacity() == h_remote_results.size()
+        if (result_window <= 0
+            && h_remote_results.capacity() == h_remote_results.size()
             && elapsed_ms > 0.0)
         {
             // capacity exceeded: over estimate capacity needed for the whole operation
@@ -335,29 +448,736 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
             h_remote_results.reserve(max_capacity);
         } // end if
         out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
-        h_remote_results.emplace_back(h_result_remote);
+
+        if (result_window <= 0)
+            h_remote_results.emplace_back(h_result_remote);
+        else
+        {
+            RAIIHandle h_result(h_result_remote);
+            // keep only the sampled results; the rest are destroyed right away
+            if (b_valid && op_count % result_sampling == 0)
+                h_remote_results.emplace_back(std::move(h_result));
+            if (h_remote_results.size() >= result_window)
+            {
+                // post-process the window outside of the timed region
+                b_valid = postprocessResults(out_report, p_dataset, run_config,
+                                             h_remote_results, postprocess_event_ids,
+                                             postprocess_count, false);
+                postprocess_count += result_window;
+            } // end if
+        } // end else
 
         ++op_count;
     } // end while
 
     std::cout << IOS_MSG_DONE << std::endl;
 
+    if (stopping_rule.isAdaptive())
+    {
+        ss = std::stringstream();
+        ss << "Operations: " << op_count << ". "
+           << "Achieved precision: " << stopping_rule.getMeanPrecision() * 100.0 << "% "
+           << "(" << StoppingRule::getStopReasonName(stopping_rule.getStopReason()) << ").";
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    } // end if
+    stopping_rule.appendStoppingReport(out_report);
+
     // clean up data we no longer need
 
     // destroyHandle(h_remote_inputs);
 
-    h_inputs_remote.destroy();
+    h_inputs_remote.clear(); // input handles cleaned up automatically here
 
     // postprocess output
 
+    if (result_window <= 0)
+    {
+        postprocess_event_ids.store      = getEventIDNext();
+        postprocess_event_ids.decryption = getEventIDNext();
+        postprocess_event_ids.decoding   = getEventIDNext();
+
+        b_valid = postprocessResults(out_report, p_dataset, run_config,
+                                     h_remote_results, postprocess_event_ids,
+                                     0, true);
+    } // end if
+    else
+    {
+        std::uint64_t last_window_count = h_remote_results.size();
+        if (b_valid && !h_remote_results.empty())
+            // post-process results left in the last window
+            b_valid = postprocessResults(out_report, p_dataset, run_config,
+                                         h_remote_results, postprocess_event_ids,
+                                         postprocess_count, false);
+        h_remote_results.clear();
+        postprocess_count += last_window_count;
+
+        ss = std::stringstream();
+        ss << "Post-processed results: " << postprocess_count << " out of " << op_count << ".";
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+        if (b_valid)
+            std::cout << IOS_MSG_OK << std::endl;
+        if (result_sampling > 1)
+        {
+            ss = std::stringstream();
+            ss << "Bounded memory latency test: " << postprocess_count << " out of " << op_count
+               << " operation results post-processed (sampling 1 out of every " << result_sampling << ")";
+            out_report.appendFooter(ss.str());
+        } // end if
+    } // end else
+
+    completeValidation(out_report, run_config);
+
+    std::cout << IOS_MSG_DONE << hebench::Logging::GlobalLogger::log("Test Completed.") << std::endl;
+
+    return b_valid;
+}
+
+bool BenchmarkLatency::runOpenLoop(hebench::Utilities::TimingReportEx &out_report,
+                                   IDataLoader::Ptr p_dataset,
+                                   IBenchmark::RunConfig &run_config,
+                                   const hebench::APIBridge::Handle &h_inputs_remote,
+                                   const std::vector<hebench::APIBridge::ParameterIndexer> &params,
+                                   std::uint64_t min_test_time_ms)
+{
+    using Clock = std::chrono::steady_clock;
+
+    if (run_config.arrival_rates.empty())
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("No arrival rates specified for open-loop latency test."));
+
+    std::stringstream ss;
+    hebench::Common::EventTimer<true> timer; // high precision
+    hebench::Common::TimingReportEvent::Ptr p_timing_event;
+
+    std::uint32_t event_id = getEventIDNext();
+    std::string event_name = "Operation";
+    out_report.addEventType(event_id, event_name, true);
+
+    // results are post-processed after each offered load, outside of the schedule,
+    // so, event IDs for post-processing are needed beforehand
+    PostprocessEventIDs postprocess_event_ids;
+    postprocess_event_ids.store      = getEventIDNext();
+    postprocess_event_ids.decryption = getEventIDNext();
+    postprocess_event_ids.decoding   = getEventIDNext();
+
+    std::uint64_t result_window   = run_config.latency_result_window;
+    std::uint64_t result_sampling = run_config.latency_result_sampling > 1 ? run_config.latency_result_sampling : 1;
+    double test_time_s            = min_test_time_ms / 1000.0;
+
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Starting open-loop latency test.") << std::endl
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Arrival process: " + IBenchmark::getArrivalProcessName(run_config.arrival_process)) << std::endl
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Time per offered load: " + std::to_string(min_test_time_ms) + " ms") << std::endl;
+
+    std::vector<OpenLoopLoadPoint> load_points;
+    load_points.reserve(run_config.arrival_rates.size());
+    std::uint64_t postprocess_count = 0; // number of results post-processed so far
+    bool b_valid                    = true;
+    for (std::size_t rate_i = 0; rate_i < run_config.arrival_rates.size(); ++rate_i)
+    {
+        double rate = run_config.arrival_rates[rate_i];
+        ArrivalSchedule schedule(run_config.arrival_process, rate,
+                                 hebench::Utilities::RandomGenerator::getRandomSeed() + rate_i);
+
+        ss = std::stringstream();
+        ss << rate << " ops/s";
+        std::string s_rate = ss.str();
+
+        std::uint32_t queueing_event_id = getEventIDNext();
+        std::string queueing_event_name = "Queueing delay (" + s_rate + ")";
+        std::uint32_t response_event_id = getEventIDNext();
+        std::string response_event_name = "Response time (" + s_rate + ")";
+        out_report.addEventType(queueing_event_id, queueing_event_name);
+        out_report.addEventType(response_event_id, response_event_name);
+
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Offered load: " + s_rate + ". Testing...") << std::endl;
+
+        // estimate the capacity needed for the whole offered load
+        std::size_t expected_count = static_cast<std::size_t>(rate * test_time_s) + 2;
+        out_report.setEventCapacity(out_report.getEventCapacity() + 3 * expected_count);
+        OpenLoopLoadPoint load_point(rate);
+        load_point.queueing_delays.reserve(expected_count);
+        load_point.service_times.reserve(expected_count);
+
+        std::vector<RAIIHandle> h_remote_results;
+        // unsampled results are destroyed after the load point so that destroying
+        // them does not delay the operations in the schedule
+        std::vector<RAIIHandle> h_discarded_results;
+        h_discarded_results.reserve(expected_count);
+        std::uint64_t op_count           = 0;
+        double elapsed_s                 = 0.0;
+        Clock::time_point schedule_start = Clock::now();
+        while (op_count < 2 || (schedule.peek() < test_time_s && elapsed_s < test_time_s))
+        {
+            // wait for the next arrival only if it has not arrived yet:
+            // otherwise, the operation has been queued while backend was busy
+            Clock::time_point arrival_time = schedule_start
+                                             + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(schedule.pop()));
+            std::this_thread::sleep_until(arrival_time);
+
+            hebench::APIBridge::Handle h_result_remote;
+            Clock::time_point service_start = Clock::now();
+            timer.start();
+            validateRetCode(hebench::APIBridge::operate(handle(),
+                                                        h_inputs_remote,
+                                                        params.data(), params.size(),
+                                                        &h_result_remote));
+            p_timing_event = timer.stop<DefaultTimeInterval>(event_id, 1, nullptr);
+            out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+
+            // queueing delay ends when the operation starts, and response time spans
+            // both, the queueing delay and the operation
+            std::chrono::duration<double, DefaultTimeInterval> queueing_delay =
+                std::max(service_start - arrival_time, Clock::duration::zero());
+            hebench::ReportGen::TimingReportEventC operation_event =
+                hebench::Utilities::TimingReportEx::convert2C<DefaultTimeInterval>(*p_timing_event);
+            hebench::ReportGen::TimingReportEventC queueing_event = operation_event;
+            queueing_event.event_type_id                          = queueing_event_id;
+            queueing_event.wall_time_end                          = operation_event.wall_time_start;
+            queueing_event.wall_time_start                        = operation_event.wall_time_start - queueing_delay.count();
+            queueing_event.cpu_time_end                           = operation_event.cpu_time_start;
+            out_report.addEvent(queueing_event);
+            hebench::ReportGen::TimingReportEventC response_event = operation_event;
+            response_event.event_type_id                          = response_event_id;
+            response_event.wall_time_start                        = queueing_event.wall_time_start;
+            out_report.addEvent(response_event);
+
+            load_point.queueing_delays.push_back(std::chrono::duration<double, std::milli>(queueing_delay).count());
+            load_point.service_times.push_back(p_timing_event->elapsedWallTime<std::milli>());
+
+            RAIIHandle h_result(h_result_remote);
+            // keep only the sampled results, up to the result window, for post-processing
+            if (b_valid
+                && op_count % result_sampling == 0
+                && (result_window <= 0 || h_remote_results.size() < result_window))
+                h_remote_results.emplace_back(std::move(h_result));
+            else
+                h_discarded_results.emplace_back(std::move(h_result));
+
+            ++op_count;
+            elapsed_s = std::chrono::duration<double>(Clock::now() - schedule_start).count();
+        } // end while
+        load_point.elapsed_ms = elapsed_s * 1000.0;
+        // operations that arrived before the end of the test, but were never issued,
+        // waited, at least, until the end of the test
+        while (schedule.peek() < std::min(elapsed_s, test_time_s))
+            load_point.unserved_delays.push_back((elapsed_s - schedule.pop()) * 1000.0);
+        h_discarded_results.clear();
+
+        std::cout << IOS_MSG_DONE << std::endl;
+
+        ss = std::stringstream();
+        ss << "Achieved throughput: " << load_point.getAchievedRate() << " ops/s. "
+           << "Mean response time: " << hebench::Utilities::computeMean(load_point.getResponseTimes()) << " ms.";
+        if (load_point.isSaturated())
+            ss << " Backend saturated: " << load_point.unserved_delays.size() << " operations left unserved"
+               << " (response time is a lower bound).";
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+        // post-process the results of this offered load outside of the schedule
+        std::uint64_t window_count = h_remote_results.size();
+        if (b_valid && !h_remote_results.empty())
+            b_valid = postprocessResults(out_report, p_dataset, run_config,
+                                         h_remote_results, postprocess_event_ids,
+                                         postprocess_count, false);
+        h_remote_results.clear();
+        postprocess_count += window_count;
+
+        load_points.emplace_back(std::move(load_point));
+    } // end for
+
+    ss = std::stringstream();
+    ss << "Post-processed results: " << postprocess_count << ".";
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    if (b_valid)
+        std::cout << IOS_MSG_OK << std::endl;
+
+    OpenLoopLoadPoint::appendLatencyCurve(out_report, run_config.arrival_process, load_points);
+
+    return b_valid;
+}
+
+bool BenchmarkLatency::runMultiStream(hebench::Utilities::TimingReportEx &out_report,
+                                      IDataLoader::Ptr p_dataset,
+                                      IBenchmark::RunConfig &run_config,
+                                      const std::vector<RAIIHandle> &h_inputs_remote,
+                                      const std::vector<hebench::APIBridge::ParameterIndexer> &params,
+                                      std::uint64_t min_test_time_ms)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::stringstream ss;
+    std::size_t stream_count = h_inputs_remote.size();
+
+    std::uint32_t event_id = getEventIDNext();
+    std::string event_name = "Operation";
+    out_report.addEventType(event_id, event_name, true);
+
+    std::uint64_t result_window   = run_config.latency_result_window;
+    std::uint64_t result_sampling = run_config.latency_result_sampling > 1 ? run_config.latency_result_sampling : 1;
+
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Starting multi-stream latency test.") << std::endl
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Streams: " + std::to_string(stream_count)) << std::endl
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Time per stream: " + std::to_string(min_test_time_ms) + " ms") << std::endl;
+
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Testing...") << std::endl;
+
+    std::vector<LatencyStream> streams(stream_count);
+    std::atomic<std::size_t> ready_count(0);
+    std::atomic<bool> b_abort(false);
+    auto run_stream = [&, this](std::uint64_t first, std::uint64_t last) {
+        assert(last == first + 1); // one stream per thread
+        (void)last;
+
+        LatencyStream &stream     = streams[first];
+        std::string s_description = "Stream " + std::to_string(first);
+        hebench::Common::EventTimer<true> timer; // high precision
+        stream.events.reserve(20); // initial capacity for 20 iterations
+        stream.latencies.reserve(stream.events.capacity());
+
+        // all streams start at the same time
+        ++ready_count;
+        while (ready_count < stream_count)
+            std::this_thread::yield();
+
+        try
+        {
+            std::uint64_t op_count = 0;
+            double elapsed_ms      = 0.0;
+            stream.time_start      = Clock::now();
+            while (!b_abort && (op_count < 2 || elapsed_ms < min_test_time_ms))
+            {
+                hebench::APIBridge::Handle h_result_remote;
+                timer.start();
+                validateRetCode(hebench::APIBridge::operate(handle(),
+                                                            h_inputs_remote[first].handle,
+                                                            params.data(), params.size(),
+                                                            &h_result_remote));
+                hebench::Common::TimingReportEvent::Ptr p_timing_event =
+                    timer.stop<DefaultTimeInterval>(event_id, 1, s_description.c_str());
+                RAIIHandle h_result(h_result_remote);
+
+                stream.events.push_back(hebench::Utilities::TimingReportEx::convert2C<DefaultTimeInterval>(*p_timing_event));
+                stream.latencies.push_back(p_timing_event->elapsedWallTime<std::milli>());
+                // keep only the sampled results, up to the result window; the rest are destroyed right away
+                if (op_count % result_sampling == 0
+                    && (result_window <= 0 || stream.h_remote_results.size() < result_window))
+                    stream.h_remote_results.emplace_back(std::move(h_result));
+
+                ++op_count;
+                elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - stream.time_start).count();
+            } // end while
+            stream.time_end = Clock::now();
+        }
+        catch (...)
+        {
+            // stop the rest of the streams as soon as possible
+            b_abort = true;
+            throw;
+        }
+    };
+    hebench::Utilities::parallelForChunks(stream_count, run_stream, 1, stream_count);
+
+    std::cout << IOS_MSG_DONE << std::endl;
+
+    // collect events and results from all streams
+
+    std::uint64_t op_count = 0;
+    for (const LatencyStream &stream : streams)
+        op_count += stream.events.size();
+    out_report.setEventCapacity(out_report.getEventCapacity() + op_count);
+    std::vector<RAIIHandle> h_remote_results;
+    std::vector<double> latencies;
+    latencies.reserve(op_count);
+    Clock::time_point time_start = streams.front().time_start;
+    Clock::time_point time_end   = streams.front().time_end;
+    for (LatencyStream &stream : streams)
+    {
+        for (const auto &event : stream.events)
+            out_report.addEvent(event);
+        latencies.insert(latencies.end(), stream.latencies.begin(), stream.latencies.end());
+        for (auto &h_result : stream.h_remote_results)
+            h_remote_results.emplace_back(std::move(h_result));
+        time_start = std::min(time_start, stream.time_start);
+        time_end   = std::max(time_end, stream.time_end);
+
+        stream.events.clear();
+        stream.h_remote_results.clear();
+    } // end for
+
+    // report per stream and aggregate latency and throughput
+
+    ss = std::stringstream();
+    ss << "Streams, " << stream_count << std::endl
+       << "Multi-stream latency (ms)" << std::endl
+       << "Stream, Operations, Throughput (ops/s), Latency mean, Latency p50, Latency p90, Latency p99" << std::endl;
+    for (std::size_t stream_i = 0; stream_i < streams.size(); ++stream_i)
+    {
+        const LatencyStream &stream = streams[stream_i];
+        double elapsed_s            = std::chrono::duration<double>(stream.time_end - stream.time_start).count();
+        ss << stream_i << ", "
+           << stream.latencies.size() << ", "
+           << (elapsed_s > 0.0 ? stream.latencies.size() / elapsed_s : 0.0) << ", "
+           << hebench::Utilities::computeMean(stream.latencies) << ", "
+           << hebench::Utilities::computePercentile(stream.latencies, 50.0) << ", "
+           << hebench::Utilities::computePercentile(stream.latencies, 90.0) << ", "
+           << hebench::Utilities::computePercentile(stream.latencies, 99.0) << std::endl;
+    } // end for
+    double elapsed_s      = std::chrono::duration<double>(time_end - time_start).count();
+    double aggregate_rate = elapsed_s > 0.0 ? latencies.size() / elapsed_s : 0.0;
+    double aggregate_mean = hebench::Utilities::computeMean(latencies);
+    ss << "Aggregate, "
+       << latencies.size() << ", "
+       << aggregate_rate << ", "
+       << aggregate_mean << ", "
+       << hebench::Utilities::computePercentile(latencies, 50.0) << ", "
+       << hebench::Utilities::computePercentile(latencies, 90.0) << ", "
+       << hebench::Utilities::computePercentile(latencies, 99.0) << std::endl;
+    out_report.appendFooter(ss.str());
+
+    ss = std::stringstream();
+    ss << "Aggregate throughput: " << aggregate_rate << " ops/s. "
+       << "Mean latency: " << aggregate_mean << " ms.";
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+    // post-process the results of all streams
+
+    PostprocessEventIDs postprocess_event_ids;
+    postprocess_event_ids.store      = getEventIDNext();
+    postprocess_event_ids.decryption = getEventIDNext();
+    postprocess_event_ids.decoding   = getEventIDNext();
+    return postprocessResults(out_report, p_dataset, run_config,
+                              h_remote_results, postprocess_event_ids,
+                              0, true);
+}
+
+bool BenchmarkLatency::runPipelined(hebench::Utilities::TimingReportEx &out_report,
+                                    IDataLoader::Ptr p_dataset,
+                                    IBenchmark::RunConfig &run_config,
+                                    const std::vector<hebench::APIBridge::DataPackCollection> &packed_parameters,
+                                    const std::vector<hebench::APIBridge::ParameterIndexer> &params,
+                                    std::uint64_t min_test_time_ms)
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Stage
+    {
+        std::string name;
+        std::uint32_t event_id;
+        std::function<void(PipelineItem &)> process;
+    };
+
+    std::stringstream ss;
+    std::uint64_t queue_size = run_config.pipeline_queue_size > 0 ? run_config.pipeline_queue_size : 1;
+
+    // decoding buffers: allocated once and reused by the last stage for every sample
+
+    std::vector<std::uint8_t> raw_result_buffer;
+    std::uint64_t max_raw_result_size = 0;
+    for (std::uint64_t result_pos = 0; result_pos < p_dataset->getResultCount(); ++result_pos)
+    {
+        if (p_dataset->getResultData(result_pos).buffer_count <= 0
+            || !p_dataset->getResultData(result_pos).p_buffers)
+            throw std::logic_error(IL_LOG_MSG_CLASS("Invalid empty NativeDataBuffer in IDataLoader `p_dataset` at result " + std::to_string(result_pos) + "."));
+        max_raw_result_size += p_dataset->getResultData(result_pos).p_buffers[0].size;
+    } // end for
+    raw_result_buffer.resize(max_raw_result_size);
+
+    std::vector<hebench::APIBridge::NativeDataBuffer> raw_results(p_dataset->getResultCount(),
+                                                                  hebench::APIBridge::NativeDataBuffer({ 0, 0, 0 }));
+    std::vector<hebench::APIBridge::DataPack> results_pack(p_dataset->getResultCount());
+    std::uint64_t offset_p = 0;
+    for (std::uint64_t result_pos = 0; result_pos < p_dataset->getResultCount(); ++result_pos)
+    {
+        raw_results[result_pos].p    = raw_result_buffer.data() + offset_p;
+        raw_results[result_pos].size = p_dataset->getResultData(result_pos).p_buffers[0].size;
+        raw_results[result_pos].tag  = 0;
+        offset_p += raw_results[result_pos].size;
+
+        results_pack[result_pos].p_buffers      = &raw_results[result_pos];
+        results_pack[result_pos].buffer_count   = 1;
+        results_pack[result_pos].param_position = result_pos;
+    } // end for
+    hebench::APIBridge::DataPackCollection packed_results;
+    packed_results.p_data_packs = results_pack.data();
+    packed_results.pack_count   = results_pack.size();
+
+    // stages
+
+    std::vector<Stage> stages;
+    stages.push_back({ "Encoding", getEventIDNext(), [&, this](PipelineItem &item) {
+                          for (std::size_t i = 0; i < packed_parameters.size(); ++i)
+                          {
+                              if (packed_parameters[i].pack_count > 0)
+                              {
+                                  RAIIHandle h_input;
+                                  validateRetCode(hebench::APIBridge::encode(handle(), &packed_parameters[i], &h_input.handle));
+                                  item.h_inputs.emplace_back(std::move(h_input));
+                              } // end if
+                          } // end for
+                      } });
+    if (packed_parameters.front().pack_count > 0)
+        // encrypted parameters are always in the first pack
+        stages.push_back({ "Encryption", getEventIDNext(), [this](PipelineItem &item) {
+                              hebench::APIBridge::Handle encrypted_input;
+                              validateRetCode(hebench::APIBridge::encrypt(handle(), item.h_inputs.front().handle, &encrypted_input));
+                              item.h_inputs.front() = encrypted_input; // old handle automatically destroyed by RAII
+                          } });
+    stages.push_back({ "Loading", getEventIDNext(), [this](PipelineItem &item) {
+                          std::vector<hebench::APIBridge::Handle> h_inputs_local(item.h_inputs.size());
+                          for (std::size_t i = 0; i < item.h_inputs.size(); ++i)
+                              h_inputs_local[i] = item.h_inputs[i].handle;
+                          validateRetCode(hebench::APIBridge::load(handle(),
+                                                                   h_inputs_local.data(), h_inputs_local.size(),
+                                                                   &item.h_data.handle));
+                          item.h_inputs.clear();
+                      } });
+    stages.push_back({ "Operation", getEventIDNext(), [&params, this](PipelineItem &item) {
+                          hebench::APIBridge::Handle h_result_remote;
+                          validateRetCode(hebench::APIBridge::operate(handle(),
+                                                                      item.h_data.handle,
+                                                                      params.data(), params.size(),
+                                                                      &h_result_remote));
+                          item.h_data = h_result_remote; // remote inputs automatically destroyed by RAII
+                      } });
+    stages.push_back({ "Store", getEventIDNext(), [this](PipelineItem &item) {
+                          hebench::APIBridge::Handle h_cipher_result;
+                          validateRetCode(hebench::APIBridge::store(handle(), item.h_data.handle, &h_cipher_result, 1));
+                          item.h_data = h_cipher_result;
+                      } });
+    stages.push_back({ "Decryption", getEventIDNext(), [this](PipelineItem &item) {
+                          hebench::APIBridge::Handle h_plain_result;
+                          validateRetCode(hebench::APIBridge::decrypt(handle(), item.h_data.handle, &h_plain_result));
+                          item.h_data = h_plain_result;
+                      } });
+    stages.push_back({ "Decoding", getEventIDNext(), [&packed_results, this](PipelineItem &item) {
+                          validateRetCode(hebench::APIBridge::decode(handle(), item.h_data.handle, &packed_results));
+                          item.h_data.destroy();
+                      } });
+
+    std::uint32_t event_id = getEventIDNext();
+    std::string event_name = "End-to-end";
+    out_report.addEventType(event_id, event_name, true);
+    for (const Stage &stage : stages)
+        out_report.addEventType(stage.event_id, stage.name);
+
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Starting pipelined latency test.") << std::endl
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Stages: " + std::to_string(stages.size())) << std::endl
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Queue size: " + std::to_string(queue_size)) << std::endl
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Requested time: " + std::to_string(min_test_time_ms) + " ms") << std::endl;
+
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Testing...") << std::endl;
+
+    // run every stage in its own thread
+
+    std::vector<std::unique_ptr<BoundedQueue<PipelineItem>>> queues(stages.size() - 1);
+    for (auto &p_queue : queues)
+        p_queue = std::make_unique<BoundedQueue<PipelineItem>>(queue_size);
+    std::vector<PipelineStageStats> stage_stats;
+    for (const Stage &stage : stages)
+        stage_stats.emplace_back(stage.name);
+    std::vector<std::vector<hebench::ReportGen::TimingReportEventC>> stage_events(stages.size());
+    std::vector<hebench::ReportGen::TimingReportEventC> end_to_end_events;
+    std::vector<double> completion_times; // milliseconds from the start of the test
+    std::atomic<bool> b_abort(false);
+    bool b_valid = true;
+    std::string s_validation_failure;
+    Clock::time_point time_start = Clock::now();
+
+    auto run_stage = [&, this](std::uint64_t stage_i, std::uint64_t last) {
+        assert(last == stage_i + 1); // one stage per thread
+        (void)last;
+
+        const Stage &stage                = stages[stage_i];
+        PipelineStageStats &stats         = stage_stats[stage_i];
+        BoundedQueue<PipelineItem> *p_in  = stage_i > 0 ? queues[stage_i - 1].get() : nullptr;
+        BoundedQueue<PipelineItem> *p_out = stage_i < queues.size() ? queues[stage_i].get() : nullptr;
+        hebench::Common::EventTimer<true> timer; // high precision
+        hebench::Common::TimingReportEvent::Ptr p_timing_event;
+
+        try
+        {
+            while (!b_abort)
+            {
+                PipelineItem item;
+                Clock::time_point wait_start = Clock::now();
+                if (p_in)
+                {
+                    if (!p_in->pop(item))
+                        break; // previous stage is done
+                } // end if
+                else
+                {
+                    // first stage feeds new samples until the test time elapses
+                    double elapsed_ms = std::chrono::duration<double, std::milli>(wait_start - time_start).count();
+                    if (stats.item_count >= 2 && elapsed_ms >= min_test_time_ms)
+                        break;
+                    item.index = stats.item_count;
+                } // end else
+                stats.starvation_ms += std::chrono::duration<double, std::milli>(Clock::now() - wait_start).count();
+
+                timer.start();
+                stage.process(item);
+                p_timing_event = timer.stop<DefaultTimeInterval>(stage.event_id, 1, nullptr);
+                stage_events[stage_i].push_back(hebench::Utilities::TimingReportEx::convert2C<DefaultTimeInterval>(*p_timing_event));
+                stats.busy_ms += p_timing_event->elapsedWallTime<std::milli>();
+                ++stats.item_count;
+                if (!p_in)
+                    item.event_start = stage_events[stage_i].back();
+
+                if (p_out)
+                {
+                    wait_start = Clock::now();
+                    if (!p_out->push(std::move(item)))
+                        break; // next stage stopped
+                    stats.backpressure_ms += std::chrono::duration<double, std::milli>(Clock::now() - wait_start).count();
+                } // end if
+                else
+                {
+                    // sample completed the pipeline
+                    completion_times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - time_start).count());
+                    hebench::ReportGen::TimingReportEventC end_to_end_event = item.event_start;
+                    end_to_end_event.event_type_id                          = event_id;
+                    end_to_end_event.cpu_time_end                           = stage_events[stage_i].back().cpu_time_end;
+                    end_to_end_event.wall_time_end                          = stage_events[stage_i].back().wall_time_end;
+                    end_to_end_events.push_back(end_to_end_event);
+
+                    // validate output outside of the timed region
+                    if (run_config.b_validate_results)
+                    {
+                        std::string s_error_msg;
+                        std::vector<std::uint64_t> data_pack_indices(p_dataset->getParameterCount(), 0);
+                        std::vector<hebench::APIBridge::NativeDataBuffer *> outputs(p_dataset->getResultCount());
+                        bool b_item_valid;
+                        try
+                        {
+                            for (std::uint64_t i = 0; i < packed_results.pack_count; ++i)
+                            {
+                                if (packed_results.p_data_packs[i].param_position >= outputs.size())
+                                    throw std::runtime_error("Invalid result position received from decoding.");
+                                if (packed_results.p_data_packs[i].buffer_count <= 0)
+                                    throw std::runtime_error("Invalid empty result buffers received from decoding.");
+                                outputs[packed_results.p_data_packs[i].param_position] =
+                                    &packed_results.p_data_packs[i].p_buffers[0];
+                            } // end for
+                            b_item_valid = validateResult(p_dataset, data_pack_indices.data(),
+                                                          outputs,
+                                                          this->getBackendDescription().descriptor.data_type);
+                        }
+                        catch (std::exception &ex)
+                        {
+                            b_item_valid = false;
+                            s_error_msg  = ex.what();
+                        }
+                        catch (...)
+                        {
+                            b_item_valid = false;
+                        }
+
+                        if (!b_item_valid)
+                        {
+                            ss = std::stringstream();
+                            ss << "Validation failed" << std::endl
+                               << "Result, " << item.index + 1 << std::endl;
+                            if (!s_error_msg.empty())
+                                ss << s_error_msg << std::endl;
+                            ss << std::endl;
+                            logResult(ss, p_dataset, data_pack_indices.data(),
+                                      outputs,
+                                      this->getBackendDescription().descriptor.data_type);
+                            s_validation_failure = ss.str();
+                            b_valid              = false;
+                            b_abort              = true;
+                        } // end if
+                    } // end if
+                } // end else
+            } // end while
+        }
+        catch (...)
+        {
+            // stop the rest of the stages as soon as possible
+            b_abort = true;
+            for (auto &p_queue : queues)
+                p_queue->close();
+            throw;
+        }
+
+        // release the stages waiting on this one
+        if (p_in)
+            p_in->close();
+        if (p_out)
+            p_out->close();
+    };
+    hebench::Utilities::parallelForChunks(stages.size(), run_stage, 1, stages.size());
+    queues.clear(); // samples left behind are cleaned up automatically here
+
+    std::cout << IOS_MSG_DONE << std::endl;
+
+    // collect events from all stages
+
+    std::size_t event_count = end_to_end_events.size();
+    for (const auto &events : stage_events)
+        event_count += events.size();
+    out_report.setEventCapacity(out_report.getEventCapacity() + event_count);
+    for (const auto &events : stage_events)
+        for (const auto &event : events)
+            out_report.addEvent(event);
+    for (const auto &event : end_to_end_events)
+        out_report.addEvent(event);
+
+    PipelineStageStats::appendPipelineReport(out_report, queue_size, completion_times, stage_stats);
+
+    ss = std::stringstream();
+    ss << "Samples completed: " << completion_times.size() << ". "
+       << "End-to-end throughput: "
+       << (completion_times.empty() || completion_times.back() <= 0.0 ? 0.0 : completion_times.size() * 1000.0 / completion_times.back())
+       << " ops/s.";
+    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+    if (!b_valid)
+    {
+        std::cout << IOS_MSG_FAILED << hebench::Logging::GlobalLogger::log(s_validation_failure) << std::endl;
+        out_report.appendFooter(s_validation_failure);
+    } // end if
+    else if (run_config.b_validate_results)
+        std::cout << IOS_MSG_OK << std::endl;
+
+    return b_valid;
+}
+
+void BenchmarkLatency::completeValidation(hebench::Utilities::TimingReportEx &out_report,
+                                          const IBenchmark::RunConfig &run_config) const
+{
+    if (!run_config.b_validate_results)
+    {
+        out_report.prependFooter("Validation skipped");
+        std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("Validation skipped.") << std::endl;
+    } // end if
+    else
+        appendValidationStats(out_report);
+}
+
+bool BenchmarkLatency::postprocessResults(hebench::Utilities::TimingReportEx &out_report,
+                                          IDataLoader::Ptr p_dataset,
+                                          IBenchmark::RunConfig &run_config,
+                                          std::vector<RAIIHandle> &h_remote_results,
+                                          const PostprocessEventIDs &event_ids,
+                                          std::uint64_t result_offset,
+                                          bool b_show_progress)
+{
+    std::stringstream ss;
+    hebench::Common::EventTimer<true> timer; // high precision
+    std::uint32_t event_id;
+    std::string event_name;
+    hebench::Common::TimingReportEvent::Ptr p_timing_event;
+
     // Handle h_cipher_output;
 
     // retrieve data from backend's remote and store in host
 
-    event_id   = getEventIDNext();
+    event_id   = event_ids.store;
     event_name = "Store";
 
-    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Retrieving data from remote backend...") << std::endl;
+    if (b_show_progress)
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Retrieving data from remote backend...") << std::endl;
 
     std::vector<RAIIHandle> h_cipher_results(h_remote_results.size());
     for (std::size_t i = 0; i < h_remote_results.size(); ++i)
@@ -383,14 +1203,16 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     } // end for
     h_remote_results.clear();
 
-    std::cout << IOS_MSG_OK << std::endl;
+    if (b_show_progress)
+        std::cout << IOS_MSG_OK << std::endl;
 
     // decrypt results
 
-    event_id   = getEventIDNext();
+    event_id   = event_ids.decryption;
     event_name = "Decryption";
 
-    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decrypting results...") << std::endl;
+    if (b_show_progress)
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decrypting results...") << std::endl;
 
     std::vector<RAIIHandle> h_plain_results(h_cipher_results.size());
     for (std::size_t i = 0; i < h_cipher_results.size(); ++i)
@@ -412,7 +1234,8 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     } // end for
     h_cipher_results.clear();
 
-    std::cout << IOS_MSG_OK << std::endl;
+    if (b_show_progress)
+        std::cout << IOS_MSG_OK << std::endl;
 
     // allocate space for decoded results
 
@@ -477,16 +1300,20 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
     // decode the results
 
-    event_id   = getEventIDNext();
+    event_id   = event_ids.decoding;
     event_name = "Decoding";
 
-    if (run_config.b_validate_results)
-        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decoding and Validation.") << std::endl;
-    else
-        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decoding...") << std::endl;
+    if (b_show_progress)
+    {
+        if (run_config.b_validate_results)
+            std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decoding and Validation.") << std::endl;
+        else
+            std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Decoding...") << std::endl;
 
-    std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Result", false);
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Result", false);
+    } // end if
 
+    std::uint64_t result_count          = h_plain_results.size();
     std::size_t mini_reports_cnt        = 3;
     std::size_t report_every_n_elements = h_plain_results.size() / 7 + 1;
     if (report_every_n_elements <= 0)
@@ -502,7 +1329,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
         const auto &h_plain = h_plain_results[i].handle;
         if (b_valid)
         {
-            if (i == 0 || (i + 1) % report_every_n_elements == 0)
+            if (b_show_progress && (i == 0 || (i + 1) % report_every_n_elements == 0))
             {
                 // report operation to show sign of life
                 while (mini_reports_cnt++ < 3)
@@ -521,7 +1348,8 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
             //            if (i + 1 < h_plain_results.size() && mini_reports_cnt < 3
             //                && (mini_reports_cnt == 0 || (i + 1) % report_every_n_by_3_elements == 0))
-            if (mini_reports_cnt < 3
+            if (b_show_progress
+                && mini_reports_cnt < 3
                 && progress_report_batch > 0
                 && progress_report_batch % report_every_n_by_3_elements == 0)
             {
@@ -541,7 +1369,7 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
                     outputs.resize(p_dataset->getResultCount());
                     for (std::uint64_t i = 0; i < packed_results.pack_count; ++i)
                     {
-                        if (packed_results.p_data_packs[i].param_position > outputs.size())
+                        if (packed_results.p_data_packs[i].param_position >= outputs.size())
                             throw std::runtime_error("Invalid result position received from decoding.");
                         if (packed_results.p_data_packs[i].buffer_count <= 0)
                             throw std::runtime_error("Invalid empty result buffers received from decoding.");
@@ -566,10 +1394,11 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
 
                 if (!b_valid)
                 {
-                    std::cout << hebench::Logging::GlobalLogger::log("", true) << std::endl;
+                    if (b_show_progress)
+                        std::cout << hebench::Logging::GlobalLogger::log("", true) << std::endl;
                     ss = std::stringstream();
                     ss << "Validation failed" << std::endl
-                       << "Result, " << i + 1 << std::endl;
+                       << "Result, " << result_offset + i + 1 << std::endl;
                     if (!s_error_msg.empty())
                         ss << s_error_msg << std::endl;
                     std::cout << IOS_MSG_FAILED << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
@@ -594,29 +1423,21 @@ bool BenchmarkLatency::run(hebench::Utilities::TimingReportEx &out_report,
     } // end for
     h_plain_results.clear();
 
-    if (b_valid)
+    if (b_valid && b_show_progress)
     {
         // report valid op
-        if ((op_count) % report_every_n_elements != 0)
+        if ((result_count) % report_every_n_elements != 0)
         {
             // pretty-print end of result report
             while (mini_reports_cnt++ < 3)
                 std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-            std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(op_count)) << std::endl;
+            std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(result_offset + result_count)) << std::endl;
         } // end if
         else
             std::cout << hebench::Logging::GlobalLogger::log("") << std::endl;
         std::cout << IOS_MSG_OK << std::endl;
     } // end if
 
-    if (!run_config.b_validate_results)
-    {
-        out_report.prependFooter("Validation skipped");
-        std::cout << IOS_MSG_WARNING << hebench::Logging::GlobalLogger::log("Validation skipped.") << std::endl;
-    } // end if
-
-    std::cout << IOS_MSG_DONE << hebench::Logging::GlobalLogger::log("Test Completed.") << std::endl;
-
     return b_valid;
 }
 
@@ -5,18 +5,24 @@
 #include <algorithm>
 #include <bitset>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <numeric>
+#include <random>
 #include <stdexcept>
+#include <unordered_set>
 
 #include "hebench/modules/timer/include/timer.h"
 
 #include "hebench/api_bridge/api.h"
-#include "hebench/modules/general/include/hebench_math_utils.h"
 #include "include/hebench_engine.h"
+#include "include/hebench_utilities_harness.h"
 
 #include "../include/hebench_benchmark_offline.h"
+#include "../include/hebench_benchmark_steady_state.h"
+#include "../include/hebench_benchmark_stopping_rule.h"
 
 namespace hebench {
 namespace TestHarness {
@@ -244,6 +250,70 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
         params[i].value_index = 0;
     } // end if
 
+    // warm up
+
+    event_id   = getEventIDNext();
+    event_name = "Warmup";
+
+    std::uint64_t warmup_iterations_count = run_config.offline_warmup_iterations;
+    if (run_config.b_offline_steady_state)
+        warmup_iterations_count = std::max(warmup_iterations_count, run_config.offline_max_warmup_iterations);
+    if (warmup_iterations_count > 0)
+    {
+        ss = std::stringstream();
+        ss << "Starting warm-up iterations: requested " << run_config.offline_warmup_iterations << " iterations";
+        if (run_config.b_offline_steady_state)
+            ss << ", then until steady state (window " << run_config.offline_steady_state_window
+               << ", up to " << warmup_iterations_count << " iterations)";
+        ss << ".";
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Warming up...") << std::endl;
+
+        SteadyStateDetector detector(run_config.b_offline_steady_state ?
+                                         run_config.offline_steady_state_window :
+                                         SteadyStateDetector::DefaultWindowSize);
+        std::uint64_t rep_i = 0;
+        out_report.setEventCapacity(out_report.getEventCapacity() + warmup_iterations_count);
+        while (rep_i < warmup_iterations_count
+               && (rep_i < run_config.offline_warmup_iterations
+                   || (run_config.b_offline_steady_state && !detector.isSteady())))
+        {
+            RAIIHandle h_result_remote;
+            timer.start();
+            validateRetCode(hebench::APIBridge::operate(handle(),
+                                                        h_inputs_remote.handle,
+                                                        params.data(), params.size(),
+                                                        &h_result_remote.handle));
+            p_timing_event = timer.stop<DefaultTimeInterval>(event_id, num_results_samples, nullptr);
+            out_report.addEvent<DefaultTimeInterval>(p_timing_event, event_name);
+            detector.add(p_timing_event->elapsedWallTime<std::milli>());
+            ++rep_i;
+        } // end while
+
+        std::cout << IOS_MSG_DONE << hebench::Logging::GlobalLogger::log("Warm-up iterations: " + std::to_string(rep_i)) << std::endl;
+
+        ss = std::stringstream();
+        ss << "Warmup iterations, " << rep_i << std::endl;
+        if (run_config.b_offline_steady_state)
+        {
+            if (detector.isSteady())
+                std::cout << IOS_MSG_OK << hebench::Logging::GlobalLogger::log("Steady state detected.") << std::endl;
+            else
+                std::cout << IOS_MSG_WARNING
+                          << hebench::Logging::GlobalLogger::log("Steady state not detected within the maximum warm-up iterations.")
+                          << std::endl;
+
+            ss << "Steady state, " << (detector.isSteady() ? "detected" : "not detected") << std::endl
+               << "Steady state window, " << detector.getWindowSize() << std::endl
+               << "Change point statistic, " << detector.getChangePointStatistic() << std::endl
+               << "Change point critical value, " << detector.getChangePointCritical() << std::endl
+               << "Trend statistic, " << detector.getTrendStatistic() << std::endl
+               << "Trend critical value, " << detector.getTrendCritical() << std::endl;
+        } // end if
+        out_report.appendFooter(ss.str());
+    } // end if
+
     // operate
 
     std::uint64_t min_test_time_ms =
@@ -251,9 +321,12 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
             this->getBackendDescription().descriptor.cat_params.min_test_time_ms :
             this->getBenchmarkConfiguration().default_min_test_time_ms;
 
+    StoppingRule stopping_rule(run_config.stopping_criteria, min_test_time_ms, 1);
+
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Starting offline test.") << std::endl
               << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Requested time: " + std::to_string(this->getBackendDescription().descriptor.cat_params.min_test_time_ms) + " ms") << std::endl
-              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Actual time: " + std::to_string(min_test_time_ms) + " ms") << std::endl;
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Actual time: " + std::to_string(min_test_time_ms) + " ms") << std::endl
+              << std::string(sizeof(IOS_MSG_INFO) + 1, ' ') << hebench::Logging::GlobalLogger::log("Stopping rule: " + stopping_rule.describe()) << std::endl;
 
     std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Testing...") << std::endl;
 
@@ -270,7 +343,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     std::size_t iteration_capacity = 20; // initial capacity for 20 iterations
     double elapsed_ms              = 0.0;
     out_report.setEventCapacity(out_report.getEventCapacity() + iteration_capacity);
-    while (iteration_count <= 0 || elapsed_ms < min_test_time_ms)
+    while (!stopping_rule.isDone())
     {
         if (iteration_count > 0)
             // destroy previous result
@@ -282,6 +355,7 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
                                                     &h_remote_results.handle));
         p_timing_event = timer.stop<DefaultTimeInterval>(event_id, num_results_samples, nullptr);
         elapsed_ms += p_timing_event->elapsedWallTime<std::milli>();
+        stopping_rule.add(p_timing_event->elapsedWallTime<std::milli>());
 
         // check if we have enough capacity
         if (iteration_capacity == iteration_count
@@ -305,6 +379,16 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     ss << "Elapsed time: " << p_timing_event->elapsedWallTime<std::milli>() << "ms";
     std::cout << IOS_MSG_DONE << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
 
+    if (stopping_rule.isAdaptive())
+    {
+        ss = std::stringstream();
+        ss << "Operations: " << iteration_count << ". "
+           << "Achieved precision: " << stopping_rule.getMeanPrecision() * 100.0 << "% "
+           << "(" << StoppingRule::getStopReasonName(stopping_rule.getStopReason()) << ").";
+        std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+    } // end if
+    stopping_rule.appendStoppingReport(out_report);
+
     // clean up data we no longer need
 
     // destroyHandle(h_remote_inputs);
@@ -463,57 +547,30 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     {
         std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Validation.") << std::endl;
 
+        // select the results to validate
+        std::vector<std::uint64_t> selected_results = selectResultsToValidate(p_dataset, run_config);
+        std::uint64_t num_validated_samples         = selected_results.empty() ? num_results_samples : selected_results.size();
+        if (!selected_results.empty())
+        {
+            ss = std::stringstream();
+            ss << "Validating " << num_validated_samples << " out of " << num_results_samples << " results ("
+               << IBenchmark::getValidationPolicyName(run_config.validation_policy) << ").";
+            std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+        } // end if
+
         std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Result", false);
 
-        std::size_t mini_reports_cnt        = 3;
-        std::size_t report_every_n_elements = num_results_samples / 7 + 1;
-        if (report_every_n_elements <= 0)
-            report_every_n_elements = 1;
-        std::size_t report_every_n_by_3_elements = report_every_n_elements / 4;
+        std::uint64_t report_every_n_elements      = num_validated_samples / 7 + 1;
+        std::uint64_t report_every_n_by_3_elements = report_every_n_elements / 4;
         if (report_every_n_by_3_elements <= 0)
             report_every_n_by_3_elements = 1;
-        std::size_t progress_report_batch = 0;
-
-        // initialize loop limits
-        std::vector<std::size_t> params_count(p_dataset->getParameterCount());
-        for (std::uint64_t param_i = 0; param_i < p_dataset->getParameterCount(); ++param_i)
-        {
-            // ComponentCounter increments starting from component 0,
-            // but we want to increment starting from most significant component,
-            // so, reverse the sizes:
-            params_count[params_count.size() - param_i - 1] = p_dataset->getParameterData(param_i).buffer_count;
-        } // end for
-        // looping variables
-        hebench::Utilities::Math::ComponentCounter param_counter(params_count);
-        std::size_t result_i = 0;
-        // validate the result of the operation evaluated on all sample combinations per parameter
-        do
-        {
-            assert(result_i < num_results_samples);
 
-            if (result_i == 0 || (result_i + 1) % report_every_n_elements == 0)
-            {
-                // report operation to show sign of life
-                while (mini_reports_cnt++ < 3)
-                    std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-                mini_reports_cnt      = 0;
-                progress_report_batch = 0;
-                std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(result_i + 1), false) << std::flush;
-            } // end if
-
-            if (mini_reports_cnt < 3
-                && progress_report_batch > 0
-                && progress_report_batch % report_every_n_by_3_elements == 0)
-            {
-                // report operation to show sign of life
-                ++mini_reports_cnt;
-                std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-            } // end if
-
-            // validate output
-            std::string s_error_msg;
-            std::vector<hebench::APIBridge::NativeDataBuffer *> outputs;
-            std::vector<std::uint64_t> data_pack_indices;
+        // validates a single result sample: returns whether it is valid
+        auto validate_result_sample = [this, &p_dataset, &packed_results](std::uint64_t result_i,
+                                                                          std::vector<std::uint64_t> &data_pack_indices,
+                                                                          std::vector<hebench::APIBridge::NativeDataBuffer *> &outputs,
+                                                                          std::string &s_error_msg) -> bool {
+            bool retval = true;
             try
             {
                 outputs.resize(p_dataset->getResultCount());
@@ -528,63 +585,125 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
                         &packed_results.p_data_packs[result_component_i].p_buffers[result_i];
                 } // end for
 
-                // ComponentCounter increments starting from component 0,
-                // but we want to increment starting from most significant component,
-                // so, reverse the counter:
-                const auto &tmp = param_counter.getCount();
-                data_pack_indices.assign(tmp.rbegin(), tmp.rend());
-                assert(data_pack_indices.size() == p_dataset->getParameterCount());
+                // find the input sample indices for the result:
+                // most significant parameter is the first one
+                data_pack_indices.resize(p_dataset->getParameterCount());
+                std::uint64_t remainder = result_i;
+                for (std::size_t param_i = data_pack_indices.size(); param_i > 0; --param_i)
+                {
+                    std::uint64_t sample_count     = p_dataset->getParameterData(param_i - 1).buffer_count;
+                    data_pack_indices[param_i - 1] = remainder % sample_count;
+                    remainder /= sample_count;
+                } // end for
 
-                b_valid = validateResult(p_dataset, data_pack_indices.data(),
-                                         outputs,
-                                         this->getBackendDescription().descriptor.data_type);
+                retval = validateResult(p_dataset, data_pack_indices.data(),
+                                        outputs,
+                                        this->getBackendDescription().descriptor.data_type);
             }
             catch (std::exception &ex)
             {
-                b_valid     = false;
+                retval      = false;
                 s_error_msg = ex.what();
             }
             catch (...)
             {
-                b_valid = false;
+                retval = false;
             }
+            return retval;
+        };
 
-            if (!b_valid)
-            {
-                std::cout << hebench::Logging::GlobalLogger::log("", true) << std::endl;
-                ss = std::stringstream();
-                ss << "Validation failed" << std::endl
-                   << "Result, " << result_i + 1 << std::endl;
-                if (!s_error_msg.empty())
-                    ss << s_error_msg << std::endl;
-                std::cout << IOS_MSG_FAILED << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+        // details of a result sample that failed validation
+        struct InvalidResult
+        {
+            std::uint64_t result_i = 0;
+            std::vector<std::uint64_t> data_pack_indices;
+            std::vector<hebench::APIBridge::NativeDataBuffer *> outputs;
+            std::string s_error_msg;
+        };
 
-                // log the parameters, expected result and received result.
-                ss << std::endl;
-                logResult(ss, p_dataset, data_pack_indices.data(),
-                          outputs,
-                          this->getBackendDescription().descriptor.data_type);
-                out_report.appendFooter(ss.str());
-            } // end else
+        // validate the result of the operation evaluated on all selected sample combinations per parameter:
+        // result samples are independent, so, each batch is validated concurrently
+        // (indices in the loop refer to the position in the selection)
+        InvalidResult invalid_result;
+        for (std::uint64_t batch_first = 0; b_valid && batch_first < num_validated_samples; batch_first += report_every_n_elements)
+        {
+            // report operation to show sign of life
+            std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(batch_first + 1), false) << std::flush;
 
-            ++progress_report_batch;
-            ++result_i; // next result
-        } while (b_valid && !param_counter.inc());
+            std::uint64_t batch_last     = std::min(batch_first + report_every_n_elements, num_validated_samples);
+            std::size_t mini_reports_cnt = 0;
+            for (std::uint64_t mini_batch_first = batch_first; b_valid && mini_batch_first < batch_last; mini_batch_first += report_every_n_by_3_elements)
+            {
+                if (mini_batch_first > batch_first && mini_reports_cnt++ < 3)
+                    std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
+
+                // the details of the first invalid result are kept from its only validation,
+                // so that its error statistics are accumulated once
+                std::uint64_t mini_batch_last = std::min(mini_batch_first + report_every_n_by_3_elements, batch_last);
+                std::uint64_t invalid_i       = hebench::Utilities::parallelFindFirst(
+                    mini_batch_last - mini_batch_first,
+                    [mini_batch_first, &selected_results, &validate_result_sample](std::uint64_t i, InvalidResult &result) {
+                        std::uint64_t validated_i = mini_batch_first + i;
+                        result.result_i           = selected_results.empty() ? validated_i : selected_results[validated_i];
+                        return !validate_result_sample(result.result_i, result.data_pack_indices, result.outputs, result.s_error_msg);
+                    },
+                    invalid_result);
+                b_valid = invalid_i >= mini_batch_last - mini_batch_first;
+            } // end for
+        } // end for
 
         if (b_valid)
         {
             // report valid op
-            if ((num_results_samples) % report_every_n_elements != 0)
+            std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(num_validated_samples)) << std::endl;
+            std::cout << IOS_MSG_OK << std::endl;
+
+            if (!selected_results.empty())
             {
-                // pretty-print end of result report
-                while (mini_reports_cnt++ < 3)
-                    std::cout << hebench::Logging::GlobalLogger::log(".", false) << std::flush;
-                std::cout << hebench::Logging::GlobalLogger::log(" " + std::to_string(num_results_samples)) << std::endl;
+                // report confidence achieved by validating only a selection of results
+                ss = std::stringstream();
+                ss << "Validation policy, " << IBenchmark::getValidationPolicyName(run_config.validation_policy) << std::endl
+                   << "Validated results, " << num_validated_samples << ", " << num_results_samples << std::endl
+                   << "Validation confidence, ";
+                if (run_config.validation_policy == IBenchmark::ValidationPolicy::FirstLast)
+                    ss << "N/A, selection is not random";
+                else if (run_config.validation_policy == IBenchmark::ValidationPolicy::Stratified)
+                    ss << "N/A, selection is not uniformly random";
+                else
+                    ss << computeValidationConfidence(num_results_samples, num_validated_samples, ValidationInvalidFraction) * 100.0
+                       << "%, fewer than " << ValidationInvalidFraction * 100.0 << "% of results are invalid";
+                ss << std::endl;
+                out_report.appendFooter(ss.str());
+                std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
             } // end if
-            else
-                std::cout << hebench::Logging::GlobalLogger::log("") << std::endl;
-            std::cout << IOS_MSG_OK << std::endl;
         } // end if
+        else
+        {
+            // report the first invalid result
+            std::uint64_t result_i                                             = invalid_result.result_i;
+            const std::vector<std::uint64_t> &data_pack_indices                = invalid_result.data_pack_indices;
+            const std::vector<hebench::APIBridge::NativeDataBuffer *> &outputs = invalid_result.outputs;
+            const std::string &s_error_msg                                     = invalid_result.s_error_msg;
+
+            std::cout << hebench::Logging::GlobalLogger::log("", true) << std::endl;
+            ss = std::stringstream();
+            ss << "Validation failed" << std::endl
+               << "Result, " << result_i + 1 << std::endl;
+            if (!s_error_msg.empty())
+                ss << s_error_msg << std::endl;
+            std::cout << IOS_MSG_FAILED << hebench::Logging::GlobalLogger::log(ss.str()) << std::endl;
+
+            // log the parameters, expected result and received result.
+            ss << std::endl;
+            if (data_pack_indices.size() == p_dataset->getParameterCount()
+                && outputs.size() == p_dataset->getResultCount())
+                logResult(ss, p_dataset, data_pack_indices.data(),
+                          outputs,
+                          this->getBackendDescription().descriptor.data_type);
+            out_report.appendFooter(ss.str());
+        } // end else
+
+        appendValidationStats(out_report);
     } // end if
     else
     {
@@ -597,5 +716,114 @@ bool BenchmarkOffline::run(hebench::Utilities::TimingReportEx &out_report,
     return b_valid;
 }
 
+std::vector<std::uint64_t> BenchmarkOffline::selectResultsToValidate(IDataLoader::Ptr p_dataset,
+                                                                     const IBenchmark::RunConfig &run_config)
+{
+    std::vector<std::uint64_t> retval;
+
+    std::vector<std::uint64_t> params_count(p_dataset->getParameterCount());
+    std::uint64_t result_count = 1;
+    for (std::size_t param_i = 0; param_i < params_count.size(); ++param_i)
+    {
+        params_count[param_i] = p_dataset->getParameterData(param_i).buffer_count;
+        result_count *= params_count[param_i];
+    } // end for
+
+    if (run_config.validation_policy == IBenchmark::ValidationPolicy::Full
+        || run_config.validation_sample_count >= result_count)
+        return retval; // validate all results
+
+    std::uint64_t sample_count = run_config.validation_sample_count;
+    // independent from the global random generator to avoid changing the
+    // sequence of random values observed by other components
+    std::mt19937_64 rand_gen(hebench::Utilities::RandomGenerator::getRandomSeed());
+
+    switch (run_config.validation_policy)
+    {
+    case IBenchmark::ValidationPolicy::Random:
+    {
+        // Floyd's algorithm: sample_count distinct results chosen uniformly
+        std::unordered_set<std::uint64_t> selected;
+        selected.reserve(sample_count);
+        for (std::uint64_t j = result_count - sample_count; j < result_count; ++j)
+        {
+            std::uint64_t t = std::uniform_int_distribution<std::uint64_t>(0, j)(rand_gen);
+            if (!selected.insert(t).second)
+                selected.insert(j);
+        } // end for
+        retval.assign(selected.begin(), selected.end());
+    }
+    break;
+
+    case IBenchmark::ValidationPolicy::Stratified:
+    {
+        // each parameter cycles through a random permutation of its samples, so,
+        // every sample of every parameter is validated before any is repeated
+        std::vector<std::vector<std::uint64_t>> permutations(params_count.size());
+        for (std::size_t param_i = 0; param_i < permutations.size(); ++param_i)
+        {
+            permutations[param_i].resize(params_count[param_i]);
+            std::iota(permutations[param_i].begin(), permutations[param_i].end(), 0);
+        } // end for
+        std::unordered_set<std::uint64_t> selected;
+        selected.reserve(sample_count);
+        for (std::uint64_t j = 0; j < sample_count; ++j)
+        {
+            std::uint64_t result_i = 0;
+            for (std::size_t param_i = 0; param_i < permutations.size(); ++param_i)
+            {
+                std::vector<std::uint64_t> &permutation = permutations[param_i];
+                if (j % permutation.size() == 0)
+                    std::shuffle(permutation.begin(), permutation.end(), rand_gen);
+                // most significant parameter is the first one
+                result_i = permutation[j % permutation.size()] + permutation.size() * result_i;
+            } // end for
+            selected.insert(result_i);
+        } // end for
+        retval.assign(selected.begin(), selected.end());
+    }
+    break;
+
+    case IBenchmark::ValidationPolicy::FirstLast:
+    {
+        std::uint64_t first_count = (sample_count + 1) / 2;
+        retval.resize(sample_count);
+        std::iota(retval.begin(), retval.begin() + first_count, 0);
+        std::iota(retval.begin() + first_count, retval.end(), result_count - (sample_count - first_count));
+    }
+    break;
+
+    default:
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Unknown validation policy."));
+        break;
+    } // end switch
+
+    std::sort(retval.begin(), retval.end());
+
+    return retval;
+}
+
+double BenchmarkOffline::computeValidationConfidence(std::uint64_t result_count,
+                                                     std::uint64_t validated_count,
+                                                     double invalid_fraction)
+{
+    if (result_count <= 0)
+        return 1.0;
+
+    std::uint64_t invalid_count = static_cast<std::uint64_t>(std::ceil(invalid_fraction * result_count));
+    if (invalid_count <= 0)
+        invalid_count = 1;
+    if (validated_count + invalid_count > result_count)
+        return 1.0; // any selection this large contains, at least, one invalid result
+
+    // probability of selecting only valid results:
+    // prod_{i = 0}^{validated_count - 1} (result_count - invalid_count - i) / (result_count - i)
+    double log_p = 0.0;
+    for (std::uint64_t i = 0; i < validated_count; ++i)
+        log_p += std::log1p(-static_cast<double>(invalid_count) / static_cast<double>(result_count - i));
+
+    return 1.0 - std::exp(log_p);
+}
+
 } // namespace TestHarness
 } // namespace hebench
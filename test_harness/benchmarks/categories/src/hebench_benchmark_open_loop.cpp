@@ -0,0 +1,110 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include "../include/hebench_benchmark_open_loop.h"
+
+namespace hebench {
+namespace TestHarness {
+
+//-----------------------
+// class ArrivalSchedule
+//-----------------------
+
+ArrivalSchedule::ArrivalSchedule(IBenchmark::ArrivalProcess process, double rate, std::uint64_t seed) :
+    m_process(process),
+    m_rate(rate),
+    m_arrival_count(0),
+    m_next_arrival(0.0),
+    m_rand_gen(seed),
+    m_interarrival(rate > 0.0 ? rate : 1.0)
+{
+    if (process != IBenchmark::ArrivalProcess::Constant
+        && process != IBenchmark::ArrivalProcess::Poisson)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid arrival process for open-loop schedule: `process`."));
+    if (!std::isfinite(rate) || rate <= 0.0)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Arrival rate must be positive: `rate`."));
+}
+
+double ArrivalSchedule::pop()
+{
+    double retval = m_next_arrival;
+
+    ++m_arrival_count;
+    if (m_process == IBenchmark::ArrivalProcess::Constant)
+        // computed from the count to avoid accumulating rounding errors
+        m_next_arrival = static_cast<double>(m_arrival_count) / m_rate;
+    else
+        m_next_arrival += m_interarrival(m_rand_gen);
+
+    return retval;
+}
+
+//-------------------------
+// struct OpenLoopLoadPoint
+//-------------------------
+
+double OpenLoopLoadPoint::getAchievedRate() const
+{
+    return elapsed_ms > 0.0 ? service_times.size() * 1000.0 / elapsed_ms : 0.0;
+}
+
+std::vector<double> OpenLoopLoadPoint::getQueueingDelays() const
+{
+    std::vector<double> retval(queueing_delays);
+    retval.insert(retval.end(), unserved_delays.begin(), unserved_delays.end());
+    return retval;
+}
+
+std::vector<double> OpenLoopLoadPoint::getResponseTimes() const
+{
+    std::vector<double> retval(service_times.size());
+    for (std::size_t i = 0; i < retval.size(); ++i)
+        retval[i] = queueing_delays[i] + service_times[i];
+    // unserved operations never received service
+    retval.insert(retval.end(), unserved_delays.begin(), unserved_delays.end());
+    return retval;
+}
+
+void OpenLoopLoadPoint::appendLatencyCurve(hebench::Utilities::TimingReportEx &out_report,
+                                           IBenchmark::ArrivalProcess process,
+                                           const std::vector<OpenLoopLoadPoint> &load_points)
+{
+    bool b_saturated = false;
+    std::stringstream ss;
+    ss << "Arrival process, " << IBenchmark::getArrivalProcessName(process) << std::endl
+       << "Latency vs throughput (ms)" << std::endl
+       << "Offered load (ops/s), Achieved throughput (ops/s), Operations, Unserved operations, "
+       << "Queueing delay mean, Queueing delay p99, "
+       << "Service time mean, Service time p99, "
+       << "Response time mean, Response time p50, Response time p90, Response time p99" << std::endl;
+    for (const OpenLoopLoadPoint &load_point : load_points)
+    {
+        std::vector<double> queueing_delays = load_point.getQueueingDelays();
+        std::vector<double> response_times  = load_point.getResponseTimes();
+        b_saturated                         = b_saturated || load_point.isSaturated();
+        ss << load_point.offered_rate << ", "
+           << load_point.getAchievedRate() << ", "
+           << load_point.service_times.size() << ", "
+           << load_point.unserved_delays.size() << ", "
+           << hebench::Utilities::computeMean(queueing_delays) << ", "
+           << hebench::Utilities::computePercentile(queueing_delays, 99.0) << ", "
+           << hebench::Utilities::computeMean(load_point.service_times) << ", "
+           << hebench::Utilities::computePercentile(load_point.service_times, 99.0) << ", "
+           << hebench::Utilities::computeMean(response_times) << ", "
+           << hebench::Utilities::computePercentile(response_times, 50.0) << ", "
+           << hebench::Utilities::computePercentile(response_times, 90.0) << ", "
+           << hebench::Utilities::computePercentile(response_times, 99.0) << std::endl;
+    } // end for
+    if (b_saturated)
+        ss << "Note, unserved operations are charged their wait until the end of the test: "
+           << "queueing delays and response times of offered loads with unserved operations are lower bounds." << std::endl;
+    out_report.appendFooter(ss.str());
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,49 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <sstream>
+
+#include "../include/hebench_benchmark_pipeline.h"
+
+namespace hebench {
+namespace TestHarness {
+
+//---------------------------
+// struct PipelineStageStats
+//---------------------------
+
+void PipelineStageStats::appendPipelineReport(hebench::Utilities::TimingReportEx &out_report,
+                                              std::uint64_t queue_size,
+                                              const std::vector<double> &completion_times,
+                                              const std::vector<PipelineStageStats> &stages)
+{
+    double test_time_ms   = completion_times.empty() ? 0.0 : completion_times.back();
+    double throughput     = test_time_ms > 0.0 ? completion_times.size() * 1000.0 / test_time_ms : 0.0;
+    double sustained_time = completion_times.size() > 1 ? completion_times.back() - completion_times.front() : 0.0;
+    double sustained      = sustained_time > 0.0 ? (completion_times.size() - 1) * 1000.0 / sustained_time : throughput;
+    auto percent          = [test_time_ms](double value_ms) -> double {
+        return test_time_ms > 0.0 ? value_ms * 100.0 / test_time_ms : 0.0;
+    };
+
+    std::stringstream ss;
+    ss << "Pipeline queue size, " << queue_size << std::endl
+       << "Pipeline items, " << completion_times.size() << std::endl
+       << "End-to-end throughput (ops/s), " << throughput << std::endl
+       << "Sustained throughput (ops/s), " << sustained << std::endl
+       << "Pipeline stages" << std::endl
+       << "Stage, Items, Mean time (ms), Occupancy (%), Backpressure (%), Starvation (%)" << std::endl;
+    for (const PipelineStageStats &stage : stages)
+    {
+        ss << stage.name << ", "
+           << stage.item_count << ", "
+           << (stage.item_count > 0 ? stage.busy_ms / stage.item_count : 0.0) << ", "
+           << percent(stage.busy_ms) << ", "
+           << percent(stage.backpressure_ms) << ", "
+           << percent(stage.starvation_ms) << std::endl;
+    } // end for
+    out_report.appendFooter(ss.str());
+}
+
+} // namespace TestHarness
+} // namespace hebench
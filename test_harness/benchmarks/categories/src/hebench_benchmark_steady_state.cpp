@@ -0,0 +1,147 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "../include/hebench_benchmark_steady_state.h"
+#include "../include/hebench_benchmark_stopping_rule.h"
+
+namespace hebench {
+namespace TestHarness {
+
+//---------------------------
+// class SteadyStateDetector
+//---------------------------
+
+SteadyStateDetector::SteadyStateDetector(std::size_t window_size, double significance) :
+    m_window_size(window_size),
+    m_change_point_critical(0.0),
+    m_trend_critical(0.0),
+    m_count(0),
+    m_change_point_statistic(0.0),
+    m_trend_statistic(0.0),
+    m_b_steady(false)
+{
+    if (window_size < 3)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Steady state window size must be, at least, 3: `window_size`."));
+    if (!std::isfinite(significance) || significance <= 0.0 || significance >= 1.0)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Significance level must be in range (0, 1): `significance`."));
+
+    // Bonferroni correction for the number of split points tested
+    m_change_point_critical = StoppingRule::computeStudentCritical(1.0 - significance / (window_size - 1),
+                                                                   window_size - 2);
+    m_trend_critical        = StoppingRule::computeStudentCritical(1.0 - significance, window_size - 2);
+    m_window.reserve(window_size);
+}
+
+void SteadyStateDetector::add(double elapsed_ms)
+{
+    if (m_window.size() < m_window_size)
+        m_window.push_back(elapsed_ms);
+    else
+        m_window[m_count % m_window_size] = elapsed_ms;
+    ++m_count;
+
+    if (m_window.size() >= m_window_size)
+    {
+        // test the window in chronological order
+        std::vector<double> series(m_window_size);
+        for (std::size_t i = 0; i < m_window_size; ++i)
+            series[i] = m_window[(m_count + i) % m_window_size];
+        std::size_t change_point;
+        m_change_point_statistic = computeChangePointStatistic(series, change_point);
+        m_trend_statistic        = computeTrendStatistic(series);
+
+        m_b_steady = m_change_point_statistic <= m_change_point_critical
+                     && m_trend_statistic <= m_trend_critical;
+    } // end if
+}
+
+double SteadyStateDetector::computeChangePointStatistic(const std::vector<double> &series,
+                                                        std::size_t &change_point)
+{
+    if (series.size() < 3)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Series must have, at least, 3 values: `series`."));
+
+    double retval = 0.0;
+    change_point  = 0;
+    for (std::size_t split = 1; split < series.size(); ++split)
+    {
+        double n_before    = static_cast<double>(split);
+        double n_after     = static_cast<double>(series.size() - split);
+        double mean_before = 0.0;
+        double mean_after  = 0.0;
+        for (std::size_t i = 0; i < series.size(); ++i)
+        {
+            if (i < split)
+                mean_before += series[i];
+            else
+                mean_after += series[i];
+        } // end for
+        mean_before /= n_before;
+        mean_after /= n_after;
+
+        double sum_sq = 0.0;
+        for (std::size_t i = 0; i < series.size(); ++i)
+        {
+            double delta = series[i] - (i < split ? mean_before : mean_after);
+            sum_sq += delta * delta;
+        } // end for
+        double pooled_variance = sum_sq / (series.size() - 2);
+        double mean_diff       = std::abs(mean_after - mean_before);
+
+        double statistic;
+        if (pooled_variance > 0.0)
+            statistic = mean_diff / std::sqrt(pooled_variance * (1.0 / n_before + 1.0 / n_after));
+        else
+            statistic = mean_diff > 0.0 ? std::numeric_limits<double>::infinity() : 0.0;
+
+        if (statistic > retval)
+        {
+            retval       = statistic;
+            change_point = split;
+        } // end if
+    } // end for
+
+    return retval;
+}
+
+double SteadyStateDetector::computeTrendStatistic(const std::vector<double> &series)
+{
+    if (series.size() < 3)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Series must have, at least, 3 values: `series`."));
+
+    double n      = static_cast<double>(series.size());
+    double mean_x = (n - 1.0) / 2.0;
+    double mean_y = 0.0;
+    for (double y : series)
+        mean_y += y;
+    mean_y /= n;
+
+    double s_xx = 0.0;
+    double s_xy = 0.0;
+    for (std::size_t i = 0; i < series.size(); ++i)
+    {
+        s_xx += (i - mean_x) * (i - mean_x);
+        s_xy += (i - mean_x) * (series[i] - mean_y);
+    } // end for
+    double slope = s_xy / s_xx;
+
+    double sum_sq = 0.0;
+    for (std::size_t i = 0; i < series.size(); ++i)
+    {
+        double residual = series[i] - (mean_y + slope * (i - mean_x));
+        sum_sq += residual * residual;
+    } // end for
+    double residual_variance = sum_sq / (n - 2.0);
+
+    if (residual_variance > 0.0)
+        return std::abs(slope) / std::sqrt(residual_variance / s_xx);
+    return slope != 0.0 ? std::numeric_limits<double>::infinity() : 0.0;
+}
+
+} // namespace TestHarness
+} // namespace hebench
@@ -0,0 +1,349 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "../include/hebench_benchmark_stopping_rule.h"
+
+namespace hebench {
+namespace TestHarness {
+
+namespace {
+
+// precision of the quantiles computed by bisection: the number of bisection
+// steps is the number of halvings needed to narrow the range down to it
+constexpr double QuantileTolerance = 1.0e-12;
+
+/**
+ * @brief Quantile of the standard normal distribution.
+ * @param[in] p Probability in range `(0, 1)`.
+ * @details Accurate to QuantileTolerance.
+ */
+double computeNormalQuantile(double p)
+{
+    // bisection on the normal CDF: range covers any p of interest
+    double lo = -40.0;
+    double hi = 40.0;
+    while (hi - lo > QuantileTolerance)
+    {
+        double mid = (lo + hi) / 2.0;
+        if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p)
+            lo = mid;
+        else
+            hi = mid;
+    } // end while
+    return (lo + hi) / 2.0;
+}
+
+/**
+ * @brief Continued fraction for the regularized incomplete beta function.
+ */
+double computeBetaContinuedFraction(double x, double a, double b)
+{
+    constexpr double Epsilon = 1.0e-15;
+    constexpr double Tiny    = 1.0e-300;
+
+    // modified Lentz's method
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    if (std::abs(d) < Tiny)
+        d = Tiny;
+    d             = 1.0 / d;
+    double retval = d;
+    for (int m = 1; m <= 300; ++m)
+    {
+        // even step
+        double numerator = m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m));
+        d                = 1.0 + numerator * d;
+        c                = 1.0 + numerator / c;
+        if (std::abs(d) < Tiny)
+            d = Tiny;
+        if (std::abs(c) < Tiny)
+            c = Tiny;
+        d = 1.0 / d;
+        retval *= d * c;
+
+        // odd step
+        numerator = -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0));
+        d         = 1.0 + numerator * d;
+        c         = 1.0 + numerator / c;
+        if (std::abs(d) < Tiny)
+            d = Tiny;
+        if (std::abs(c) < Tiny)
+            c = Tiny;
+        d            = 1.0 / d;
+        double delta = d * c;
+        retval *= delta;
+        if (std::abs(delta - 1.0) < Epsilon)
+            break;
+    } // end for
+    return retval;
+}
+
+/**
+ * @brief Regularized incomplete beta function `I_x(a, b)`.
+ */
+double computeIncompleteBeta(double x, double a, double b)
+{
+    if (x <= 0.0)
+        return 0.0;
+    if (x >= 1.0)
+        return 1.0;
+
+    double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b)
+                            + a * std::log(x) + b * std::log(1.0 - x));
+    // continued fraction converges fast on this side of the symmetry point
+    return x < (a + 1.0) / (a + b + 2.0) ?
+               front * computeBetaContinuedFraction(x, a, b) / a :
+               1.0 - front * computeBetaContinuedFraction(1.0 - x, b, a) / b;
+}
+
+/**
+ * @brief Probability of `|T| <= t` for the Student t distribution with \p v
+ * degrees of freedom.
+ */
+double computeStudentTwoSidedCDF(double t, double v)
+{
+    // P(|T| <= t) = 1 - I_x(v / 2, 1 / 2), with x = v / (v + t^2)
+    return 1.0 - computeIncompleteBeta(v / (v + t * t), v / 2.0, 0.5);
+}
+
+/**
+ * @brief Bisection for the critical value of the two-sided Student t distribution
+ * in range `[lo, hi]`.
+ * @details The critical value must be in the range. Result is accurate to
+ * QuantileTolerance relative to \p hi , so, narrower ranges take fewer steps.
+ */
+double bisectStudentCritical(double confidence_level, double v, double lo, double hi)
+{
+    while (hi - lo > QuantileTolerance * hi)
+    {
+        double mid = (lo + hi) / 2.0;
+        if (computeStudentTwoSidedCDF(mid, v) < confidence_level)
+            lo = mid;
+        else
+            hi = mid;
+    } // end while
+    return (lo + hi) / 2.0;
+}
+
+} // namespace
+
+//--------------------
+// class StoppingRule
+//--------------------
+
+StoppingRule::StoppingRule(const IBenchmark::StoppingCriteria &criteria,
+                           std::uint64_t test_time_ms,
+                           std::uint64_t min_count) :
+    m_criteria(criteria),
+    m_test_time_ms(test_time_ms),
+    m_min_count(min_count),
+    m_count(0),
+    m_elapsed_ms(0.0),
+    m_mean(0.0),
+    m_m2(0.0),
+    m_stop_reason(StopReason::None),
+    m_normal_critical(0.0),
+    m_student_dof(0),
+    m_student_critical(0.0)
+{
+    if (!std::isfinite(criteria.precision) || criteria.precision < 0.0)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Target precision cannot be negative: `criteria.precision`."));
+    if (isAdaptive())
+    {
+        if (!std::isfinite(criteria.confidence_level)
+            || criteria.confidence_level <= 0.0 || criteria.confidence_level >= 1.0)
+            throw std::invalid_argument(IL_LOG_MSG_CLASS("Confidence level must be in range (0, 1): `criteria.confidence_level`."));
+        if (criteria.max_time_ms > 0 && criteria.max_time_ms < criteria.min_time_ms)
+            throw std::invalid_argument(IL_LOG_MSG_CLASS("Maximum time cannot be less than minimum time: `criteria.max_time_ms`."));
+        if (criteria.max_iterations > 0 && criteria.max_iterations < criteria.min_iterations)
+            throw std::invalid_argument(IL_LOG_MSG_CLASS("Maximum iterations cannot be less than minimum iterations: `criteria.max_iterations`."));
+    } // end if
+
+    m_normal_critical = computeNormalQuantile((1.0 + getConfidenceLevel()) / 2.0);
+}
+
+void StoppingRule::add(double elapsed_ms)
+{
+    ++m_count;
+    m_elapsed_ms += elapsed_ms;
+
+    // Welford's online algorithm
+    double delta = elapsed_ms - m_mean;
+    m_mean += delta / m_count;
+    m_m2 += delta * (elapsed_ms - m_mean);
+
+    if (isAdaptive() && m_criteria.b_median)
+        m_sketch.add(elapsed_ms);
+}
+
+bool StoppingRule::isDone()
+{
+    if (m_stop_reason == StopReason::None)
+    {
+        if (!isAdaptive())
+        {
+            if (m_count >= m_min_count && m_elapsed_ms >= m_test_time_ms)
+                m_stop_reason = StopReason::TestTime;
+        } // end if
+        else if (m_count >= m_min_count)
+        {
+            if (m_criteria.max_time_ms > 0 && m_elapsed_ms >= m_criteria.max_time_ms)
+                m_stop_reason = StopReason::MaxTime;
+            else if (m_criteria.max_iterations > 0 && m_count >= m_criteria.max_iterations)
+                m_stop_reason = StopReason::MaxIterations;
+            else if (m_count >= m_criteria.min_iterations
+                     && m_elapsed_ms >= m_criteria.min_time_ms
+                     && getMeanPrecision() <= m_criteria.precision
+                     && (!m_criteria.b_median || getMedianPrecision() <= m_criteria.precision))
+                m_stop_reason = StopReason::Precision;
+        } // end else if
+    } // end if
+
+    return m_stop_reason != StopReason::None;
+}
+
+double StoppingRule::getMeanPrecision() const
+{
+    if (m_count < 2 || m_mean <= 0.0)
+        return std::numeric_limits<double>::infinity();
+
+    double half_width = getStudentCritical(m_count - 1) * std::sqrt(getVariance() / m_count);
+    return half_width / m_mean;
+}
+
+double StoppingRule::getMedianPrecision() const
+{
+    if (!isAdaptive() || !m_criteria.b_median)
+        return std::numeric_limits<double>::infinity();
+
+    // ranks (1-based) of the order statistics bounding the median
+    double n       = static_cast<double>(m_sketch.getCount());
+    double z       = m_normal_critical;
+    double rank_lo = std::floor(n / 2.0 - z * std::sqrt(n) / 2.0);
+    double rank_hi = std::ceil(1.0 + n / 2.0 + z * std::sqrt(n) / 2.0);
+    double median  = m_sketch.getQuantile(0.5);
+    if (n < 3.0 || rank_lo < 1.0 || rank_hi > n || median <= 0.0)
+        return std::numeric_limits<double>::infinity();
+
+    double value_lo = m_sketch.getQuantile((rank_lo - 1.0) / (n - 1.0));
+    double value_hi = m_sketch.getQuantile((rank_hi - 1.0) / (n - 1.0));
+    return (value_hi - value_lo) / (2.0 * median);
+}
+
+double StoppingRule::computeStudentCritical(double confidence_level, std::uint64_t dof)
+{
+    if (dof < 1)
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Degrees of freedom must be positive."));
+
+    // find a range for the bisection by doubling the upper bound
+    double v  = static_cast<double>(dof);
+    double lo = 0.0;
+    double hi = 1.0;
+    while (computeStudentTwoSidedCDF(hi, v) < confidence_level && hi < 1.0e9)
+    {
+        lo = hi;
+        hi *= 2.0;
+    } // end while
+    return bisectStudentCritical(confidence_level, v, lo, hi);
+}
+
+double StoppingRule::getStudentCritical(std::uint64_t dof) const
+{
+    if (dof != m_student_dof)
+    {
+        // critical values decrease towards the normal one as degrees of freedom grow:
+        // while operations are added, the cached value bounds the new one from above
+        m_student_critical = m_student_dof > 0 && dof > m_student_dof ?
+                                 bisectStudentCritical(getConfidenceLevel(), static_cast<double>(dof),
+                                                       m_normal_critical, m_student_critical) :
+                                 computeStudentCritical(getConfidenceLevel(), dof);
+        m_student_dof = dof;
+    } // end if
+    return m_student_critical;
+}
+
+std::string StoppingRule::getStopReasonName(StopReason reason)
+{
+    std::string retval;
+
+    switch (reason)
+    {
+    case StopReason::None:
+        retval = "running";
+        break;
+
+    case StopReason::TestTime:
+        retval = "test time elapsed";
+        break;
+
+    case StopReason::Precision:
+        retval = "precision reached";
+        break;
+
+    case StopReason::MaxTime:
+        retval = "maximum time reached";
+        break;
+
+    case StopReason::MaxIterations:
+        retval = "maximum iterations reached";
+        break;
+
+    default:
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Unknown stop reason."));
+        break;
+    } // end switch
+
+    return retval;
+}
+
+std::string StoppingRule::describe() const
+{
+    std::stringstream ss;
+    if (!isAdaptive())
+        ss << "fixed time " << m_test_time_ms << " ms";
+    else
+    {
+        ss << "adaptive, " << m_criteria.precision * 100.0 << "% precision at "
+           << m_criteria.confidence_level * 100.0 << "% confidence ("
+           << (m_criteria.b_median ? "mean and median" : "mean") << ")"
+           << ", time " << m_criteria.min_time_ms << " to ";
+        if (m_criteria.max_time_ms > 0)
+            ss << m_criteria.max_time_ms << " ms";
+        else
+            ss << "(unbounded)";
+        ss << ", iterations " << std::max(m_min_count, m_criteria.min_iterations) << " to ";
+        if (m_criteria.max_iterations > 0)
+            ss << m_criteria.max_iterations;
+        else
+            ss << "(unbounded)";
+    } // end else
+    return ss.str();
+}
+
+void StoppingRule::appendStoppingReport(hebench::Utilities::TimingReportEx &out_report) const
+{
+    if (isAdaptive())
+    {
+        std::stringstream ss;
+        ss << "Stopping rule, adaptive" << std::endl
+           << "Target precision (%), " << m_criteria.precision * 100.0 << std::endl
+           << "Confidence level (%), " << m_criteria.confidence_level * 100.0 << std::endl
+           << "Iterations, " << m_count << std::endl
+           << "Elapsed time (ms), " << m_elapsed_ms << std::endl
+           << "Achieved mean precision (%), " << getMeanPrecision() * 100.0 << std::endl;
+        if (m_criteria.b_median)
+            ss << "Achieved median precision (%), " << getMedianPrecision() * 100.0 << std::endl;
+        ss << "Stop reason, " << getStopReasonName(m_stop_reason) << std::endl;
+        out_report.appendFooter(ss.str());
+    } // end if
+}
+
+} // namespace TestHarness
+} // namespace hebench
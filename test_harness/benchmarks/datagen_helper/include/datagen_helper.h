@@ -5,11 +5,18 @@
 #ifndef _HEBench_Harness_DataGenHelper_H_0596d40a3cce4b108a81595c50eb286d
 #define _HEBench_Harness_DataGenHelper_H_0596d40a3cce4b108a81595c50eb286d
 
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <list>
 #include <mutex>
 #include <set>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "hebench/modules/logging/include/logging.h"
 
@@ -30,8 +37,33 @@ public:
     ~DataLoaderCompute() override {}
     ResultDataPtr getResultFor(const std::uint64_t *param_data_pack_indices) override;
 
+    /**
+     * @brief Sets the ground truth mode for data loaders created after this call.
+     * @param[in] b_lazy If `true`, data loaders that generate their own data keep
+     * only the inputs resident and compute each ground truth on demand when
+     * requested by getResultFor(). If `false`, all ground truths are computed and
+     * stored during initialization.
+     * @param[in] cache_capacity Maximum number of ground truth samples computed on
+     * demand to keep in a least-recently-used cache. Use `0` to disable caching.
+     * @details Loaders that read an external dataset are not affected by the lazy
+     * mode: ground truths contained in the dataset are always loaded. Results computed
+     * on demand when a dataset does not contain ground truths are cached as well.
+     */
+    static void setLazyResultsMode(bool b_lazy, std::uint64_t cache_capacity = 0);
+    static bool getLazyResultsMode() { return m_b_lazy_results_default; }
+    static std::uint64_t getResultCacheCapacity() { return m_result_cache_capacity_default; }
+
 protected:
-    DataLoaderCompute() {}
+    DataLoaderCompute();
+
+    /**
+     * @brief Specifies whether this loader must skip computing ground truths during
+     * initialization when generating its own data.
+     * @details Derived classes generating synthetic data should pass the negation
+     * of this value as `allocate_output` parameter to `PartialDataLoader::init()`
+     * and skip computing results when this is `true`.
+     */
+    bool isLazyResults() const { return m_b_lazy_results; }
 
     /**
      * @brief Computes result of the operation on the input data given the
@@ -46,17 +78,292 @@ protected:
     virtual void computeResult(std::vector<hebench::APIBridge::NativeDataBuffer *> &result,
                                const std::uint64_t *param_data_pack_indices,
                                hebench::APIBridge::DataType data_type) = 0;
+    /**
+     * @brief Computes and stores the ground truths for every combination of input samples.
+     * @throws std::logic_error if loader is not initialized or no memory was allocated
+     * for results.
+     * @details Result samples are split among all available hardware threads. Each
+     * result sample is computed by calling computeResult() with the input sample
+     * indices that map to it according to getResultIndex(). Thus, computeResult()
+     * must be safe to call concurrently for different result samples.
+     *
+     * Derived classes generating synthetic data should call this method after their
+     * inputs have been generated, unless isLazyResults() is `true`.
+     */
+    void computeResults();
 
 private:
+    typedef std::list<std::pair<std::uint64_t, ResultDataPtr>> ResultCacheList;
+
     // can we find a thread friendly/safe solution?
     std::vector<std::shared_ptr<hebench::APIBridge::DataPack>> &getLocalTempResult();
+    ResultDataPtr computeResultFor(const std::uint64_t *param_data_pack_indices);
+
     std::shared_ptr<std::vector<std::shared_ptr<hebench::APIBridge::DataPack>>> m_p_temp_result;
+    bool m_b_lazy_results;
+    std::uint64_t m_result_cache_capacity;
+    // LRU cache of results computed on demand: most recently used at the front
+    ResultCacheList m_result_cache;
+    std::unordered_map<std::uint64_t, ResultCacheList::iterator> m_result_cache_map;
+    std::mutex m_mtx_result_cache;
+
+    static bool m_b_lazy_results_default;
+    static std::uint64_t m_result_cache_capacity_default;
 };
 
+/**
+ * @brief Session wide cache of data loaders shared among benchmarks.
+ * @details Benchmarks requesting the same dataset reuse the inputs and ground truths
+ * already generated or loaded by a previous benchmark instead of generating or
+ * loading them again. Two requests refer to the same dataset when they match the
+ * workload, workload dimensions, data type, sample sizes, and random seed (for
+ * generated data) or dataset file (for external data).
+ *
+ * Data loaders are cached as long as the total data they hold fits in the configured
+ * memory budget. When the budget is exceeded, least recently used data loaders are
+ * evicted first. Evicted data loaders remain valid while still in use by a benchmark.
+ *
+ * A cache hit skips data generation entirely, so, cached synthetic data is only correct
+ * if generating it again would produce the same values. Data loaders that generate their
+ * own data must draw exclusively from the per-parameter, per-sample streams provided by
+ * DataGeneratorHelper, and never from the global random generator.
+ *
+ * The cache is disabled (capacity `0`) until setCapacity() is called.
+ */
+class DataLoaderCache
+{
+public:
+    DISABLE_COPY(DataLoaderCache)
+    DISABLE_MOVE(DataLoaderCache)
+private:
+    IL_DECLARE_CLASS_NAME(DataLoaderCache)
+public:
+    /**
+     * @brief Identifies a dataset in the cache.
+     */
+    struct Key
+    {
+        /**
+         * @brief Name of the workload for which the dataset is created.
+         */
+        std::string workload;
+        hebench::APIBridge::DataType data_type;
+        /**
+         * @brief Workload dimensions derived from the workload parameters.
+         */
+        std::vector<std::uint64_t> workload_params;
+        /**
+         * @brief Number of samples for each operation parameter.
+         */
+        std::vector<std::uint64_t> sample_sizes;
+        /**
+         * @brief External dataset file. If empty, the dataset is generated using
+         * the current global random seed.
+         */
+        std::string dataset_filename;
+    };
+
+    /**
+     * @brief Sets the memory budget for cached data loaders.
+     * @param[in] capacity Maximum number of bytes of data held by all cached data
+     * loaders. Use `0` to disable caching.
+     * @details Data loaders already cached are evicted as needed to fit the new budget.
+     */
+    static void setCapacity(std::uint64_t capacity);
+    static std::uint64_t getCapacity() { return m_capacity; }
+    /**
+     * @brief Total bytes of data currently held by cached data loaders.
+     */
+    static std::uint64_t getSize();
+    /**
+     * @brief Evicts all data loaders from the cache.
+     */
+    static void clear();
+
+    /**
+     * @brief Retrieves a cached data loader or creates and caches a new one.
+     * @param[in] key Identifies the requested dataset.
+     * @param[in] create Callable object returning a new `std::shared_ptr<TDataLoader>`
+     * initialized for the requested dataset. Only called on a cache miss.
+     * @return Data loader for the requested dataset.
+     * @details If the created data loader does not fit in the memory budget, it is
+     * returned without caching.
+     */
+    template <class TDataLoader, class CreateFunction>
+    static std::shared_ptr<TDataLoader> getDataLoader(const Key &key, CreateFunction &&create);
+
+private:
+    struct CacheEntry
+    {
+        std::string key;
+        IDataLoader::Ptr p_data_loader;
+        /**
+         * @brief Bytes of data held by the data loader when it was cached.
+         */
+        std::uint64_t data_size;
+    };
+    typedef std::list<CacheEntry> CacheList;
+
+    DataLoaderCache() = default;
+    static std::string makeKeyString(const Key &key);
+    /**
+     * @brief Looks up a data loader in the cache and marks it as most recently used.
+     * @param[in] s_key Key string of the requested dataset.
+     * @param[out] p_data_loader Cached data loader, if found.
+     * @param[out] data_size Bytes of data held by the cached data loader, if found.
+     * @return `true` on cache hit, `false` otherwise.
+     */
+    static bool find(const std::string &s_key, IDataLoader::Ptr &p_data_loader, std::uint64_t &data_size);
+    static void insert(const std::string &s_key, IDataLoader::Ptr p_data_loader);
+    static void evict(std::uint64_t capacity);
+
+    static std::uint64_t m_capacity;
+    static std::uint64_t m_size;
+    // LRU cache of data loaders: most recently used at the front
+    static CacheList m_cache;
+    static std::unordered_map<std::string, CacheList::iterator> m_cache_map;
+    static std::mutex m_mtx_cache;
+};
+
+template <class TDataLoader, class CreateFunction>
+inline std::shared_ptr<TDataLoader> DataLoaderCache::getDataLoader(const Key &key, CreateFunction &&create)
+{
+    std::string s_key = makeKeyString(key);
+    std::shared_ptr<TDataLoader> retval;
+    IDataLoader::Ptr p_cached;
+    std::uint64_t data_size;
+    if (find(s_key, p_cached, data_size))
+        retval = std::dynamic_pointer_cast<TDataLoader>(p_cached);
+    if (retval)
+    {
+        std::cout << IOS_MSG_INFO
+                  << hebench::Logging::GlobalLogger::log("Reusing dataset from session cache (" + std::to_string(data_size) + " bytes).")
+                  << std::endl;
+    } // end if
+    else
+    {
+        retval = create();
+        insert(s_key, retval);
+    } // end else
+    return retval;
+}
+
+/**
+ * @brief Counter-based pseudo-random number generator (Philox4x32-10).
+ * @details Each output block is a pure function of a 64-bit key and a 128-bit
+ * counter. This allows any element of a random stream to be generated
+ * independently from all others, without shared state or locking, and
+ * streams can be split by key without overlap.
+ */
+class CounterBasedRandom
+{
+public:
+    typedef std::array<std::uint32_t, 4> Block;
+
+    /**
+     * @brief Sequential view of a counter-based random stream that satisfies the
+     * requirements of a standard uniform random bit generator.
+     * @details The n-th value drawn depends only on the key, the stream index and n,
+     * never on shared state, so, it can be used with standard distributions and
+     * algorithms to obtain repeatable results in any order or thread.
+     */
+    class Engine
+    {
+    public:
+        typedef std::uint64_t result_type;
+
+        Engine(std::uint64_t key, std::uint64_t stream_index) :
+            m_key(key), m_stream_index(stream_index), m_counter(0) {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~static_cast<result_type>(0); }
+        result_type operator()()
+        {
+            Block block = CounterBasedRandom::generate(m_key, m_counter++, m_stream_index);
+            return (static_cast<std::uint64_t>(block[1]) << 32) | block[0];
+        }
+
+    private:
+        std::uint64_t m_key;
+        std::uint64_t m_stream_index;
+        std::uint64_t m_counter;
+    };
+
+    /**
+     * @brief Generates the random block for the specified key and counter.
+     * @param[in] key Key identifying the random stream.
+     * @param[in] counter_lo Low 64 bits of the counter.
+     * @param[in] counter_hi High 64 bits of the counter.
+     * @return 128 random bits.
+     */
+    static Block generate(std::uint64_t key, std::uint64_t counter_lo, std::uint64_t counter_hi);
+    /**
+     * @brief Derives a key for an independent stream from a seed and a stream ID.
+     */
+    static std::uint64_t makeStreamKey(std::uint64_t seed, std::uint64_t stream_id);
+    /**
+     * @brief Converts random bits into a uniformly distributed double in
+     * range `[0, 1)` using the 53 most significant bits.
+     */
+    static double toUniform(std::uint64_t bits) { return static_cast<double>(bits >> 11) * 0x1.0p-53; }
+
+private:
+    static constexpr std::uint32_t M0   = 0xD2511F53U;
+    static constexpr std::uint32_t M1   = 0xCD9E8D57U;
+    static constexpr std::uint32_t W0   = 0x9E3779B9U;
+    static constexpr std::uint32_t W1   = 0xBB67AE85U;
+    static constexpr std::size_t Rounds = 10;
+    static std::uint64_t mix(std::uint64_t x);
+};
+
+inline CounterBasedRandom::Block CounterBasedRandom::generate(std::uint64_t key,
+                                                              std::uint64_t counter_lo,
+                                                              std::uint64_t counter_hi)
+{
+    std::uint32_t k0 = static_cast<std::uint32_t>(key);
+    std::uint32_t k1 = static_cast<std::uint32_t>(key >> 32);
+    Block c;
+    c[0] = static_cast<std::uint32_t>(counter_lo);
+    c[1] = static_cast<std::uint32_t>(counter_lo >> 32);
+    c[2] = static_cast<std::uint32_t>(counter_hi);
+    c[3] = static_cast<std::uint32_t>(counter_hi >> 32);
+    for (std::size_t round_i = 0; round_i < Rounds; ++round_i)
+    {
+        std::uint64_t prod0 = static_cast<std::uint64_t>(M0) * c[0];
+        std::uint64_t prod1 = static_cast<std::uint64_t>(M1) * c[2];
+        c[0]                = static_cast<std::uint32_t>(prod1 >> 32) ^ c[1] ^ k0;
+        c[2]                = static_cast<std::uint32_t>(prod0 >> 32) ^ c[3] ^ k1;
+        c[1]                = static_cast<std::uint32_t>(prod1);
+        c[3]                = static_cast<std::uint32_t>(prod0);
+        k0 += W0;
+        k1 += W1;
+    } // end for
+    return c;
+}
+
+inline std::uint64_t CounterBasedRandom::mix(std::uint64_t x)
+{
+    // splitmix64 finalizer
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+inline std::uint64_t CounterBasedRandom::makeStreamKey(std::uint64_t seed, std::uint64_t stream_id)
+{
+    return mix(seed ^ mix(stream_id));
+}
+
 /**
  * @brief Static helper class to generate vector data for all supported data types.
  * @details This class uses the default seed for generation to ensure repeatable results
  * as long as parameters for the tests are the same.
+ *
+ * Random values are produced by a counter-based generator where each element is
+ * keyed by `(seed, parameter, sample, element)`. Buffers are filled in parallel
+ * chunks without locking, and the generated data is identical regardless of the
+ * number of threads used.
  */
 class DataGeneratorHelper
 {
@@ -90,7 +397,51 @@ public:
                                       void *result, std::uint64_t elem_count,
                                       double mean, double stddev);
 
+    /**
+     * @brief Generates uniform random data of the specified type for a sample
+     * of an operation parameter.
+     * @param[in] data_type Data type of data to generate.
+     * @param[in] result Pointer to buffer containing elements of the specified type.
+     * @param[in] elem_count Number of elements in pointed buffer.
+     * @param[in] min_val Minimum value for generated elements.
+     * @param[in] max_val Maximum value for generated elements.
+     * @param[in] param_index Index of the operation parameter for which to generate.
+     * @param[in] sample_index Index of the sample inside the operation parameter.
+     * @details The generated data depends only on the global random seed,
+     * \p param_index , \p sample_index and the element position, hence,
+     * samples can be generated in any order or concurrently with repeatable results.
+     */
+    static void generateRandomVectorU(hebench::APIBridge::DataType data_type,
+                                      void *result, std::uint64_t elem_count,
+                                      double min_val, double max_val,
+                                      std::uint64_t param_index, std::uint64_t sample_index);
+
+    /**
+     * @brief Generates normally distributed random data of the specified type for
+     * a sample of an operation parameter.
+     * @param[in] data_type Data type of data to generate.
+     * @param[in] result Pointer to buffer containing elements of the specified type.
+     * @param[in] elem_count Number of elements in pointed buffer.
+     * @param[in] mean Mean of the distribution.
+     * @param[in] stddev Standard deviation of the distribution.
+     * @param[in] param_index Index of the operation parameter for which to generate.
+     * @param[in] sample_index Index of the sample inside the operation parameter.
+     * @details See generateRandomVectorU() for details on repeatability.
+     */
+    static void generateRandomVectorN(hebench::APIBridge::DataType data_type,
+                                      void *result, std::uint64_t elem_count,
+                                      double mean, double stddev,
+                                      std::uint64_t param_index, std::uint64_t sample_index);
+
     static std::uint64_t generateRandomIntU(std::uint64_t min_val, std::uint64_t max_val);
+    /**
+     * @brief Generates a uniform random integer drawing from the specified stream.
+     * @param[in] min_val Minimum value to generate.
+     * @param[in] max_val Maximum value to generate.
+     * @param[in,out] engine Random stream as returned by createRandomEngine().
+     */
+    static std::uint64_t generateRandomIntU(std::uint64_t min_val, std::uint64_t max_val,
+                                            CounterBasedRandom::Engine &engine);
 
     /**
      * @brief Generates uniform random amount of indices.
@@ -99,17 +450,57 @@ public:
      * @return A vector holding the indices.
      */
     static std::vector<std::uint64_t> generateRandomIntersectionIndicesU(std::uint64_t elem_count, std::uint64_t indices_count = 0);
+    /**
+     * @brief Generates uniform random amount of indices drawing from the specified stream.
+     * @param[in] elem_count Number of elements in the set.
+     * @param[in] indices_count Number of pre-defined indices to be generated.
+     * If 0, a random amount is generated.
+     * @param[in,out] engine Random stream as returned by createRandomEngine().
+     * @return A vector holding the indices.
+     */
+    static std::vector<std::uint64_t> generateRandomIntersectionIndicesU(std::uint64_t elem_count, std::uint64_t indices_count,
+                                                                         CounterBasedRandom::Engine &engine);
+
+    /**
+     * @brief Creates a random stream for the auxiliary random choices made while
+     * generating a sample of an operation parameter.
+     * @param[in] param_index Index of the operation parameter for which to generate.
+     * @param[in] sample_index Index of the sample inside the operation parameter.
+     * @details The stream depends only on the global random seed, \p param_index and
+     * \p sample_index , and it does not overlap with the data generated by
+     * generateRandomVectorU() or generateRandomVectorN() for the same sample.
+     */
+    static CounterBasedRandom::Engine createRandomEngine(std::uint64_t param_index, std::uint64_t sample_index);
 
 protected:
     DataGeneratorHelper() = default;
 
 private:
+    // minimum number of elements per thread when filling a buffer
+    static constexpr std::uint64_t MinParallelChunkSize = 0x4000;
+    // stream ID used for generation not tied to an operation parameter
+    static constexpr std::uint64_t AnonymousStreamID = ~static_cast<std::uint64_t>(0);
+    // stream ID used to derive auxiliary random streams from the parameter streams
+    static constexpr std::uint64_t EngineStreamID = AnonymousStreamID - 1;
+
     template <class T>
     static void generateRandomVectorU(T *result, std::uint64_t elem_count,
-                                      T min_val, T max_val);
+                                      T min_val, T max_val,
+                                      std::uint64_t key, std::uint64_t sample_index);
     template <class T>
     static void generateRandomVectorN(T *result, std::uint64_t elem_count,
-                                      T mean, T stddev);
+                                      T mean, T stddev,
+                                      std::uint64_t key, std::uint64_t sample_index);
+    template <class URBG>
+    static std::uint64_t generateRandomIntU(std::uint64_t min_val, std::uint64_t max_val, URBG &rand);
+    template <class URBG>
+    static std::vector<std::uint64_t> generateRandomIntersectionIndicesU(std::uint64_t elem_count, std::uint64_t indices_count,
+                                                                         URBG &rand);
+    /**
+     * @brief Draws a new stream index from the global random generator to
+     * use in calls that do not specify operation parameter and sample.
+     */
+    static std::uint64_t nextAnonymousSample();
 
 private:
     static std::mutex m_mtx_rand;
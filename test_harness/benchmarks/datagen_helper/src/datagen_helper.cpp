@@ -5,7 +5,10 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>
 
 #include "../include/datagen_helper.h"
@@ -15,11 +18,30 @@ namespace hebench {
 namespace TestHarness {
 
 std::mutex DataGeneratorHelper::m_mtx_rand;
+bool DataLoaderCompute::m_b_lazy_results_default                 = false;
+std::uint64_t DataLoaderCompute::m_result_cache_capacity_default = 0;
+std::uint64_t DataLoaderCache::m_capacity                        = 0;
+std::uint64_t DataLoaderCache::m_size                            = 0;
+DataLoaderCache::CacheList DataLoaderCache::m_cache;
+std::unordered_map<std::string, DataLoaderCache::CacheList::iterator> DataLoaderCache::m_cache_map;
+std::mutex DataLoaderCache::m_mtx_cache;
 
 //-------------------------
 // class DataLoaderCompute
 //-------------------------
 
+void DataLoaderCompute::setLazyResultsMode(bool b_lazy, std::uint64_t cache_capacity)
+{
+    m_b_lazy_results_default        = b_lazy;
+    m_result_cache_capacity_default = cache_capacity;
+}
+
+DataLoaderCompute::DataLoaderCompute() :
+    m_b_lazy_results(m_b_lazy_results_default),
+    m_result_cache_capacity(m_result_cache_capacity_default)
+{
+}
+
 IDataLoader::ResultDataPtr DataLoaderCompute::getResultFor(const std::uint64_t *param_data_pack_indices)
 {
     if (!this->isInitialized())
@@ -31,87 +53,312 @@ IDataLoader::ResultDataPtr DataLoaderCompute::getResultFor(const std::uint64_t *
     {
         p_retval = PartialDataLoader::getResultFor(param_data_pack_indices);
     } // end if
+    else if (m_result_cache_capacity <= 0)
+    {
+        p_retval = computeResultFor(param_data_pack_indices);
+    } // end else if
     else
     {
         std::uint64_t r_i = getResultIndex(param_data_pack_indices);
-        std::shared_ptr<std::vector<std::shared_ptr<hebench::APIBridge::DataPack>>> p_tmp_packs =
-            std::make_shared<std::vector<std::shared_ptr<hebench::APIBridge::DataPack>>>(getResultTempDataPacks());
-        std::vector<std::shared_ptr<hebench::APIBridge::DataPack>> &tmp_packs = *p_tmp_packs;
-        // point to the `NativeDataBuffer`s to contain the result
-        std::vector<hebench::APIBridge::NativeDataBuffer *> result(tmp_packs.size());
-        for (std::size_t result_component_i = 0; result_component_i < result.size(); ++result_component_i)
+
         {
-            assert(tmp_packs[result_component_i]
-                   && tmp_packs[result_component_i]->buffer_count > 0
-                   && tmp_packs[result_component_i]->p_buffers
-                   && tmp_packs[result_component_i]->p_buffers[0].p
-                   && tmp_packs[result_component_i]->p_buffers[0].size > 0);
-            result[result_component_i] = &(tmp_packs[result_component_i]->p_buffers[0]);
-        } // end for
-        // compute result and store in the pre-allocated buffers
-        computeResult(result, param_data_pack_indices, getDataType());
-
-        p_retval = ResultDataPtr(new ResultData());
-        p_retval->result.assign(result.begin(), result.end()); // pointers to pre-allocated data
-        p_retval->sample_index = r_i;
-        p_retval->reserved0    = p_tmp_packs; // pre-allocated data as a RAII
-    } // end if
+            std::lock_guard<std::mutex> lock(m_mtx_result_cache);
+            auto it = m_result_cache_map.find(r_i);
+            if (it != m_result_cache_map.end())
+            {
+                // cache hit: move to front of LRU list
+                m_result_cache.splice(m_result_cache.begin(), m_result_cache, it->second);
+                p_retval = it->second->second;
+            } // end if
+        }
+
+        if (!p_retval)
+        {
+            // cache miss: compute outside the lock to allow concurrent computations
+            p_retval = computeResultFor(param_data_pack_indices);
+
+            std::lock_guard<std::mutex> lock(m_mtx_result_cache);
+            if (m_result_cache_map.count(r_i) <= 0)
+            {
+                m_result_cache.emplace_front(r_i, p_retval);
+                m_result_cache_map[r_i] = m_result_cache.begin();
+                if (m_result_cache.size() > m_result_cache_capacity)
+                {
+                    // evict least recently used
+                    m_result_cache_map.erase(m_result_cache.back().first);
+                    m_result_cache.pop_back();
+                } // end if
+            } // end if
+        } // end if
+    } // end else
 
     return p_retval;
 }
 
+void DataLoaderCompute::computeResults()
+{
+    if (!this->isInitialized())
+        throw std::logic_error(IL_LOG_MSG_CLASS("Not initialized."));
+    if (!this->hasResults())
+        throw std::logic_error(IL_LOG_MSG_CLASS("No memory allocated for results."));
+
+    if (getResultCount() <= 0)
+        return;
+
+    // all result components have one sample per combination of input samples
+    std::uint64_t result_sample_count = getResultData(0).buffer_count;
+    hebench::Utilities::parallelForChunks(
+        result_sample_count,
+        [this](std::uint64_t first, std::uint64_t last) {
+            std::vector<std::uint64_t> ppi(getParameterCount());
+            std::vector<hebench::APIBridge::NativeDataBuffer *> result(getResultCount());
+            for (std::uint64_t r_i = first; r_i < last; ++r_i)
+            {
+                // find the input indices for the result buffer: inverse of getResultIndex()
+                std::uint64_t remainder = r_i;
+                for (std::size_t param_i = ppi.size(); param_i > 0; --param_i)
+                {
+                    std::uint64_t sample_count = getParameterData(param_i - 1).buffer_count;
+                    ppi[param_i - 1]           = remainder % sample_count;
+                    remainder /= sample_count;
+                } // end for
+                assert(remainder == 0 && getResultIndex(ppi.data()) == r_i);
+
+                for (std::size_t result_component_i = 0; result_component_i < result.size(); ++result_component_i)
+                    result[result_component_i] = &getResultData(result_component_i).p_buffers[r_i];
+
+                // compute result and store in the pre-allocated buffers
+                computeResult(result, ppi.data(), getDataType());
+            } // end for
+        });
+}
+
+IDataLoader::ResultDataPtr DataLoaderCompute::computeResultFor(const std::uint64_t *param_data_pack_indices)
+{
+    ResultDataPtr p_retval;
+
+    std::uint64_t r_i = getResultIndex(param_data_pack_indices);
+    std::shared_ptr<std::vector<std::shared_ptr<hebench::APIBridge::DataPack>>> p_tmp_packs =
+        std::make_shared<std::vector<std::shared_ptr<hebench::APIBridge::DataPack>>>(getResultTempDataPacks());
+    std::vector<std::shared_ptr<hebench::APIBridge::DataPack>> &tmp_packs = *p_tmp_packs;
+    // point to the `NativeDataBuffer`s to contain the result
+    std::vector<hebench::APIBridge::NativeDataBuffer *> result(tmp_packs.size());
+    for (std::size_t result_component_i = 0; result_component_i < result.size(); ++result_component_i)
+    {
+        assert(tmp_packs[result_component_i]
+               && tmp_packs[result_component_i]->buffer_count > 0
+               && tmp_packs[result_component_i]->p_buffers
+               && tmp_packs[result_component_i]->p_buffers[0].p
+               && tmp_packs[result_component_i]->p_buffers[0].size > 0);
+        result[result_component_i] = &(tmp_packs[result_component_i]->p_buffers[0]);
+    } // end for
+    // compute result and store in the pre-allocated buffers
+    computeResult(result, param_data_pack_indices, getDataType());
+
+    p_retval = ResultDataPtr(new ResultData());
+    p_retval->result.assign(result.begin(), result.end()); // pointers to pre-allocated data
+    p_retval->sample_index = r_i;
+    p_retval->reserved0    = p_tmp_packs; // pre-allocated data as a RAII
+
+    return p_retval;
+}
+
+//-----------------------
+// class DataLoaderCache
+//-----------------------
+
+void DataLoaderCache::setCapacity(std::uint64_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_mtx_cache);
+    m_capacity = capacity;
+    evict(m_capacity);
+}
+
+std::uint64_t DataLoaderCache::getSize()
+{
+    std::lock_guard<std::mutex> lock(m_mtx_cache);
+    return m_size;
+}
+
+void DataLoaderCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mtx_cache);
+    evict(0);
+}
+
+std::string DataLoaderCache::makeKeyString(const Key &key)
+{
+    std::stringstream ss;
+
+    ss << key.workload << "|" << static_cast<int>(key.data_type) << "|";
+    for (std::uint64_t value : key.workload_params)
+        ss << value << ",";
+    ss << "|";
+    for (std::uint64_t value : key.sample_sizes)
+        ss << value << ",";
+    ss << "|";
+    if (key.dataset_filename.empty())
+    {
+        // generated data depends on the seed and on how ground truths are produced
+        ss << "seed=" << hebench::Utilities::RandomGenerator::getRandomSeed()
+           << "|lazy=" << DataLoaderCompute::getLazyResultsMode();
+    } // end if
+    else
+    {
+        // identify the file by its contents version as well, in case it changes during the session
+        std::error_code err;
+        std::filesystem::path dataset_path = std::filesystem::absolute(key.dataset_filename, err);
+        if (err)
+            dataset_path = key.dataset_filename;
+        ss << "file=" << dataset_path.string();
+        auto file_size = std::filesystem::file_size(dataset_path, err);
+        if (!err)
+            ss << "|size=" << file_size;
+        auto file_time = std::filesystem::last_write_time(dataset_path, err);
+        if (!err)
+            ss << "|time=" << file_time.time_since_epoch().count();
+    } // end else
+
+    return ss.str();
+}
+
+bool DataLoaderCache::find(const std::string &s_key, IDataLoader::Ptr &p_data_loader, std::uint64_t &data_size)
+{
+    std::lock_guard<std::mutex> lock(m_mtx_cache);
+    auto it = m_cache_map.find(s_key);
+    if (it == m_cache_map.end())
+        return false;
+
+    // cache hit: move to front of LRU list
+    m_cache.splice(m_cache.begin(), m_cache, it->second);
+    p_data_loader = it->second->p_data_loader;
+    data_size     = it->second->data_size;
+    return true;
+}
+
+void DataLoaderCache::insert(const std::string &s_key, IDataLoader::Ptr p_data_loader)
+{
+    if (!p_data_loader)
+        return;
+
+    std::uint64_t data_size = p_data_loader->getTotalDataLoaded();
+
+    std::lock_guard<std::mutex> lock(m_mtx_cache);
+    if (data_size > m_capacity || m_cache_map.count(s_key) > 0)
+        // does not fit in the budget or already cached
+        return;
+
+    evict(m_capacity - data_size);
+    m_cache.push_front({ s_key, p_data_loader, data_size });
+    m_cache_map[s_key] = m_cache.begin();
+    m_size += data_size;
+}
+
+void DataLoaderCache::evict(std::uint64_t capacity)
+{
+    // must be called with m_mtx_cache locked
+    while (!m_cache.empty() && m_size > capacity)
+    {
+        // evict least recently used
+        m_size -= m_cache.back().data_size;
+        m_cache_map.erase(m_cache.back().key);
+        m_cache.pop_back();
+    } // end while
+}
+
 //---------------------------
 // class DataGeneratorHelper
 //---------------------------
 
+std::uint64_t DataGeneratorHelper::nextAnonymousSample()
+{
+    std::lock_guard<std::mutex> lock(m_mtx_rand);
+    std::uint64_t retval = hebench::Utilities::RandomGenerator::get()();
+    retval               = (retval << 32) | hebench::Utilities::RandomGenerator::get()();
+    return retval;
+}
+
 template <class T>
 inline void DataGeneratorHelper::generateRandomVectorU(T *result, std::uint64_t elem_count,
-                                                       T min_val, T max_val)
+                                                       T min_val, T max_val,
+                                                       std::uint64_t key, std::uint64_t sample_index)
 {
-    std::uniform_real_distribution<double> rnd(min_val, max_val);
-    for (std::uint64_t i = 0; i < elem_count; ++i)
-    {
-        std::lock_guard<std::mutex> lock(m_mtx_rand);
-        result[i] = static_cast<T>(rnd(hebench::Utilities::RandomGenerator::get()));
-    } // end for
+    const double range = static_cast<double>(max_val) - static_cast<double>(min_val);
+    hebench::Utilities::parallelForChunks(
+        elem_count,
+        [result, min_val, range, key, sample_index](std::uint64_t first, std::uint64_t last) {
+            for (std::uint64_t i = first; i < last; ++i)
+            {
+                CounterBasedRandom::Block block = CounterBasedRandom::generate(key, i, sample_index);
+                double u                        = CounterBasedRandom::toUniform((static_cast<std::uint64_t>(block[1]) << 32) | block[0]);
+                result[i]                       = static_cast<T>(static_cast<double>(min_val) + u * range);
+            } // end for
+        },
+        MinParallelChunkSize);
 }
 
 template <class T>
 inline void DataGeneratorHelper::generateRandomVectorN(T *result, std::uint64_t elem_count,
-                                                       T mean, T stddev)
+                                                       T mean, T stddev,
+                                                       std::uint64_t key, std::uint64_t sample_index)
 {
-    std::normal_distribution<double> rnd(mean, stddev);
-    for (std::uint64_t i = 0; i < elem_count; ++i)
-    {
-        std::lock_guard<std::mutex> lock(m_mtx_rand);
-        result[i] = static_cast<T>(rnd(hebench::Utilities::RandomGenerator::get()));
-    } // end for
+    constexpr double TwoPi = 6.283185307179586476925286766559;
+    hebench::Utilities::parallelForChunks(
+        elem_count,
+        [result, mean, stddev, key, sample_index](std::uint64_t first, std::uint64_t last) {
+            for (std::uint64_t i = first; i < last; ++i)
+            {
+                // Box-Muller transform on the two halves of the block
+                CounterBasedRandom::Block block = CounterBasedRandom::generate(key, i, sample_index);
+                double u0                       = 1.0 - CounterBasedRandom::toUniform((static_cast<std::uint64_t>(block[1]) << 32) | block[0]); // (0, 1]
+                double u1                       = CounterBasedRandom::toUniform((static_cast<std::uint64_t>(block[3]) << 32) | block[2]);
+                double z                        = std::sqrt(-2.0 * std::log(u0)) * std::cos(TwoPi * u1);
+                result[i]                       = static_cast<T>(static_cast<double>(mean) + z * static_cast<double>(stddev));
+            } // end for
+        },
+        MinParallelChunkSize);
 }
 
 void DataGeneratorHelper::generateRandomVectorU(hebench::APIBridge::DataType data_type,
                                                 void *result, std::uint64_t elem_count,
                                                 double min_val, double max_val)
 {
+    generateRandomVectorU(data_type, result, elem_count, min_val, max_val,
+                          AnonymousStreamID, nextAnonymousSample());
+}
+
+void DataGeneratorHelper::generateRandomVectorU(hebench::APIBridge::DataType data_type,
+                                                void *result, std::uint64_t elem_count,
+                                                double min_val, double max_val,
+                                                std::uint64_t param_index, std::uint64_t sample_index)
+{
+    std::uint64_t key = CounterBasedRandom::makeStreamKey(hebench::Utilities::RandomGenerator::getRandomSeed(),
+                                                          param_index);
+
     switch (data_type)
     {
     case hebench::APIBridge::DataType::Int32:
         generateRandomVectorU<std::int32_t>(reinterpret_cast<std::int32_t *>(result), elem_count,
-                                            static_cast<std::int32_t>(min_val), static_cast<std::int32_t>(max_val));
+                                            static_cast<std::int32_t>(min_val), static_cast<std::int32_t>(max_val),
+                                            key, sample_index);
         break;
 
     case hebench::APIBridge::DataType::Int64:
         generateRandomVectorU<std::int64_t>(reinterpret_cast<std::int64_t *>(result), elem_count,
-                                            static_cast<std::int64_t>(min_val), static_cast<std::int64_t>(max_val));
+                                            static_cast<std::int64_t>(min_val), static_cast<std::int64_t>(max_val),
+                                            key, sample_index);
         break;
 
     case hebench::APIBridge::DataType::Float32:
         generateRandomVectorU<float>(reinterpret_cast<float *>(result), elem_count,
-                                     static_cast<float>(min_val), static_cast<float>(max_val));
+                                     static_cast<float>(min_val), static_cast<float>(max_val),
+                                     key, sample_index);
         break;
 
     case hebench::APIBridge::DataType::Float64:
         generateRandomVectorU<double>(reinterpret_cast<double *>(result), elem_count,
-                                      static_cast<double>(min_val), static_cast<double>(max_val));
+                                      static_cast<double>(min_val), static_cast<double>(max_val),
+                                      key, sample_index);
         break;
 
     default:
@@ -124,26 +371,42 @@ void DataGeneratorHelper::generateRandomVectorN(hebench::APIBridge::DataType dat
                                                 void *result, std::uint64_t elem_count,
                                                 double mean, double stddev)
 {
+    generateRandomVectorN(data_type, result, elem_count, mean, stddev,
+                          AnonymousStreamID, nextAnonymousSample());
+}
+
+void DataGeneratorHelper::generateRandomVectorN(hebench::APIBridge::DataType data_type,
+                                                void *result, std::uint64_t elem_count,
+                                                double mean, double stddev,
+                                                std::uint64_t param_index, std::uint64_t sample_index)
+{
+    std::uint64_t key = CounterBasedRandom::makeStreamKey(hebench::Utilities::RandomGenerator::getRandomSeed(),
+                                                          param_index);
+
     switch (data_type)
     {
     case hebench::APIBridge::DataType::Int32:
         generateRandomVectorN<std::int32_t>(reinterpret_cast<std::int32_t *>(result), elem_count,
-                                            static_cast<std::int32_t>(mean), static_cast<std::int32_t>(stddev));
+                                            static_cast<std::int32_t>(mean), static_cast<std::int32_t>(stddev),
+                                            key, sample_index);
         break;
 
     case hebench::APIBridge::DataType::Int64:
         generateRandomVectorN<std::int64_t>(reinterpret_cast<std::int64_t *>(result), elem_count,
-                                            static_cast<std::int64_t>(mean), static_cast<std::int64_t>(stddev));
+                                            static_cast<std::int64_t>(mean), static_cast<std::int64_t>(stddev),
+                                            key, sample_index);
         break;
 
     case hebench::APIBridge::DataType::Float32:
         generateRandomVectorN<float>(reinterpret_cast<float *>(result), elem_count,
-                                     static_cast<float>(mean), static_cast<float>(stddev));
+                                     static_cast<float>(mean), static_cast<float>(stddev),
+                                     key, sample_index);
         break;
 
     case hebench::APIBridge::DataType::Float64:
         generateRandomVectorN<double>(reinterpret_cast<double *>(result), elem_count,
-                                      static_cast<double>(mean), static_cast<double>(stddev));
+                                      static_cast<double>(mean), static_cast<double>(stddev),
+                                      key, sample_index);
         break;
 
     default:
@@ -152,25 +415,57 @@ void DataGeneratorHelper::generateRandomVectorN(hebench::APIBridge::DataType dat
     } // end switch
 }
 
-std::uint64_t DataGeneratorHelper::generateRandomIntU(std::uint64_t min_val, std::uint64_t max_val)
+template <class URBG>
+inline std::uint64_t DataGeneratorHelper::generateRandomIntU(std::uint64_t min_val, std::uint64_t max_val, URBG &rand)
 {
     std::uniform_int_distribution<std::uint64_t> rnd(min_val, max_val);
-    return rnd(hebench::Utilities::RandomGenerator::get());
+    return rnd(rand);
 }
 
-std::vector<std::uint64_t> DataGeneratorHelper::generateRandomIntersectionIndicesU(std::uint64_t elem_count, std::uint64_t indices_count)
+template <class URBG>
+inline std::vector<std::uint64_t> DataGeneratorHelper::generateRandomIntersectionIndicesU(std::uint64_t elem_count, std::uint64_t indices_count,
+                                                                                          URBG &rand)
 {
     std::vector<std::uint64_t> retval;
 
     if (indices_count <= 0)
-        indices_count = generateRandomIntU(0, elem_count - 1);
+        indices_count = generateRandomIntU(0, elem_count - 1, rand);
 
     retval.resize(elem_count);
     std::iota(retval.begin(), retval.end(), 0);
-    std::shuffle(retval.begin(), retval.end(), hebench::Utilities::RandomGenerator::get());
+    std::shuffle(retval.begin(), retval.end(), rand);
 
     return std::vector<std::uint64_t>(retval.begin(), retval.begin() + indices_count);
 }
 
+std::uint64_t DataGeneratorHelper::generateRandomIntU(std::uint64_t min_val, std::uint64_t max_val)
+{
+    return generateRandomIntU(min_val, max_val, hebench::Utilities::RandomGenerator::get());
+}
+
+std::uint64_t DataGeneratorHelper::generateRandomIntU(std::uint64_t min_val, std::uint64_t max_val,
+                                                      CounterBasedRandom::Engine &engine)
+{
+    return generateRandomIntU<CounterBasedRandom::Engine>(min_val, max_val, engine);
+}
+
+std::vector<std::uint64_t> DataGeneratorHelper::generateRandomIntersectionIndicesU(std::uint64_t elem_count, std::uint64_t indices_count)
+{
+    return generateRandomIntersectionIndicesU(elem_count, indices_count, hebench::Utilities::RandomGenerator::get());
+}
+
+std::vector<std::uint64_t> DataGeneratorHelper::generateRandomIntersectionIndicesU(std::uint64_t elem_count, std::uint64_t indices_count,
+                                                                                   CounterBasedRandom::Engine &engine)
+{
+    return generateRandomIntersectionIndicesU<CounterBasedRandom::Engine>(elem_count, indices_count, engine);
+}
+
+CounterBasedRandom::Engine DataGeneratorHelper::createRandomEngine(std::uint64_t param_index, std::uint64_t sample_index)
+{
+    std::uint64_t key = CounterBasedRandom::makeStreamKey(hebench::Utilities::RandomGenerator::getRandomSeed(),
+                                                          param_index);
+    return CounterBasedRandom::Engine(CounterBasedRandom::makeStreamKey(key, EngineStreamID), sample_index);
+}
+
 } // namespace TestHarness
 } // namespace hebench
@@ -88,6 +88,79 @@ private:
     }
 };
 
+/**
+ * @brief Numeric tolerance used to validate benchmark results against ground truth.
+ * @details An element `b` of a result is valid with respect to the corresponding
+ * ground truth element `a` if `a == b` or if it satisfies the criterion selected
+ * by `model`:
+ *
+ * - Model::Relative: `a` and `b` are within `relative * 100` percent of each other,
+ * as defined by `hebench::Utilities::Math::almostEqual()`.
+ * - Model::Absolute: `|a - b| <= absolute`.
+ * - Model::ULP: there are at most `ulp` representable values between `a` and `b`.
+ * For integer data types, this is `|a - b| <= ulp`.
+ * - Model::Mixed: any of the above criteria.
+ *
+ * The default tolerance is 1% relative.
+ */
+class ValidationTolerance
+{
+public:
+    enum class Model
+    {
+        Relative,
+        Absolute,
+        ULP,
+        Mixed
+    };
+
+    static constexpr double DefaultRelative = 0.01;
+
+    ValidationTolerance() :
+        model(Model::Relative),
+        absolute(0.0),
+        relative(DefaultRelative),
+        ulp(0)
+    {
+    }
+
+    /**
+     * @brief Lowercase name of the specified model, as used in configuration files.
+     */
+    static std::string getModelName(Model model)
+    {
+        switch (model)
+        {
+        case Model::Relative:
+            return "relative";
+        case Model::Absolute:
+            return "absolute";
+        case Model::ULP:
+            return "ulp";
+        case Model::Mixed:
+            return "mixed";
+        default:
+            return "unknown";
+        } // end switch
+    }
+
+    Model model;
+    /**
+     * @brief Maximum absolute difference for Model::Absolute and Model::Mixed.
+     */
+    double absolute;
+    /**
+     * @brief Maximum relative difference, as per-one, for Model::Relative and
+     * Model::Mixed.
+     */
+    double relative;
+    /**
+     * @brief Maximum distance in units in the last place for Model::ULP and
+     * Model::Mixed.
+     */
+    std::uint64_t ulp;
+};
+
 /**
  * @brief Specifies a benchmark configuration.
  * @details Parameters are established by priority based on where they are
@@ -153,6 +226,12 @@ public:
      * @brief Defines if the workload report will be created in a single-level directory
      */
     bool b_single_path_report;
+    /**
+     * @brief Numeric tolerance used to validate results of the benchmark.
+     * @details Since each benchmark is specific to a workload and data type, this
+     * allows tolerances per workload and data type.
+     */
+    ValidationTolerance validation_tolerance;
 };
 
 class Description
@@ -446,6 +446,76 @@ private:
 
 public:
     typedef std::shared_ptr<IBenchmark> Ptr;
+    /**
+     * @brief Specifies which results of an offline test are validated.
+     */
+    enum class ValidationPolicy
+    {
+        /**
+         * @brief All results are validated.
+         */
+        Full,
+        /**
+         * @brief A uniformly random selection of results is validated.
+         */
+        Random,
+        /**
+         * @brief A random selection of results is validated such that the samples
+         * for each operation parameter are represented evenly.
+         */
+        Stratified,
+        /**
+         * @brief The first and the last results are validated.
+         */
+        FirstLast
+    };
+    /**
+     * @brief Specifies how operations are issued during a latency test.
+     */
+    enum class ArrivalProcess
+    {
+        /**
+         * @brief Closed loop: each operation is issued as soon as the previous one
+         * completes.
+         */
+        Closed,
+        /**
+         * @brief Open loop: operations arrive at constant intervals.
+         */
+        Constant,
+        /**
+         * @brief Open loop: operations arrive following a Poisson process.
+         */
+        Poisson
+    };
+    /**
+     * @brief Specifies when the operation loop of a test stops.
+     * @details If `precision` is `0`, tests run for the minimum test time of the
+     * benchmark. Otherwise, the loop stops adaptively as soon as the confidence
+     * interval for the mean operation time is narrow enough, within the time and
+     * iteration bounds specified. Zero bounds are not enforced.
+     */
+    struct StoppingCriteria
+    {
+        /**
+        * @brief Target half-width of the confidence interval, relative to the
+        * estimate, as per-one. `0` disables adaptive stopping.
+        */
+        double precision;
+        /**
+        * @brief Confidence level of the interval, as per-one, in range `(0, 1)`.
+        */
+        double confidence_level;
+        /**
+        * @brief If `true`, the confidence interval for the median must also reach
+        * the target precision before stopping.
+        */
+        bool b_median;
+        std::uint64_t min_time_ms;
+        std::uint64_t max_time_ms;
+        std::uint64_t min_iterations;
+        std::uint64_t max_iterations;
+    };
     /**
      * @brief Provides configuration to and retrieves data from a benchmark run.
      */
@@ -458,10 +528,110 @@ public:
         * that have been already validated or when creating and debugging new backends.
         */
         bool b_validate_results;
+        /**
+        * @brief Specifies which results are validated during offline tests when
+        * `b_validate_results` is `true`.
+        */
+        ValidationPolicy validation_policy;
+        /**
+        * @brief Number of results validated during offline tests when `validation_policy`
+        * is not ValidationPolicy::Full. If a test has fewer results, all are validated.
+        */
+        std::uint64_t validation_sample_count;
+        /**
+        * @brief Maximum number of operation results pending post-processing during
+        * latency tests.
+        * @details If `0`, all results from the timed operations are kept until the
+        * test time elapses and then retrieved, decrypted, decoded and validated
+        * altogether. Otherwise, as soon as this number of results is pending, they are
+        * post-processed outside of the timed region and destroyed, keeping memory usage
+        * constant regardless of test duration.
+        */
+        std::uint64_t latency_result_window;
+        /**
+        * @brief When latency results are post-processed in windows, only one out of
+        * this many results is retrieved, decrypted, decoded and validated. The rest are
+        * destroyed immediately after the timed operation. Values less than `2` mean
+        * that every result is post-processed.
+        */
+        std::uint64_t latency_result_sampling;
+        /**
+        * @brief Number of concurrent streams issuing operations during latency tests.
+        * @details Each stream loads its own copy of the inputs into the backend and
+        * calls `operate()` in its own thread, concurrently with the other streams, on
+        * the same benchmark handle. Values less than `2` mean a single stream.
+        */
+        std::uint64_t latency_stream_count;
+        /**
+        * @brief Specifies whether latency tests run end-to-end through a pipeline
+        * (`true`) instead of timing each phase over all data in turn (`false`).
+        * @details In a pipelined test, a stream of samples goes through encoding,
+        * encryption, loading, operation, storing, decryption and decoding, with each
+        * stage running in its own thread and bounded queues between stages.
+        */
+        bool b_pipelined;
+        /**
+        * @brief Capacity of the queues between stages of pipelined tests.
+        */
+        std::uint64_t pipeline_queue_size;
+        /**
+        * @brief Arrival process used to issue operations during latency tests.
+        */
+        ArrivalProcess arrival_process;
+        /**
+        * @brief Offered loads, in operations per second, tested in turn during
+        * open-loop latency tests.
+        * @details Ignored when `arrival_process` is ArrivalProcess::Closed. Each
+        * offered load is tested for the minimum test time of the benchmark. Operations
+        * that arrive while the backend is busy wait in a queue, and their queueing
+        * delay is reported separately from their service time.
+        */
+        std::vector<double> arrival_rates;
+        /**
+        * @brief Specifies when the operation loop stops during closed-loop, single
+        * stream latency tests and during offline tests.
+        */
+        StoppingCriteria stopping_criteria;
+        /**
+        * @brief Number of untimed operations executed during offline tests before
+        * the operation loop starts.
+        * @details Warmup operations are reported separately, under the "Warmup" event.
+        */
+        std::uint64_t offline_warmup_iterations;
+        /**
+        * @brief Specifies whether offline tests keep executing warmup operations after
+        * `offline_warmup_iterations` until their times reach a steady state (`true`).
+        */
+        bool b_offline_steady_state;
+        /**
+        * @brief Number of most recent warmup operations tested for steady state.
+        * Must be, at least, `3`.
+        */
+        std::uint64_t offline_steady_state_window;
+        /**
+        * @brief Maximum number of warmup operations executed during offline tests while
+        * waiting for a steady state. If reached, the test continues with a warning.
+        */
+        std::uint64_t offline_max_warmup_iterations;
     };
 
     virtual ~IBenchmark() = default;
 
+    static std::string getValidationPolicyName(ValidationPolicy policy);
+    /**
+     * @brief Retrieves the validation policy from its name as returned by
+     * getValidationPolicyName().
+     * @throws std::invalid_argument if \p name does not correspond to a validation policy.
+     */
+    static ValidationPolicy getValidationPolicy(const std::string &name);
+    static std::string getArrivalProcessName(ArrivalProcess process);
+    /**
+     * @brief Retrieves the arrival process from its name as returned by
+     * getArrivalProcessName().
+     * @throws std::invalid_argument if \p name does not correspond to an arrival process.
+     */
+    static ArrivalProcess getArrivalProcess(const std::string &name);
+
     /**
      * @brief Executes the benchmark operations.
      * @param out_report Object where to append the report of the operation.
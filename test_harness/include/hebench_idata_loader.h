@@ -16,6 +16,10 @@
 #include "hebench_types_harness.h"
 
 namespace hebench {
+namespace DataLoader {
+class MappedBinaryDataset;
+} // namespace DataLoader
+
 namespace TestHarness {
 
 class IDataLoader
@@ -250,7 +254,7 @@ public:
     const hebench::APIBridge::DataPack &getResultData(std::uint64_t param_position) const override;
     ResultDataPtr getResultFor(const std::uint64_t *param_data_pack_indices) override;
     std::uint64_t getResultIndex(const std::uint64_t *param_data_pack_indices) const override;
-    std::uint64_t getTotalDataLoaded() const override { return m_raw_buffer.size(); }
+    std::uint64_t getTotalDataLoaded() const override { return m_raw_buffer.size() + m_mapped_data_size; }
     /**
      * @brief Retrieves whether buffers to contain output data have been allocated or not.
      * @returns true is memory is allocated for outputs.
@@ -330,6 +334,12 @@ protected:
      * The number of output samples is the multiplication of the number of samples per input
      * component.
      *
+     * Files in binary dataset format (see hebench::DataLoader::BinaryDatasetFormat) are
+     * detected automatically from their contents. These are memory mapped instead of
+     * loaded: buffers for the samples point directly into the mapped file, which remains
+     * mapped for the lifetime of this object. The mapping is private, so, changes to the
+     * sample buffers are never written back to the file.
+     *
      * On error, this method throws an instance of, or derived from std::exception.
      */
     void init(const std::string &filename,
@@ -445,6 +455,9 @@ private:
     std::vector<unique_ptr_custom_deleter<hebench::APIBridge::DataPack>> m_output_data;
     // RAII storage for native data buffers
     std::vector<std::uint8_t> m_raw_buffer; // used to store all the data in contiguous memory
+    // RAII storage for datasets mapped from binary dataset files
+    std::shared_ptr<hebench::DataLoader::MappedBinaryDataset> m_p_mapped_dataset;
+    std::uint64_t m_mapped_data_size; // bytes of mapped data referenced by the buffers
     hebench::APIBridge::DataType m_data_type;
     bool m_b_is_output_allocated;
     bool m_b_initialized;
@@ -5,13 +5,17 @@
 #ifndef _HEBench_Harness_Utilities_H_0596d40a3cce4b108a81595c50eb286d
 #define _HEBench_Harness_Utilities_H_0596d40a3cce4b108a81595c50eb286d
 
+#include <cstdint>
 #include <functional>
 #include <ostream>
 #include <random>
 #include <string>
+#include <vector>
 
 #include "hebench/api_bridge/types.h"
 #include "hebench/modules/timer/include/timer.h"
+#include "hebench_benchmark_description.h"
+#include "hebench_parallel_for.h"
 #include "hebench_report_cpp.h"
 
 namespace hebench {
@@ -79,13 +83,128 @@ void printArraysAsColumns(std::ostream &os,
                           bool output_row_index = false,
                           const char *separator = " ");
 
+/**
+ * @brief Computes a percentile of a collection of values using the nearest rank method.
+ * @param[in] values Collection of values. Copied because it gets partially sorted.
+ * @param[in] percentile Percentile to compute in the range `[0, 100]`.
+ * @returns The value for the percentile, or `0` if \p values is empty.
+ */
+double computePercentile(std::vector<double> values, double percentile);
+/**
+ * @brief Computes the arithmetic mean of a collection of values.
+ * @returns The mean, or `0` if \p values is empty.
+ */
+double computeMean(const std::vector<double> &values);
+
+/**
+ * @brief Error statistics of results with respect to their ground truth.
+ * @details Relative error of an element is its absolute error divided by the
+ * largest magnitude between the element and its ground truth.
+ */
+struct ValidationErrorStats
+{
+    ValidationErrorStats() :
+        element_count(0),
+        max_abs_error(0.0),
+        max_rel_error(0.0),
+        sum_sq_error(0.0)
+    {
+    }
+
+    /**
+     * @brief Combines the statistics from another set of elements into this one.
+     */
+    void merge(const ValidationErrorStats &rhs);
+    /**
+     * @brief Root mean square of the absolute error of all elements.
+     */
+    double getRMSE() const;
+
+    std::uint64_t element_count;
+    double max_abs_error;
+    double max_rel_error;
+    double sum_sq_error;
+};
+
+/**
+ * @brief Finds whether two values are within a tolerance of each other.
+ * @param[in] a Ground truth value.
+ * @param[in] b Value to compare.
+ * @param[in] tolerance Tolerance for the comparison.
+ * @return `true` if \p b is within \p tolerance of \p a, `false` otherwise.
+ * @details Supported types are `int32_t`, `int64_t`, `float`, and `double`.
+ * @sa findNotWithinTolerance()
+ */
+template <typename T>
+bool isWithinTolerance(T a, T b, const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &tolerance);
+/**
+ * @brief Maps a value to an unsigned integer that keeps the order of values and
+ * where consecutive representable values map to consecutive integers.
+ * @details The distance between the integers of two values is the number of
+ * representable values between them, as counted by the ULP tolerance model. Zero
+ * and negative zero map to consecutive integers. The integer for NaN is unspecified.
+ *
+ * Supported types are `int32_t`, `int64_t`, `float`, and `double`.
+ */
+template <typename T>
+std::uint64_t getOrderedBits(T value);
+/**
+ * @brief Finds the elements in two arrays that are not within a tolerance of each
+ * other.
+ * @param[in] a Pointer to start of first array to compare (ground truth).
+ * @param[in] b Pointer to start of second array to compare.
+ * @param[in] count Number of elements in each array.
+ * @param[in] tolerance Tolerance for the comparison.
+ * @param[out] p_stats If not null, the error statistics of \p b with respect to
+ * \p a are merged into the object pointed.
+ * @return Indices of the elements in \p a and \p b that were not within
+ * \p tolerance of each other, in increasing order. Empty if all elements were
+ * within tolerance.
+ * @details Arrays are processed in blocks by a vectorized kernel (AVX-512, AVX2 or
+ * scalar, selected at runtime) that computes the error statistics and screens the
+ * block in the same pass. Screening is exact for absolute and ULP criteria, and
+ * stricter than the relative criterion: integers must be equal, and floating point
+ * values must be within half of the relative tolerance of the smaller magnitude.
+ * Only blocks that fail screening are compared element by element. Thus, if all
+ * blocks pass, each element is read only once.
+ *
+ * Supported types are `int32_t`, `int64_t`, `float`, and `double`.
+ * @sa hebench::TestHarness::BenchmarkDescription::ValidationTolerance
+ */
+template <typename T>
+std::vector<std::uint64_t> findNotWithinTolerance(const T *a, const T *b, std::uint64_t count,
+                                                  const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &tolerance,
+                                                  ValidationErrorStats *p_stats = nullptr);
+/**
+ * @brief Finds the elements in two arrays that are not within a certain percentage
+ * of each other.
+ * @param[in] a Pointer to start of first array to compare.
+ * @param[in] b Pointer to start of second array to compare.
+ * @param[in] count Number of elements in each array.
+ * @param[in] pct Per-one for comparison: this is percent divided by 100.
+ * @return Indices of the elements in \p a and \p b that were not within \p pct * 100
+ * of each other, in increasing order. Empty if all elements were within range.
+ * @details Result is the same as `hebench::Utilities::Math::almostEqual()`, but it
+ * is faster when most elements match. Equivalent to `findNotWithinTolerance()` with
+ * a relative tolerance of \p pct .
+ */
+template <typename T>
+std::vector<std::uint64_t> findNotAlmostEqual(const T *a, const T *b, std::uint64_t count, double pct = 0.05);
+
 class RandomGenerator
 {
 private:
     static std::mt19937 m_rand;
+    static std::uint64_t m_seed;
 
 public:
     static decltype(m_rand) &get() { return m_rand; }
+    /**
+     * @brief Seed last used to initialize the global random generator.
+     * @details Counter-based generators use this value as key to produce
+     * repeatable streams independent of the state of `get()`.
+     */
+    static std::uint64_t getRandomSeed() { return m_seed; }
     static void setRandomSeed(std::uint64_t seed);
     static void setRandomSeed();
 };
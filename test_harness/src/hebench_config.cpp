@@ -75,6 +75,8 @@ public:
     }
 
 private:
+    static hebench::TestHarness::BenchmarkDescription::ValidationTolerance
+    importValidationTolerance(std::size_t benchmark_index, const YAML::Node &yaml_tolerance);
     static std::string getCleanEnvVariableName(std::string s_var_name)
     {
         s_var_name.erase(0, s_var_name.find_first_not_of(" \t\n\r\f\v"));
@@ -146,6 +148,58 @@ inline T ConfigImporterImpl::retrieveValue(const std::string &s_value)
     return retval;
 }
 
+hebench::TestHarness::BenchmarkDescription::ValidationTolerance
+ConfigImporterImpl::importValidationTolerance(std::size_t benchmark_index, const YAML::Node &yaml_tolerance)
+{
+    using ValidationTolerance = hebench::TestHarness::BenchmarkDescription::ValidationTolerance;
+
+    ValidationTolerance retval;
+
+    auto throw_error = [benchmark_index, &yaml_tolerance](const std::string &s_msg) {
+        YAML::Mark yaml_mark = yaml_tolerance.Mark();
+        std::stringstream ss;
+        ss << "Value of field `validation_tolerance` in ";
+        if (yaml_mark.is_null())
+            ss << "benchmark with ID " << benchmark_index;
+        else
+            ss << "line " << yaml_mark.line + 1;
+        ss << " " << s_msg;
+        throw std::runtime_error(ss.str());
+    };
+
+    if (!yaml_tolerance.IsMap())
+        throw_error("must be a map with fields `model`, `absolute`, `relative` and `ulp`.");
+
+    if (yaml_tolerance["model"].IsDefined())
+    {
+        std::string s_model = hebench::Utilities::ToLowerCase(retrieveValue<std::string>(yaml_tolerance["model"]));
+        bool b_found        = false;
+        for (ValidationTolerance::Model model : { ValidationTolerance::Model::Relative,
+                                                  ValidationTolerance::Model::Absolute,
+                                                  ValidationTolerance::Model::ULP,
+                                                  ValidationTolerance::Model::Mixed })
+        {
+            if (s_model == ValidationTolerance::getModelName(model))
+            {
+                retval.model = model;
+                b_found      = true;
+            } // end if
+        } // end for
+        if (!b_found)
+            throw_error("has invalid `model` \"" + s_model + "\". Expected one of: relative, absolute, ulp, mixed.");
+    } // end if
+    if (yaml_tolerance["absolute"].IsDefined())
+        retval.absolute = retrieveValue<decltype(retval.absolute)>(yaml_tolerance["absolute"]);
+    if (yaml_tolerance["relative"].IsDefined())
+        retval.relative = retrieveValue<decltype(retval.relative)>(yaml_tolerance["relative"]);
+    if (yaml_tolerance["ulp"].IsDefined())
+        retval.ulp = retrieveValue<decltype(retval.ulp)>(yaml_tolerance["ulp"]);
+    if (retval.absolute < 0.0 || retval.relative < 0.0)
+        throw_error("must have non-negative `absolute` and `relative` tolerances.");
+
+    return retval;
+}
+
 std::vector<BenchmarkRequest> ConfigImporterImpl::importYAML2BenchmarkRequest(const std::filesystem::path &working_path,
                                                                               std::size_t benchmark_index,
                                                                               const YAML::Node &yaml_bench,
@@ -160,6 +214,7 @@ std::vector<BenchmarkRequest> ConfigImporterImpl::importYAML2BenchmarkRequest(co
     std::filesystem::path dataset_filename;
     std::uint64_t default_min_test_time_ms = 0;
     std::vector<std::uint64_t> default_sample_sizes;
+    hebench::TestHarness::BenchmarkDescription::ValidationTolerance validation_tolerance;
 
     if (yaml_bench["dataset"].IsDefined() && !yaml_bench["dataset"].IsNull())
     {
@@ -215,6 +270,9 @@ std::vector<BenchmarkRequest> ConfigImporterImpl::importYAML2BenchmarkRequest(co
         } // end for
     } // end if
 
+    if (yaml_bench["validation_tolerance"].IsDefined() && !yaml_bench["validation_tolerance"].IsNull())
+        validation_tolerance = importValidationTolerance(benchmark_index, yaml_bench["validation_tolerance"]);
+
     if (yaml_bench["params"].IsDefined() && yaml_bench["params"].size() > 0)
     {
         // create a component counter to iterate over the parameters using from-to-step model
@@ -311,6 +369,7 @@ std::vector<BenchmarkRequest> ConfigImporterImpl::importYAML2BenchmarkRequest(co
             config.default_min_test_time_ms     = default_min_test_time_ms <= 0 ? fallback_min_test_time : default_min_test_time_ms;
             config.fallback_default_sample_size = fallback_sample_size;
             config.default_sample_sizes         = default_sample_sizes;
+            config.validation_tolerance         = validation_tolerance;
             for (std::size_t param_i = 0; param_i < count.size(); ++param_i)
             {
                 // fill out WorkloadParam struct
@@ -376,6 +435,7 @@ std::vector<BenchmarkRequest> ConfigImporterImpl::importYAML2BenchmarkRequest(co
             retval.emplace_back();
             retval.back().configuration.default_min_test_time_ms = default_min_test_time_ms;
             retval.back().configuration.default_sample_sizes     = default_sample_sizes;
+            retval.back().configuration.validation_tolerance     = validation_tolerance;
             hebench::TestHarness::IBenchmarkDescriptor::DescriptionToken::Ptr p_token =
                 engine.describeBenchmark(benchmark_index, retval.back().configuration);
             if (!p_token)
@@ -463,6 +523,11 @@ void ConfigExporterImpl::exportBenchmarkRequest2YAML(YAML::Emitter &out,
         node_benchmark["default_sample_sizes"]["to_map"] = "yes"; // convert sequence to map to have the indices as keys
         node_benchmark["default_sample_sizes"].remove("to_map");
     } // end if
+    node_benchmark["validation_tolerance"]["model"] =
+        hebench::TestHarness::BenchmarkDescription::ValidationTolerance::getModelName(config.validation_tolerance.model);
+    node_benchmark["validation_tolerance"]["absolute"] = config.validation_tolerance.absolute;
+    node_benchmark["validation_tolerance"]["relative"] = config.validation_tolerance.relative;
+    node_benchmark["validation_tolerance"]["ulp"]      = config.validation_tolerance.ulp;
     if (!config.w_params.empty())
     {
         for (std::size_t param_i = 0; param_i < config.w_params.size(); ++param_i)
@@ -637,7 +702,17 @@ void BenchmarkConfigBroker::exportConfiguration(const std::string &yaml_filename
        << "attempt to load the specified file and use its contents as values for inputs" << std::endl
        << "and ground truths instead of using synthetic data. For a benchmark" << std::endl
        << "description specifying a dataset file, all workload parameter ranges must" << std::endl
-       << "resolve to single values." << std::endl;
+       << "resolve to single values." << std::endl
+       << std::endl
+       << "Field \"validation_tolerance\" specifies how results of a benchmark are" << std::endl
+       << "compared against ground truth. Since each benchmark ID corresponds to a" << std::endl
+       << "workload and data type, tolerances can be tuned for each. Field \"model\"" << std::endl
+       << "is one of:" << std::endl
+       << "  - relative: elements within \"relative\" (per-one) of each other." << std::endl
+       << "  - absolute: elements at most \"absolute\" apart." << std::endl
+       << "  - ulp: elements at most \"ulp\" units in the last place apart." << std::endl
+       << "  - mixed: elements satisfying any of the above." << std::endl
+       << "Defaults to relative 0.01 if not present." << std::endl;
 
     out << YAML::Comment(ss.str()) << YAML::Newline;
 
@@ -35,6 +35,83 @@ IBenchmarkDescriptor::DescriptionToken::Ptr IBenchmarkDescriptor::createToken(co
                                                       m_key_creation));
 }
 
+//------------------
+// class IBenchmark
+//------------------
+
+std::string IBenchmark::getValidationPolicyName(ValidationPolicy policy)
+{
+    std::string retval;
+
+    switch (policy)
+    {
+    case ValidationPolicy::Full:
+        retval = "full";
+        break;
+
+    case ValidationPolicy::Random:
+        retval = "random";
+        break;
+
+    case ValidationPolicy::Stratified:
+        retval = "stratified";
+        break;
+
+    case ValidationPolicy::FirstLast:
+        retval = "first_last";
+        break;
+
+    default:
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Unknown validation policy."));
+        break;
+    } // end switch
+
+    return retval;
+}
+
+IBenchmark::ValidationPolicy IBenchmark::getValidationPolicy(const std::string &name)
+{
+    for (ValidationPolicy policy : { ValidationPolicy::Full, ValidationPolicy::Random,
+                                     ValidationPolicy::Stratified, ValidationPolicy::FirstLast })
+        if (getValidationPolicyName(policy) == name)
+            return policy;
+    throw std::invalid_argument(IL_LOG_MSG_CLASS("Unknown validation policy: \"" + name + "\"."));
+}
+
+std::string IBenchmark::getArrivalProcessName(ArrivalProcess process)
+{
+    std::string retval;
+
+    switch (process)
+    {
+    case ArrivalProcess::Closed:
+        retval = "closed";
+        break;
+
+    case ArrivalProcess::Constant:
+        retval = "constant";
+        break;
+
+    case ArrivalProcess::Poisson:
+        retval = "poisson";
+        break;
+
+    default:
+        throw std::invalid_argument(IL_LOG_MSG_CLASS("Unknown arrival process."));
+        break;
+    } // end switch
+
+    return retval;
+}
+
+IBenchmark::ArrivalProcess IBenchmark::getArrivalProcess(const std::string &name)
+{
+    for (ArrivalProcess process : { ArrivalProcess::Closed, ArrivalProcess::Constant, ArrivalProcess::Poisson })
+        if (getArrivalProcessName(process) == name)
+            return process;
+    throw std::invalid_argument(IL_LOG_MSG_CLASS("Unknown arrival process: \"" + name + "\"."));
+}
+
 //-----------------------------------
 // class PartialBenchmarkDescription
 //-----------------------------------
@@ -9,6 +9,7 @@
 #include <sstream>
 #include <stdexcept>
 
+#include "hebench_dataset_binary.h"
 #include "hebench_dataset_loader.h"
 
 #include "../include/hebench_idata_loader.h"
@@ -178,6 +179,69 @@ public:
                              const std::uint64_t *expected_input_count_per_dim,
                              std::size_t expected_output_dim,
                              const std::uint64_t *expected_output_count_per_dim);
+
+private:
+    static void loadFromCSVFile(PartialDataLoader &data_loader,
+                                const std::string &filename,
+                                std::size_t expected_input_dim,
+                                const std::size_t *max_input_sample_count_per_dim,
+                                const std::uint64_t *expected_input_count_per_dim,
+                                std::size_t expected_output_dim,
+                                const std::uint64_t *expected_output_count_per_dim);
+    /**
+     * @brief Loads a dataset in binary dataset format by memory mapping the file.
+     * @details No data is copied: the `NativeDataBuffer` for each sample points directly
+     * into the mapped file. The mapping is kept alive by the data loader.
+     */
+    static void loadFromBinaryFile(PartialDataLoader &data_loader,
+                                   const std::string &filename,
+                                   std::size_t expected_input_dim,
+                                   const std::size_t *max_input_sample_count_per_dim,
+                                   const std::uint64_t *expected_input_count_per_dim,
+                                   std::size_t expected_output_dim,
+                                   const std::uint64_t *expected_output_count_per_dim);
+    /**
+     * @brief Validates the shape of a dataset against the expected shape.
+     * @return Number of samples to use from each input component.
+     * @throws std::runtime_error if the dataset does not have enough samples or its
+     * dimensions do not match the expected ones.
+     */
+    static std::vector<std::size_t> validateDatasetShape(const hebench::DataLoader::ExternalDatasetShape &dataset_shape,
+                                                         std::size_t expected_input_dim,
+                                                         const std::size_t *max_input_sample_count_per_dim,
+                                                         std::size_t expected_output_dim);
+
+    /**
+     * @brief Stores samples loaded from an external dataset directly into the
+     * buffers allocated by a data loader.
+     * @details The data loader is initialized when the shape of the dataset is
+     * known, before any sample is loaded.
+     */
+    class DataPackSink : public hebench::DataLoader::IExternalDatasetSink<T>
+    {
+    private:
+        IL_DECLARE_CLASS_NAME(DataPackSink)
+    public:
+        DataPackSink(PartialDataLoader &data_loader,
+                     std::size_t expected_input_dim,
+                     const std::size_t *max_input_sample_count_per_dim,
+                     const std::uint64_t *expected_input_count_per_dim,
+                     std::size_t expected_output_dim,
+                     const std::uint64_t *expected_output_count_per_dim);
+
+        void onShape(const hebench::DataLoader::ExternalDatasetShape &shape) override;
+        void reserveSamples(bool is_input, std::uint64_t component_index, std::uint64_t sample_count) override;
+        T *getSampleBuffer(bool is_input, std::uint64_t component_index,
+                           std::uint64_t sample_index, std::uint64_t sample_size) override;
+
+    private:
+        PartialDataLoader &m_data_loader;
+        std::size_t m_expected_input_dim;
+        const std::size_t *m_max_input_sample_count_per_dim;
+        const std::uint64_t *m_expected_input_count_per_dim;
+        std::size_t m_expected_output_dim;
+        const std::uint64_t *m_expected_output_count_per_dim;
+    };
 };
 
 template <typename T>
@@ -244,134 +308,249 @@ inline void PartialDataLoaderHelper<T>::loadFromFile(PartialDataLoader &data_loa
     if (expected_output_dim <= 0)
         throw std::invalid_argument(IL_LOG_MSG_CLASS("Invalid output dimensions: 'expected_output_dim' must be positive."));
 
-    hebench::DataLoader::ExternalDataset<T> dataset = hebench::DataLoader::ExternalDatasetLoader<T>::loadFromCSV(filename, 0);
-    std::size_t max_output_sample_count             = 1;
+    if (hebench::DataLoader::BinaryDatasetFormat::isBinaryDatasetFile(filename))
+        loadFromBinaryFile(data_loader, filename,
+                           expected_input_dim, max_input_sample_count_per_dim, expected_input_count_per_dim,
+                           expected_output_dim, expected_output_count_per_dim);
+    else
+        loadFromCSVFile(data_loader, filename,
+                        expected_input_dim, max_input_sample_count_per_dim, expected_input_count_per_dim,
+                        expected_output_dim, expected_output_count_per_dim);
+}
 
-    // validate loaded data
+template <typename T>
+inline std::vector<std::size_t>
+PartialDataLoaderHelper<T>::validateDatasetShape(const hebench::DataLoader::ExternalDatasetShape &dataset_shape,
+                                                 std::size_t expected_input_dim,
+                                                 const std::size_t *max_input_sample_count_per_dim,
+                                                 std::size_t expected_output_dim)
+{
+    std::size_t max_output_sample_count = 1;
 
     // inputs
-    if (dataset.inputs.size() != expected_input_dim)
+    if (dataset_shape.input_sample_counts.size() != expected_input_dim)
     {
         std::stringstream ss;
         ss << "Loaded input dimensions do not match the number of parameters for the operation. "
-           << "Expected " << expected_input_dim << ", but " << dataset.inputs.size() << "loaded.";
+           << "Expected " << expected_input_dim << ", but " << dataset_shape.input_sample_counts.size() << "loaded.";
         throw std::runtime_error(IL_LOG_MSG_CLASS(ss.str()));
     } // end if
-    for (std::size_t input_dim_i = 0; input_dim_i < dataset.inputs.size(); ++input_dim_i)
+    std::vector<std::size_t> input_sample_count_per_dim(dataset_shape.input_sample_counts.size());
+    for (std::size_t input_dim_i = 0; input_dim_i < dataset_shape.input_sample_counts.size(); ++input_dim_i)
     {
-        std::vector<std::vector<T>> &input_component = dataset.inputs[input_dim_i];
-        if (input_component.size() < max_input_sample_count_per_dim[input_dim_i])
+        std::uint64_t input_component_size = dataset_shape.input_sample_counts[input_dim_i];
+        if (input_component_size < max_input_sample_count_per_dim[input_dim_i])
         {
             std::stringstream ss;
             ss << "Insufficient data loaded for operation input parameter " << input_dim_i << ". "
                << "Expected " << max_input_sample_count_per_dim[input_dim_i] << " samples, but "
-               << input_component.size() << " found.";
+               << input_component_size << " found.";
             throw std::runtime_error(IL_LOG_MSG_CLASS(ss.str()));
         } // end if
-        if (input_component.size() > max_input_sample_count_per_dim[input_dim_i])
-            // discard excess data
-            input_component.resize(max_input_sample_count_per_dim[input_dim_i]);
-        max_output_sample_count *= input_component.size(); // count the samples into the output
-        // check each sample size
-        for (std::size_t input_sample_i = 0; input_sample_i < input_component.size(); ++input_sample_i)
-        {
-            if (input_component[input_sample_i].size() != expected_input_count_per_dim[input_dim_i])
-            {
-                std::stringstream ss;
-                ss << "Incorrect vector size loaded for input dimension " << input_dim_i << ", sample " << input_sample_i << ". "
-                   << "Expected vector with " << expected_input_count_per_dim[input_dim_i] << " elements, but "
-                   << input_component[input_sample_i].size() << " received.";
-                throw std::runtime_error(IL_LOG_MSG_CLASS(ss.str()));
-            } // end if
-        } // end for
+        // excess data is discarded during loading
+        input_sample_count_per_dim[input_dim_i] = max_input_sample_count_per_dim[input_dim_i];
+        max_output_sample_count *= input_sample_count_per_dim[input_dim_i]; // count the samples into the output
     } // end for
 
     // outputs
-    if (!dataset.outputs.empty()
-        && dataset.outputs.size() != expected_output_dim)
+    if (!dataset_shape.output_sample_counts.empty()
+        && dataset_shape.output_sample_counts.size() != expected_output_dim)
     {
         std::stringstream ss;
         ss << "Loaded output dimensions do not match the dimensions of the result for the operation. "
-           << "Expected " << expected_output_dim << ", but " << dataset.outputs.size() << "loaded.";
+           << "Expected " << expected_output_dim << ", but " << dataset_shape.output_sample_counts.size() << "loaded.";
         throw std::runtime_error(IL_LOG_MSG_CLASS(ss.str()));
     } // end if
-    for (std::size_t output_dim_i = 0; output_dim_i < dataset.outputs.size(); ++output_dim_i)
+    for (std::size_t output_dim_i = 0; output_dim_i < dataset_shape.output_sample_counts.size(); ++output_dim_i)
     {
-        std::vector<std::vector<T>> &output_component = dataset.outputs[output_dim_i];
-        if (output_component.size() < max_output_sample_count)
+        std::uint64_t output_component_size = dataset_shape.output_sample_counts[output_dim_i];
+        if (output_component_size < max_output_sample_count)
         {
             // must have a ground truth for each combination of inputs
             std::stringstream ss;
             ss << "Insufficient ground-truth output samples loaded for output component " << output_dim_i << ". "
                << "Expected, at least, " << max_input_sample_count_per_dim << " samples, but "
-               << output_component.size() << " received.";
+               << output_component_size << " received.";
             throw std::runtime_error(IL_LOG_MSG_CLASS(ss.str()));
         } // end if
-        if (output_component.size() > max_output_sample_count)
-            // discard excess data
-            output_component.resize(max_output_sample_count);
-        for (std::size_t output_sample_i = 0; output_sample_i < output_component.size(); ++output_sample_i)
-        {
-            if (output_component[output_sample_i].size() != expected_output_count_per_dim[output_dim_i])
-            {
-                std::stringstream ss;
-                ss << "Incorrect vector size loaded for output dimension " << output_dim_i << ", sample " << output_sample_i << ". "
-                   << "Expected vector with " << expected_output_count_per_dim[output_dim_i] << " elements, but "
-                   << output_component[output_sample_i].size() << " received.";
-                throw std::runtime_error(IL_LOG_MSG_CLASS(ss.str()));
-            } // end if
-        } // end for
+        // excess data is discarded during loading
     } // end for
 
-    // initialize the data loader object
+    return input_sample_count_per_dim;
+}
 
-    std::vector<std::size_t> input_sample_count_per_dim(dataset.inputs.size());
-    for (std::size_t i = 0; i < dataset.inputs.size(); ++i)
-        input_sample_count_per_dim[i] = dataset.inputs[i].size();
-    init(data_loader,
-         dataset.inputs.size(), input_sample_count_per_dim.data(), expected_input_count_per_dim,
-         expected_output_dim, expected_output_count_per_dim, !dataset.outputs.empty());
+template <typename T>
+inline void PartialDataLoaderHelper<T>::loadFromCSVFile(PartialDataLoader &data_loader,
+                                                        const std::string &filename,
+                                                        std::size_t expected_input_dim,
+                                                        const std::size_t *max_input_sample_count_per_dim,
+                                                        const std::uint64_t *expected_input_count_per_dim,
+                                                        std::size_t expected_output_dim,
+                                                        const std::uint64_t *expected_output_count_per_dim)
+{
+    // the sink initializes the data loader object from the dataset shape
+    // and, then, data is loaded directly into internal allocation
+    DataPackSink sink(data_loader,
+                      expected_input_dim, max_input_sample_count_per_dim, expected_input_count_per_dim,
+                      expected_output_dim, expected_output_count_per_dim);
+    hebench::DataLoader::ExternalDatasetLoader<T>::loadFromCSV(filename, sink);
+}
 
-    assert(data_loader.getParameterCount() == dataset.inputs.size());
-    assert(data_loader.getResultCount() == expected_output_dim);
+template <typename T>
+inline void PartialDataLoaderHelper<T>::loadFromBinaryFile(PartialDataLoader &data_loader,
+                                                           const std::string &filename,
+                                                           std::size_t expected_input_dim,
+                                                           const std::size_t *max_input_sample_count_per_dim,
+                                                           const std::uint64_t *expected_input_count_per_dim,
+                                                           std::size_t expected_output_dim,
+                                                           const std::uint64_t *expected_output_count_per_dim)
+{
+    std::shared_ptr<hebench::DataLoader::MappedBinaryDataset> p_dataset =
+        std::make_shared<hebench::DataLoader::MappedBinaryDataset>(filename);
+
+    if (p_dataset->getDataType() != hebench::DataLoader::BinaryDatasetFormat::getDataType<T>())
+        throw std::runtime_error(IL_LOG_MSG_CLASS("Data type in binary dataset \"" + filename + "\" does not match the data type for the operation."));
+
+    // validate dataset shape
+    hebench::DataLoader::ExternalDatasetShape dataset_shape = p_dataset->getShape();
+    std::vector<std::size_t> input_sample_count_per_dim =
+        validateDatasetShape(dataset_shape, expected_input_dim, max_input_sample_count_per_dim, expected_output_dim);
+    bool has_outputs = !dataset_shape.output_sample_counts.empty();
+
+    // validate sample sizes
+    auto check_sample_size = [](bool is_input, std::size_t component_index,
+                                const hebench::DataLoader::BinaryDatasetFormat::BinaryDatasetComponent &component,
+                                std::uint64_t expected_sample_size) {
+        if (component.sample_size != expected_sample_size)
+        {
+            std::stringstream ss;
+            ss << "Incorrect vector size loaded for " << (is_input ? "input" : "output") << " dimension "
+               << component_index << ". "
+               << "Expected vector with " << expected_sample_size << " elements, but "
+               << component.sample_size << " received.";
+            throw std::runtime_error(IL_LOG_MSG_CLASS(ss.str()));
+        } // end if
+    };
+    for (std::size_t input_dim_i = 0; input_dim_i < expected_input_dim; ++input_dim_i)
+        check_sample_size(true, input_dim_i, p_dataset->getInput(input_dim_i), expected_input_count_per_dim[input_dim_i]);
+    if (has_outputs)
+        for (std::size_t output_dim_i = 0; output_dim_i < expected_output_dim; ++output_dim_i)
+            check_sample_size(false, output_dim_i, p_dataset->getOutput(output_dim_i), expected_output_count_per_dim[output_dim_i]);
 
-    // copy loaded data into internal allocation
+    // initialize the data loader object by pointing the buffers into the mapped file
 
-    for (std::size_t input_dim_i = 0; input_dim_i < dataset.inputs.size(); ++input_dim_i)
+    data_loader.m_input_data.resize(expected_input_dim);
+    data_loader.m_output_data.resize(expected_output_dim);
+    data_loader.m_raw_buffer.clear();
+    data_loader.m_mapped_data_size = 0;
+
+    std::size_t output_sample_count_per_dim = 1;
+    for (std::size_t input_dim_i = 0; input_dim_i < data_loader.m_input_data.size(); ++input_dim_i)
     {
-        // input parameter
-        const std::vector<std::vector<T>> &input_component = dataset.inputs[input_dim_i];
-        hebench::APIBridge::DataPack &data_pack            = *data_loader.m_input_data[input_dim_i];
-        assert(data_pack.param_position == input_dim_i
-               && data_pack.buffer_count == input_component.size());
-        for (std::size_t sample_i = 0; sample_i < data_pack.buffer_count; ++sample_i)
+        const auto &component = p_dataset->getInput(input_dim_i);
+        output_sample_count_per_dim *= input_sample_count_per_dim[input_dim_i];
+        data_loader.m_input_data[input_dim_i] = data_loader.createDataPack(input_sample_count_per_dim[input_dim_i], input_dim_i);
+        for (std::uint64_t i = 0; i < input_sample_count_per_dim[input_dim_i]; ++i)
         {
-            // parameter sample
-            const std::vector<T> &input_component_sample       = input_component[sample_i];
-            hebench::APIBridge::NativeDataBuffer &param_sample = data_pack.p_buffers[sample_i];
-            assert(param_sample.p
-                   && param_sample.size == input_component_sample.size() * sizeof(T));
-            std::memcpy(param_sample.p, input_component_sample.data(), param_sample.size);
+            hebench::APIBridge::NativeDataBuffer &sample_buffer = data_loader.m_input_data[input_dim_i]->p_buffers[i];
+            sample_buffer.p                                     = p_dataset->getSampleData(component, i);
+            sample_buffer.size                                  = component.sample_size * sizeof(T);
+            sample_buffer.tag                                   = 0;
+            data_loader.m_mapped_data_size += sample_buffer.size;
         } // end for
     } // end for
 
-    for (std::size_t output_dim_i = 0; output_dim_i < dataset.outputs.size(); ++output_dim_i)
+    for (std::size_t output_dim_i = 0; output_dim_i < data_loader.m_output_data.size(); ++output_dim_i)
     {
-        // output component
-        const std::vector<std::vector<T>> &output_component = dataset.outputs[output_dim_i];
-        hebench::APIBridge::DataPack &data_pack             = *data_loader.m_output_data[output_dim_i];
-        assert(data_pack.param_position == output_dim_i
-               && data_pack.buffer_count == output_component.size());
-        for (std::size_t sample_i = 0; sample_i < data_pack.buffer_count; ++sample_i)
+        data_loader.m_output_data[output_dim_i] = data_loader.createDataPack(output_sample_count_per_dim, output_dim_i);
+        for (std::uint64_t i = 0; i < output_sample_count_per_dim; ++i)
         {
-            // parameter sample
-            const std::vector<T> &output_component_sample                 = output_component[sample_i];
-            hebench::APIBridge::NativeDataBuffer &result_component_sample = data_pack.p_buffers[sample_i];
-            assert(result_component_sample.p
-                   && result_component_sample.size == output_component_sample.size() * sizeof(T));
-            std::memcpy(result_component_sample.p, output_component_sample.data(), result_component_sample.size);
+            hebench::APIBridge::NativeDataBuffer &sample_buffer = data_loader.m_output_data[output_dim_i]->p_buffers[i];
+            // without ground truth, only the size of the results is available
+            sample_buffer.p    = has_outputs ? p_dataset->getSampleData(p_dataset->getOutput(output_dim_i), i) : nullptr;
+            sample_buffer.size = expected_output_count_per_dim[output_dim_i] * sizeof(T);
+            sample_buffer.tag  = 0;
+            if (has_outputs)
+                data_loader.m_mapped_data_size += sample_buffer.size;
         } // end for
     } // end for
+
+    data_loader.m_b_is_output_allocated = has_outputs;
+    data_loader.m_p_mapped_dataset      = p_dataset;
+}
+
+template <typename T>
+PartialDataLoaderHelper<T>::DataPackSink::DataPackSink(PartialDataLoader &data_loader,
+                                                       std::size_t expected_input_dim,
+                                                       const std::size_t *max_input_sample_count_per_dim,
+                                                       const std::uint64_t *expected_input_count_per_dim,
+                                                       std::size_t expected_output_dim,
+                                                       const std::uint64_t *expected_output_count_per_dim) :
+    m_data_loader(data_loader),
+    m_expected_input_dim(expected_input_dim),
+    m_max_input_sample_count_per_dim(max_input_sample_count_per_dim),
+    m_expected_input_count_per_dim(expected_input_count_per_dim),
+    m_expected_output_dim(expected_output_dim),
+    m_expected_output_count_per_dim(expected_output_count_per_dim)
+{
+}
+
+template <typename T>
+void PartialDataLoaderHelper<T>::DataPackSink::onShape(const hebench::DataLoader::ExternalDatasetShape &shape)
+{
+    // validate dataset shape
+    std::vector<std::size_t> input_sample_count_per_dim =
+        validateDatasetShape(shape, m_expected_input_dim, m_max_input_sample_count_per_dim, m_expected_output_dim);
+
+    // initialize the data loader object
+
+    init(m_data_loader,
+         input_sample_count_per_dim.size(), input_sample_count_per_dim.data(), m_expected_input_count_per_dim,
+         m_expected_output_dim, m_expected_output_count_per_dim, !shape.output_sample_counts.empty());
+
+    assert(m_data_loader.getParameterCount() == input_sample_count_per_dim.size());
+    assert(m_data_loader.getResultCount() == m_expected_output_dim);
+}
+
+template <typename T>
+void PartialDataLoaderHelper<T>::DataPackSink::reserveSamples(bool is_input, std::uint64_t component_index, std::uint64_t sample_count)
+{
+    (void)sample_count;
+    const auto &data_packs = is_input ? m_data_loader.m_input_data : m_data_loader.m_output_data;
+    if (component_index >= data_packs.size())
+    {
+        // should not happen: dataset changed since its samples were counted
+        std::stringstream ss;
+        ss << "Unexpected " << (is_input ? "input" : "output") << " component " << component_index << " found in dataset.";
+        throw std::runtime_error(IL_LOG_MSG_CLASS(ss.str()));
+    } // end if
+}
+
+template <typename T>
+T *PartialDataLoaderHelper<T>::DataPackSink::getSampleBuffer(bool is_input, std::uint64_t component_index,
+                                                             std::uint64_t sample_index, std::uint64_t sample_size)
+{
+    hebench::APIBridge::DataPack &data_pack = is_input ?
+                                                  *m_data_loader.m_input_data[component_index] :
+                                                  *m_data_loader.m_output_data[component_index];
+    assert(data_pack.param_position == component_index);
+    if (sample_index >= data_pack.buffer_count)
+        // discard excess data
+        return nullptr;
+
+    hebench::APIBridge::NativeDataBuffer &sample_buffer = data_pack.p_buffers[sample_index];
+    if (sample_buffer.size != sample_size * sizeof(T))
+    {
+        std::stringstream ss;
+        ss << "Incorrect vector size loaded for " << (is_input ? "input" : "output") << " dimension "
+           << component_index << ", sample " << sample_index << ". "
+           << "Expected vector with " << sample_buffer.size / sizeof(T) << " elements, but "
+           << sample_size << " received.";
+        throw std::runtime_error(IL_LOG_MSG_CLASS(ss.str()));
+    } // end if
+    assert(sample_buffer.p);
+
+    return reinterpret_cast<T *>(sample_buffer.p);
 }
 
 //-------------------------
@@ -379,6 +558,7 @@ inline void PartialDataLoaderHelper<T>::loadFromFile(PartialDataLoader &data_loa
 //-------------------------
 
 PartialDataLoader::PartialDataLoader() :
+    m_mapped_data_size(0),
     m_data_type(hebench::APIBridge::DataType::Int32),
     m_b_is_output_allocated(false),
     m_b_initialized(false)
@@ -3,17 +3,27 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <algorithm>
+#include <cassert>
 #include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
+#include <limits>
+#include <numeric>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
+#include "hebench/modules/general/include/hebench_math_utils.h"
 #include "include/hebench_utilities_harness.h"
 
 namespace hebench {
 namespace Utilities {
 
 std::mt19937 RandomGenerator::m_rand;
+std::uint64_t RandomGenerator::m_seed = std::mt19937::default_seed;
 
 std::string convertToDirectoryName(const std::string &s, bool to_lowercase)
 {
@@ -79,12 +89,302 @@ void printArraysAsColumns(std::ostream &os,
     } // end switch
 }
 
+double computePercentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+        return 0.0;
+
+    // nearest rank
+    double rank      = std::ceil(percentile / 100.0 * values.size());
+    std::size_t pos  = rank > 1.0 ? static_cast<std::size_t>(rank) - 1 : 0;
+    pos              = std::min(pos, values.size() - 1);
+    auto it_position = values.begin() + pos;
+    std::nth_element(values.begin(), it_position, values.end());
+    return *it_position;
+}
+
+double computeMean(const std::vector<double> &values)
+{
+    return values.empty() ? 0.0 : std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+//----------------------------
+// struct ValidationErrorStats
+//----------------------------
+
+void ValidationErrorStats::merge(const ValidationErrorStats &rhs)
+{
+    // NaN errors are kept to signal invalid values in the results
+    auto max_error = [](double a, double b) -> double {
+        return std::isnan(a) || a > b ? a : b;
+    };
+    element_count += rhs.element_count;
+    max_abs_error = max_error(max_abs_error, rhs.max_abs_error);
+    max_rel_error = max_error(max_rel_error, rhs.max_rel_error);
+    sum_sq_error += rhs.sum_sq_error;
+}
+
+double ValidationErrorStats::getRMSE() const
+{
+    return element_count > 0 ? std::sqrt(sum_sq_error / static_cast<double>(element_count)) : 0.0;
+}
+
+namespace {
+
+// screening parameters for findNotWithinTolerance(): disabled criteria use
+// values that no mismatching pair of elements can satisfy
+struct ToleranceScreen
+{
+    double absolute;
+    double strict_relative;
+    std::uint64_t ulp;
+};
+
+struct ToleranceScreenResult
+{
+    bool b_pass;
+    ValidationErrorStats stats;
+};
+
+// maps the bits of floating point values into unsigned integers with the
+// same ordering as the values they represent
+template <typename T>
+inline auto toOrderedUInt(T value)
+{
+    typedef std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t> UIntType;
+    static constexpr UIntType SignBit = static_cast<UIntType>(1) << (sizeof(UIntType) * 8 - 1);
+    UIntType retval;
+    std::memcpy(&retval, &value, sizeof(retval));
+    return (retval & SignBit) ? static_cast<UIntType>(~retval) : static_cast<UIntType>(retval | SignBit);
+}
+
+// number of representable values between a and b
+template <typename T>
+inline std::uint64_t ulpDistance(T a, T b)
+{
+    if constexpr (std::is_integral_v<T>)
+    {
+        typedef std::make_unsigned_t<T> UIntType;
+        return a > b ?
+                   static_cast<UIntType>(static_cast<UIntType>(a) - static_cast<UIntType>(b)) :
+                   static_cast<UIntType>(static_cast<UIntType>(b) - static_cast<UIntType>(a));
+    } // end if
+    else
+    {
+        auto ua       = toOrderedUInt(a);
+        auto ub       = toOrderedUInt(b);
+        auto distance = ua > ub ? ua - ub : ub - ua;
+        // NaN is not within any distance (a != a only for NaN)
+        return (a != a) | (b != b) ? std::numeric_limits<std::uint64_t>::max() : distance;
+    } // end else
+}
+
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(__clang__)
+#define HEBENCH_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+// kernels must be inlined into each clone to be compiled for the clone target
+#define HEBENCH_CLONE_INLINE inline __attribute__((always_inline))
+#else
+#define HEBENCH_TARGET_CLONES
+#define HEBENCH_CLONE_INLINE inline
+#endif
+
+// maximum number of elements screened per call to screenWithinTolerance()
+static constexpr std::uint64_t ToleranceBlockSize = 1024;
+
+// screening and error statistics for findNotWithinTolerance(): loops are kept
+// branchless so that they are vectorized for each target ISA
+template <typename T>
+HEBENCH_CLONE_INLINE void screenWithinToleranceImpl(const T *a, const T *b, std::uint64_t count,
+                                                    const ToleranceScreen &screen, ToleranceScreenResult &result)
+{
+    typedef std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t> MaskType;
+
+    assert(count <= ToleranceBlockSize);
+
+    // floating point max and sum reductions can only be vectorized by reassociating
+    // operations: errors are non-negative, so, their maximum is found by comparing
+    // their bit patterns as integers instead, and squared errors are summed
+    // separately in independent lanes
+    double sq_errors[ToleranceBlockSize];
+    std::int64_t max_abs_bits = 0;
+    std::int64_t max_rel_bits = 0;
+    MaskType mismatch         = 0;
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        double x       = static_cast<double>(a[i]);
+        double y       = static_cast<double>(b[i]);
+        double err     = std::abs(x - y);
+        double max_mag = std::max(std::abs(x), std::abs(y));
+        double min_mag = std::min(std::abs(x), std::abs(y));
+        // unconditional division: when both magnitudes are 0, so is the error
+        double rel = err / std::max(max_mag, std::numeric_limits<double>::denorm_min());
+        std::int64_t err_bits, rel_bits;
+        std::memcpy(&err_bits, &err, sizeof(err_bits));
+        std::memcpy(&rel_bits, &rel, sizeof(rel_bits));
+        max_abs_bits = err_bits > max_abs_bits ? err_bits : max_abs_bits;
+        max_rel_bits = rel_bits > max_rel_bits ? rel_bits : max_rel_bits;
+        sq_errors[i] = err * err;
+        // bitwise operators avoid short-circuit branches
+        bool b_within = (a[i] == b[i])
+                        | (err <= screen.absolute)
+                        | (err <= screen.strict_relative * min_mag)
+                        | (ulpDistance(a[i], b[i]) <= screen.ulp);
+        mismatch |= (b_within ? 0 : 1);
+    } // end for
+
+    static constexpr std::uint64_t Lanes = 8;
+    double lane_sum_sq[Lanes]            = {};
+    std::uint64_t i                      = 0;
+    for (; i + Lanes <= count; i += Lanes)
+        for (std::uint64_t lane = 0; lane < Lanes; ++lane)
+            lane_sum_sq[lane] += sq_errors[i + lane];
+    for (std::uint64_t lane = 0; i < count; ++i, ++lane)
+        lane_sum_sq[lane] += sq_errors[i];
+
+    result.b_pass              = mismatch == 0;
+    result.stats.element_count = count;
+    result.stats.sum_sq_error  = 0.0;
+    for (std::uint64_t lane = 0; lane < Lanes; ++lane)
+        result.stats.sum_sq_error += lane_sum_sq[lane];
+    // NaN errors have the largest bit patterns, so, they are kept as maximum
+    std::memcpy(&result.stats.max_abs_error, &max_abs_bits, sizeof(result.stats.max_abs_error));
+    std::memcpy(&result.stats.max_rel_error, &max_rel_bits, sizeof(result.stats.max_rel_error));
+}
+
+HEBENCH_TARGET_CLONES void screenWithinTolerance(const std::int32_t *a, const std::int32_t *b, std::uint64_t count,
+                                                 const ToleranceScreen &screen, ToleranceScreenResult &result)
+{
+    screenWithinToleranceImpl(a, b, count, screen, result);
+}
+
+HEBENCH_TARGET_CLONES void screenWithinTolerance(const std::int64_t *a, const std::int64_t *b, std::uint64_t count,
+                                                 const ToleranceScreen &screen, ToleranceScreenResult &result)
+{
+    screenWithinToleranceImpl(a, b, count, screen, result);
+}
+
+HEBENCH_TARGET_CLONES void screenWithinTolerance(const float *a, const float *b, std::uint64_t count,
+                                                 const ToleranceScreen &screen, ToleranceScreenResult &result)
+{
+    screenWithinToleranceImpl(a, b, count, screen, result);
+}
+
+HEBENCH_TARGET_CLONES void screenWithinTolerance(const double *a, const double *b, std::uint64_t count,
+                                                 const ToleranceScreen &screen, ToleranceScreenResult &result)
+{
+    screenWithinToleranceImpl(a, b, count, screen, result);
+}
+
+#undef HEBENCH_TARGET_CLONES
+#undef HEBENCH_CLONE_INLINE
+
+} // namespace
+
+template <typename T>
+bool isWithinTolerance(T a, T b, const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &tolerance)
+{
+    using Model = hebench::TestHarness::BenchmarkDescription::ValidationTolerance::Model;
+
+    if (a == b)
+        return true;
+    bool b_relative = tolerance.model == Model::Relative || tolerance.model == Model::Mixed;
+    bool b_absolute = tolerance.model == Model::Absolute || tolerance.model == Model::Mixed;
+    bool b_ulp      = tolerance.model == Model::ULP || tolerance.model == Model::Mixed;
+    return (b_absolute && std::abs(static_cast<double>(a) - static_cast<double>(b)) <= tolerance.absolute)
+           || (b_ulp && ulpDistance(a, b) <= tolerance.ulp)
+           || (b_relative && hebench::Utilities::Math::almostEqual(a, b, tolerance.relative));
+}
+
+template <typename T>
+std::uint64_t getOrderedBits(T value)
+{
+    static constexpr std::uint64_t SignBit = static_cast<std::uint64_t>(1) << 63;
+    if constexpr (std::is_integral_v<T>)
+        return static_cast<std::uint64_t>(static_cast<std::int64_t>(value)) ^ SignBit;
+    else
+        return toOrderedUInt(value);
+}
+
+template <typename T>
+std::vector<std::uint64_t> findNotWithinTolerance(const T *a, const T *b, std::uint64_t count,
+                                                  const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &tolerance,
+                                                  ValidationErrorStats *p_stats)
+{
+    using Model = hebench::TestHarness::BenchmarkDescription::ValidationTolerance::Model;
+
+    std::vector<std::uint64_t> retval;
+    ValidationErrorStats stats;
+
+    bool b_relative = tolerance.model == Model::Relative || tolerance.model == Model::Mixed;
+    bool b_absolute = tolerance.model == Model::Absolute || tolerance.model == Model::Mixed;
+    bool b_ulp      = tolerance.model == Model::ULP || tolerance.model == Model::Mixed;
+    ToleranceScreen screen;
+    screen.absolute = b_absolute ? tolerance.absolute : -1.0;
+    // integers are screened for equality under relative tolerance
+    screen.strict_relative = b_relative && !std::is_integral_v<T> ? tolerance.relative / 2.0 : -1.0;
+    screen.ulp             = b_ulp ? tolerance.ulp : 0;
+
+    for (std::uint64_t block_first = 0; block_first < count; block_first += ToleranceBlockSize)
+    {
+        std::uint64_t block_count = std::min(ToleranceBlockSize, count - block_first);
+        ToleranceScreenResult block_result;
+        screenWithinTolerance(a + block_first, b + block_first, block_count, screen, block_result);
+        stats.merge(block_result.stats);
+        if (!block_result.b_pass)
+        {
+            for (std::uint64_t i = block_first; i < block_first + block_count; ++i)
+                if (!isWithinTolerance(a[i], b[i], tolerance))
+                    retval.push_back(i);
+        } // end if
+    } // end for
+
+    if (p_stats)
+        p_stats->merge(stats);
+
+    return retval;
+}
+
+template <typename T>
+std::vector<std::uint64_t> findNotAlmostEqual(const T *a, const T *b, std::uint64_t count, double pct)
+{
+    hebench::TestHarness::BenchmarkDescription::ValidationTolerance tolerance;
+    tolerance.model    = hebench::TestHarness::BenchmarkDescription::ValidationTolerance::Model::Relative;
+    tolerance.relative = pct;
+    return findNotWithinTolerance(a, b, count, tolerance);
+}
+
+template std::vector<std::uint64_t> findNotWithinTolerance<std::int32_t>(const std::int32_t *, const std::int32_t *, std::uint64_t,
+                                                                         const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &,
+                                                                         ValidationErrorStats *);
+template std::vector<std::uint64_t> findNotWithinTolerance<std::int64_t>(const std::int64_t *, const std::int64_t *, std::uint64_t,
+                                                                         const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &,
+                                                                         ValidationErrorStats *);
+template std::vector<std::uint64_t> findNotWithinTolerance<float>(const float *, const float *, std::uint64_t,
+                                                                  const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &,
+                                                                  ValidationErrorStats *);
+template std::vector<std::uint64_t> findNotWithinTolerance<double>(const double *, const double *, std::uint64_t,
+                                                                   const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &,
+                                                                   ValidationErrorStats *);
+template bool isWithinTolerance<std::int32_t>(std::int32_t, std::int32_t, const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &);
+template bool isWithinTolerance<std::int64_t>(std::int64_t, std::int64_t, const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &);
+template bool isWithinTolerance<float>(float, float, const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &);
+template bool isWithinTolerance<double>(double, double, const hebench::TestHarness::BenchmarkDescription::ValidationTolerance &);
+template std::uint64_t getOrderedBits<std::int32_t>(std::int32_t);
+template std::uint64_t getOrderedBits<std::int64_t>(std::int64_t);
+template std::uint64_t getOrderedBits<float>(float);
+template std::uint64_t getOrderedBits<double>(double);
+template std::vector<std::uint64_t> findNotAlmostEqual<std::int32_t>(const std::int32_t *, const std::int32_t *, std::uint64_t, double);
+template std::vector<std::uint64_t> findNotAlmostEqual<std::int64_t>(const std::int64_t *, const std::int64_t *, std::uint64_t, double);
+template std::vector<std::uint64_t> findNotAlmostEqual<float>(const float *, const float *, std::uint64_t, double);
+template std::vector<std::uint64_t> findNotAlmostEqual<double>(const double *, const double *, std::uint64_t, double);
+
 //-----------------------
 // class RandomGenerator
 //-----------------------
 
 void RandomGenerator::setRandomSeed(std::uint64_t seed)
 {
+    m_seed = seed;
     m_rand.seed(seed);
 }
 
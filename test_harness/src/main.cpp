@@ -2,8 +2,10 @@
 // Copyright (C) 2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
@@ -23,6 +25,8 @@
 #include "hebench/dynamic_lib_load.h"
 #include "hebench_report_compiler.h"
 
+#include "benchmarks/categories/include/hebench_benchmark_batch_sweep.h"
+#include "benchmarks/datagen_helper/include/datagen_helper.h"
 #include "include/hebench_config.h"
 #include "include/hebench_engine.h"
 #include "include/hebench_types_harness.h"
@@ -42,6 +46,24 @@ struct ProgramConfig
     bool b_dump_config;
     bool b_force_config;
     bool b_validate_results;
+    hebench::TestHarness::IBenchmark::ValidationPolicy validation_policy;
+    std::uint64_t validation_sample_count;
+    bool b_lazy_ground_truth;
+    std::uint64_t ground_truth_cache_size;
+    std::uint64_t dataset_cache_size_mb;
+    std::uint64_t latency_result_window;
+    std::uint64_t latency_result_sampling;
+    std::uint64_t latency_stream_count;
+    hebench::TestHarness::IBenchmark::ArrivalProcess arrival_process;
+    std::vector<double> arrival_rates;
+    bool b_pipelined;
+    std::uint64_t pipeline_queue_size;
+    hebench::TestHarness::BatchSweep::Config batch_sweep;
+    hebench::TestHarness::IBenchmark::StoppingCriteria stopping_criteria;
+    std::uint64_t offline_warmup_iterations;
+    bool b_offline_steady_state;
+    std::uint64_t offline_steady_state_window;
+    std::uint64_t offline_max_warmup_iterations;
     bool b_single_path_report;
     std::uint64_t random_seed;
     std::size_t report_delay_ms;
@@ -54,6 +76,18 @@ struct ProgramConfig
     static constexpr std::uint64_t DefaultSampleSize  = 0;
     static constexpr std::size_t DefaultReportDelay   = 1000;
     static constexpr const char *DefaultRootPath      = ".";
+    static constexpr std::uint64_t DefaultGTCacheSize = 64;
+    static constexpr std::uint64_t DefaultDSCacheSize = 0;
+    static constexpr const char *DefaultValPolicy     = "full";
+    static constexpr std::uint64_t DefaultValSamples  = 1000;
+    static constexpr const char *DefaultArrivalProc   = "closed";
+    static constexpr std::uint64_t DefaultPipeQueue   = 4;
+    static constexpr const char *DefaultBatchSweep    = "none";
+    static constexpr std::uint64_t DefaultSweepMax    = 1024;
+    static constexpr std::uint64_t DefaultAdaptMaxMs  = 600000;
+    static constexpr std::uint64_t DefaultAdaptMinIt  = 10;
+    static constexpr std::uint64_t DefaultSSWindow    = 5;
+    static constexpr std::uint64_t DefaultMaxWarmup   = 50;
 
     void initializeConfig(const hebench::ArgsParser &parser);
     void showBenchmarkDefaults(std::ostream &os);
@@ -84,6 +118,123 @@ void ProgramConfig::initializeConfig(const hebench::ArgsParser &parser)
     backend_lib_path = s_tmp;
 
     parser.getValue<decltype(b_validate_results)>(b_validate_results, "--enable_validation", true);
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--validation_policy", DefaultValPolicy);
+    validation_policy = hebench::TestHarness::IBenchmark::getValidationPolicy(s_tmp);
+    parser.getValue<decltype(validation_sample_count)>(validation_sample_count, "--validation_sample_count", DefaultValSamples);
+    if (validation_policy != hebench::TestHarness::IBenchmark::ValidationPolicy::Full
+        && validation_sample_count == 0)
+        throw std::runtime_error("Invalid validation sample count: \"--validation_sample_count\" must be positive when \"--validation_policy\" is not \"full\".");
+
+    parser.getValue<decltype(b_lazy_ground_truth)>(b_lazy_ground_truth, "--lazy_ground_truth", false);
+    parser.getValue<decltype(ground_truth_cache_size)>(ground_truth_cache_size, "--ground_truth_cache_size", DefaultGTCacheSize);
+    parser.getValue<decltype(dataset_cache_size_mb)>(dataset_cache_size_mb, "--dataset_cache_size", DefaultDSCacheSize);
+
+    parser.getValue<decltype(latency_result_window)>(latency_result_window, "--latency_result_window", 0);
+    parser.getValue<decltype(latency_result_sampling)>(latency_result_sampling, "--latency_result_sampling", 1);
+    parser.getValue<decltype(latency_stream_count)>(latency_stream_count, "--latency_streams", 1);
+
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--arrival_process", DefaultArrivalProc);
+    arrival_process = hebench::TestHarness::IBenchmark::getArrivalProcess(s_tmp);
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--arrival_rates", "");
+    arrival_rates.clear();
+    std::stringstream ss_rates(s_tmp);
+    std::string s_rate;
+    while (std::getline(ss_rates, s_rate, ','))
+    {
+        std::size_t pos = 0;
+        double rate     = 0.0;
+        try
+        {
+            rate = std::stod(s_rate, &pos);
+        }
+        catch (...)
+        {
+            pos = 0;
+        }
+        if (pos <= 0 || s_rate.find_first_not_of(' ', pos) != std::string::npos
+            || !std::isfinite(rate) || rate <= 0.0)
+            throw std::runtime_error("Invalid arrival rate specified in \"--arrival_rates\": \"" + s_rate + "\". Rates must be positive numbers.");
+        arrival_rates.push_back(rate);
+    } // end while
+    if (arrival_process != hebench::TestHarness::IBenchmark::ArrivalProcess::Closed
+        && arrival_rates.empty())
+        throw std::runtime_error("Open-loop arrival process requested, but no arrival rates given with \"--arrival_rates\" parameter.");
+    if (arrival_process != hebench::TestHarness::IBenchmark::ArrivalProcess::Closed
+        && latency_stream_count > 1)
+        throw std::runtime_error("Open-loop arrival process is not supported with multiple latency streams (\"--latency_streams\").");
+    if (arrival_process == hebench::TestHarness::IBenchmark::ArrivalProcess::Closed
+        && parser.hasArgument("--arrival_rates"))
+        throw std::runtime_error("Arrival rates given with \"--arrival_rates\" parameter, but arrival process is \"closed\".");
+    if (latency_result_window == 0 && latency_result_sampling > 1)
+        throw std::runtime_error("Latency result sampling requested with \"--latency_result_sampling\", but no result window given with \"--latency_result_window\" parameter.");
+
+    parser.getValue<decltype(b_pipelined)>(b_pipelined, "--pipelined", false);
+    parser.getValue<decltype(pipeline_queue_size)>(pipeline_queue_size, "--pipeline_queue_size", DefaultPipeQueue);
+    if (b_pipelined
+        && (arrival_process != hebench::TestHarness::IBenchmark::ArrivalProcess::Closed
+            || latency_stream_count > 1))
+        throw std::runtime_error("Pipelined latency tests are not supported with open-loop arrival process or multiple latency streams.");
+    if (b_pipelined
+        && (parser.hasArgument("--latency_result_window") || parser.hasArgument("--latency_result_sampling")))
+        throw std::runtime_error("Pipelined latency tests validate every result: \"--latency_result_window\" and \"--latency_result_sampling\" are not supported.");
+    if (!b_pipelined && parser.hasArgument("--pipeline_queue_size"))
+        throw std::runtime_error("Pipeline queue size given with \"--pipeline_queue_size\" parameter, but pipelined latency tests were not requested with \"--pipelined\".");
+
+    parser.getValue<decltype(s_tmp)>(s_tmp, "--batch_sweep", DefaultBatchSweep);
+    batch_sweep.strategy = hebench::TestHarness::BatchSweep::getStrategy(s_tmp);
+    parser.getValue<decltype(batch_sweep.param_index)>(batch_sweep.param_index, "--batch_sweep_param", 0);
+    parser.getValue<decltype(batch_sweep.min_batch_size)>(batch_sweep.min_batch_size, "--batch_sweep_min", 1);
+    parser.getValue<decltype(batch_sweep.max_batch_size)>(batch_sweep.max_batch_size, "--batch_sweep_max", DefaultSweepMax);
+    parser.getValue<decltype(batch_sweep.growth_factor)>(batch_sweep.growth_factor, "--batch_sweep_factor", 2.0);
+    parser.getValue<decltype(batch_sweep.min_gain)>(batch_sweep.min_gain, "--batch_sweep_min_gain", 5.0);
+    batch_sweep.min_gain /= 100.0; // percent to per-one
+    if (batch_sweep.strategy != hebench::TestHarness::BatchSweep::Strategy::None)
+    {
+        if (batch_sweep.min_batch_size < 1 || batch_sweep.max_batch_size < batch_sweep.min_batch_size)
+            throw std::runtime_error("Invalid batch sweep range: \"--batch_sweep_min\" must be positive and not greater than \"--batch_sweep_max\".");
+        if (!std::isfinite(batch_sweep.growth_factor) || batch_sweep.growth_factor <= 1.0)
+            throw std::runtime_error("Invalid batch sweep growth factor: \"--batch_sweep_factor\" must be greater than 1.");
+        if (!std::isfinite(batch_sweep.min_gain) || batch_sweep.min_gain < 0.0)
+            throw std::runtime_error("Invalid batch sweep minimum gain: \"--batch_sweep_min_gain\" cannot be negative.");
+    } // end if
+
+    parser.getValue<decltype(stopping_criteria.precision)>(stopping_criteria.precision, "--adaptive_precision", 0.0);
+    parser.getValue<decltype(stopping_criteria.confidence_level)>(stopping_criteria.confidence_level, "--adaptive_confidence", 95.0);
+    parser.getValue<decltype(stopping_criteria.b_median)>(stopping_criteria.b_median, "--adaptive_median", false);
+    parser.getValue<decltype(stopping_criteria.min_time_ms)>(stopping_criteria.min_time_ms, "--adaptive_min_time", 0);
+    parser.getValue<decltype(stopping_criteria.max_time_ms)>(stopping_criteria.max_time_ms, "--adaptive_max_time", DefaultAdaptMaxMs);
+    parser.getValue<decltype(stopping_criteria.min_iterations)>(stopping_criteria.min_iterations, "--adaptive_min_iterations", DefaultAdaptMinIt);
+    parser.getValue<decltype(stopping_criteria.max_iterations)>(stopping_criteria.max_iterations, "--adaptive_max_iterations", 0);
+    // percent to per-one
+    stopping_criteria.precision /= 100.0;
+    stopping_criteria.confidence_level /= 100.0;
+    if (!std::isfinite(stopping_criteria.precision) || stopping_criteria.precision < 0.0)
+        throw std::runtime_error("Invalid target precision: \"--adaptive_precision\" cannot be negative.");
+    if (stopping_criteria.precision > 0.0)
+    {
+        if (!std::isfinite(stopping_criteria.confidence_level)
+            || stopping_criteria.confidence_level <= 0.0 || stopping_criteria.confidence_level >= 1.0)
+            throw std::runtime_error("Invalid confidence level: \"--adaptive_confidence\" must be in range (0, 100).");
+        if (stopping_criteria.max_time_ms > 0 && stopping_criteria.max_time_ms < stopping_criteria.min_time_ms)
+            throw std::runtime_error("Invalid adaptive time range: \"--adaptive_max_time\" cannot be less than \"--adaptive_min_time\".");
+        if (stopping_criteria.max_iterations > 0 && stopping_criteria.max_iterations < stopping_criteria.min_iterations)
+            throw std::runtime_error("Invalid adaptive iteration range: \"--adaptive_max_iterations\" cannot be less than \"--adaptive_min_iterations\".");
+        if (arrival_process != hebench::TestHarness::IBenchmark::ArrivalProcess::Closed
+            || latency_stream_count > 1 || b_pipelined)
+            throw std::runtime_error("Adaptive stopping rule (\"--adaptive_precision\") is not supported with open-loop arrival process, multiple latency streams or pipelined latency tests.");
+    } // end if
+
+    parser.getValue<decltype(offline_warmup_iterations)>(offline_warmup_iterations, "--offline_warmup", 0);
+    parser.getValue<decltype(b_offline_steady_state)>(b_offline_steady_state, "--offline_steady_state", false);
+    parser.getValue<decltype(offline_steady_state_window)>(offline_steady_state_window, "--offline_steady_state_window", DefaultSSWindow);
+    parser.getValue<decltype(offline_max_warmup_iterations)>(offline_max_warmup_iterations, "--offline_max_warmup", DefaultMaxWarmup);
+    if (b_offline_steady_state)
+    {
+        if (offline_steady_state_window < 3)
+            throw std::runtime_error("Invalid steady state window: \"--offline_steady_state_window\" must be, at least, 3.");
+        if (offline_max_warmup_iterations < offline_steady_state_window)
+            throw std::runtime_error("Invalid maximum warm-up iterations: \"--offline_max_warmup\" cannot be less than \"--offline_steady_state_window\".");
+    } // end if
 
     parser.getValue<decltype(random_seed)>(random_seed, "--random_seed", std::chrono::system_clock::now().time_since_epoch().count());
 
@@ -138,7 +289,65 @@ void ProgramConfig::showConfig(std::ostream &os) const
     {
         os << "Benchmark Run." << std::endl
            << "    Validate results: " << (b_validate_results ? "Yes" : "No") << std::endl
-           << "    Report delay (ms): " << report_delay_ms << std::endl
+           << "    Validation policy: " << hebench::TestHarness::IBenchmark::getValidationPolicyName(validation_policy);
+        if (validation_policy != hebench::TestHarness::IBenchmark::ValidationPolicy::Full)
+            os << " (" << validation_sample_count << " results)";
+        os << std::endl
+           << "    Lazy ground truth: " << (b_lazy_ground_truth ? "Yes" : "No") << std::endl
+           << "    Ground truth cache size: " << ground_truth_cache_size << std::endl
+           << "    Dataset cache size (MB): " << dataset_cache_size_mb << std::endl
+           << "    Latency result window: ";
+        if (latency_result_window > 0)
+            os << latency_result_window << " (sampling 1 out of " << (latency_result_sampling > 1 ? latency_result_sampling : 1) << ")" << std::endl;
+        else
+            os << "(unbounded)" << std::endl;
+        os << "    Latency streams: " << (latency_stream_count > 1 ? latency_stream_count : 1) << std::endl;
+        os << "    Latency arrival process: " << hebench::TestHarness::IBenchmark::getArrivalProcessName(arrival_process);
+        if (arrival_process != hebench::TestHarness::IBenchmark::ArrivalProcess::Closed)
+        {
+            os << " (";
+            for (std::size_t i = 0; i < arrival_rates.size(); ++i)
+                os << (i > 0 ? ", " : "") << arrival_rates[i];
+            os << " ops/s)";
+        } // end if
+        os << std::endl;
+        os << "    Pipelined latency: " << (b_pipelined ? "Yes" : "No");
+        if (b_pipelined)
+            os << " (queue size " << (pipeline_queue_size > 0 ? pipeline_queue_size : 1) << ")";
+        os << std::endl;
+        os << "    Offline batch sweep: " << hebench::TestHarness::BatchSweep::getStrategyName(batch_sweep.strategy);
+        if (batch_sweep.strategy != hebench::TestHarness::BatchSweep::Strategy::None)
+            os << " (parameter " << batch_sweep.param_index
+               << ", batch sizes " << batch_sweep.min_batch_size << " to " << batch_sweep.max_batch_size
+               << ", factor " << batch_sweep.growth_factor
+               << ", minimum gain " << batch_sweep.min_gain * 100.0 << "%)";
+        os << std::endl;
+        os << "    Stopping rule: ";
+        if (stopping_criteria.precision > 0.0)
+        {
+            os << "adaptive (" << stopping_criteria.precision * 100.0 << "% precision at "
+               << stopping_criteria.confidence_level * 100.0 << "% confidence"
+               << (stopping_criteria.b_median ? ", mean and median" : "")
+               << ", time " << stopping_criteria.min_time_ms << " to ";
+            if (stopping_criteria.max_time_ms > 0)
+                os << stopping_criteria.max_time_ms << " ms";
+            else
+                os << "(unbounded)";
+            os << ", iterations " << stopping_criteria.min_iterations << " to ";
+            if (stopping_criteria.max_iterations > 0)
+                os << stopping_criteria.max_iterations;
+            else
+                os << "(unbounded)";
+            os << ")" << std::endl;
+        } // end if
+        else
+            os << "fixed minimum test time" << std::endl;
+        os << "    Offline warm-up iterations: " << offline_warmup_iterations;
+        if (b_offline_steady_state)
+            os << ", then until steady state (window " << offline_steady_state_window
+               << ", up to " << std::max(offline_warmup_iterations, offline_max_warmup_iterations) << " iterations)";
+        os << std::endl;
+        os << "    Report delay (ms): " << report_delay_ms << std::endl
            << "    Report Root Path: " << report_root_path << std::endl
            << "    Compile reports: " << (b_compile_reports ? "Yes" : "No") << std::endl
            << "    Show run overview: " << (b_show_run_overview ? "Yes" : "No") << std::endl;
@@ -176,9 +385,68 @@ std::ostream &ProgramConfig::showVersion(std::ostream &os)
 
 void initArgsParser(hebench::ArgsParser &parser, int argc, char **argv)
 {
+    parser.addArgument("--adaptive_confidence", 1, "<percent>",
+                       "   [OPTIONAL] Confidence level, in percent, of the confidence intervals used\n"
+                       "   by the adaptive stopping rule. Defaults to 95.");
+    parser.addArgument("--adaptive_max_iterations", 1, "<count>",
+                       "   [OPTIONAL] Maximum number of operations in a test with adaptive stopping\n"
+                       "   rule. Pass 0 for no limit. Defaults to 0.");
+    parser.addArgument("--adaptive_max_time", 1, "<time_in_ms>",
+                       "   [OPTIONAL] Maximum operation time, in milliseconds, of a test with adaptive\n"
+                       "   stopping rule. Pass 0 for no limit. Defaults to 600000 (10 minutes).");
+    parser.addArgument("--adaptive_median", 1, "<bool: 0|false|1|true>",
+                       "   [OPTIONAL] Specifies whether the confidence interval for the median must\n"
+                       "   also reach the target precision before the adaptive stopping rule stops a\n"
+                       "   test (TRUE) or only the one for the mean (FALSE). Defaults to \"FALSE\".");
+    parser.addArgument("--adaptive_min_iterations", 1, "<count>",
+                       "   [OPTIONAL] Minimum number of operations in a test with adaptive stopping\n"
+                       "   rule. Defaults to 10.");
+    parser.addArgument("--adaptive_min_time", 1, "<time_in_ms>",
+                       "   [OPTIONAL] Minimum operation time, in milliseconds, of a test with adaptive\n"
+                       "   stopping rule. Defaults to 0.");
+    parser.addArgument("--adaptive_precision", 1, "<percent>",
+                       "   [OPTIONAL] Target half-width, in percent of the mean, of the confidence\n"
+                       "   interval for the operation time. When non-zero, closed-loop latency tests\n"
+                       "   and offline tests stop as soon as this precision is reached, within the\n"
+                       "   adaptive time and iteration bounds, instead of after the minimum test time\n"
+                       "   of the benchmark. Pass 0 to use the minimum test time. Not supported with\n"
+                       "   open-loop, multi-stream or pipelined latency tests. Defaults to 0.");
+    parser.addArgument("--arrival_process", 1, "<closed|constant|poisson>",
+                       "   [OPTIONAL] Specifies how operations are issued during latency tests.\n"
+                       "   \"closed\" issues each operation as soon as the previous one completes.\n"
+                       "   \"constant\" and \"poisson\" issue operations on an open-loop schedule\n"
+                       "   with constant or exponentially distributed inter-arrival times for each\n"
+                       "   rate in \"--arrival_rates\". Queueing delay and response time are reported\n"
+                       "   separately from service time. Defaults to \"closed\".");
+    parser.addArgument("--arrival_rates", 1, "<rate[,rate...]>",
+                       "   [OPTIONAL] Comma separated list of offered loads, in operations per\n"
+                       "   second, to test in turn during open-loop latency tests. Each offered\n"
+                       "   load is tested for the minimum test time of the benchmark. Required when,\n"
+                       "   and only valid when, \"--arrival_process\" is not \"closed\".");
     parser.addArgument("--backend_lib_path", "--backend", "-b", 1, "<path_to_shared_lib>",
                        "   [REQUIRED] Path to backend shared library.\n"
                        "   The library file must exist and be accessible for reading.");
+    parser.addArgument("--batch_sweep", 1, "<none|geometric|bisection>",
+                       "   [OPTIONAL] Specifies whether offline benchmarks sweep the sample size of\n"
+                       "   one operation parameter to find the batch size with the best throughput.\n"
+                       "   \"geometric\" grows the batch size by \"--batch_sweep_factor\" until the\n"
+                       "   throughput gain falls below \"--batch_sweep_min_gain\". \"bisection\" then\n"
+                       "   bisects the last step to locate where throughput saturates. A single\n"
+                       "   report with the throughput for every batch size and the optimum is\n"
+                       "   written per benchmark. Defaults to \"none\".");
+    parser.addArgument("--batch_sweep_factor", 1, "<factor>",
+                       "   [OPTIONAL] Growth factor of the batch size on each geometric step of the\n"
+                       "   batch sweep. Must be greater than 1. Defaults to 2.");
+    parser.addArgument("--batch_sweep_max", 1, "<count>",
+                       "   [OPTIONAL] Largest batch size tested by the batch sweep. Defaults to 1024.");
+    parser.addArgument("--batch_sweep_min", 1, "<count>",
+                       "   [OPTIONAL] First batch size tested by the batch sweep. Defaults to 1.");
+    parser.addArgument("--batch_sweep_min_gain", 1, "<percent>",
+                       "   [OPTIONAL] Throughput gain, in percent, below which the batch sweep\n"
+                       "   considers throughput saturated. Defaults to 5.");
+    parser.addArgument("--batch_sweep_param", 1, "<index>",
+                       "   [OPTIONAL] Index of the operation parameter whose sample size is swept\n"
+                       "   by the batch sweep. Defaults to 0.");
     parser.addArgument("--benchmark_config_file", "--config_file", "-c", 1, "<path_to_config_file>",
                        "   [OPTIONAL] Path to benchmark run configuration file.\n"
                        "   YAML file specifying the selection of benchmarks and their workload\n"
@@ -187,6 +455,13 @@ void initArgsParser(hebench::ArgsParser &parser, int argc, char **argv)
     parser.addArgument("--compile_reports", "--compile", "-C", 1, "<bool: 0|false|1|true>",
                        "   [OPTIONAL] Enables (TRUE) or disables (FALSE) inline compilation of\n"
                        "   benchmark reports into summaries and statistics. Defaults to \"TRUE\".");
+    parser.addArgument("--dataset_cache_size", "--ds_cache", 1, "<size_in_MB>",
+                       "   [OPTIONAL] Memory budget, in megabytes, for datasets kept in memory to be\n"
+                       "   reused by subsequent benchmarks. Benchmarks with the same workload,\n"
+                       "   dimensions, data type, sample sizes and random seed or dataset file share\n"
+                       "   the same inputs and ground truths instead of generating or loading them\n"
+                       "   again. Least recently used datasets are evicted first. Pass 0 to disable\n"
+                       "   caching. Defaults to 0 (disabled).");
     parser.addArgument("--dump_config", "--dump", 0, "",
                        "   [OPTIONAL] If specified, Test Harness will dump a general configuration\n"
                        "   file with the possible benchmarks that the backend can run. This file can\n"
@@ -199,6 +474,60 @@ void initArgsParser(hebench::ArgsParser &parser, int argc, char **argv)
                        "   [OPTIONAL] Specifies whether an attempt will be made to force configuration\n"
                        "   file values on backend (TRUE) or non-flexible backend values will take\n"
                        "   priority (FALSE). Defaults to \"TRUE\".");
+    parser.addArgument("--ground_truth_cache_size", "--gt_cache", 1, "<count>",
+                       "   [OPTIONAL] Maximum number of ground truth samples computed on demand\n"
+                       "   to keep cached for reuse during validation. Least recently used results\n"
+                       "   are evicted first. Pass 0 to disable caching. Defaults to 64.");
+    parser.addArgument("--latency_result_sampling", 1, "<count>",
+                       "   [OPTIONAL] When \"--latency_result_window\" is non-zero, only one out of\n"
+                       "   every this many latency results is post-processed and validated. The rest\n"
+                       "   are destroyed right after the timed operation. Not supported with pipelined\n"
+                       "   latency tests. Defaults to 1 (all results).");
+    parser.addArgument("--latency_result_window", 1, "<count>",
+                       "   [OPTIONAL] Maximum number of results from timed operations kept pending\n"
+                       "   during latency tests. When this many results are pending, they are\n"
+                       "   retrieved, decrypted, decoded and validated outside of the timed region\n"
+                       "   and destroyed, keeping memory constant regardless of test time. Pass 0 to\n"
+                       "   keep all results until the test time elapses. Not supported with pipelined\n"
+                       "   latency tests. Defaults to 0.");
+    parser.addArgument("--latency_streams", 1, "<count>",
+                       "   [OPTIONAL] Number of concurrent streams issuing operations during latency\n"
+                       "   tests. Each stream loads its own copy of the inputs and calls the backend\n"
+                       "   operation from its own thread, concurrently with the other streams, on\n"
+                       "   the same benchmark. Per stream and aggregate latency and throughput are\n"
+                       "   reported. The backend must support concurrent operations. Defaults to 1.");
+    parser.addArgument("--lazy_ground_truth", "--lazy_gt", 1, "<bool: 0|false|1|true>",
+                       "   [OPTIONAL] Specifies whether ground truth for generated (synthetic)\n"
+                       "   datasets is computed on demand during validation (TRUE) instead of\n"
+                       "   precomputed and stored for every input combination during\n"
+                       "   initialization (FALSE). Reduces memory footprint and startup time for\n"
+                       "   large offline datasets. Defaults to \"FALSE\".");
+    parser.addArgument("--offline_max_warmup", 1, "<count>",
+                       "   [OPTIONAL] Maximum number of warm-up operations executed by offline tests\n"
+                       "   while waiting for a steady state. If reached, the test continues with a\n"
+                       "   warning. Defaults to 50.");
+    parser.addArgument("--offline_steady_state", 1, "<bool: 0|false|1|true>",
+                       "   [OPTIONAL] Specifies whether offline tests keep warming up after\n"
+                       "   \"--offline_warmup\" operations until the operation times reach a steady\n"
+                       "   state (TRUE). Steady state is reached when the last operations show no\n"
+                       "   significant change point nor trend. Defaults to \"FALSE\".");
+    parser.addArgument("--offline_steady_state_window", 1, "<count>",
+                       "   [OPTIONAL] Number of most recent warm-up operations tested for steady\n"
+                       "   state. Must be, at least, 3. Defaults to 5.");
+    parser.addArgument("--offline_warmup", 1, "<count>",
+                       "   [OPTIONAL] Number of warm-up operations executed by offline tests before\n"
+                       "   the timed operations. Warm-up operations are reported separately under\n"
+                       "   the \"Warmup\" event and excluded from throughput. Defaults to 0.");
+    parser.addArgument("--pipeline_queue_size", 1, "<count>",
+                       "   [OPTIONAL] Capacity of the bounded queues between stages of pipelined\n"
+                       "   latency tests. A stage blocks when the queue to the next stage is full.\n"
+                       "   Only valid with \"--pipelined\". Defaults to 4.");
+    parser.addArgument("--pipelined", 1, "<bool: 0|false|1|true>",
+                       "   [OPTIONAL] Specifies whether latency tests push a stream of samples\n"
+                       "   through a pipeline where encoding, encryption, loading, operation, store,\n"
+                       "   decryption and decoding run concurrently, each on its own thread (TRUE),\n"
+                       "   or only time the operation (FALSE). Sustained end-to-end throughput and\n"
+                       "   per stage occupancy and backpressure are reported. Defaults to \"FALSE\".");
     parser.addArgument("--run_overview", 1, "<bool: 0|false|1|true>",
                        "   [OPTIONAL] Specifies whether final summary overview of the benchmarks ran\n"
                        "   will be printed in standard output (TRUE) or not (FALSE). Results of the\n"
@@ -218,6 +547,19 @@ void initArgsParser(hebench::ArgsParser &parser, int argc, char **argv)
     parser.addArgument("--single_path_report", "--single_path", 0, "",
                        "   [OPTIONAL] Allows the user to choose if the benchmark's report (s) will be\n"
                        "   created in a single-level directory or not.");
+    parser.addArgument("--validation_policy", 1, "<full|random|stratified|first_last>",
+                       "   [OPTIONAL] Selects which results from offline benchmarks are validated\n"
+                       "   when validation is enabled. \"full\" validates every result. \"random\"\n"
+                       "   validates a uniformly random selection of results. \"stratified\"\n"
+                       "   validates a random selection that covers every sample of every operation\n"
+                       "   parameter as evenly as possible. \"first_last\" validates the first and\n"
+                       "   last results. Confidence of the validation for uniformly random\n"
+                       "   selections is included in the report. Defaults to \"full\".");
+    parser.addArgument("--validation_sample_count", 1, "<count>",
+                       "   [OPTIONAL] Number of offline results to validate when\n"
+                       "   \"--validation_policy\" is not \"full\". If this is greater than or equal\n"
+                       "   to the number of results, all results are validated. Must be positive.\n"
+                       "   Defaults to 1000.");
     parser.addArgument("--version", 0, "",
                        "   [OPTIONAL] Outputs Test Harness version, required API Bridge version and\n"
                        "   currently linked API Bridge version. Application exits after this.");
@@ -381,6 +723,9 @@ int main(int argc, char **argv)
 
         // propagating application configuration
         hebench::TestHarness::PartialBenchmarkDescriptor::setForceConfigValues(config.b_force_config);
+        hebench::TestHarness::DataLoaderCompute::setLazyResultsMode(config.b_lazy_ground_truth,
+                                                                    config.ground_truth_cache_size);
+        hebench::TestHarness::DataLoaderCache::setCapacity(config.dataset_cache_size_mb * 1024 * 1024);
 
         ss = std::stringstream();
         ss << "Initializing Backend from shared library:" << std::endl
@@ -518,14 +863,44 @@ int main(int argc, char **argv)
                     std::cout << std::endl
                               << report.getHeader() << std::endl;
 
-                    // create the benchmark
-                    hebench::TestHarness::IBenchmark::Ptr p_bench = p_engine->createBenchmark(bench_token, report);
-
                     hebench::TestHarness::IBenchmark::RunConfig run_config;
-                    run_config.b_validate_results = config.b_validate_results;
+                    run_config.b_validate_results      = config.b_validate_results;
+                    run_config.validation_policy       = config.validation_policy;
+                    run_config.validation_sample_count = config.validation_sample_count;
+                    run_config.latency_result_window   = config.latency_result_window;
+                    run_config.latency_result_sampling = config.latency_result_sampling;
+                    run_config.latency_stream_count    = config.latency_stream_count;
+                    run_config.arrival_process         = config.arrival_process;
+                    run_config.arrival_rates           = config.arrival_rates;
+                    run_config.b_pipelined             = config.b_pipelined;
+                    run_config.pipeline_queue_size     = config.pipeline_queue_size;
+                    run_config.stopping_criteria       = config.stopping_criteria;
+
+                    run_config.offline_warmup_iterations     = config.offline_warmup_iterations;
+                    run_config.b_offline_steady_state        = config.b_offline_steady_state;
+                    run_config.offline_steady_state_window   = config.offline_steady_state_window;
+                    run_config.offline_max_warmup_iterations = config.offline_max_warmup_iterations;
+
+                    bool b_succeeded;
+                    if (config.batch_sweep.strategy != hebench::TestHarness::BatchSweep::Strategy::None
+                        && bench_token->getBackendDescription().descriptor.category == hebench::APIBridge::Category::Offline)
+                    {
+                        // run the workload once per batch size until the optimum is found
+                        b_succeeded = hebench::TestHarness::BatchSweep::run(*p_engine,
+                                                                            benchmark_request.index,
+                                                                            benchmark_request.configuration,
+                                                                            run_config,
+                                                                            config.batch_sweep,
+                                                                            report);
+                    } // end if
+                    else
+                    {
+                        // create the benchmark
+                        hebench::TestHarness::IBenchmark::Ptr p_bench = p_engine->createBenchmark(bench_token, report);
 
-                    // run the workload
-                    bool b_succeeded = p_bench->run(report, run_config);
+                        // run the workload
+                        b_succeeded = p_bench->run(report, run_config);
+                    } // end else
 
                     if (!b_succeeded)
                     {
@@ -609,8 +984,9 @@ int main(int argc, char **argv)
                 // benchmark cleaned up here automatically
             } // end for
 
-            // clean-up engine before final report (engine can clean up
-            // automatically, but better to release when no longer needed)
+            // release cached datasets and clean-up engine before final report (engine
+            // can clean up automatically, but better to release when no longer needed)
+            hebench::TestHarness::DataLoaderCache::clear();
             p_engine.reset();
 
             // At this point all benchmarks have been run and reports generated.
@@ -672,6 +1048,7 @@ int main(int argc, char **argv)
                 compiler_config.time_unit_stats    = 0;
                 compiler_config.time_unit_overview = 0;
                 compiler_config.time_unit_summary  = 0;
+                compiler_config.sketch_threshold   = 0;
 
                 std::cout << IOS_MSG_INFO << hebench::Logging::GlobalLogger::log("Compiling reports using default compiler options...") << std::endl
                           << std::endl;
@@ -0,0 +1,122 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "benchmarks/datagen_helper/include/datagen_helper.h"
+#include "include/hebench_utilities_harness.h"
+
+using namespace hebench::TestHarness;
+
+namespace {
+
+// large enough for generation to be split among several threads
+constexpr std::uint64_t LargeCount = 0x4000 * 16 + 7;
+// small enough for generation to run on the calling thread only
+constexpr std::uint64_t SmallCount = 0x4000 + 3;
+
+using hebench::UnitTest::check;
+
+void checkBlock(const CounterBasedRandom::Block &block, const CounterBasedRandom::Block &expected)
+{
+    check(block == expected, "Philox4x32-10 block does not match known answer.");
+}
+
+void testKnownAnswers()
+{
+    // known answers for Philox4x32-10 from the Random123 reference implementation
+    checkBlock(CounterBasedRandom::generate(0, 0, 0),
+               { 0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U });
+    checkBlock(CounterBasedRandom::generate(0xffffffffffffffffULL, 0xffffffffffffffffULL, 0xffffffffffffffffULL),
+               { 0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU });
+    checkBlock(CounterBasedRandom::generate(0x299f31d0a4093822ULL, 0x85a308d3243f6a88ULL, 0x0370734413198a2eULL),
+               { 0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U });
+}
+
+template <class T>
+std::vector<T> generateU(hebench::APIBridge::DataType data_type, std::uint64_t count,
+                         std::uint64_t param_index, std::uint64_t sample_index)
+{
+    std::vector<T> retval(count);
+    DataGeneratorHelper::generateRandomVectorU(data_type, retval.data(), retval.size(),
+                                               -100.0, 100.0, param_index, sample_index);
+    return retval;
+}
+
+template <class T>
+std::vector<T> generateN(hebench::APIBridge::DataType data_type, std::uint64_t count,
+                         std::uint64_t param_index, std::uint64_t sample_index)
+{
+    std::vector<T> retval(count);
+    DataGeneratorHelper::generateRandomVectorN(data_type, retval.data(), retval.size(),
+                                               0.0, 10.0, param_index, sample_index);
+    return retval;
+}
+
+template <class T>
+void testThreadCountIndependence(hebench::APIBridge::DataType data_type)
+{
+    hebench::Utilities::RandomGenerator::setRandomSeed(1234);
+
+    // every element depends only on its position: buffers generated with different
+    // numbers of threads must agree on their common elements
+    std::vector<T> serial = generateU<T>(data_type, SmallCount, 0, 5);
+    for (std::uint64_t count : { SmallCount * 2, SmallCount * 3, LargeCount })
+    {
+        std::vector<T> parallel = generateU<T>(data_type, count, 0, 5);
+        for (std::uint64_t i = 0; i < serial.size(); ++i)
+            check(parallel[i] == serial[i], "Uniform data depends on the number of threads.");
+    } // end for
+
+    serial = generateN<T>(data_type, SmallCount, 1, 2);
+    for (std::uint64_t count : { SmallCount * 2, LargeCount })
+    {
+        std::vector<T> parallel = generateN<T>(data_type, count, 1, 2);
+        for (std::uint64_t i = 0; i < serial.size(); ++i)
+            check(parallel[i] == serial[i], "Normal data depends on the number of threads.");
+    } // end for
+
+    // repeatable for the same seed, regardless of the state of the global generator
+    std::vector<T> first = generateU<T>(data_type, LargeCount, 2, 7);
+    hebench::Utilities::RandomGenerator::get().discard(1000);
+    check(generateU<T>(data_type, LargeCount, 2, 7) == first, "Uniform data is not repeatable.");
+
+    for (const T &value : first)
+        check(value >= static_cast<T>(-100) && value <= static_cast<T>(100), "Uniform data out of range.");
+}
+
+void testStreamIndependence()
+{
+    hebench::Utilities::RandomGenerator::setRandomSeed(99);
+
+    // samples can be generated in any order
+    std::vector<double> sample_3 = generateU<double>(hebench::APIBridge::DataType::Float64, 64, 0, 3);
+    std::vector<double> sample_1 = generateU<double>(hebench::APIBridge::DataType::Float64, 64, 0, 1);
+    check(generateU<double>(hebench::APIBridge::DataType::Float64, 64, 0, 3) == sample_3,
+          "Sample data depends on generation order.");
+
+    // different samples, parameters and seeds produce different streams
+    check(sample_1 != sample_3, "Different samples share a random stream.");
+    check(generateU<double>(hebench::APIBridge::DataType::Float64, 64, 1, 3) != sample_3,
+          "Different parameters share a random stream.");
+    hebench::Utilities::RandomGenerator::setRandomSeed(100);
+    check(generateU<double>(hebench::APIBridge::DataType::Float64, 64, 0, 3) != sample_3,
+          "Different seeds share a random stream.");
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testKnownAnswers,
+                                         []() { testThreadCountIndependence<std::int32_t>(hebench::APIBridge::DataType::Int32); },
+                                         []() { testThreadCountIndependence<std::int64_t>(hebench::APIBridge::DataType::Int64); },
+                                         []() { testThreadCountIndependence<float>(hebench::APIBridge::DataType::Float32); },
+                                         []() { testThreadCountIndependence<double>(hebench::APIBridge::DataType::Float64); },
+                                         testStreamIndependence });
+}
@@ -0,0 +1,304 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "benchmarks/SimpleSetIntersection/include/hebench_simple_set_intersection.h"
+#include "benchmarks/datagen_helper/include/datagen_helper.h"
+#include "include/hebench_utilities_harness.h"
+
+using namespace hebench::TestHarness;
+
+namespace {
+
+constexpr std::uint64_t ElementCount = 16;
+
+using hebench::UnitTest::check;
+
+/**
+ * @brief Element-wise addition of two vectors that counts how many results it computes.
+ */
+class TestDataLoader : public DataLoaderCompute
+{
+public:
+    typedef std::shared_ptr<TestDataLoader> Ptr;
+
+    static std::atomic<std::uint64_t> created_count;
+
+    static Ptr create(const DataLoaderCache::Key &key)
+    {
+        return DataLoaderCache::getDataLoader<TestDataLoader>(key, [&]() {
+            Ptr retval = Ptr(new TestDataLoader());
+            retval->init(key.sample_sizes.at(0), key.sample_sizes.at(1));
+            ++created_count;
+            return retval;
+        });
+    }
+
+    std::uint64_t getComputedCount() const { return m_computed_count; }
+    std::uint64_t getTotalDataLoaded() const override { return DataLoaderCompute::getTotalDataLoaded() + m_extra_size; }
+    /**
+     * @brief Simulates data held by the loader changing after it was created.
+     */
+    void setExtraSize(std::uint64_t extra_size) { m_extra_size = extra_size; }
+
+protected:
+    void computeResult(std::vector<hebench::APIBridge::NativeDataBuffer *> &result,
+                       const std::uint64_t *param_data_pack_indices,
+                       hebench::APIBridge::DataType data_type) override
+    {
+        (void)data_type;
+        const double *x = reinterpret_cast<const double *>(getParameterData(0).p_buffers[param_data_pack_indices[0]].p);
+        const double *y = reinterpret_cast<const double *>(getParameterData(1).p_buffers[param_data_pack_indices[1]].p);
+        double *z       = reinterpret_cast<double *>(result.front()->p);
+        for (std::uint64_t i = 0; i < ElementCount; ++i)
+            z[i] = x[i] + y[i];
+        ++m_computed_count;
+    }
+
+private:
+    TestDataLoader() :
+        m_computed_count(0), m_extra_size(0) {}
+
+    void init(std::uint64_t batch_size_x, std::uint64_t batch_size_y)
+    {
+        std::size_t batch_sizes[2]   = { batch_size_x, batch_size_y };
+        std::uint64_t sample_sizes[] = { ElementCount, ElementCount, ElementCount };
+        PartialDataLoader::init(hebench::APIBridge::DataType::Float64,
+                                2, batch_sizes, sample_sizes,
+                                1, sample_sizes + 2,
+                                !isLazyResults());
+        for (std::size_t param_i = 0; param_i < 2; ++param_i)
+            for (std::uint64_t sample_i = 0; sample_i < batch_sizes[param_i]; ++sample_i)
+                DataGeneratorHelper::generateRandomVectorU(hebench::APIBridge::DataType::Float64,
+                                                           getParameterData(param_i).p_buffers[sample_i].p,
+                                                           ElementCount, -10.0, 10.0,
+                                                           param_i, sample_i);
+        if (!isLazyResults())
+            computeResults();
+    }
+
+    std::atomic<std::uint64_t> m_computed_count;
+    std::atomic<std::uint64_t> m_extra_size;
+};
+
+std::atomic<std::uint64_t> TestDataLoader::created_count(0);
+
+DataLoaderCache::Key makeKey(std::uint64_t batch_size_x = 3, std::uint64_t batch_size_y = 4,
+                             const std::string &workload = "Test")
+{
+    DataLoaderCache::Key key;
+    key.workload        = workload;
+    key.data_type       = hebench::APIBridge::DataType::Float64;
+    key.workload_params = { ElementCount };
+    key.sample_sizes    = { batch_size_x, batch_size_y };
+    return key;
+}
+
+void checkResult(TestDataLoader &loader, std::uint64_t x_i, std::uint64_t y_i)
+{
+    std::uint64_t indices[2]            = { x_i, y_i };
+    IDataLoader::ResultDataPtr p_result = loader.getResultFor(indices);
+    const double *x                     = reinterpret_cast<const double *>(loader.getParameterData(0).p_buffers[x_i].p);
+    const double *y                     = reinterpret_cast<const double *>(loader.getParameterData(1).p_buffers[y_i].p);
+    const double *z                     = reinterpret_cast<const double *>(p_result->result.front()->p);
+    check(p_result->sample_index == loader.getResultIndex(indices), "Result index does not match.");
+    for (std::uint64_t i = 0; i < ElementCount; ++i)
+        check(z[i] == x[i] + y[i], "Result does not match.");
+}
+
+void testResultCache()
+{
+    DataLoaderCache::setCapacity(0);
+
+    // eager results are computed once during initialization
+    DataLoaderCompute::setLazyResultsMode(false);
+    TestDataLoader::Ptr p_eager = TestDataLoader::create(makeKey());
+    check(p_eager->getComputedCount() == 12, "Eager results must be computed during initialization.");
+    checkResult(*p_eager, 2, 3);
+    check(p_eager->getComputedCount() == 12, "Eager results must not be computed on demand.");
+
+    // lazy results without cache are computed on every request
+    DataLoaderCompute::setLazyResultsMode(true, 0);
+    TestDataLoader::Ptr p_lazy = TestDataLoader::create(makeKey());
+    check(p_lazy->getComputedCount() == 0, "Lazy results must not be computed during initialization.");
+    checkResult(*p_lazy, 1, 1);
+    checkResult(*p_lazy, 1, 1);
+    check(p_lazy->getComputedCount() == 2, "Uncached lazy results must be computed on every request.");
+
+    // lazy results with cache are evicted in least recently used order
+    DataLoaderCompute::setLazyResultsMode(true, 2);
+    TestDataLoader::Ptr p_cached = TestDataLoader::create(makeKey());
+    checkResult(*p_cached, 0, 0); // A: computed
+    checkResult(*p_cached, 0, 1); // B: computed
+    checkResult(*p_cached, 0, 0); // A: cached, becomes most recently used
+    check(p_cached->getComputedCount() == 2, "Cached result was computed again.");
+    checkResult(*p_cached, 0, 2); // C: computed, evicts B
+    checkResult(*p_cached, 0, 0); // A: cached
+    check(p_cached->getComputedCount() == 3, "Most recently used result was evicted.");
+    checkResult(*p_cached, 0, 1); // B: computed again, evicts C
+    check(p_cached->getComputedCount() == 4, "Least recently used result was not evicted.");
+    checkResult(*p_cached, 0, 0); // A: cached
+    check(p_cached->getComputedCount() == 4, "Cached result was computed again.");
+
+    DataLoaderCompute::setLazyResultsMode(false);
+}
+
+void testDataLoaderCacheKeys()
+{
+    DataLoaderCompute::setLazyResultsMode(false);
+    hebench::Utilities::RandomGenerator::setRandomSeed(1);
+
+    // disabled cache always creates new loaders
+    DataLoaderCache::setCapacity(0);
+    TestDataLoader::created_count = 0;
+    TestDataLoader::Ptr p_first   = TestDataLoader::create(makeKey());
+    check(TestDataLoader::create(makeKey()) != p_first && TestDataLoader::created_count == 2,
+          "Disabled cache must not reuse data loaders.");
+    check(DataLoaderCache::getSize() == 0, "Disabled cache must not hold data.");
+
+    DataLoaderCache::setCapacity(1024 * 1024);
+    TestDataLoader::created_count = 0;
+    p_first                       = TestDataLoader::create(makeKey());
+    check(TestDataLoader::create(makeKey()) == p_first && TestDataLoader::created_count == 1,
+          "Same dataset must be reused.");
+    check(DataLoaderCache::getSize() == p_first->getTotalDataLoaded(), "Cache size does not match cached data.");
+
+    // every field of the key identifies a different dataset
+    std::vector<DataLoaderCache::Key> keys(6, makeKey());
+    keys[0].workload        = "Other";
+    keys[1].data_type       = hebench::APIBridge::DataType::Float32;
+    keys[2].workload_params = { ElementCount + 1 };
+    keys[3].sample_sizes    = { 4, 3 };
+    keys[4].sample_sizes    = { 3, 4, 1 };
+    keys[5].workload_params = { ElementCount, 1 };
+    for (const DataLoaderCache::Key &key : keys)
+        check(TestDataLoader::create(key) != p_first, "Different datasets must not share a data loader.");
+    check(TestDataLoader::created_count == 1 + keys.size(), "Different datasets must not share a data loader.");
+
+    // generated data depends on the seed and the ground truth mode
+    TestDataLoader::created_count = 0;
+    hebench::Utilities::RandomGenerator::setRandomSeed(2);
+    TestDataLoader::Ptr p_seed = TestDataLoader::create(makeKey());
+    check(p_seed != p_first, "Data generated with a different seed must not be reused.");
+    DataLoaderCompute::setLazyResultsMode(true);
+    check(TestDataLoader::create(makeKey()) != p_seed, "Data with a different ground truth mode must not be reused.");
+    DataLoaderCompute::setLazyResultsMode(false);
+    hebench::Utilities::RandomGenerator::setRandomSeed(1);
+    check(TestDataLoader::create(makeKey()) == p_first, "Dataset evicted unexpectedly.");
+    check(TestDataLoader::created_count == 2, "Unexpected number of data loaders created.");
+
+    // external datasets are identified by file path and version
+    std::filesystem::path filename = std::filesystem::temp_directory_path()
+                                     / ("hebench_data_loader_cache_test_" + std::to_string(std::random_device()()) + ".csv");
+    std::ofstream(filename) << "dataset version 1" << std::endl;
+    DataLoaderCache::Key file_key = makeKey();
+    file_key.dataset_filename     = filename.string();
+    TestDataLoader::Ptr p_file    = TestDataLoader::create(file_key);
+    check(p_file != p_first, "External dataset must not match generated data.");
+    check(TestDataLoader::create(file_key) == p_file, "Same external dataset must be reused.");
+    std::ofstream(filename) << "dataset version 2, longer" << std::endl;
+    check(TestDataLoader::create(file_key) != p_file, "Modified external dataset must not be reused.");
+    std::error_code ec;
+    std::filesystem::remove(filename, ec);
+
+    DataLoaderCache::clear();
+    check(DataLoaderCache::getSize() == 0, "Cleared cache must not hold data.");
+}
+
+void testDataLoaderCacheEviction()
+{
+    DataLoaderCompute::setLazyResultsMode(false);
+    hebench::Utilities::RandomGenerator::setRandomSeed(1);
+
+    // data loaders for different workloads with the same size
+    DataLoaderCache::setCapacity(1024 * 1024);
+    std::uint64_t loader_size = TestDataLoader::create(makeKey())->getTotalDataLoaded();
+    DataLoaderCache::clear();
+
+    // room for three data loaders
+    DataLoaderCache::setCapacity(loader_size * 3 + loader_size / 2);
+    TestDataLoader::Ptr p_a = TestDataLoader::create(makeKey(3, 4, "A"));
+    TestDataLoader::Ptr p_b = TestDataLoader::create(makeKey(3, 4, "B"));
+    TestDataLoader::Ptr p_c = TestDataLoader::create(makeKey(3, 4, "C"));
+    check(DataLoaderCache::getSize() == loader_size * 3, "Cache size does not match cached data.");
+    check(TestDataLoader::create(makeKey(3, 4, "A")) == p_a, "Data loader evicted unexpectedly.");
+    // B is least recently used
+    TestDataLoader::Ptr p_d = TestDataLoader::create(makeKey(3, 4, "D"));
+    check(TestDataLoader::create(makeKey(3, 4, "A")) == p_a, "Recently used data loader was evicted.");
+    check(TestDataLoader::create(makeKey(3, 4, "C")) == p_c, "Recently used data loader was evicted.");
+    check(TestDataLoader::create(makeKey(3, 4, "D")) == p_d, "New data loader was not cached.");
+    check(TestDataLoader::create(makeKey(3, 4, "B")) != p_b, "Least recently used data loader was not evicted.");
+    check(DataLoaderCache::getSize() == loader_size * 3, "Cache size does not match cached data.");
+
+    // evicted loaders remain valid while in use
+    checkResult(*p_b, 2, 3);
+
+    // evicting releases the size recorded when a loader was cached, even if its data changed since
+    p_c->setExtraSize(loader_size * 10);
+    DataLoaderCache::clear();
+    check(DataLoaderCache::getSize() == 0, "Evicted size must match the size recorded when cached.");
+    p_c->setExtraSize(0);
+    p_a = TestDataLoader::create(makeKey(3, 4, "A"));
+    p_a->setExtraSize(loader_size);
+    check(TestDataLoader::create(makeKey(3, 4, "A")) == p_a && DataLoaderCache::getSize() == loader_size,
+          "Cache size must not change with the data held by a cached loader.");
+
+    // reducing the capacity evicts loaders, and loaders larger than the capacity are not cached
+    DataLoaderCache::setCapacity(loader_size / 2);
+    check(DataLoaderCache::getSize() == 0, "Reducing capacity must evict data loaders.");
+    TestDataLoader::Ptr p_large = TestDataLoader::create(makeKey());
+    check(TestDataLoader::create(makeKey()) != p_large, "Data loader exceeding the capacity was cached.");
+
+    DataLoaderCache::setCapacity(0);
+}
+
+void testSimpleSetIntersectionRepeatable()
+{
+    // data for a cached loader must be the same as if generated again,
+    // regardless of the state of the global random generator
+    DataLoaderCache::setCapacity(0);
+    DataLoaderCompute::setLazyResultsMode(false);
+    hebench::Utilities::RandomGenerator::setRandomSeed(7);
+
+    auto p_first = SimpleSetIntersection::DataLoader::create(20, 12, 3, 4, 2, hebench::APIBridge::DataType::Int64);
+    hebench::Utilities::RandomGenerator::get().discard(1000);
+    auto p_second = SimpleSetIntersection::DataLoader::create(20, 12, 3, 4, 2, hebench::APIBridge::DataType::Int64);
+    check(p_first != p_second, "Data loaders must not be cached.");
+    for (std::uint64_t param_i = 0; param_i < p_first->getParameterCount(); ++param_i)
+    {
+        const hebench::APIBridge::DataPack &pack_first  = p_first->getParameterData(param_i);
+        const hebench::APIBridge::DataPack &pack_second = p_second->getParameterData(param_i);
+        for (std::uint64_t sample_i = 0; sample_i < pack_first.buffer_count; ++sample_i)
+        {
+            const hebench::APIBridge::NativeDataBuffer &buffer_first  = pack_first.p_buffers[sample_i];
+            const hebench::APIBridge::NativeDataBuffer &buffer_second = pack_second.p_buffers[sample_i];
+            check(buffer_first.size == buffer_second.size
+                      && std::memcmp(buffer_first.p, buffer_second.p, buffer_first.size) == 0,
+                  "Set intersection data depends on the global random generator.");
+        } // end for
+    } // end for
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testResultCache,
+                                         testDataLoaderCacheKeys,
+                                         testDataLoaderCacheEviction,
+                                         testSimpleSetIntersectionRepeatable });
+}
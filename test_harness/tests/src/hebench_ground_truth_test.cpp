@@ -0,0 +1,133 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "benchmarks/datagen_helper/include/datagen_helper.h"
+
+using namespace hebench::TestHarness;
+
+namespace {
+
+using hebench::UnitTest::check;
+
+/**
+ * @brief Data loader whose results identify the input samples used to compute them.
+ * @details Input sample `i` of parameter `p` holds value `p * 1000 + i`. Result
+ * component `c` holds, for every parameter, the value of the input sample used,
+ * plus `c`.
+ */
+class IndexDataLoader : public DataLoaderCompute
+{
+public:
+    typedef std::shared_ptr<IndexDataLoader> Ptr;
+
+    static Ptr create(const std::vector<std::size_t> &batch_sizes, std::size_t result_count)
+    {
+        Ptr retval = Ptr(new IndexDataLoader());
+        retval->init(batch_sizes, result_count);
+        return retval;
+    }
+
+    std::uint64_t getComputedCount(std::uint64_t result_index) const { return m_computed_counts[result_index]; }
+
+protected:
+    void computeResult(std::vector<hebench::APIBridge::NativeDataBuffer *> &result,
+                       const std::uint64_t *param_data_pack_indices,
+                       hebench::APIBridge::DataType data_type) override
+    {
+        (void)data_type;
+        for (std::size_t result_component_i = 0; result_component_i < result.size(); ++result_component_i)
+        {
+            std::int64_t *z = reinterpret_cast<std::int64_t *>(result[result_component_i]->p);
+            for (std::size_t param_i = 0; param_i < getParameterCount(); ++param_i)
+            {
+                const std::int64_t *x = reinterpret_cast<const std::int64_t *>(getParameterData(param_i).p_buffers[param_data_pack_indices[param_i]].p);
+                z[param_i]            = x[0] + static_cast<std::int64_t>(result_component_i);
+            } // end for
+        } // end for
+        ++m_computed_counts[getResultIndex(param_data_pack_indices)];
+    }
+
+private:
+    IndexDataLoader() = default;
+
+    void init(const std::vector<std::size_t> &batch_sizes, std::size_t result_count)
+    {
+        std::vector<std::uint64_t> input_sample_sizes(batch_sizes.size(), 1);
+        std::vector<std::uint64_t> output_sample_sizes(result_count, batch_sizes.size());
+        PartialDataLoader::init(hebench::APIBridge::DataType::Int64,
+                                batch_sizes.size(), batch_sizes.data(), input_sample_sizes.data(),
+                                result_count, output_sample_sizes.data(),
+                                true);
+        for (std::size_t param_i = 0; param_i < batch_sizes.size(); ++param_i)
+            for (std::uint64_t sample_i = 0; sample_i < batch_sizes[param_i]; ++sample_i)
+                reinterpret_cast<std::int64_t *>(getParameterData(param_i).p_buffers[sample_i].p)[0] =
+                    static_cast<std::int64_t>(param_i * 1000 + sample_i);
+        m_computed_counts = std::vector<std::atomic<std::uint64_t>>(getResultData(0).buffer_count);
+        computeResults();
+    }
+
+    std::vector<std::atomic<std::uint64_t>> m_computed_counts;
+};
+
+/**
+ * @brief Checks every result against the serial cross product of the input samples.
+ */
+void checkGroundTruths(const std::vector<std::size_t> &batch_sizes, std::size_t result_count)
+{
+    IndexDataLoader::Ptr p_loader = IndexDataLoader::create(batch_sizes, result_count);
+
+    std::uint64_t expected_count = 1;
+    for (std::size_t batch_size : batch_sizes)
+        expected_count *= batch_size;
+    check(p_loader->getResultData(0).buffer_count == expected_count, "Incorrect number of results.");
+
+    std::vector<std::uint64_t> ppi(batch_sizes.size(), 0);
+    for (std::uint64_t count = 0; count < expected_count; ++count)
+    {
+        std::uint64_t r_i = p_loader->getResultIndex(ppi.data());
+        check(p_loader->getComputedCount(r_i) == 1,
+              "Result " + std::to_string(r_i) + " must be computed exactly once.");
+        for (std::size_t result_component_i = 0; result_component_i < result_count; ++result_component_i)
+        {
+            const std::int64_t *z = reinterpret_cast<const std::int64_t *>(p_loader->getResultData(result_component_i).p_buffers[r_i].p);
+            for (std::size_t param_i = 0; param_i < batch_sizes.size(); ++param_i)
+                check(z[param_i] == static_cast<std::int64_t>(param_i * 1000 + ppi[param_i] + result_component_i),
+                      "Result " + std::to_string(r_i) + " was computed from the wrong input samples.");
+        } // end for
+
+        // next combination of input samples, last parameter varying fastest
+        for (std::size_t param_i = ppi.size(); param_i > 0; --param_i)
+        {
+            if (++ppi[param_i - 1] < batch_sizes[param_i - 1])
+                break;
+            ppi[param_i - 1] = 0;
+        } // end for
+    } // end for
+}
+
+void testGroundTruths()
+{
+    checkGroundTruths({ 1 }, 1);
+    checkGroundTruths({ 3, 4 }, 1);
+    checkGroundTruths({ 7, 1, 5 }, 2);
+    // enough results to be split among several threads
+    checkGroundTruths({ 61, 53 }, 1);
+    checkGroundTruths({ 13, 2, 17, 3 }, 3);
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testGroundTruths });
+}
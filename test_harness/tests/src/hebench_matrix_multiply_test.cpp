@@ -0,0 +1,86 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "benchmarks/MatrixMultiply/include/hebench_matmult.h"
+#include "benchmarks/datagen_helper/include/datagen_helper.h"
+
+using namespace hebench::TestHarness;
+
+namespace {
+
+using hebench::UnitTest::check;
+
+/**
+ * @brief Straight-forward triple loop matrix multiplication, accumulating each
+ * element of the result in increasing order of columns of A.
+ */
+template <class T>
+std::vector<T> matMulNaive(const T *mat_a, const T *mat_b,
+                           std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b)
+{
+    std::vector<T> retval(rows_a * cols_b, static_cast<T>(0));
+    for (std::uint64_t row_a = 0; row_a < rows_a; ++row_a)
+        for (std::uint64_t col_b = 0; col_b < cols_b; ++col_b)
+        {
+            T acc = static_cast<T>(0);
+            for (std::uint64_t col_a = 0; col_a < cols_a; ++col_a)
+                acc += mat_a[row_a * cols_a + col_a] * mat_b[col_a * cols_b + col_b];
+            retval[row_a * cols_b + col_b] = acc;
+        } // end for
+    return retval;
+}
+
+template <class T>
+void checkMatMul(hebench::APIBridge::DataType data_type,
+                 std::uint64_t rows_a, std::uint64_t cols_a, std::uint64_t cols_b)
+{
+    const std::string s_shape = "(" + std::to_string(rows_a) + "x" + std::to_string(cols_a) + ") x ("
+                                + std::to_string(cols_a) + "x" + std::to_string(cols_b) + ")";
+
+    MatrixMultiply::DataLoader::Ptr p_loader = MatrixMultiply::DataLoader::create(rows_a, cols_a, cols_b, 2, 1, data_type);
+    for (std::uint64_t a_i = 0; a_i < 2; ++a_i)
+    {
+        std::uint64_t indices[2] = { a_i, 0 };
+        const T *mat_a           = reinterpret_cast<const T *>(p_loader->getParameterData(0).p_buffers[a_i].p);
+        const T *mat_b           = reinterpret_cast<const T *>(p_loader->getParameterData(1).p_buffers[0].p);
+        const T *mat_result      = reinterpret_cast<const T *>(p_loader->getResultData(0).p_buffers[p_loader->getResultIndex(indices)].p);
+
+        // blocked multiplication keeps the order of accumulation, so, results
+        // must match exactly, even for floating point
+        std::vector<T> expected = matMulNaive(mat_a, mat_b, rows_a, cols_a, cols_b);
+        for (std::uint64_t i = 0; i < expected.size(); ++i)
+            check(mat_result[i] == expected[i],
+                  "Product " + s_shape + " does not match the triple loop at element " + std::to_string(i) + ".");
+    } // end for
+}
+
+template <class T>
+void testMatMul(hebench::APIBridge::DataType data_type)
+{
+    DataLoaderCache::setCapacity(0);
+    DataLoaderCompute::setLazyResultsMode(false);
+
+    // smaller than a register tile, edge tiles in both dimensions,
+    // and several cache blocks along the columns of A
+    checkMatMul<T>(data_type, 1, 1, 1);
+    checkMatMul<T>(data_type, 5, 67, 67);
+    checkMatMul<T>(data_type, 300, 257, 257);
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ []() { testMatMul<std::int32_t>(hebench::APIBridge::DataType::Int32); },
+                                         []() { testMatMul<std::int64_t>(hebench::APIBridge::DataType::Int64); },
+                                         []() { testMatMul<float>(hebench::APIBridge::DataType::Float32); },
+                                         []() { testMatMul<double>(hebench::APIBridge::DataType::Float64); } });
+}
@@ -0,0 +1,308 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "benchmarks/SimpleSetIntersection/include/hebench_simple_set_intersection.h"
+
+using namespace hebench::TestHarness::SimpleSetIntersection;
+
+namespace {
+
+using Mismatches          = std::vector<std::pair<bool, std::uint64_t>>;
+using ValidationTolerance = hebench::TestHarness::BenchmarkDescription::ValidationTolerance;
+using Model               = ValidationTolerance::Model;
+
+using hebench::UnitTest::check;
+
+template <typename T>
+std::vector<T> shuffleItems(const std::vector<T> &items, std::uint64_t k, std::mt19937_64 &rand)
+{
+    std::vector<std::uint64_t> order(items.size() / k);
+    for (std::uint64_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), rand);
+    std::vector<T> retval;
+    retval.reserve(items.size());
+    for (std::uint64_t i : order)
+        retval.insert(retval.end(), items.begin() + i * k, items.begin() + (i + 1) * k);
+    return retval;
+}
+
+/**
+ * @brief Number of unmatched items in a maximum matching between X and Y, found
+ * by testing all pairs of items.
+ */
+template <typename T>
+std::size_t countUnmatchedBruteForce(const std::vector<T> &X, const std::vector<T> &Y, std::uint64_t k,
+                                     const ValidationTolerance &tolerance)
+{
+    std::size_t n = X.size() / k;
+    std::size_t m = Y.size() / k;
+    std::vector<std::size_t> match_X(n, m);
+    std::function<bool(std::size_t, std::vector<bool> &)> augment =
+        [&](std::size_t y_i, std::vector<bool> &visited_X) {
+            for (std::size_t x_i = 0; x_i < n; ++x_i)
+                if (!visited_X[x_i] && isMemberOf(X.data() + x_i * k, Y.data() + y_i * k, 1, k, tolerance))
+                {
+                    visited_X[x_i] = true;
+                    if (match_X[x_i] == m || augment(match_X[x_i], visited_X))
+                    {
+                        match_X[x_i] = y_i;
+                        return true;
+                    } // end if
+                } // end if
+            return false;
+        };
+    std::size_t matched = 0;
+    for (std::size_t y_i = 0; y_i < m; ++y_i)
+    {
+        std::vector<bool> visited_X(n, false);
+        if (augment(y_i, visited_X))
+            ++matched;
+    } // end for
+    return (n - matched) + (m - matched);
+}
+
+ValidationTolerance createTolerance(Model model, double absolute, double relative, std::uint64_t ulp)
+{
+    ValidationTolerance retval;
+    retval.model    = model;
+    retval.absolute = absolute;
+    retval.relative = relative;
+    retval.ulp      = ulp;
+    return retval;
+}
+
+/**
+ * @brief Moves a value a random distance of up to twice the tolerance of the
+ * specified criterion, so that it may end up within or out of tolerance.
+ */
+template <typename T>
+T perturb(T value, const ValidationTolerance &tolerance, Model criterion, std::mt19937_64 &rand)
+{
+    std::uniform_real_distribution<double> rand_error(-2.0, 2.0);
+    switch (criterion)
+    {
+    case Model::Relative:
+    {
+        double perturbed = static_cast<double>(value) * (1.0 + tolerance.relative * rand_error(rand));
+        return static_cast<T>(std::is_integral_v<T> ? std::round(perturbed) : perturbed);
+    }
+
+    case Model::Absolute:
+        return static_cast<T>(static_cast<double>(value) + tolerance.absolute * rand_error(rand));
+
+    default:
+    {
+        std::int64_t steps = static_cast<std::int64_t>(static_cast<double>(tolerance.ulp) * rand_error(rand));
+        if constexpr (std::is_integral_v<T>)
+            return static_cast<T>(value + steps);
+        else
+        {
+            for (; steps != 0; steps += steps > 0 ? -1 : 1)
+                value = std::nextafter(value, steps > 0 ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity());
+            return value;
+        } // end else
+    }
+    } // end switch
+}
+
+void testExactMatches()
+{
+    std::mt19937_64 rand(1);
+    constexpr std::uint64_t k = 3;
+    std::uniform_int_distribution<std::int64_t> rand_value(-5, 5);
+    std::vector<std::int64_t> X(200 * k);
+    for (std::int64_t &value : X)
+        value = rand_value(rand);
+    std::vector<std::int64_t> Y = shuffleItems(X, k, rand);
+
+    // same multiset in different order, including repeated items
+    check(almostEqualSet(X.data(), Y.data(), 200, 200, k, 0.0).empty(), "Permuted multisets must match.");
+    check(almostEqualSet(X.data(), X.data(), 200, 200, k, 0.0).empty(), "A set must match itself.");
+
+    // an item repeated in X only once in Y is a mismatch
+    std::vector<std::int64_t> X_dup = { 1, 2, 1, 2, 3, 4 };
+    std::vector<std::int64_t> Y_dup = { 3, 4, 1, 2 };
+    Mismatches mismatches           = almostEqualSet(X_dup.data(), Y_dup.data(), 3, 2, 2, 0.0);
+    check(mismatches.size() == 1 && mismatches[0].first, "Repeated item must be matched only once.");
+
+    // empty collections
+    mismatches = almostEqualSet<std::int64_t>(nullptr, Y_dup.data(), 0, 2, 2, 0.0);
+    check(mismatches == Mismatches({ { false, 0 }, { false, 1 } }), "Items of Y must not match an empty X.");
+    mismatches = almostEqualSet<std::int64_t>(X_dup.data(), nullptr, 3, 0, 2, 0.0);
+    check(mismatches == Mismatches({ { true, 0 }, { true, 1 }, { true, 2 } }), "Items of X must not match an empty Y.");
+}
+
+void testToleranceMatches()
+{
+    constexpr double Pct = 0.01;
+
+    // a greedy match of the first item of Y with the first item of X leaves
+    // the second item of Y without match: the maximum matching has none
+    std::vector<double> X = { 1.0, 0.992 };
+    std::vector<double> Y = { 0.995, 1.008 };
+    check(almostEqualSet(X.data(), Y.data(), 2, 2, 1, Pct).empty(), "Items must be matched when a full matching exists.");
+    // same for an exact match
+    X = { 1.0, 0.991 };
+    Y = { 1.009, 1.0 };
+    check(almostEqualSet(X.data(), Y.data(), 2, 2, 1, Pct).empty(), "Exact matches must not prevent a full matching.");
+
+    // items within tolerance, of any sign and magnitude, including zeroes
+    std::mt19937_64 rand(2);
+    constexpr std::uint64_t k = 2;
+    constexpr std::uint64_t n = 5000;
+    std::uniform_real_distribution<double> rand_exponent(-30.0, 30.0);
+    std::uniform_real_distribution<double> rand_error(-0.99 * Pct, 0.99 * Pct);
+    std::bernoulli_distribution rand_sign(0.5);
+    X.resize(n * k);
+    Y.resize(n * k);
+    for (std::uint64_t i = 0; i < X.size(); ++i)
+    {
+        X[i] = i % 97 == 0 ? 0.0 : (rand_sign(rand) ? -1.0 : 1.0) * std::exp(rand_exponent(rand));
+        // perturbed value is within tolerance of the larger magnitude
+        Y[i] = X[i] * (1.0 + rand_error(rand));
+    } // end for
+    Y = shuffleItems(Y, k, rand);
+    check(almostEqualSet(X.data(), Y.data(), n, n, k, Pct).empty(), "Items within tolerance must match.");
+
+    // values on each side of bucket boundaries
+    X.clear();
+    Y.clear();
+    for (double value = 1e-3; value < 1e3; value *= 1.0 + Pct / 3.0)
+    {
+        X.push_back(value);
+        Y.push_back(value * (1.0 - 0.999 * Pct));
+    } // end for
+    check(almostEqualSet(X.data(), Y.data(), X.size(), Y.size(), 1, Pct).empty(),
+          "Items at the edge of tolerance must match.");
+
+    // items out of tolerance are reported with their indices
+    X = { 1.0, -2.0, 3.0, 4.0 };
+    Y = { 4.0, 3.01, -2.05, 1.005 };
+
+    Mismatches mismatches = almostEqualSet(X.data(), Y.data(), 4, 4, 1, Pct);
+    check(mismatches == Mismatches({ { true, 1 }, { false, 2 } }), "Items out of tolerance must be reported.");
+    // values of different sign never match with a tolerance below 100%
+    X = { 0.001 };
+    Y = { -0.001 };
+    check(almostEqualSet(X.data(), Y.data(), 1, 1, 1, 0.5).size() == 2, "Values of different sign must not match.");
+    check(almostEqualSet(X.data(), Y.data(), 1, 1, 1, 2.0).empty(), "Tolerance of 200% must match values of different sign.");
+
+    // relative tolerance is with respect to the larger magnitude, in either order
+    X = { 100.0 };
+    Y = { 99.0 };
+    check(isMemberOf(X.data(), Y.data(), 1, 1, Pct) && isMemberOf(Y.data(), X.data(), 1, 1, Pct),
+          "Relative tolerance must be with respect to the larger magnitude.");
+    // infinite values only match themselves, and NaN never matches
+    X = { std::numeric_limits<double>::infinity(), std::numeric_limits<double>::max() };
+    Y = { std::numeric_limits<double>::max(), std::numeric_limits<double>::infinity() };
+    check(almostEqualSet(X.data(), Y.data(), 2, 2, 1, Pct).empty(), "Infinite values must match themselves.");
+    Y = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+    check(almostEqualSet(X.data(), Y.data(), 2, 2, 1, 2.0).size() == 2, "Infinite values must only match themselves.");
+    X = { std::numeric_limits<double>::quiet_NaN() };
+    check(!isMemberOf(X.data(), X.data(), 1, 1, createTolerance(Model::Mixed, 1.0, 2.0, 1000)),
+          "NaN must not be within any tolerance.");
+}
+
+void testAgainstBruteForce()
+{
+    // values on a coarse grid so that items have several candidate matches
+    std::mt19937_64 rand(3);
+    std::uniform_int_distribution<int> rand_step(-6, 6);
+    for (int test_i = 0; test_i < 300; ++test_i)
+    {
+        std::uint64_t k = 1 + test_i % 3;
+        std::uint64_t n = 1 + rand() % 40;
+        std::uint64_t m = 1 + rand() % 40;
+        double pct      = test_i % 2 == 0 ? 0.01 : 0.03;
+        std::vector<double> X(n * k);
+        std::vector<double> Y(m * k);
+        for (double &value : X)
+            value = 1.0 + 0.005 * rand_step(rand);
+        for (double &value : Y)
+            value = 1.0 + 0.005 * rand_step(rand);
+
+        Mismatches mismatches = almostEqualSet(X.data(), Y.data(), n, m, k, pct);
+        check(mismatches.size() == countUnmatchedBruteForce(X, Y, k, createTolerance(Model::Relative, 0.0, pct, 0)),
+              "Number of mismatches does not match maximum matching.");
+        check(std::is_sorted(mismatches.begin(), mismatches.end(),
+                             [](const auto &a, const auto &b) { return a.first > b.first || (a.first == b.first && a.second < b.second); }),
+              "Mismatches must be listed in X first, in increasing order of index.");
+    } // end for
+}
+
+template <typename T>
+void checkNearEqualAgainstBruteForce(std::uint64_t seed)
+{
+    // items are perturbed copies of a few base items, so that each item has
+    // several candidate matches, near the edge of tolerance
+    std::mt19937_64 rand(seed);
+    std::uniform_int_distribution<int> rand_base(-1000, 1000);
+    std::bernoulli_distribution rand_perturb(0.5);
+    for (Model model : { Model::Relative, Model::Absolute, Model::ULP, Model::Mixed })
+    {
+        ValidationTolerance tolerance = createTolerance(model, 3.0, 0.01, 4);
+        for (int test_i = 0; test_i < 40; ++test_i)
+        {
+            std::uint64_t k = 1 + test_i % 3;
+            std::uint64_t n = 1 + rand() % 60;
+            std::uint64_t m = 1 + rand() % 60;
+            std::vector<T> base_items(4 * k);
+            for (T &value : base_items)
+                value = static_cast<T>(rand_base(rand)) / static_cast<T>(test_i % 2 == 0 ? 1 : 8);
+            auto rand_item = [&](std::vector<T> &items) {
+                std::uint64_t base_i = rand() % 4;
+                for (std::uint64_t j = 0; j < k; ++j)
+                {
+                    T value         = base_items[base_i * k + j];
+                    Model criterion = model == Model::Mixed ? static_cast<Model>(rand() % 3) : model;
+                    items.push_back(rand_perturb(rand) ? perturb(value, tolerance, criterion, rand) : value);
+                } // end for
+            };
+            std::vector<T> X;
+            std::vector<T> Y;
+            for (std::uint64_t i = 0; i < n; ++i)
+                rand_item(X);
+            for (std::uint64_t i = 0; i < m; ++i)
+                rand_item(Y);
+
+            Mismatches mismatches = almostEqualSet(X.data(), Y.data(), n, m, k, tolerance);
+            check(mismatches.size() == countUnmatchedBruteForce(X, Y, k, tolerance),
+                  "Number of mismatches does not match maximum matching for "
+                      + ValidationTolerance::getModelName(model) + " tolerance.");
+        } // end for
+    } // end for
+}
+
+void testNearEqualAgainstBruteForce()
+{
+    checkNearEqualAgainstBruteForce<std::int32_t>(4);
+    checkNearEqualAgainstBruteForce<std::int64_t>(5);
+    checkNearEqualAgainstBruteForce<float>(6);
+    checkNearEqualAgainstBruteForce<double>(7);
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testExactMatches,
+                                         testToleranceMatches,
+                                         testAgainstBruteForce,
+                                         testNearEqualAgainstBruteForce });
+}
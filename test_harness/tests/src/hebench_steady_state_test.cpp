@@ -0,0 +1,106 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "benchmarks/categories/include/hebench_benchmark_steady_state.h"
+#include "benchmarks/categories/include/hebench_benchmark_stopping_rule.h"
+
+using namespace hebench::TestHarness;
+
+namespace {
+
+using hebench::UnitTest::check;
+using hebench::UnitTest::checkThrows;
+
+void testStatistics()
+{
+    std::size_t change_point;
+
+    // gradual increase: significant trend, no significant change point at 5%
+    std::vector<double> series = { 1.0, 2.0, 4.0, 3.0, 5.0 };
+    check(std::abs(SteadyStateDetector::computeChangePointStatistic(series, change_point) - 3.0) < 1e-9
+              && change_point == 2,
+          "Incorrect change point statistic.");
+    check(std::abs(SteadyStateDetector::computeTrendStatistic(series) - 3.5762373641) < 1e-9,
+          "Incorrect trend statistic.");
+
+    // no variance around the means
+    series = { 1.0, 1.0, 1.0, 5.0, 5.0 };
+    check(std::isinf(SteadyStateDetector::computeChangePointStatistic(series, change_point)) && change_point == 3,
+          "Step without noise must be an infinite change point at the step.");
+    series = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    check(std::isinf(SteadyStateDetector::computeTrendStatistic(series)),
+          "Perfect line with non-zero slope must be an infinite trend.");
+    series = { 2.0, 2.0, 2.0, 2.0 };
+    check(SteadyStateDetector::computeChangePointStatistic(series, change_point) == 0.0
+              && SteadyStateDetector::computeTrendStatistic(series) == 0.0,
+          "Constant series must have neither change point nor trend.");
+
+    series = { 1.0, 2.0 };
+    checkThrows<std::invalid_argument>([&series]() { SteadyStateDetector::computeTrendStatistic(series); },
+                                       "Series with fewer than 3 values must be rejected.");
+}
+
+void testDetector()
+{
+    SteadyStateDetector detector;
+    check(detector.getWindowSize() == SteadyStateDetector::DefaultWindowSize, "Incorrect default window size.");
+    // Bonferroni correction for the 4 split points of a window of 5
+    check(std::abs(detector.getChangePointCritical() - StoppingRule::computeStudentCritical(1.0 - 0.05 / 4.0, 3)) < 1e-12,
+          "Incorrect change point critical value.");
+    check(std::abs(detector.getTrendCritical() - StoppingRule::computeStudentCritical(0.95, 3)) < 1e-12,
+          "Incorrect trend critical value.");
+
+    // slow first operations, then noise around 20 ms: the series is steady once
+    // the slow operations leave the window
+    const std::vector<double> series = { 100.0, 60.0, 40.0, 30.0, 25.0,
+                                         20.3, 19.8, 20.1, 19.6, 20.2,
+                                         20.0, 19.9, 20.4, 19.7, 20.1 };
+    constexpr std::uint64_t SteadyCount = 10;
+    for (std::uint64_t i = 0; i < series.size(); ++i)
+    {
+        detector.add(series[i]);
+        check(detector.getCount() == i + 1, "Incorrect operation count.");
+        check(detector.isSteady() == (i + 1 >= SteadyCount),
+              "Incorrect steady state after " + std::to_string(i + 1) + " operations.");
+
+        if (i + 1 >= detector.getWindowSize())
+        {
+            // statistics are computed on the last window in chronological order
+            std::vector<double> window(series.begin() + (i + 1 - detector.getWindowSize()), series.begin() + (i + 1));
+            std::size_t change_point;
+            check(detector.getChangePointStatistic() == SteadyStateDetector::computeChangePointStatistic(window, change_point)
+                      && detector.getTrendStatistic() == SteadyStateDetector::computeTrendStatistic(window),
+                  "Statistics must be those of the last window.");
+        } // end if
+    } // end for
+
+    // a sudden slowdown breaks steady state
+    detector.add(40.0);
+    check(!detector.isSteady(), "Step in operation times must break steady state.");
+
+    checkThrows<std::invalid_argument>([]() { SteadyStateDetector(2); },
+                                       "Window with fewer than 3 operations must be rejected.");
+    checkThrows<std::invalid_argument>([]() { SteadyStateDetector(5, 0.0); },
+                                       "Significance level of 0 must be rejected.");
+    checkThrows<std::invalid_argument>([]() { SteadyStateDetector(5, std::numeric_limits<double>::quiet_NaN()); },
+                                       "Invalid significance level must be rejected.");
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testStatistics,
+                                         testDetector });
+}
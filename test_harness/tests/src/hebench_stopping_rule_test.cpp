@@ -0,0 +1,172 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "benchmarks/categories/include/hebench_benchmark_stopping_rule.h"
+
+using namespace hebench::TestHarness;
+
+namespace {
+
+using hebench::UnitTest::check;
+using hebench::UnitTest::checkThrows;
+
+IBenchmark::StoppingCriteria makeCriteria(double precision)
+{
+    IBenchmark::StoppingCriteria retval;
+    retval.precision        = precision;
+    retval.confidence_level = 0.95;
+    retval.b_median         = false;
+    retval.min_time_ms      = 0;
+    retval.max_time_ms      = 0;
+    retval.min_iterations   = 2;
+    retval.max_iterations   = 0;
+    return retval;
+}
+
+void testStudentCritical()
+{
+    struct Reference
+    {
+        double confidence_level;
+        std::uint64_t dof;
+        double critical;
+    };
+    // two-sided critical values from Student t tables
+    static const Reference references[] = {
+        { 0.95, 1, 12.70620 },
+        { 0.95, 2, 4.30265 },
+        { 0.95, 3, 3.18245 },
+        { 0.95, 4, 2.77645 },
+        { 0.95, 10, 2.22814 },
+        { 0.95, 30, 2.04227 },
+        { 0.95, 1000, 1.96234 },
+        { 0.99, 1, 63.65674 },
+        { 0.99, 2, 9.92484 },
+        { 0.99, 30, 2.75000 },
+        { 0.90, 1, 6.31375 },
+        { 0.90, 10, 1.81246 },
+        { 0.9875, 3, 5.39195 } // Bonferroni corrected 95% for 4 tests
+    };
+    for (const Reference &reference : references)
+    {
+        double critical = StoppingRule::computeStudentCritical(reference.confidence_level, reference.dof);
+        check(std::abs(critical - reference.critical) <= 1e-5 * reference.critical,
+              "Critical value for confidence " + std::to_string(reference.confidence_level)
+                  + " and " + std::to_string(reference.dof) + " degrees of freedom: expected "
+                  + std::to_string(reference.critical) + ", got " + std::to_string(critical) + ".");
+    } // end for
+
+    // decreases with the degrees of freedom towards the normal quantile
+    double prev_critical = StoppingRule::computeStudentCritical(0.95, 1);
+    for (std::uint64_t dof = 2; dof <= 4096; dof *= 2)
+    {
+        double critical = StoppingRule::computeStudentCritical(0.95, dof);
+        check(critical < prev_critical, "Critical value must decrease with the degrees of freedom.");
+        prev_critical = critical;
+    } // end for
+    check(std::abs(StoppingRule::computeStudentCritical(0.95, 10000000) - 1.959964) < 1e-5,
+          "Critical value must approach the normal quantile for large degrees of freedom.");
+}
+
+void testFixedTime()
+{
+    StoppingRule rule(makeCriteria(0.0), 100, 2);
+    check(!rule.isAdaptive(), "Zero precision must not be adaptive.");
+
+    // test time elapses on the first operation, but two are required
+    rule.add(150.0);
+    check(!rule.isDone(), "Rule must not stop before the minimum number of operations.");
+    rule.add(1.0);
+    check(rule.isDone() && rule.getStopReason() == StoppingRule::StopReason::TestTime,
+          "Rule must stop once the test time has elapsed.");
+    check(std::abs(rule.getElapsedMs() - 151.0) < 1e-9, "Elapsed time must be the sum of the operation times.");
+}
+
+void testAdaptive()
+{
+    // operation times alternate around 10 ms: relative half-width is
+    // t(n - 1) * sqrt(variance / n) / mean, with the variance computed in two passes
+    IBenchmark::StoppingCriteria criteria = makeCriteria(0.02);
+    StoppingRule rule(criteria, 1000000, 2);
+    check(rule.isAdaptive(), "Non-zero precision must be adaptive.");
+
+    std::vector<double> times;
+    bool b_precision_reached = false;
+    while (!b_precision_reached)
+    {
+        check(!rule.isDone(), "Rule must not stop before the precision is reached.");
+        times.push_back(times.size() % 2 == 0 ? 9.0 : 11.0);
+        rule.add(times.back());
+
+        double n    = static_cast<double>(times.size());
+        double mean = std::accumulate(times.begin(), times.end(), 0.0) / n;
+        double m2   = 0.0;
+        for (double time : times)
+            m2 += (time - mean) * (time - mean);
+        check(std::abs(rule.getMean() - mean) < 1e-9, "Incorrect running mean.");
+        if (times.size() >= 2)
+        {
+            check(std::abs(rule.getVariance() - m2 / (n - 1.0)) < 1e-9, "Incorrect running variance.");
+            double precision = StoppingRule::computeStudentCritical(0.95, times.size() - 1)
+                               * std::sqrt(m2 / (n - 1.0) / n) / mean;
+            check(std::abs(rule.getMeanPrecision() - precision) < 1e-9, "Incorrect mean precision.");
+            b_precision_reached = precision <= criteria.precision;
+        } // end if
+    } // end while
+    check(rule.isDone() && rule.getStopReason() == StoppingRule::StopReason::Precision,
+          "Rule must stop as soon as the precision is reached.");
+
+    std::uint64_t count;
+
+    // maximum bounds stop the rule before the precision is reached
+    criteria.max_iterations = 10;
+    StoppingRule rule_max_it(criteria, 1000000, 2);
+    for (count = 0; !rule_max_it.isDone(); ++count)
+        rule_max_it.add(count % 2 == 0 ? 1.0 : 100.0);
+    check(count == 10 && rule_max_it.getStopReason() == StoppingRule::StopReason::MaxIterations,
+          "Rule must stop at the maximum number of iterations.");
+    criteria.max_iterations = 0;
+    criteria.max_time_ms    = 500;
+    StoppingRule rule_max_time(criteria, 1000000, 2);
+    for (count = 0; !rule_max_time.isDone(); ++count)
+        rule_max_time.add(count % 2 == 0 ? 1.0 : 100.0);
+    check(count == 10 && rule_max_time.getStopReason() == StoppingRule::StopReason::MaxTime,
+          "Rule must stop at the maximum time.");
+
+    // minimum bounds hold the rule even if precision is reached
+    criteria                = makeCriteria(0.02);
+    criteria.min_iterations = 50;
+    StoppingRule rule_min_it(criteria, 1000000, 2);
+    for (count = 0; !rule_min_it.isDone(); ++count)
+        rule_min_it.add(10.0);
+    check(count == 50, "Rule must not stop before the minimum number of iterations.");
+
+    // invalid criteria
+    checkThrows<std::invalid_argument>(
+        [&]() {
+            criteria                  = makeCriteria(0.02);
+            criteria.confidence_level = 1.0;
+            StoppingRule rule_invalid(criteria, 1000, 2);
+        },
+        "Invalid confidence level must be rejected.");
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testStudentCritical,
+                                         testFixedTime,
+                                         testAdaptive });
+}
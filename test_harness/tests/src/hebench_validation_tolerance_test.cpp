@@ -0,0 +1,264 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hebench_unit_test.h"
+
+#include "benchmarks/SimpleSetIntersection/include/hebench_simple_set_intersection.h"
+#include "include/hebench_utilities_harness.h"
+
+using namespace hebench::TestHarness;
+using ValidationTolerance = BenchmarkDescription::ValidationTolerance;
+using Model               = ValidationTolerance::Model;
+
+namespace {
+
+using hebench::UnitTest::check;
+
+ValidationTolerance createTolerance(Model model, double absolute, double relative, std::uint64_t ulp)
+{
+    ValidationTolerance retval;
+    retval.model    = model;
+    retval.absolute = absolute;
+    retval.relative = relative;
+    retval.ulp      = ulp;
+    return retval;
+}
+
+template <typename T>
+T nextUp(T value, int steps)
+{
+    for (int i = 0; i < steps; ++i)
+        value = std::nextafter(value, std::numeric_limits<T>::infinity());
+    return value;
+}
+
+void testModels()
+{
+    using hebench::Utilities::isWithinTolerance;
+
+    // relative
+    ValidationTolerance relative = createTolerance(Model::Relative, 0.0, 0.01, 0);
+    check(isWithinTolerance(100.0, 100.9, relative), "Relative: value within tolerance rejected.");
+    check(!isWithinTolerance(100.0, 101.5, relative), "Relative: value out of tolerance accepted.");
+    check(!isWithinTolerance(0.0, 1e-300, relative), "Relative: nonzero value matched zero.");
+    check(!isWithinTolerance(1.0, -1.0, relative), "Relative: values of different sign matched.");
+
+    // absolute
+    ValidationTolerance absolute = createTolerance(Model::Absolute, 0.5, 0.0, 0);
+    check(isWithinTolerance(0.0, 0.5, absolute), "Absolute: value at tolerance rejected.");
+    check(isWithinTolerance(-0.25, 0.25, absolute), "Absolute: values of different sign rejected.");
+    check(!isWithinTolerance(1000.0, 1000.75, absolute), "Absolute: value out of tolerance accepted.");
+    check(isWithinTolerance<std::int32_t>(7, 7, createTolerance(Model::Absolute, 0.0, 0.0, 0)),
+          "Absolute: equal values rejected with zero tolerance.");
+
+    // ULP
+    ValidationTolerance ulp = createTolerance(Model::ULP, 0.0, 0.0, 3);
+    check(isWithinTolerance(1.0, nextUp(1.0, 3), ulp), "ULP: double 3 ulp apart rejected.");
+    check(!isWithinTolerance(1.0, nextUp(1.0, 4), ulp), "ULP: double 4 ulp apart accepted.");
+    check(isWithinTolerance(1.0f, nextUp(1.0f, 3), ulp), "ULP: float 3 ulp apart rejected.");
+    check(!isWithinTolerance(1.0f, nextUp(1.0f, 4), ulp), "ULP: float 4 ulp apart accepted.");
+    // zero and negative zero count as one representable value apart
+    double denorm = std::numeric_limits<double>::denorm_min();
+    check(isWithinTolerance(-denorm, denorm, ulp), "ULP: values across zero rejected.");
+    check(!isWithinTolerance(-denorm, denorm, createTolerance(Model::ULP, 0.0, 0.0, 2)),
+          "ULP: values across zero accepted.");
+    check(isWithinTolerance<std::int64_t>(-1, 2, ulp), "ULP: integers 3 apart rejected.");
+    check(!isWithinTolerance<std::int64_t>(-2, 2, ulp), "ULP: integers 4 apart accepted.");
+    check(isWithinTolerance<std::int32_t>(std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max(),
+                                          createTolerance(Model::ULP, 0.0, 0.0, std::numeric_limits<std::uint32_t>::max())),
+          "ULP: integer distance overflows.");
+
+    // mixed: any criterion
+    ValidationTolerance mixed = createTolerance(Model::Mixed, 1e-6, 0.01, 3);
+    check(isWithinTolerance(0.0, 1e-7, mixed), "Mixed: value within absolute tolerance rejected.");
+    check(isWithinTolerance(1e6, 1.005e6, mixed), "Mixed: value within relative tolerance rejected.");
+    check(isWithinTolerance(1e-300, nextUp(1e-300, 3), mixed), "Mixed: value within ULP tolerance rejected.");
+    check(!isWithinTolerance(1.0, 1.5, mixed), "Mixed: value out of all tolerances accepted.");
+
+    // NaN is never within tolerance
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    for (Model model : { Model::Relative, Model::Absolute, Model::ULP, Model::Mixed })
+    {
+        ValidationTolerance loose = createTolerance(model, 1e300, 0.99, std::numeric_limits<std::uint64_t>::max() - 1);
+        check(!isWithinTolerance(nan, nan, loose) && !isWithinTolerance(1.0, nan, loose),
+              "NaN accepted by " + ValidationTolerance::getModelName(model) + " model.");
+    } // end for
+}
+
+template <typename T>
+void testOrderedBits()
+{
+    std::vector<T> values;
+    if constexpr (std::is_integral_v<T>)
+        values = { std::numeric_limits<T>::min(), -5, -1, 0, 1, 5, std::numeric_limits<T>::max() };
+    else
+        values = { -std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::max(), static_cast<T>(-1),
+                   -std::numeric_limits<T>::denorm_min(), static_cast<T>(-0.0), static_cast<T>(0.0),
+                   std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::min(), static_cast<T>(1),
+                   std::numeric_limits<T>::max(), std::numeric_limits<T>::infinity() };
+    for (std::size_t i = 1; i < values.size(); ++i)
+        check(hebench::Utilities::getOrderedBits(values[i - 1]) < hebench::Utilities::getOrderedBits(values[i]),
+              "Ordered bits do not keep the order of values.");
+    if constexpr (!std::is_integral_v<T>)
+    {
+        check(hebench::Utilities::getOrderedBits(static_cast<T>(0.0)) - hebench::Utilities::getOrderedBits(static_cast<T>(-0.0)) == 1,
+              "Zero and negative zero must be consecutive.");
+        T value = static_cast<T>(3.5);
+        check(hebench::Utilities::getOrderedBits(nextUp(value, 1)) - hebench::Utilities::getOrderedBits(value) == 1,
+              "Consecutive values must map to consecutive integers.");
+    } // end if
+}
+
+template <typename T>
+void testFindNotWithinTolerance(const ValidationTolerance &tolerance, std::uint64_t seed)
+{
+    // mostly matching arrays spanning several blocks of the screening kernel, with some mismatches
+    std::mt19937_64 rand(seed);
+    std::uniform_real_distribution<double> rand_value(-1000.0, 1000.0);
+    std::uniform_real_distribution<double> rand_error(-0.02, 0.02);
+    constexpr std::uint64_t Count = 3 * 1024 + 17;
+    std::vector<T> a(Count);
+    std::vector<T> b(Count);
+    for (std::uint64_t i = 0; i < Count; ++i)
+    {
+        a[i] = static_cast<T>(rand_value(rand));
+        b[i] = i % 5 == 0 ? a[i] : static_cast<T>(static_cast<double>(a[i]) * (1.0 + rand_error(rand)));
+    } // end for
+
+    std::vector<std::uint64_t> expected;
+    hebench::Utilities::ValidationErrorStats expected_stats;
+    for (std::uint64_t i = 0; i < Count; ++i)
+    {
+        if (!hebench::Utilities::isWithinTolerance(a[i], b[i], tolerance))
+            expected.push_back(i);
+        double err                   = std::abs(static_cast<double>(a[i]) - static_cast<double>(b[i]));
+        double max_mag               = std::max(std::abs(static_cast<double>(a[i])), std::abs(static_cast<double>(b[i])));
+        expected_stats.max_abs_error = std::max(expected_stats.max_abs_error, err);
+        expected_stats.max_rel_error = std::max(expected_stats.max_rel_error, max_mag > 0.0 ? err / max_mag : 0.0);
+        expected_stats.sum_sq_error += err * err;
+    } // end for
+
+    hebench::Utilities::ValidationErrorStats stats;
+    std::vector<std::uint64_t> not_within = hebench::Utilities::findNotWithinTolerance(a.data(), b.data(), Count, tolerance, &stats);
+    check(not_within == expected, "Elements not within " + ValidationTolerance::getModelName(tolerance.model) + " tolerance do not match.");
+    check(stats.element_count == Count, "Error statistics element count does not match.");
+    check(stats.max_abs_error == expected_stats.max_abs_error, "Maximum absolute error does not match.");
+    check(stats.max_rel_error == expected_stats.max_rel_error, "Maximum relative error does not match.");
+    check(std::abs(stats.getRMSE() - std::sqrt(expected_stats.sum_sq_error / Count)) <= 1e-9 * stats.getRMSE(),
+          "RMSE does not match.");
+}
+
+void testErrorStats()
+{
+    std::vector<double> a = { 1.0, 2.0, -4.0, 0.0 };
+    std::vector<double> b = { 1.0, 2.5, -3.0, 0.0 };
+    hebench::Utilities::ValidationErrorStats stats;
+    std::vector<std::uint64_t> not_within =
+        hebench::Utilities::findNotWithinTolerance(a.data(), b.data(), a.size(), createTolerance(Model::Absolute, 0.5, 0.0, 0), &stats);
+    check(not_within == std::vector<std::uint64_t>({ 2 }), "Elements not within absolute tolerance do not match.");
+    check(stats.element_count == 4, "Error statistics element count does not match.");
+    check(stats.max_abs_error == 1.0, "Maximum absolute error does not match.");
+    check(stats.max_rel_error == 0.25, "Maximum relative error does not match.");
+    check(stats.getRMSE() == std::sqrt(1.25 / 4.0), "RMSE does not match.");
+
+    // NaN errors are kept by the maximum
+    b[0] = std::numeric_limits<double>::quiet_NaN();
+    hebench::Utilities::ValidationErrorStats nan_stats;
+    not_within = hebench::Utilities::findNotWithinTolerance(a.data(), b.data(), a.size(), createTolerance(Model::Absolute, 0.5, 0.0, 0), &nan_stats);
+    check(not_within == std::vector<std::uint64_t>({ 0, 2 }), "NaN element must not be within tolerance.");
+    stats.merge(nan_stats);
+    check(std::isnan(stats.max_abs_error) && stats.element_count == 8, "Merged statistics must keep NaN error.");
+}
+
+void testSetTolerance()
+{
+    // set items are matched with each tolerance model
+    std::mt19937_64 rand(11);
+    std::uniform_real_distribution<double> rand_value(-100.0, 100.0);
+    constexpr std::uint64_t n = 2000;
+    constexpr std::uint64_t k = 2;
+    std::vector<double> X(n * k);
+    for (double &value : X)
+        value = rand_value(rand);
+
+    struct ToleranceCase
+    {
+        ValidationTolerance tolerance;
+        std::vector<double> Y;
+    };
+    std::vector<ToleranceCase> cases(4);
+    cases[0].tolerance = createTolerance(Model::Relative, 0.0, 0.01, 0);
+    cases[1].tolerance = createTolerance(Model::Absolute, 0.05, 0.0, 0);
+    cases[2].tolerance = createTolerance(Model::ULP, 0.0, 0.0, 8);
+    cases[3].tolerance = createTolerance(Model::Mixed, 0.05, 0.01, 8);
+    for (std::uint64_t i = 0; i < n * k; ++i)
+    {
+        cases[0].Y.push_back(X[i] * 1.0099);
+        cases[1].Y.push_back(X[i] + (i % 2 == 0 ? 0.0499 : -0.0499));
+        cases[2].Y.push_back(nextUp(X[i], 8));
+        // each element within a different criterion
+        cases[3].Y.push_back(i % 3 == 0 ? X[i] * 1.0099 : i % 3 == 1 ? X[i] - 0.0499 : nextUp(X[i], 8));
+    } // end for
+
+    for (ToleranceCase &tolerance_case : cases)
+    {
+        std::string model_name = ValidationTolerance::getModelName(tolerance_case.tolerance.model);
+        // reverse the order of items
+        std::vector<double> Y;
+        for (std::uint64_t i = n; i > 0; --i)
+            Y.insert(Y.end(), tolerance_case.Y.begin() + (i - 1) * k, tolerance_case.Y.begin() + i * k);
+
+        hebench::Utilities::ValidationErrorStats stats;
+        check(SimpleSetIntersection::almostEqualSet(X.data(), Y.data(), n, n, k, tolerance_case.tolerance, &stats).empty(),
+              "Set items within " + model_name + " tolerance must match.");
+        hebench::Utilities::ValidationErrorStats expected_stats;
+        hebench::Utilities::findNotWithinTolerance(X.data(), tolerance_case.Y.data(), n * k, tolerance_case.tolerance, &expected_stats);
+        check(stats.element_count == expected_stats.element_count
+                  && stats.max_abs_error == expected_stats.max_abs_error
+                  && stats.max_rel_error == expected_stats.max_rel_error,
+              "Set error statistics for " + model_name + " tolerance do not match.");
+
+        // an item out of tolerance is reported
+        Y[3] += 10.0;
+        std::vector<std::pair<bool, std::uint64_t>> mismatches =
+            SimpleSetIntersection::almostEqualSet(X.data(), Y.data(), n, n, k, tolerance_case.tolerance);
+        check(mismatches.size() == 2 && mismatches[0] == std::pair(true, n - 2) && mismatches[1] == std::pair(false, std::uint64_t(1)),
+              "Set item out of " + model_name + " tolerance must be reported.");
+    } // end for
+}
+
+void testFindNotWithinToleranceModels()
+{
+    for (Model model : { Model::Relative, Model::Absolute, Model::ULP, Model::Mixed })
+    {
+        ValidationTolerance tolerance = createTolerance(model, 5.0, 0.01, 1ULL << 40);
+        testFindNotWithinTolerance<double>(tolerance, 1);
+        testFindNotWithinTolerance<float>(tolerance, 2);
+        testFindNotWithinTolerance<std::int32_t>(tolerance, 3);
+        testFindNotWithinTolerance<std::int64_t>(tolerance, 4);
+    } // end for
+}
+
+} // namespace
+
+int main()
+{
+    return hebench::UnitTest::runTests({ testModels,
+                                         testOrderedBits<std::int32_t>,
+                                         testOrderedBits<std::int64_t>,
+                                         testOrderedBits<float>,
+                                         testOrderedBits<double>,
+                                         testFindNotWithinToleranceModels,
+                                         testErrorStats,
+                                         testSetTolerance });
+}
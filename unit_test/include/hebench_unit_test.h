@@ -0,0 +1,115 @@
+
+// Copyright (C) 2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef _HEBench_UnitTest_H_0596d40a3cce4b108a81595c50eb286d
+#define _HEBench_UnitTest_H_0596d40a3cce4b108a81595c50eb286d
+
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace hebench {
+namespace UnitTest {
+
+/**
+ * @brief Fails the running test case if a condition does not hold.
+ * @param[in] condition Condition to check.
+ * @param[in] msg Description of the failure.
+ * @throws std::runtime_error with \p msg if \p condition is `false`.
+ */
+inline void check(bool condition, const std::string &msg)
+{
+    if (!condition)
+        throw std::runtime_error(msg);
+}
+
+/**
+ * @brief Fails the running test case if a call does not throw.
+ * @param[in] f Callable object to call without arguments.
+ * @param[in] msg Description of the failure.
+ * @throws std::runtime_error with \p msg if \p f does not throw an exception of
+ * type `E` or derived from it.
+ */
+template <class E, class F>
+void checkThrows(F f, const std::string &msg)
+{
+    bool b_thrown = false;
+    try
+    {
+        f();
+    }
+    catch (const E &)
+    {
+        b_thrown = true;
+    }
+    check(b_thrown, msg);
+}
+
+/**
+ * @brief Directory in the system temporary path, removed with all its contents
+ * when the object is destroyed.
+ */
+class TemporaryDirectory
+{
+public:
+    /**
+     * @brief Creates a new directory with a unique name.
+     * @param[in] prefix Prefix for the name of the directory.
+     * @throws std::filesystem::filesystem_error if the directory cannot be created.
+     */
+    TemporaryDirectory(const std::string &prefix) :
+        m_path(std::filesystem::temp_directory_path() / (prefix + "_" + std::to_string(std::random_device()())))
+    {
+        std::filesystem::create_directories(m_path);
+    }
+    ~TemporaryDirectory()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path, ec);
+    }
+    TemporaryDirectory(const TemporaryDirectory &)            = delete;
+    TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+
+    const std::filesystem::path &getPath() const { return m_path; }
+
+private:
+    std::filesystem::path m_path;
+};
+
+/**
+ * @brief Runs the test cases of a unit test executable in order.
+ * @param[in] test_cases Test cases to run. A test case fails by throwing.
+ * @return `EXIT_SUCCESS` if all test cases passed, `EXIT_FAILURE` otherwise. Meant
+ * to be returned from `main()`.
+ * @details Stops at the first test case that fails and prints its error to
+ * `std::cerr`. Prints `PASSED` to `std::cout` if all test cases passed.
+ */
+inline int runTests(const std::vector<std::function<void()>> &test_cases)
+{
+    try
+    {
+        for (const std::function<void()> &test_case : test_cases)
+            test_case();
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "FAILED: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "PASSED" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+} // namespace UnitTest
+} // namespace hebench
+
+#endif // defined _HEBench_UnitTest_H_0596d40a3cce4b108a81595c50eb286d